@@ -15,6 +15,23 @@ protected:
     virtual void check_exec(const TensorLayout& dst, size_t workspace_in_bytes) = 0;
 };
 
+/*!
+ * \brief interface of random oprs whose output only depends on their inputs,
+ *      param and an offset into the random stream of the seed
+ *
+ * Each exec consumes the stream from offset() and then advances it. Restoring
+ * a previous offset with set_offset() makes the next exec reproduce the output
+ * generated at that offset, e.g. to recompute an evicted tensor.
+ */
+class CounterBasedRNG {
+public:
+    virtual uint64_t offset() const = 0;
+    virtual void set_offset(uint64_t offset) = 0;
+
+protected:
+    ~CounterBasedRNG() = default;
+};
+
 //! sample from poisson distribution
 class PoissonRNG : public OperatorBase {
     DEF_OPR_IMPL(PoissonRNG, OperatorBase, 1, 1);
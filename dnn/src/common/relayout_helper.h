@@ -94,26 +94,27 @@ void transpose_block(
 }
 
 /*!
- * \brief transpose contiguous (batch, m, n) to (batch, n, m)
+ * \brief transpose the rows [row_begin, row_end) of (m, n) to the columns of
+ * contiguous (n, m)
+ *
+ * This is used to split a transpose into independent tasks, since the rows of
+ * src are written to disjoint columns of dst
  */
 template <typename T>
-void transpose(size_t batch, size_t m, size_t n, T* src, T* dst, size_t stride_m = 0) {
-    if (stride_m == 0) {
-        stride_m = n;
-    }
-    auto batch_src = src;
-    auto batch_dst = dst;
+void transpose_rows(
+        size_t m, size_t n, T* src, T* dst, size_t stride_m, size_t row_begin,
+        size_t row_end) {
     constexpr size_t B = transpose_traits<T>::block_size;
 
-    auto work_block = [m, stride_m, &batch_src, &batch_dst](
+    auto work_block = [m, stride_m, src, dst](
                               const size_t i, const size_t j, const size_t h,
                               const size_t w) {
-        auto src = batch_src + i * stride_m + j, dst = batch_dst + j * m + i;
+        auto block_src = src + i * stride_m + j, block_dst = dst + j * m + i;
         MIDOUT_BEGIN(transpose_fallback, midout_iv(0)) {
             if (h == B && w == B) {
-                transpose_block(src, dst, stride_m, m);
+                transpose_block(block_src, block_dst, stride_m, m);
             } else {
-                transpose_block(src, dst, stride_m, m, h, w);
+                transpose_block(block_src, block_dst, stride_m, m, h, w);
             }
         }
         MIDOUT_END();
@@ -128,16 +129,27 @@ void transpose(size_t batch, size_t m, size_t n, T* src, T* dst, size_t stride_m
         }
     };
 
+    size_t i = row_begin;
+    for (; i + B <= row_end; i += B) {
+        work_row(i, B);
+    }
+    if (i < row_end) {
+        work_row(i, row_end - i);
+    }
+}
+
+/*!
+ * \brief transpose contiguous (batch, m, n) to (batch, n, m)
+ */
+template <typename T>
+void transpose(size_t batch, size_t m, size_t n, T* src, T* dst, size_t stride_m = 0) {
+    if (stride_m == 0) {
+        stride_m = n;
+    }
     for (size_t b = 0; b < batch; ++b) {
-        size_t i = 0;
-        for (; i + B <= m; i += B) {
-            work_row(i, B);
-        }
-        if (i < m) {
-            work_row(i, m - i);
-        }
-        batch_src += m * stride_m;
-        batch_dst += m * n;
+        transpose_rows(m, n, src, dst, stride_m, 0, m);
+        src += m * stride_m;
+        dst += m * n;
     }
 }
 }  // namespace transpose_fallback
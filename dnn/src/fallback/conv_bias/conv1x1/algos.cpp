@@ -210,7 +210,11 @@ bool ConvBiasImpl::AlgoConv1x1::usable(
         }
 #else  //! x86 and RISC-V do not support NCHW44_DOT
         if (format != param::ConvBias::Format::NCHW &&
-            format != param::ConvBias::Format::NCHW44) {
+            format != param::ConvBias::Format::NCHW44
+#if MEGDNN_X86
+            && format != param::ConvBias::Format::NCHW88
+#endif
+        ) {
             return false;
         }
         //! hybird mode is not support
@@ -219,6 +223,16 @@ bool ConvBiasImpl::AlgoConv1x1::usable(
                 return false;
             }
         }
+#if MEGDNN_X86
+        //! x86 nchw88 only runs float32 on the MK8 matmul, without hybrid mode
+        //! and channel wise
+        if (format == param::ConvBias::Format::NCHW88) {
+            if (param.src_type.enumv() != DTypeEnum::Float32 ||
+                param.filter_meta.icpg < 8_z || param.filter_meta.ocpg == 1) {
+                return false;
+            }
+        }
+#endif
 #endif
         //! param
         if (FH != 1 || FW != 1 || PH || PW || SH != 1 || SW != 1) {
@@ -0,0 +1,115 @@
+#include "src/fallback/copy_helper.h"
+
+#include <cstring>
+#include <vector>
+#include "src/common/utils.h"
+
+#if MEGDNN_X86
+#include <emmintrin.h>
+#endif
+
+namespace megdnn {
+namespace fallback {
+namespace copy {
+
+void copy_bytes(void* dst, const void* src, size_t nr_bytes, bool non_temporal) {
+#if MEGDNN_X86
+    //! short copies would mostly be spent on the unaligned head and tail
+    if (non_temporal && nr_bytes >= 256) {
+        auto dptr = static_cast<uint8_t*>(dst);
+        auto sptr = static_cast<const uint8_t*>(src);
+        size_t head = (16 - reinterpret_cast<uintptr_t>(dptr) % 16) % 16;
+        std::memcpy(dptr, sptr, head);
+        size_t i = head;
+        for (; i + 64 <= nr_bytes; i += 64) {
+            __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + i));
+            __m128i v1 =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + i + 16));
+            __m128i v2 =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + i + 32));
+            __m128i v3 =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + i + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dptr + i), v0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dptr + i + 16), v1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dptr + i + 32), v2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dptr + i + 48), v3);
+        }
+        std::memcpy(dptr + i, sptr + i, nr_bytes - i);
+        return;
+    }
+#else
+    MEGDNN_MARK_USED_VAR(non_temporal);
+#endif
+    std::memcpy(dst, src, nr_bytes);
+}
+
+void store_fence(bool non_temporal) {
+#if MEGDNN_X86
+    if (non_temporal) {
+        _mm_sfence();
+    }
+#else
+    MEGDNN_MARK_USED_VAR(non_temporal);
+#endif
+}
+
+void dispatch_segments_copy(
+        Handle* handle, const TensorND& whole, const TensorNDArray& parts,
+        size_t nr_rows, bool to_whole) {
+    if (!nr_rows) {
+        return;
+    }
+    size_t nr_parts = parts.size();
+    //! offsets[i] is the offset of the row of parts[i] in a row of whole
+    std::vector<size_t> offsets(nr_parts + 1, 0);
+    for (size_t i = 0; i < nr_parts; ++i) {
+        auto&& layout = parts[i].layout;
+        size_t part_bytes = layout.total_nr_elems() * layout.dtype.size();
+        offsets[i + 1] = offsets[i] + part_bytes / nr_rows;
+    }
+    size_t row_bytes = offsets[nr_parts];
+    size_t nr_bytes = row_bytes * nr_rows;
+    if (!nr_bytes) {
+        return;
+    }
+    size_t nr_chunks = div_ceil(nr_bytes, CHUNK_BYTES);
+    size_t nr_tasks = get_nr_tasks(handle, nr_chunks, nr_bytes);
+    size_t chunks_per_task = div_ceil(nr_chunks, nr_tasks);
+    bool non_temporal = nr_bytes >= MIN_BYTES_NON_TEMPORAL;
+    auto kern = [=](size_t task_id, size_t) {
+        auto whole_ptr = static_cast<uint8_t*>(whole.raw_ptr());
+        size_t begin = std::min(nr_bytes, task_id * chunks_per_task * CHUNK_BYTES);
+        size_t end = std::min(nr_bytes, begin + chunks_per_task * CHUNK_BYTES);
+        size_t row = begin / row_bytes, offset = begin % row_bytes;
+        size_t part = std::upper_bound(offsets.begin(), offsets.end(), offset) -
+                      offsets.begin() - 1;
+        for (size_t pos = begin; pos < end;) {
+            size_t part_row_bytes = offsets[part + 1] - offsets[part];
+            size_t part_offset = offset - offsets[part];
+            size_t len = std::min(part_row_bytes - part_offset, end - pos);
+            auto part_ptr = static_cast<uint8_t*>(parts[part].raw_ptr()) +
+                            row * part_row_bytes + part_offset;
+            if (to_whole) {
+                copy_bytes(whole_ptr + pos, part_ptr, len, non_temporal);
+            } else {
+                copy_bytes(part_ptr, whole_ptr + pos, len, non_temporal);
+            }
+            pos += len;
+            offset += len;
+            if (++part == nr_parts) {
+                part = 0;
+                offset = 0;
+                ++row;
+            }
+        }
+        store_fence(non_temporal);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle), nr_tasks, kern);
+}
+
+}  // namespace copy
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
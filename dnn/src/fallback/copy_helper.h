@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+#include "megdnn/basic_types.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+namespace copy {
+
+//! bytes written by one scheduling unit, small enough to stay in L2
+constexpr size_t CHUNK_BYTES = 128 * 1024;
+//! copies with fewer bytes are executed in one thread
+constexpr size_t MIN_BYTES_MULTI_THREAD = 256 * 1024;
+//! outputs with more bytes are written with non-temporal stores on x86, as
+//! they would only evict the working set of the following operators
+constexpr size_t MIN_BYTES_NON_TEMPORAL = 8 * 1024 * 1024;
+
+static inline size_t get_nr_tasks(Handle* handle, size_t nr_units, size_t nr_bytes) {
+    if (nr_bytes < MIN_BYTES_MULTI_THREAD) {
+        return 1;
+    }
+    size_t nr_threads =
+            static_cast<naive::HandleImpl*>(handle)->megcore_dispatcher()->nr_threads();
+    return std::max<size_t>(std::min(nr_units, nr_threads), 1);
+}
+
+/*!
+ * \brief memcpy, or streaming stores that bypass the caches when \p non_temporal
+ * is set and the target supports them
+ *
+ * A task which copied with non_temporal set must call store_fence() before it
+ * returns, so that its stores are visible to the following kernels.
+ */
+void copy_bytes(void* dst, const void* src, size_t nr_bytes, bool non_temporal);
+
+void store_fence(bool non_temporal);
+
+/*!
+ * \brief copy between a contiguous tensor and the tensors it is concatenated
+ * from along one axis
+ *
+ * \p whole is viewed as \p nr_rows rows, and row i of it is the concatenation
+ * of row i of every tensor in \p parts. The rows of \p whole are split into
+ * chunks of CHUNK_BYTES bytes and the chunks are distributed to the threads
+ * of \p handle. Parts are copied into \p whole if \p to_whole is set, and
+ * \p whole is split into parts otherwise.
+ */
+void dispatch_segments_copy(
+        Handle* handle, const TensorND& whole, const TensorNDArray& parts,
+        size_t nr_rows, bool to_whole);
+
+}  // namespace copy
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,392 @@
+/**
+ * \file dnn/src/fallback/elemwise/gi_impl/avx2/algo.cpp
+ */
+#include "src/fallback/elemwise/gi_impl/avx2/algo.h"
+
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#if defined(MGB_ENABLE_CPUINFO_CHECK) && MGB_ENABLE_CPUINFO
+#include <cpuinfo.h>
+#endif
+
+#include <atomic>
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_elemwise_avx2)
+
+using namespace megdnn;
+using namespace elemwise;
+using namespace fallback;
+
+namespace {
+
+std::atomic_bool gi_avx2_disabled{false};
+
+bool avx2_available() {
+    return !gi_avx2_disabled.load(std::memory_order_relaxed) &&
+           fallback::gi_avx2_supported();
+}
+
+//! split [0, nr) into blocks which are multiples of align, one for each thread
+template <typename Kern>
+void dispatch_blocks(
+        const ElemwiseImpl::KernParam& kern_param, size_t nr, size_t align,
+        Kern kern) {
+    if (!nr)
+        return;
+    auto handle = static_cast<naive::HandleImpl*>(kern_param.handle);
+    size_t nr_threads = handle->megcore_dispatcher()->nr_threads();
+    size_t per_thread = (nr + nr_threads - 1) / nr_threads;
+    per_thread = (per_thread + align - 1) / align * align;
+    size_t nr_tasks = (nr + per_thread - 1) / per_thread;
+    auto task = [nr, per_thread, kern](size_t task_id, size_t) {
+        size_t begin = task_id * per_thread;
+        kern(begin, std::min(nr - begin, per_thread));
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, task);
+}
+
+struct Avx2ReluOp {
+    static GI_AVX2_FORCEINLINE GI_AVX2_FLOAT32_t apply(GI_AVX2_FLOAT32_t x) {
+        return Gi256MaximumFloat32(x, Gi256ZeroFloat32());
+    }
+    static float apply(float x) { return x > 0.f ? x : 0.f; }
+};
+
+struct Avx2AbsOp {
+    static GI_AVX2_FORCEINLINE GI_AVX2_FLOAT32_t apply(GI_AVX2_FLOAT32_t x) {
+        return Gi256AbsFloat32(x);
+    }
+    static float apply(float x) { return x > 0.f ? x : -x; }
+};
+
+#define DEF_BINARY_OP(_name, _vec_expr, _scalar_expr)                       \
+    struct _name {                                                          \
+        static GI_AVX2_FORCEINLINE GI_AVX2_FLOAT32_t                        \
+        apply(GI_AVX2_FLOAT32_t x, GI_AVX2_FLOAT32_t y) {                   \
+            return _vec_expr;                                               \
+        }                                                                   \
+        static float apply(float x, float y) { return _scalar_expr; }       \
+    }
+
+DEF_BINARY_OP(Avx2AddOp, Gi256AddFloat32(x, y), x + y);
+DEF_BINARY_OP(Avx2SubOp, Gi256SubtractFloat32(x, y), x - y);
+DEF_BINARY_OP(Avx2MulOp, Gi256MultiplyFloat32(x, y), x * y);
+DEF_BINARY_OP(Avx2TrueDivOp, Gi256DivideFloat32(x, y), x / y);
+DEF_BINARY_OP(Avx2MaxOp, Gi256MaximumFloat32(x, y), x > y ? x : y);
+DEF_BINARY_OP(Avx2MinOp, Gi256MinimumFloat32(x, y), x < y ? x : y);
+DEF_BINARY_OP(
+        Avx2FuseAddReluOp,
+        Gi256MaximumFloat32(Gi256AddFloat32(x, y), Gi256ZeroFloat32()),
+        x + y > 0.f ? x + y : 0.f);
+#undef DEF_BINARY_OP
+
+template <typename Op>
+GI_AVX2_TARGET void run_unary(const float* src, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto x0 = Gi256LoadFloat32(src + i);
+        auto x1 = Gi256LoadFloat32(src + i + 8);
+        Gi256StoreFloat32(dst + i, Op::apply(x0));
+        Gi256StoreFloat32(dst + i + 8, Op::apply(x1));
+    }
+    for (; i + 8 <= n; i += 8) {
+        Gi256StoreFloat32(dst + i, Op::apply(Gi256LoadFloat32(src + i)));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Op::apply(src[i]);
+    }
+}
+
+template <typename Op>
+GI_AVX2_TARGET void run_vec_vec(
+        const float* src0, const float* src1, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto x0 = Gi256LoadFloat32(src0 + i), x1 = Gi256LoadFloat32(src0 + i + 8);
+        auto y0 = Gi256LoadFloat32(src1 + i), y1 = Gi256LoadFloat32(src1 + i + 8);
+        Gi256StoreFloat32(dst + i, Op::apply(x0, y0));
+        Gi256StoreFloat32(dst + i + 8, Op::apply(x1, y1));
+    }
+    for (; i + 8 <= n; i += 8) {
+        Gi256StoreFloat32(
+                dst + i,
+                Op::apply(Gi256LoadFloat32(src0 + i), Gi256LoadFloat32(src1 + i)));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Op::apply(src0[i], src1[i]);
+    }
+}
+
+template <typename Op, bool scalar_first>
+GI_AVX2_FORCEINLINE GI_AVX2_FLOAT32_t
+apply_ordered(GI_AVX2_FLOAT32_t v, GI_AVX2_FLOAT32_t s) {
+    return scalar_first ? Op::apply(s, v) : Op::apply(v, s);
+}
+
+//! dst = op(src, scalar) if scalar_first is false, otherwise op(scalar, src)
+template <typename Op, bool scalar_first>
+GI_AVX2_TARGET void run_vec_scalar(
+        const float* src, float scalar, float* dst, size_t n) {
+    auto vs = Gi256BroadcastFloat32(scalar);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto x0 = Gi256LoadFloat32(src + i), x1 = Gi256LoadFloat32(src + i + 8);
+        Gi256StoreFloat32(dst + i, apply_ordered<Op, scalar_first>(x0, vs));
+        Gi256StoreFloat32(dst + i + 8, apply_ordered<Op, scalar_first>(x1, vs));
+    }
+    for (; i + 8 <= n; i += 8) {
+        auto x = Gi256LoadFloat32(src + i);
+        Gi256StoreFloat32(dst + i, apply_ordered<Op, scalar_first>(x, vs));
+    }
+    for (; i < n; ++i) {
+        dst[i] = scalar_first ? Op::apply(scalar, src[i]) : Op::apply(src[i], scalar);
+    }
+}
+
+template <typename Op, bool scalar_first>
+GI_AVX2_TARGET void run_bcast101(
+        const float* vec, const float* chan, float* dst, size_t row_begin,
+        size_t nr_rows, size_t channel, size_t inner) {
+    for (size_t row = row_begin; row < row_begin + nr_rows; ++row) {
+        size_t off = row * inner;
+        run_vec_scalar<Op, scalar_first>(
+                vec + off, chan[row % channel], dst + off, inner);
+    }
+}
+
+//! dst = src0 * src1 + src2, where src2 is a scalar if c_is_scalar
+template <bool c_is_scalar>
+GI_AVX2_TARGET void run_fma3(
+        const float* src0, const float* src1, const float* src2, float* dst,
+        size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto c0 = c_is_scalar ? Gi256BroadcastFloat32(src2[0])
+                              : Gi256LoadFloat32(src2 + i);
+        auto c1 = c_is_scalar ? c0 : Gi256LoadFloat32(src2 + i + 8);
+        Gi256StoreFloat32(
+                dst + i,
+                Gi256MultiplyAddFloat32(
+                        c0, Gi256LoadFloat32(src0 + i), Gi256LoadFloat32(src1 + i)));
+        Gi256StoreFloat32(
+                dst + i + 8, Gi256MultiplyAddFloat32(
+                                     c1, Gi256LoadFloat32(src0 + i + 8),
+                                     Gi256LoadFloat32(src1 + i + 8)));
+    }
+    for (; i + 8 <= n; i += 8) {
+        auto c = c_is_scalar ? Gi256BroadcastFloat32(src2[0])
+                             : Gi256LoadFloat32(src2 + i);
+        Gi256StoreFloat32(
+                dst + i,
+                Gi256MultiplyAddFloat32(
+                        c, Gi256LoadFloat32(src0 + i), Gi256LoadFloat32(src1 + i)));
+    }
+    for (; i < n; ++i) {
+        dst[i] = src0[i] * src1[i] + (c_is_scalar ? src2[0] : src2[i]);
+    }
+}
+
+bool is_float32(const TensorND& tensor) {
+    return tensor.layout.dtype == dtype::Float32();
+}
+
+}  // anonymous namespace
+
+bool fallback::gi_avx2_supported() {
+#if defined(MGB_ENABLE_CPUINFO_CHECK) && MGB_ENABLE_CPUINFO
+    static bool supported = cpuinfo_initialize() && cpuinfo_has_x86_avx2() &&
+                            cpuinfo_has_x86_fma3();
+#elif defined(__GNUC__)
+    static bool supported =
+            __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    static bool supported = false;
+#endif
+    return supported;
+}
+
+void fallback::gi_avx2_disable(bool disable) {
+    gi_avx2_disabled.store(disable, std::memory_order_relaxed);
+}
+
+/* ======================== unary ======================== */
+bool ElemwiseImpl::AlgoAvx2Unary::is_available(const KernParam& kern_param) const {
+    if (BcastType::VEC != kern_param.broad_cast_type || !avx2_available())
+        return false;
+    auto& src0 = kern_param.unary_elparam[0];
+    return is_float32(src0) && src0.layout.is_contiguous() &&
+           (kern_param.mode == Mode::RELU || kern_param.mode == Mode::ABS);
+}
+
+void ElemwiseImpl::AlgoAvx2Unary::exec(const KernParam& kern_param) const {
+    auto src = static_cast<const float*>(kern_param.unary_elparam[0].raw_ptr());
+    auto dst = static_cast<float*>(kern_param.m_dst->raw_ptr());
+    size_t nr_elems = kern_param.unary_elparam[0].layout.total_nr_elems();
+
+#define DISPATCH_UNARY(_mode, _op)                                                 \
+    case Mode::_mode:                                                              \
+        MIDOUT_BEGIN(                                                              \
+                megdnn_fallback_elemwise_avx2, midout_iv(0),                       \
+                midout_iv(Mode::_mode)) {                                          \
+            dispatch_blocks(kern_param, nr_elems, 8, [=](size_t off, size_t n) { \
+                run_unary<_op>(src + off, dst + off, n);                           \
+            });                                                                    \
+        }                                                                          \
+        MIDOUT_END();                                                              \
+        return
+
+    switch (kern_param.mode) {
+        DISPATCH_UNARY(RELU, Avx2ReluOp);
+        DISPATCH_UNARY(ABS, Avx2AbsOp);
+        default:
+            megdnn_throw(ssprintf(
+                    "No avaiable algo find for: %d",
+                    static_cast<int>(kern_param.mode)));
+    }
+#undef DISPATCH_UNARY
+}
+
+/* ======================== binary ======================== */
+bool ElemwiseImpl::AlgoAvx2Binary::is_available(const KernParam& kern_param) const {
+    auto type = kern_param.broad_cast_type;
+    if ((type != BcastType::VEC_VEC && type != BcastType::VEC_SCALAR &&
+         type != BcastType::SCALAR_VEC && type != BcastType::VEC_BCAST101 &&
+         type != BcastType::BCAST101_VEC) ||
+        !avx2_available())
+        return false;
+    auto& elparam = kern_param.binary_elparam;
+    if (!is_float32(elparam[0]) || !is_float32(elparam[1]))
+        return false;
+    auto mode = kern_param.mode;
+    return mode == Mode::MIN || mode == Mode::MAX || mode == Mode::ADD ||
+           mode == Mode::SUB || mode == Mode::MUL || mode == Mode::TRUE_DIV ||
+           mode == Mode::FUSE_ADD_RELU;
+}
+
+void ElemwiseImpl::AlgoAvx2Binary::exec(const KernParam& kern_param) const {
+    auto& elparam = kern_param.binary_elparam;
+    auto &src0 = elparam[0], &src1 = elparam[1];
+    auto sptr0 = static_cast<const float*>(src0.raw_ptr());
+    auto sptr1 = static_cast<const float*>(src1.raw_ptr());
+    auto dptr = static_cast<float*>(kern_param.m_dst->raw_ptr());
+    auto type = kern_param.broad_cast_type;
+    BroadcastChannelInfo binfo;
+    if (type == BcastType::VEC_BCAST101 || type == BcastType::BCAST101_VEC) {
+        bool is_bcast101 = is_broadcasted_channel_like(
+                type == BcastType::VEC_BCAST101 ? src1.layout : src0.layout, binfo);
+        megdnn_assert(is_bcast101);
+        MEGDNN_MARK_USED_VAR(is_bcast101);
+    }
+
+    //! each (batch, channel) row of bcast101 is handled as vec-scalar
+    auto run = [&](auto op) {
+        using Op = decltype(op);
+        switch (type) {
+            case BcastType::VEC_VEC:
+                dispatch_blocks(
+                        kern_param, src0.layout.total_nr_elems(), 8,
+                        [=](size_t off, size_t n) {
+                            run_vec_vec<Op>(sptr0 + off, sptr1 + off, dptr + off, n);
+                        });
+                return;
+            case BcastType::VEC_SCALAR:
+                dispatch_blocks(
+                        kern_param, src0.layout.total_nr_elems(), 8,
+                        [=](size_t off, size_t n) {
+                            run_vec_scalar<Op, false>(
+                                    sptr0 + off, sptr1[0], dptr + off, n);
+                        });
+                return;
+            case BcastType::SCALAR_VEC:
+                dispatch_blocks(
+                        kern_param, src1.layout.total_nr_elems(), 8,
+                        [=](size_t off, size_t n) {
+                            run_vec_scalar<Op, true>(
+                                    sptr1 + off, sptr0[0], dptr + off, n);
+                        });
+                return;
+            case BcastType::VEC_BCAST101:
+                dispatch_blocks(
+                        kern_param, binfo.x * binfo.y, 1, [=](size_t row, size_t n) {
+                            run_bcast101<Op, false>(
+                                    sptr0, sptr1, dptr, row, n, binfo.y, binfo.z);
+                        });
+                return;
+            case BcastType::BCAST101_VEC:
+                dispatch_blocks(
+                        kern_param, binfo.x * binfo.y, 1, [=](size_t row, size_t n) {
+                            run_bcast101<Op, true>(
+                                    sptr1, sptr0, dptr, row, n, binfo.y, binfo.z);
+                        });
+                return;
+            default:
+                megdnn_throw("bad broadcast type for AlgoAvx2Binary");
+        }
+    };
+
+#define DISPATCH_BINARY(_mode, _op)                           \
+    case Mode::_mode:                                         \
+        MIDOUT_BEGIN(                                         \
+                megdnn_fallback_elemwise_avx2, midout_iv(1),  \
+                midout_iv(Mode::_mode)) {                     \
+            run(_op{});                                       \
+        }                                                     \
+        MIDOUT_END();                                         \
+        return
+
+    switch (kern_param.mode) {
+        DISPATCH_BINARY(MIN, Avx2MinOp);
+        DISPATCH_BINARY(MAX, Avx2MaxOp);
+        DISPATCH_BINARY(ADD, Avx2AddOp);
+        DISPATCH_BINARY(SUB, Avx2SubOp);
+        DISPATCH_BINARY(MUL, Avx2MulOp);
+        DISPATCH_BINARY(TRUE_DIV, Avx2TrueDivOp);
+        DISPATCH_BINARY(FUSE_ADD_RELU, Avx2FuseAddReluOp);
+        default:
+            megdnn_throw(ssprintf(
+                    "No avaiable algo find for: %d",
+                    static_cast<int>(kern_param.mode)));
+    }
+#undef DISPATCH_BINARY
+}
+
+/* ======================== ternary ======================== */
+bool ElemwiseImpl::AlgoAvx2TernaryFma3::is_available(
+        const KernParam& kern_param) const {
+    auto type = kern_param.broad_cast_type;
+    if ((type != BcastType::VEC_VEC_VEC && type != BcastType::VEC_VEC_SCALAR) ||
+        !avx2_available())
+        return false;
+    auto& elparam = kern_param.ternary_elparam;
+    return is_float32(elparam[0]) && is_float32(elparam[1]) && is_float32(elparam[2]);
+}
+
+void ElemwiseImpl::AlgoAvx2TernaryFma3::exec(const KernParam& kern_param) const {
+    auto& elparam = kern_param.ternary_elparam;
+    auto sptr0 = static_cast<const float*>(elparam[0].raw_ptr());
+    auto sptr1 = static_cast<const float*>(elparam[1].raw_ptr());
+    auto sptr2 = static_cast<const float*>(elparam[2].raw_ptr());
+    auto dptr = static_cast<float*>(kern_param.m_dst->raw_ptr());
+    size_t nr_elems = elparam[0].layout.total_nr_elems();
+
+    MIDOUT_BEGIN(megdnn_fallback_elemwise_avx2, midout_iv(2)) {
+        if (kern_param.broad_cast_type == BcastType::VEC_VEC_VEC) {
+            dispatch_blocks(kern_param, nr_elems, 8, [=](size_t off, size_t n) {
+                run_fma3<false>(sptr0 + off, sptr1 + off, sptr2 + off, dptr + off, n);
+            });
+        } else {
+            dispatch_blocks(kern_param, nr_elems, 8, [=](size_t off, size_t n) {
+                run_fma3<true>(sptr0 + off, sptr1 + off, sptr2, dptr + off, n);
+            });
+        }
+    }
+    MIDOUT_END();
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen
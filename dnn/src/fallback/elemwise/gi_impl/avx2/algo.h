@@ -0,0 +1,32 @@
+/**
+ * \file dnn/src/fallback/elemwise/gi_impl/avx2/algo.h
+ */
+
+#pragma once
+#include "src/fallback/elemwise/gi_impl/avx2/utils.h"
+#include "src/fallback/elemwise/opr_impl.h"
+
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+namespace megdnn {
+namespace fallback {
+
+#define DECL_CB(case)                                                              \
+    class ElemwiseImpl::AlgoAvx2##case final : public ElemwiseImpl::AlgoBase {     \
+        AlgoAttribute attribute() const override {                                 \
+            return AlgoAttribute::REPRODUCIBLE;                                    \
+        }                                                                          \
+        const char* name() const override { return "Elemwise::AlgoAvx2" #case; } \
+        bool is_available(const KernParam&) const override;                        \
+        void exec(const KernParam&) const override;                                \
+    };
+
+DECL_CB(Unary);
+DECL_CB(Binary);
+DECL_CB(TernaryFma3);
+#undef DECL_CB
+
+}  // namespace fallback
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,30 @@
+/**
+ * \file dnn/src/fallback/elemwise/gi_impl/avx2/utils.h
+ */
+
+#pragma once
+#include "src/fallback/general_intrinsic/gi_avx2.h"
+
+//! float32 elemwise on 256-bit general intrinsic, used only when cpuinfo
+//! reports avx2 and fma
+#if MEGDNN_X86 && defined(GI_AVX2_DISPATCH)
+#define MEGDNN_FALLBACK_ELEMWISE_AVX2 1
+#else
+#define MEGDNN_FALLBACK_ELEMWISE_AVX2 0
+#endif
+
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+namespace megdnn {
+namespace fallback {
+
+//! whether the cpu supports avx2 and fma, checked by cpuinfo
+bool gi_avx2_supported();
+
+//! disable the 256-bit gi algos even if supported, for testing
+void gi_avx2_disable(bool disable);
+
+}  // namespace fallback
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
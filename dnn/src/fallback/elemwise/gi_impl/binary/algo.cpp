@@ -28,6 +28,60 @@ static inline bool is_available_common(Elemwise::Mode mode) {
 
     return true;
 }
+
+constexpr size_t CACHELINE_SIZE = 64;
+//! tensors smaller than this per thread are run on fewer threads
+constexpr size_t MIN_BYTES_PER_TASK = 16 * 1024;
+
+/*!
+ * \brief split nr_rows rows of row_bytes bytes of dst into tasks for the
+ *      threads of the handle
+ *
+ * Each task but the last one covers whole cache lines whenever row_bytes
+ * allows it, so two threads never write into the same cache line of dst.
+ */
+class RowPartition {
+    size_t m_nr_rows, m_nr_rows_per_task, m_nr_tasks;
+
+public:
+    RowPartition(Handle* handle, size_t nr_rows, size_t row_bytes)
+            : m_nr_rows{nr_rows} {
+        size_t nr_threads = static_cast<naive::HandleImpl*>(handle)
+                                    ->megcore_dispatcher()
+                                    ->nr_threads();
+        size_t nr_tasks = std::max<size_t>(
+                std::min(nr_threads, nr_rows * row_bytes / MIN_BYTES_PER_TASK), 1);
+        //! gcd(row_bytes, CACHELINE_SIZE) is the lowest set bit of row_bytes
+        //! capped to the cache line, as CACHELINE_SIZE is a power of two
+        size_t lowbit = std::min(row_bytes & (~row_bytes + 1), CACHELINE_SIZE);
+        size_t align = lowbit ? CACHELINE_SIZE / lowbit : 1;
+        m_nr_rows_per_task = round_up(div_ceil(nr_rows, nr_tasks), align);
+        m_nr_tasks = m_nr_rows_per_task ? div_ceil(nr_rows, m_nr_rows_per_task) : 1;
+    }
+
+    size_t nr_tasks() const { return m_nr_tasks; }
+    size_t begin(size_t task_id) const {
+        return std::min(task_id * m_nr_rows_per_task, m_nr_rows);
+    }
+    size_t end(size_t task_id) const {
+        return std::min(begin(task_id) + m_nr_rows_per_task, m_nr_rows);
+    }
+};
+
+/*!
+ * \brief call cb(row, nr_rows) on rows [begin, end) split at multiples of
+ *      nr_rows_per_batch, for the callers that walk a single batch
+ */
+template <typename Callback>
+void for_each_batch(
+        size_t begin, size_t end, size_t nr_rows_per_batch, Callback&& cb) {
+    while (begin < end) {
+        size_t nr_rows =
+                std::min(end - begin, nr_rows_per_batch - begin % nr_rows_per_batch);
+        cb(begin, nr_rows);
+        begin += nr_rows;
+    }
+}
 }  // anonymous namespace
 
 #define DISPATCH_MODE_FLOAT(_case, _type, _type_midout_id)             \
@@ -180,18 +234,23 @@ void ElemwiseImpl::AlgoBinaryVecVec::exec(const KernParam& kern_param) const {
             thin_function<void(                                                       \
                     const _type*, const _type*, _type*, DType, DType, DType, size_t)> \
                     run = OpCallerBinary<_op<_type, _type>, BcastType::VEC_VEC>::run; \
-            MEGDNN_DISPATCH_CPU_KERN(                                                 \
+            RowPartition part{kern_param.handle, nr_elems, sizeof(_type)};            \
+            auto kernel = [part, src0, src1, dst, run](size_t task_id, size_t) {      \
+                size_t offset = part.begin(task_id);                                  \
+                run(static_cast<const _type*>(src0.raw_ptr()) + offset,               \
+                    static_cast<const _type*>(src1.raw_ptr()) + offset,               \
+                    static_cast<_type*>(dst.raw_ptr()) + offset, src0.layout.dtype,   \
+                    src1.layout.dtype, dst.layout.dtype, part.end(task_id) - offset); \
+            };                                                                        \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                    \
                     static_cast<naive::HandleImpl*>(kern_param.handle),               \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                    \
-                        static_cast<const _type*>(src1.raw_ptr()),                    \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,        \
-                        src1.layout.dtype, dst.layout.dtype,                          \
-                        src0.layout.total_nr_elems()));                               \
+                    part.nr_tasks(), kernel);                                         \
         }                                                                             \
         MIDOUT_END();                                                                 \
         return
 
     auto&& dst = *(kern_param.m_dst);
+    size_t nr_elems = src0.layout.total_nr_elems();
     DISPATCH_TYPE_FALLBACK("AlgoBinaryVecVec::exec"_hash);
 
 #undef DISPATCH_BINARY
@@ -205,24 +264,29 @@ void ElemwiseImpl::AlgoBinaryVecScalar::exec(const KernParam& kern_param) const
     auto&& dst = *(kern_param.m_dst);
 
     // Case 2: vector + scalar
-#define DISPATCH_BINARY(_mode, _case, _type, _type_midout_id, _op)                   \
-    case Mode::_mode:                                                                \
-        MIDOUT_BEGIN(                                                                \
-                megdnn_fallback_elemwise_binary, midout_iv(_case),                   \
-                midout_iv(Mode::_mode), _type_midout_id) {                           \
-            thin_function<void(                                                      \
-                    const _type*, const _type, _type*, DType, DType, DType, size_t)> \
-                    run = OpCallerBinary<                                            \
-                            _op<_type, _type>, BcastType::VEC_SCALAR>::run;          \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
-                    static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr())[0],                \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype,                         \
-                        src0.layout.total_nr_elems()));                              \
-        }                                                                            \
-        MIDOUT_END();                                                                \
+#define DISPATCH_BINARY(_mode, _case, _type, _type_midout_id, _op)                    \
+    case Mode::_mode:                                                                 \
+        MIDOUT_BEGIN(                                                                 \
+                megdnn_fallback_elemwise_binary, midout_iv(_case),                    \
+                midout_iv(Mode::_mode), _type_midout_id) {                            \
+            thin_function<void(                                                       \
+                    const _type*, const _type, _type*, DType, DType, DType, size_t)>  \
+                    run = OpCallerBinary<                                             \
+                            _op<_type, _type>, BcastType::VEC_SCALAR>::run;           \
+            RowPartition part{                                                        \
+                    kern_param.handle, src0.layout.total_nr_elems(), sizeof(_type)};  \
+            auto kernel = [part, src0, src1, dst, run](size_t task_id, size_t) {      \
+                size_t offset = part.begin(task_id);                                  \
+                run(static_cast<const _type*>(src0.raw_ptr()) + offset,               \
+                    static_cast<const _type*>(src1.raw_ptr())[0],                     \
+                    static_cast<_type*>(dst.raw_ptr()) + offset, src0.layout.dtype,   \
+                    src1.layout.dtype, dst.layout.dtype, part.end(task_id) - offset); \
+            };                                                                        \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                    \
+                    static_cast<naive::HandleImpl*>(kern_param.handle),               \
+                    part.nr_tasks(), kernel);                                         \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
         return
 
     if (BcastType::VEC_SCALAR == kern_param.broad_cast_type) {
@@ -231,24 +295,29 @@ void ElemwiseImpl::AlgoBinaryVecScalar::exec(const KernParam& kern_param) const
 #undef DISPATCH_BINARY
 
     // scalar + vector
-#define DISPATCH_BINARY(_mode, _case, _type, _type_midout_id, _op)                   \
-    case Mode::_mode:                                                                \
-        MIDOUT_BEGIN(                                                                \
-                megdnn_fallback_elemwise_binary, midout_iv(_case),                   \
-                midout_iv(Mode::_mode), _type_midout_id) {                           \
-            thin_function<void(                                                      \
-                    const _type, const _type*, _type*, DType, DType, DType, size_t)> \
-                    run = OpCallerBinary<                                            \
-                            _op<_type, _type>, BcastType::SCALAR_VEC>::run;          \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
-                    static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr())[0],                \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype,                         \
-                        src1.layout.total_nr_elems()));                              \
-        }                                                                            \
-        MIDOUT_END();                                                                \
+#define DISPATCH_BINARY(_mode, _case, _type, _type_midout_id, _op)                    \
+    case Mode::_mode:                                                                 \
+        MIDOUT_BEGIN(                                                                 \
+                megdnn_fallback_elemwise_binary, midout_iv(_case),                    \
+                midout_iv(Mode::_mode), _type_midout_id) {                            \
+            thin_function<void(                                                       \
+                    const _type, const _type*, _type*, DType, DType, DType, size_t)>  \
+                    run = OpCallerBinary<                                             \
+                            _op<_type, _type>, BcastType::SCALAR_VEC>::run;           \
+            RowPartition part{                                                        \
+                    kern_param.handle, src1.layout.total_nr_elems(), sizeof(_type)};  \
+            auto kernel = [part, src0, src1, dst, run](size_t task_id, size_t) {      \
+                size_t offset = part.begin(task_id);                                  \
+                run(static_cast<const _type*>(src0.raw_ptr())[0],                     \
+                    static_cast<const _type*>(src1.raw_ptr()) + offset,               \
+                    static_cast<_type*>(dst.raw_ptr()) + offset, src0.layout.dtype,   \
+                    src1.layout.dtype, dst.layout.dtype, part.end(task_id) - offset); \
+            };                                                                        \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                    \
+                    static_cast<naive::HandleImpl*>(kern_param.handle),               \
+                    part.nr_tasks(), kernel);                                         \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
         return
 
     if (BcastType::SCALAR_VEC == kern_param.broad_cast_type) {
@@ -265,6 +334,8 @@ void ElemwiseImpl::AlgoBinaryVecBcast101::exec(const KernParam& kern_param) cons
     auto&& dst = *(kern_param.m_dst);
     BroadcastChannelInfo binfo;
 
+    //! the x * y rows of z elements are split over the threads, a part of one
+    //! batch is passed to the caller as a batch of nr_rows channels
     // Case 3: BcastType::VEC + BCAST_101
     if (BcastType::VEC_BCAST101 == kern_param.broad_cast_type &&
         is_broadcasted_channel_like(src1.layout, binfo)) {
@@ -278,13 +349,22 @@ void ElemwiseImpl::AlgoBinaryVecBcast101::exec(const KernParam& kern_param) cons
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::VEC_BCAST101>::run;        \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) + row * binfo.z,   \
+                        static_cast<const _type*>(src1.raw_ptr()) + row % binfo.y,   \
+                        static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,          \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.z);                                           \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.y, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -307,13 +387,22 @@ void ElemwiseImpl::AlgoBinaryVecBcast101::exec(const KernParam& kern_param) cons
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::BCAST101_VEC>::run;        \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) + row % binfo.y,   \
+                        static_cast<const _type*>(src1.raw_ptr()) + row * binfo.z,   \
+                        static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,          \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.z);                                           \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.y, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -331,6 +420,8 @@ void ElemwiseImpl::AlgoBinaryVecBcastX0X::exec(const KernParam& kern_param) cons
     auto&& dst = *(kern_param.m_dst);
     BroadcastChannelInfo binfo;
 
+    //! the x * y rows of z elements are split over the threads, the broadcast
+    //! row of a part is picked by its batch x
     // Case: BcastType::VEC + BCAST_X0X
     if (BcastType::VEC_BCASTX0X == kern_param.broad_cast_type &&
         is_broadcasted_3dim_like(src1.layout, binfo)) {
@@ -344,13 +435,23 @@ void ElemwiseImpl::AlgoBinaryVecBcastX0X::exec(const KernParam& kern_param) cons
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::VEC_BCASTX0X>::run;        \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) + row * binfo.z,   \
+                        static_cast<const _type*>(src1.raw_ptr()) +                  \
+                                row / binfo.y * binfo.z,                             \
+                        static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,          \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.z);                                           \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.y, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -373,13 +474,23 @@ void ElemwiseImpl::AlgoBinaryVecBcastX0X::exec(const KernParam& kern_param) cons
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::BCASTX0X_VEC>::run;        \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) +                  \
+                                row / binfo.y * binfo.z,                             \
+                        static_cast<const _type*>(src1.raw_ptr()) + row * binfo.z,   \
+                        static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,          \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.z);                                           \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.y, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -397,6 +508,8 @@ void ElemwiseImpl::AlgoBinaryVecBcast111C::exec(const KernParam& kern_param) con
     auto&& dst = *(kern_param.m_dst);
     BroadcastChannelInfo binfo;
 
+    //! every row of z elements uses the whole broadcast row, so the x * y rows
+    //! are split over the threads regardless of the batch
     // Case extra: BcastType::VEC + BCAST_111C
     if (BcastType::VEC_BCAST111C == kern_param.broad_cast_type &&
         is_NHWC_broadcasted_channel_like(src1.layout, binfo)) {
@@ -410,13 +523,20 @@ void ElemwiseImpl::AlgoBinaryVecBcast111C::exec(const KernParam& kern_param) con
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::VEC_BCAST111C>::run;       \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                size_t row = part.begin(task_id);                                    \
+                run(static_cast<const _type*>(src0.raw_ptr()) + row * binfo.z,       \
+                    static_cast<const _type*>(src1.raw_ptr()),                       \
+                    static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,              \
+                    src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,       \
+                    part.end(task_id) - row, binfo.z);                               \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -439,13 +559,20 @@ void ElemwiseImpl::AlgoBinaryVecBcast111C::exec(const KernParam& kern_param) con
                     size_t, size_t)>                                                 \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::BCAST111C_VEC>::run;       \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, binfo.x * binfo.y, binfo.z * sizeof(_type)};  \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                size_t row = part.begin(task_id);                                    \
+                run(static_cast<const _type*>(src0.raw_ptr()),                       \
+                    static_cast<const _type*>(src1.raw_ptr()) + row * binfo.z,       \
+                    static_cast<_type*>(dst.raw_ptr()) + row * binfo.z,              \
+                    src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,       \
+                    part.end(task_id) - row, binfo.z);                               \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, binfo.x, binfo.y,       \
-                        binfo.z));                                                   \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -463,6 +590,9 @@ void ElemwiseImpl::AlgoBinaryVecBcast101xX::exec(const KernParam& kern_param) co
     auto&& dst = *(kern_param.m_dst);
     BroadcastChannelInfo binfo;
 
+    //! the batch_size * x channel blocks of y * z elements are split over the
+    //! threads, a part of one batch is passed to the caller as a batch of
+    //! nr_rows channel blocks
     //  BcastType::VEC + BCAST_101X
     if (BcastType::VEC_BCAST101xX == kern_param.broad_cast_type) {
         megdnn_assert(
@@ -479,13 +609,25 @@ void ElemwiseImpl::AlgoBinaryVecBcast101xX::exec(const KernParam& kern_param) co
                     size_t, size_t, size_t)>                                         \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::VEC_BCAST101xX>::run;      \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, batch_size * binfo.x,                         \
+                    binfo.y * binfo.z * sizeof(_type)};                              \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                size_t row_size = binfo.y * binfo.z;                                 \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) + row * row_size,  \
+                        static_cast<const _type*>(src1.raw_ptr()) +                  \
+                                row % binfo.x * binfo.z,                             \
+                        static_cast<_type*>(dst.raw_ptr()) + row * row_size,         \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.y, binfo.z);                                  \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.x, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, batch_size, binfo.x,    \
-                        binfo.y, binfo.z));                                          \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
@@ -511,13 +653,25 @@ void ElemwiseImpl::AlgoBinaryVecBcast101xX::exec(const KernParam& kern_param) co
                     size_t, size_t, size_t)>                                         \
                     run = OpCallerBinary<                                            \
                             _op<_type, _type>, BcastType::BCAST101xX_VEC>::run;      \
-            MEGDNN_DISPATCH_CPU_KERN(                                                \
+            RowPartition part{                                                       \
+                    kern_param.handle, batch_size * binfo.x,                         \
+                    binfo.y * binfo.z * sizeof(_type)};                              \
+            auto kernel = [part, binfo, src0, src1, dst, run](                       \
+                                  size_t task_id, size_t) {                          \
+                size_t row_size = binfo.y * binfo.z;                                 \
+                auto cb = [&](size_t row, size_t nr_rows) {                          \
+                    run(static_cast<const _type*>(src0.raw_ptr()) +                  \
+                                row % binfo.x * binfo.z,                             \
+                        static_cast<const _type*>(src1.raw_ptr()) + row * row_size,  \
+                        static_cast<_type*>(dst.raw_ptr()) + row * row_size,         \
+                        src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, 1,   \
+                        nr_rows, binfo.y, binfo.z);                                  \
+                };                                                                   \
+                for_each_batch(part.begin(task_id), part.end(task_id), binfo.x, cb); \
+            };                                                                       \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(                                   \
                     static_cast<naive::HandleImpl*>(kern_param.handle),              \
-                    run(static_cast<const _type*>(src0.raw_ptr()),                   \
-                        static_cast<const _type*>(src1.raw_ptr()),                   \
-                        static_cast<_type*>(dst.raw_ptr()), src0.layout.dtype,       \
-                        src1.layout.dtype, dst.layout.dtype, batch_size, binfo.x,    \
-                        binfo.y, binfo.z));                                          \
+                    part.nr_tasks(), kernel);                                        \
         }                                                                            \
         MIDOUT_END();                                                                \
         return
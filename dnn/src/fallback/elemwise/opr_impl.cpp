@@ -3,6 +3,7 @@
 #include "src/common/elemwise/kern_defs.cuh"
 #include "src/common/utils.h"
 #include "src/fallback//elemwise/gi_impl/unary/algo.h"
+#include "src/fallback/elemwise/gi_impl/avx2/algo.h"
 #include "src/fallback/elemwise/gi_impl/binary/algo.h"
 #include "src/fallback/elemwise/gi_impl/ternary/algo.h"
 #include "src/naive/handle.h"
@@ -86,6 +87,11 @@ void ElemwiseImpl::exec_fallback(const TensorNDArray& srcs, _megdnn_tensor_out d
 }
 
 class ElemwiseImpl::AlgoPack {
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+    AlgoAvx2Unary algo_avx2_unary;
+    AlgoAvx2Binary algo_avx2_binary;
+    AlgoAvx2TernaryFma3 algo_avx2_ternary_fma3;
+#endif
 #if !(MEGDNN_AARCH64 || MEGDNN_ARMV7)
     AlgoUnary algo_unary;
     AlgoBinaryVecVec algo_binary_vec_vec;
@@ -108,6 +114,12 @@ class ElemwiseImpl::AlgoPack {
 
 public:
     AlgoPack() {
+        //! the 256-bit algos check cpuinfo and give way to the 128-bit ones
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+        all_algos.emplace_back(&algo_avx2_unary);
+        all_algos.emplace_back(&algo_avx2_binary);
+        all_algos.emplace_back(&algo_avx2_ternary_fma3);
+#endif
 #if !(MEGDNN_AARCH64 || MEGDNN_ARMV7)
         all_algos.emplace_back(&algo_unary);
         all_algos.emplace_back(&algo_binary_vec_vec);
@@ -45,6 +45,9 @@ private:
     class AlgoTernaryFma3VecBcast101xXVec;
     class AlgoTernaryFma3VecScalarVec;
     class AlgoTernaryFma3VecScalarScalar;
+    class AlgoAvx2Unary;
+    class AlgoAvx2Binary;
+    class AlgoAvx2TernaryFma3;
     class AlgoPack;
 
 public:
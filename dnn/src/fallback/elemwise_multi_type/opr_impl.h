@@ -1,6 +1,9 @@
 #pragma once
 
 #include "src/naive/elemwise_multi_type/opr_impl.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
 
 namespace megdnn {
 namespace fallback {
@@ -20,6 +23,68 @@ class ElemwiseMultiTypeImpl : public naive::ElemwiseMultiTypeImpl {
             const BroadcastChannelInfo& broadcast_info);
 
 protected:
+    //! minimal number of elements processed by one thread
+    static constexpr size_t MIN_ELEMS_PER_TASK = 8192;
+
+    /*!
+     * \brief split rows [0, nr_rows) of row_size elements over the threads
+     *      of the handle, and call kern(begin, end) on each part
+     *
+     * Small tensors are kept on fewer threads so every part has at least
+     * MIN_ELEMS_PER_TASK elements. \p kern is called asynchronously, so it
+     * should capture by value.
+     */
+    template <typename Kern>
+    void dispatch_rows(size_t nr_rows, size_t row_size, Kern kern) {
+        auto handle = static_cast<naive::HandleImpl*>(this->handle());
+        size_t nr_tasks = std::min(
+                {handle->megcore_dispatcher()->nr_threads(), nr_rows,
+                 nr_rows * row_size / MIN_ELEMS_PER_TASK});
+        nr_tasks = std::max<size_t>(nr_tasks, 1);
+        auto task = [nr_rows, nr_tasks, kern](size_t task_id, size_t) {
+            size_t begin = nr_rows * task_id / nr_tasks,
+                   end = nr_rows * (task_id + 1) / nr_tasks;
+            if (begin < end) {
+                kern(begin, end);
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, task);
+    }
+
+    //! call kern(offset, len) on parts of nr_elems contiguous elements
+    template <typename Kern>
+    void dispatch_elems(size_t nr_elems, Kern kern) {
+        //! split at multiples of the block so only the last part has a tail
+        //! that is not SIMD aligned
+        constexpr size_t BLOCK = 64;
+        dispatch_rows(
+                (nr_elems + BLOCK - 1) / BLOCK, BLOCK,
+                [nr_elems, kern](size_t begin, size_t end) {
+                    size_t offset = begin * BLOCK;
+                    kern(offset, std::min(end * BLOCK, nr_elems) - offset);
+                });
+    }
+
+    /*!
+     * \brief split a [x, y, z] layout with broadcast y dimension over the
+     *      threads, and call kern(row, nr_rows, y_begin) on each part
+     *
+     * A part contains nr_rows rows of z elements starting at row (an index
+     * into the x * y rows); it never crosses x, so its broadcast values are
+     * [y_begin, y_begin + nr_rows).
+     */
+    template <typename Kern>
+    void dispatch_channels(size_t x, size_t y, size_t z, Kern kern) {
+        dispatch_rows(x * y, z, [y, kern](size_t begin, size_t end) {
+            while (begin < end) {
+                size_t y_begin = begin % y,
+                       nr_rows = std::min(end - begin, y - y_begin);
+                kern(begin, nr_rows, y_begin);
+                begin += nr_rows;
+            }
+        });
+    }
+
     void on_fuse_mul_add3_int16x32x32x32(
             const ElemwiseOpParamN<3>& param, const TensorND& dst) override;
     void on_fuse_mul_add3_iXxf32xf32xi8(
@@ -58,9 +58,10 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                                 \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(0),          \
                 src_ctype, dst_ctype, midout_iv(_mode)) {                             \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                             \
-                    run(src.ptr<src_ctype>(), dst.ptr<dst_ctype>(), src.layout.dtype, \
-                        dst.layout.dtype, nr_elems));                                 \
+            dispatch_elems(nr_elems, [=](size_t offset, size_t len) {                 \
+                run(src.ptr<src_ctype>() + offset, dst.ptr<dst_ctype>() + offset,     \
+                    src.layout.dtype, dst.layout.dtype, len);                         \
+            });                                                                       \
             return;                                                                   \
         }                                                                             \
         MIDOUT_END();                                                                 \
@@ -141,10 +142,11 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                                \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(1),         \
                 src_ctype, dst_ctype, midout_iv(_mode)) {                            \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                            \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,  \
-                        dst.layout.dtype, nr_elems));                                \
+            dispatch_elems(nr_elems, [=](size_t offset, size_t len) {                \
+                run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>() + offset,  \
+                    dst.ptr<dst_ctype>() + offset, src0.layout.dtype,                \
+                    src1.layout.dtype, dst.layout.dtype, len);                       \
+            });                                                                      \
             return;                                                                  \
         }                                                                            \
         MIDOUT_END();                                                                \
@@ -170,24 +172,26 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
             if (swap_case) {
                 std::swap(lhs, rhs);
             }
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                          \
-    case _mode: {                                                                   \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                      \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                      \
-        thin_function<void(                                                         \
-                const src_ctype*, const src_ctype, dst_ctype*, DType, DType, DType, \
-                size_t)>                                                            \
-                run = OpCallerBinary<_op<src_ctype, dst_ctype>, VEC_SCALAR>::run;   \
-        MIDOUT_BEGIN(                                                               \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(2),        \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                           \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                           \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>()[0],            \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype, \
-                        dst.layout.dtype, src0.layout.total_nr_elems()));           \
-            return;                                                                 \
-        }                                                                           \
-        MIDOUT_END();                                                               \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                            \
+    case _mode: {                                                                     \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                        \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                        \
+        thin_function<void(                                                           \
+                const src_ctype*, const src_ctype, dst_ctype*, DType, DType, DType,   \
+                size_t)>                                                              \
+                run = OpCallerBinary<_op<src_ctype, dst_ctype>, VEC_SCALAR>::run;     \
+        MIDOUT_BEGIN(                                                                 \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(2),          \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                             \
+            dispatch_elems(                                                           \
+                    src0.layout.total_nr_elems(), [=](size_t offset, size_t len) {    \
+                        run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>()[0], \
+                            dst.ptr<dst_ctype>() + offset, src0.layout.dtype,         \
+                            src1.layout.dtype, dst.layout.dtype, len);                \
+                    });                                                               \
+            return;                                                                   \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
     }
 
             DISPATCH()
@@ -198,24 +202,26 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         //! SCALAR + VEC
         if (!commutable && is_vector(src1.layout) &&
             is_broadcasted_scalar(src0.layout)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                          \
-    case _mode: {                                                                   \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                      \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                      \
-        thin_function<void(                                                         \
-                const src_ctype, const src_ctype*, dst_ctype*, DType, DType, DType, \
-                size_t)>                                                            \
-                run = OpCallerBinary<_op<src_ctype, dst_ctype>, SCALAR_VEC>::run;   \
-        MIDOUT_BEGIN(                                                               \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(3),        \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                           \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                           \
-                    run(src0.ptr<src_ctype>()[0], src1.ptr<src_ctype>(),            \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype, \
-                        dst.layout.dtype, src1.layout.total_nr_elems()));           \
-            return;                                                                 \
-        }                                                                           \
-        MIDOUT_END();                                                               \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                            \
+    case _mode: {                                                                     \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                        \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                        \
+        thin_function<void(                                                           \
+                const src_ctype, const src_ctype*, dst_ctype*, DType, DType, DType,   \
+                size_t)>                                                              \
+                run = OpCallerBinary<_op<src_ctype, dst_ctype>, SCALAR_VEC>::run;     \
+        MIDOUT_BEGIN(                                                                 \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(3),          \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                             \
+            dispatch_elems(                                                           \
+                    src1.layout.total_nr_elems(), [=](size_t offset, size_t len) {    \
+                        run(src0.ptr<src_ctype>()[0], src1.ptr<src_ctype>() + offset, \
+                            dst.ptr<dst_ctype>() + offset, src0.layout.dtype,         \
+                            src1.layout.dtype, dst.layout.dtype, len);                \
+                    });                                                               \
+            return;                                                                   \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
     }
 
             DISPATCH()
@@ -241,24 +247,28 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
             auto &lhs = src0, &rhs = src1;
             if (swap_case)
                 std::swap(lhs, rhs);
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                           \
-    case _mode: {                                                                    \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                       \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                       \
-        thin_function<void(                                                          \
-                const src_ctype*, const src_ctype*, dst_ctype*, DType, DType, DType, \
-                size_t, size_t, size_t)>                                             \
-                run = OpCallerBinary<_op<src_ctype, dst_ctype>, VEC_BCAST101>::run;  \
-        MIDOUT_BEGIN(                                                                \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(4),         \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                            \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                            \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,  \
-                        dst.layout.dtype, binfo.x, binfo.y, binfo.z));               \
-            return;                                                                  \
-        }                                                                            \
-        MIDOUT_END();                                                                \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                             \
+    case _mode: {                                                                      \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
+        thin_function<void(                                                            \
+                const src_ctype*, const src_ctype*, dst_ctype*, DType, DType, DType,   \
+                size_t, size_t, size_t)>                                               \
+                run = OpCallerBinary<_op<src_ctype, dst_ctype>, VEC_BCAST101>::run;    \
+        MIDOUT_BEGIN(                                                                  \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(4),           \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                              \
+            dispatch_channels(                                                         \
+                    binfo.x, binfo.y, binfo.z,                                         \
+                    [=](size_t row, size_t nr_rows, size_t channel) {                  \
+                        run(src0.ptr<src_ctype>() + row * binfo.z,                     \
+                            src1.ptr<src_ctype>() + channel,                           \
+                            dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,   \
+                            src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.z); \
+                    });                                                                \
+            return;                                                                    \
+        }                                                                              \
+        MIDOUT_END();                                                                  \
     }
 
             DISPATCH()
@@ -269,24 +279,28 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         //! BCAST101 + VEC : only for SUB or TRUE_DIV
         if (!commutable && is_vector(src1.layout) &&
             is_broadcasted_channel_like(src0.layout, binfo)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                           \
-    case _mode: {                                                                    \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                       \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                       \
-        thin_function<void(                                                          \
-                const src_ctype*, const src_ctype*, dst_ctype*, DType, DType, DType, \
-                size_t, size_t, size_t)>                                             \
-                run = OpCallerBinary<_op<src_ctype, dst_ctype>, BCAST101_VEC>::run;  \
-        MIDOUT_BEGIN(                                                                \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(5),         \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                            \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                            \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,  \
-                        dst.layout.dtype, binfo.x, binfo.y, binfo.z));               \
-            return;                                                                  \
-        }                                                                            \
-        MIDOUT_END();                                                                \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                             \
+    case _mode: {                                                                      \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
+        thin_function<void(                                                            \
+                const src_ctype*, const src_ctype*, dst_ctype*, DType, DType, DType,   \
+                size_t, size_t, size_t)>                                               \
+                run = OpCallerBinary<_op<src_ctype, dst_ctype>, BCAST101_VEC>::run;    \
+        MIDOUT_BEGIN(                                                                  \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(5),           \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                              \
+            dispatch_channels(                                                         \
+                    binfo.x, binfo.y, binfo.z,                                         \
+                    [=](size_t row, size_t nr_rows, size_t channel) {                  \
+                        run(src0.ptr<src_ctype>() + channel,                           \
+                            src1.ptr<src_ctype>() + row * binfo.z,                     \
+                            dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,   \
+                            src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.z); \
+                    });                                                                \
+            return;                                                                    \
+        }                                                                              \
+        MIDOUT_END();                                                                  \
     }
 
             DISPATCH()
@@ -312,10 +326,16 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                                 \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(6), _src_dt, \
                 _dst_dt, midout_iv(_mode)) {                                          \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                             \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                 \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,   \
-                        dst.layout.dtype, batch_size, binfo.x, binfo.y, binfo.z));    \
+            size_t row_size = binfo.y * binfo.z;                                      \
+            dispatch_channels(                                                        \
+                    batch_size, binfo.x, row_size,                                    \
+                    [=](size_t row, size_t nr_rows, size_t block) {                   \
+                        run(src0.ptr<src_ctype>() + row * row_size,                   \
+                            src1.ptr<src_ctype>() + block * binfo.z,                  \
+                            dst.ptr<dst_ctype>() + row * row_size, src0.layout.dtype, \
+                            src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.y, \
+                            binfo.z);                                                 \
+                    });                                                               \
             return;                                                                   \
         }                                                                             \
         MIDOUT_END();                                                                 \
@@ -340,10 +360,16 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                                 \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(7),          \
                 src_ctype, dst_ctype, midout_iv(_mode)) {                             \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                             \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                 \
-                        dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,   \
-                        dst.layout.dtype, batch_size, binfo.x, binfo.y, binfo.z));    \
+            size_t row_size = binfo.y * binfo.z;                                      \
+            dispatch_channels(                                                        \
+                    batch_size, binfo.x, row_size,                                    \
+                    [=](size_t row, size_t nr_rows, size_t block) {                   \
+                        run(src0.ptr<src_ctype>() + block * binfo.z,                  \
+                            src1.ptr<src_ctype>() + row * row_size,                   \
+                            dst.ptr<dst_ctype>() + row * row_size, src0.layout.dtype, \
+                            src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.y, \
+                            binfo.z);                                                 \
+                    });                                                               \
             return;                                                                   \
         }                                                                             \
         MIDOUT_END();                                                                 \
@@ -402,11 +428,12 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                               \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(8),        \
                 src_ctype, dst_ctype, midout_iv(_mode)) {                           \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                           \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),               \
-                        src2.ptr<src_ctype>(), dst.ptr<dst_ctype>(),                \
-                        src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,    \
-                        dst.layout.dtype, nr_elems));                               \
+            dispatch_elems(nr_elems, [=](size_t offset, size_t len) {               \
+                run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>() + offset, \
+                    src2.ptr<src_ctype>() + offset, dst.ptr<dst_ctype>() + offset,  \
+                    src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,        \
+                    dst.layout.dtype, len);                                         \
+            });                                                                     \
             return;                                                                 \
         }                                                                           \
         MIDOUT_END();                                                               \
@@ -431,11 +458,14 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         MIDOUT_BEGIN(                                                                  \
                 megdnn_fallback_elemwise_multi_type_quantized, midout_iv(9),           \
                 src_ctype, dst_ctype, midout_iv(_mode)) {                              \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                              \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                  \
-                        src2.ptr<src_ctype>()[0], dst.ptr<dst_ctype>(),                \
-                        src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,       \
-                        dst.layout.dtype, src0.layout.total_nr_elems()));              \
+            dispatch_elems(                                                            \
+                    src0.layout.total_nr_elems(), [=](size_t offset, size_t len) {     \
+                        run(src0.ptr<src_ctype>() + offset,                            \
+                            src1.ptr<src_ctype>() + offset, src2.ptr<src_ctype>()[0],  \
+                            dst.ptr<dst_ctype>() + offset, src0.layout.dtype,          \
+                            src1.layout.dtype, src2.layout.dtype, dst.layout.dtype,    \
+                            len);                                                      \
+                    });                                                                \
             return;                                                                    \
         }                                                                              \
         MIDOUT_END();                                                                  \
@@ -453,26 +483,31 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
                            is_broadcasted_channel_like(src0.layout, binfo) &&
                            src0.layout.eq_shape(src2.layout);
         if (normal_case) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                           \
-    case _mode: {                                                                    \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                       \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                       \
-        thin_function<void(                                                          \
-                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,    \
-                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>         \
-                run = OpCallerTernary<                                               \
-                        _op<src_ctype, dst_ctype>, BCAST101_VEC_BCAST101>::run;      \
-        MIDOUT_BEGIN(                                                                \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(10),        \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                            \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(run(                                        \
-                    src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                    \
-                    src2.ptr<src_ctype>(), dst.ptr<dst_ctype>(), src0.layout.dtype,  \
-                    src1.layout.dtype, src2.layout.dtype, dst.layout.dtype, binfo.x, \
-                    binfo.y, binfo.z, binfo.y* binfo.z));                            \
-            return;                                                                  \
-        }                                                                            \
-        MIDOUT_END();                                                                \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                             \
+    case _mode: {                                                                      \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
+        thin_function<void(                                                            \
+                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,      \
+                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>           \
+                run = OpCallerTernary<                                                 \
+                        _op<src_ctype, dst_ctype>, BCAST101_VEC_BCAST101>::run;        \
+        MIDOUT_BEGIN(                                                                  \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(10),          \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                              \
+            dispatch_channels(                                                         \
+                    binfo.x, binfo.y, binfo.z,                                         \
+                    [=](size_t row, size_t nr_rows, size_t channel) {                  \
+                        run(src0.ptr<src_ctype>() + channel,                           \
+                            src1.ptr<src_ctype>() + row * binfo.z,                     \
+                            src2.ptr<src_ctype>() + channel,                           \
+                            dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,   \
+                            src1.layout.dtype, src2.layout.dtype, dst.layout.dtype, 1, \
+                            nr_rows, binfo.z, nr_rows * binfo.z);                      \
+                    });                                                                \
+            return;                                                                    \
+        }                                                                              \
+        MIDOUT_END();                                                                  \
     }
 
             DISPATCH()
@@ -488,26 +523,32 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
             (is_broadcastedx_channel_like<4>(src1.layout, binfo) ||
              is_broadcastedx_channel_like<8>(src1.layout, binfo)) &&
             src0.layout.eq_shape(src2.layout)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                         \
-    case _mode: {                                                                  \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                     \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                     \
-        thin_function<void(                                                        \
-                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,  \
-                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>       \
-                run = OpCallerTernary<                                             \
-                        _op<src_ctype, dst_ctype>, VEC_BCAST101xX_VEC>::run;       \
-        MIDOUT_BEGIN(                                                              \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(11),      \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                          \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                          \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),              \
-                        src2.ptr<src_ctype>(), dst.ptr<dst_ctype>(),               \
-                        src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,   \
-                        dst.layout.dtype, batch_size, binfo.x, binfo.y, binfo.z)); \
-            return;                                                                \
-        }                                                                          \
-        MIDOUT_END();                                                              \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                             \
+    case _mode: {                                                                      \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
+        thin_function<void(                                                            \
+                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,      \
+                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>           \
+                run = OpCallerTernary<                                                 \
+                        _op<src_ctype, dst_ctype>, VEC_BCAST101xX_VEC>::run;           \
+        MIDOUT_BEGIN(                                                                  \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(11),          \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                              \
+            size_t row_size = binfo.y * binfo.z;                                       \
+            dispatch_channels(                                                         \
+                    batch_size, binfo.x, row_size,                                     \
+                    [=](size_t row, size_t nr_rows, size_t block) {                    \
+                        run(src0.ptr<src_ctype>() + row * row_size,                    \
+                            src1.ptr<src_ctype>() + block * binfo.z,                   \
+                            src2.ptr<src_ctype>() + row * row_size,                    \
+                            dst.ptr<dst_ctype>() + row * row_size, src0.layout.dtype,  \
+                            src1.layout.dtype, src2.layout.dtype, dst.layout.dtype, 1, \
+                            nr_rows, binfo.y, binfo.z);                                \
+                    });                                                                \
+            return;                                                                    \
+        }                                                                              \
+        MIDOUT_END();                                                                  \
     }
 
             size_t batch_size = src0.layout.shape[0] / (binfo.x * binfo.y * binfo.z);
@@ -521,26 +562,32 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
             (is_broadcastedx_channel_like<4>(src0.layout, binfo) ||
              is_broadcastedx_channel_like<8>(src0.layout, binfo)) &&
             src0.layout.eq_shape(src2.layout)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                          \
-    case _mode: {                                                                   \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                      \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                      \
-        thin_function<void(                                                         \
-                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,   \
-                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>        \
-                run = OpCallerTernary<                                              \
-                        _op<src_ctype, dst_ctype>, BCAST101xX_VEC_BCAST101xX>::run; \
-        MIDOUT_BEGIN(                                                               \
-                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(12),       \
-                src_ctype, dst_ctype, midout_iv(_mode)) {                           \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(                                           \
-                    run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),               \
-                        src2.ptr<src_ctype>(), dst.ptr<dst_ctype>(),                \
-                        src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,    \
-                        dst.layout.dtype, batch_size, binfo.x, binfo.y, binfo.z));  \
-            return;                                                                 \
-        }                                                                           \
-        MIDOUT_END();                                                               \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op)                             \
+    case _mode: {                                                                      \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
+        thin_function<void(                                                            \
+                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,      \
+                DType, DType, DType, DType, size_t, size_t, size_t, size_t)>           \
+                run = OpCallerTernary<                                                 \
+                        _op<src_ctype, dst_ctype>, BCAST101xX_VEC_BCAST101xX>::run;    \
+        MIDOUT_BEGIN(                                                                  \
+                megdnn_fallback_elemwise_multi_type_quantized, midout_iv(12),          \
+                src_ctype, dst_ctype, midout_iv(_mode)) {                              \
+            size_t row_size = binfo.y * binfo.z;                                       \
+            dispatch_channels(                                                         \
+                    batch_size, binfo.x, row_size,                                     \
+                    [=](size_t row, size_t nr_rows, size_t block) {                    \
+                        run(src0.ptr<src_ctype>() + block * binfo.z,                   \
+                            src1.ptr<src_ctype>() + row * row_size,                    \
+                            src2.ptr<src_ctype>() + block * binfo.z,                   \
+                            dst.ptr<dst_ctype>() + row * row_size, src0.layout.dtype,  \
+                            src1.layout.dtype, src2.layout.dtype, dst.layout.dtype, 1, \
+                            nr_rows, binfo.y, binfo.z);                                \
+                    });                                                                \
+            return;                                                                    \
+        }                                                                              \
+        MIDOUT_END();                                                                  \
     }
 
             size_t batch_size = src1.layout.shape[0] / (binfo.x * binfo.y * binfo.z);
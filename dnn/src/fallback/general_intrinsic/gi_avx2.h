@@ -0,0 +1,99 @@
+#pragma once
+
+#include "gi_common.h"
+
+//! 256-bit float32 subset of general intrinsic for x86 AVX2/FMA
+//!
+//! GI_FLOAT32_t keeps 128-bit on x86, because kernels such as the NCHW44 ones
+//! assume four lanes per vector and the binary must still run on cpus without
+//! avx2. Width-agnostic kernels can instead be written on GI_AVX2_FLOAT32_t
+//! with the Gi256 api below, marked by GI_AVX2_TARGET and selected at runtime
+//! after checking cpuinfo, see megdnn::fallback::gi_avx2_supported.
+#if defined(GI_TARGET_X86) && !defined(GI_TEST_NAIVE) && !defined(GI_TEST_SSE2)
+#define GI_AVX2_DISPATCH 1
+
+#if defined(_MSC_VER)
+#define GI_AVX2_TARGET
+#define GI_AVX2_FORCEINLINE __forceinline
+#else
+#define GI_AVX2_TARGET      __attribute__((target("avx2,fma")))
+#define GI_AVX2_FORCEINLINE __attribute__((always_inline, target("avx2,fma"))) inline
+#endif
+
+//! simd length in bytes of GI_AVX2_FLOAT32_t
+#define GI_AVX2_SIMD_LEN_BYTE 32
+
+typedef __m256 GI_AVX2_FLOAT32_t;
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256LoadFloat32(const float* Buffer) {
+    return _mm256_loadu_ps(Buffer);
+}
+
+GI_AVX2_FORCEINLINE
+void Gi256StoreFloat32(float* Buffer, GI_AVX2_FLOAT32_t Vector) {
+    _mm256_storeu_ps(Buffer, Vector);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256BroadcastFloat32(float Value) {
+    return _mm256_set1_ps(Value);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256ZeroFloat32(void) {
+    return _mm256_setzero_ps();
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256AddFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_add_ps(Vector1, Vector2);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256SubtractFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_sub_ps(Vector1, Vector2);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256MultiplyFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_mul_ps(Vector1, Vector2);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256DivideFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_div_ps(Vector1, Vector2);
+}
+
+//! VectorSum + Vector1 * Vector2, fused with fma3
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256MultiplyAddFloat32(
+        GI_AVX2_FLOAT32_t VectorSum, GI_AVX2_FLOAT32_t Vector1,
+        GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_fmadd_ps(Vector1, Vector2, VectorSum);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256MaximumFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_max_ps(Vector1, Vector2);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256MinimumFloat32(
+        GI_AVX2_FLOAT32_t Vector1, GI_AVX2_FLOAT32_t Vector2) {
+    return _mm256_min_ps(Vector1, Vector2);
+}
+
+GI_AVX2_FORCEINLINE
+GI_AVX2_FLOAT32_t Gi256AbsFloat32(GI_AVX2_FLOAT32_t Vector) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), Vector);
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,114 @@
+#include "src/fallback/general_norm/opr_impl.h"
+#include <cmath>
+#include "src/common/reduce_helper.h"
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_general_norm)
+
+namespace megdnn {
+namespace fallback {
+
+void GeneralNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (!usable(data.layout)) {
+        naive::GeneralNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    float eps = param().eps;
+    bool affine = param().affine;
+    size_t A, B, C;
+    reduce::get_ABC(data.layout, A, B, C, param().axis_start, param().axis_end);
+    size_t nr_elems = data.layout.total_nr_elems();
+
+    if (C == 1) {
+        //! each a is a contiguous slice of B elements
+        size_t nr_tasks = norm::get_nr_tasks(handle(), A, nr_elems);
+        size_t slices_per_task = div_ceil(A, nr_tasks);
+        MIDOUT_BEGIN(megdnn_fallback_general_norm, midout_iv(0)) {
+            auto kern = [=](size_t task_id, size_t) {
+                const float* sptr = data.ptr<float>();
+                const float* wptr = affine ? weight.ptr<float>() : nullptr;
+                const float* bptr = affine ? bias.ptr<float>() : nullptr;
+                float* dptr = dst.ptr<float>();
+                float* mean_ptr = mean.ptr<float>();
+                float* rstd_ptr = rstd.ptr<float>();
+                size_t begin = task_id * slices_per_task;
+                size_t end = std::min(A, begin + slices_per_task);
+                for (size_t a = begin; a < end; ++a) {
+                    float slice_mean, slice_var;
+                    norm::row_mean_var(sptr + a * B, B, slice_mean, slice_var);
+                    float slice_rstd = 1.f / std::sqrt(slice_var + eps);
+                    if (affine) {
+                        norm::row_normalize_affine(
+                                sptr + a * B, wptr, bptr, dptr + a * B, B, slice_mean,
+                                slice_rstd);
+                    } else {
+                        norm::row_scale_shift(
+                                sptr + a * B, dptr + a * B, B, slice_rstd,
+                                -slice_mean * slice_rstd);
+                    }
+                    mean_ptr[a] = slice_mean;
+                    rstd_ptr[a] = slice_rstd;
+                }
+            };
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                    static_cast<naive::HandleImpl*>(handle()), nr_tasks, kern);
+        }
+        MIDOUT_END();
+        return;
+    }
+
+    //! the normalized axes are strided: split A and blocks of C channels, and
+    //! walk along B so that every load covers a contiguous run of channels
+    size_t nr_c_blocks = div_ceil(C, norm::CHANNEL_BLOCK);
+    size_t nr_units = A * nr_c_blocks;
+    size_t nr_tasks = norm::get_nr_tasks(handle(), nr_units, nr_elems);
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    MIDOUT_BEGIN(megdnn_fallback_general_norm, midout_iv(1)) {
+        auto kern = [=](size_t task_id, size_t) {
+            const float* sptr = data.ptr<float>();
+            const float* wptr = affine ? weight.ptr<float>() : nullptr;
+            const float* bptr = affine ? bias.ptr<float>() : nullptr;
+            float* dptr = dst.ptr<float>();
+            float* mean_ptr = mean.ptr<float>();
+            float* rstd_ptr = rstd.ptr<float>();
+            size_t begin = task_id * units_per_task;
+            size_t end = std::min(nr_units, begin + units_per_task);
+            for (size_t unit = begin; unit < end; ++unit) {
+                size_t a = unit / nr_c_blocks;
+                size_t c = unit % nr_c_blocks * norm::CHANNEL_BLOCK;
+                size_t width = std::min(norm::CHANNEL_BLOCK, C - c);
+                size_t offset = a * B * C + c;
+                float* slice_mean = mean_ptr + a * C + c;
+                float* slice_rstd = rstd_ptr + a * C + c;
+                norm::strided_mean_var(
+                        sptr + offset, B, C, width, slice_mean, slice_rstd);
+                for (size_t i = 0; i < width; ++i) {
+                    slice_rstd[i] = 1.f / std::sqrt(slice_rstd[i] + eps);
+                }
+                norm::strided_normalize(
+                        sptr + offset, wptr, bptr, dptr + offset, B, C, width,
+                        slice_mean, slice_rstd);
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                static_cast<naive::HandleImpl*>(handle()), nr_tasks, kern);
+    }
+    MIDOUT_END();
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,84 @@
+#include "src/fallback/group_norm/opr_impl.h"
+#include <cmath>
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_group_norm)
+
+namespace megdnn {
+namespace fallback {
+
+void GroupNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (!usable(data.layout)) {
+        naive::GroupNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    float eps = param().eps;
+    bool affine = param().affine;
+    size_t N = data.layout.shape[0];
+    size_t C = data.layout.shape[1];
+    size_t HxW = data.layout.shape[2] * data.layout.shape[3];
+    size_t G = param().group;
+    size_t D = C / G;
+    size_t inner_size = D * HxW;
+    size_t nr_tasks =
+            norm::get_nr_tasks(handle(), N * G, data.layout.total_nr_elems());
+    size_t groups_per_task = div_ceil(N * G, nr_tasks);
+
+    MIDOUT_BEGIN(megdnn_fallback_group_norm, void) {
+        auto kern = [=](size_t task_id, size_t) {
+            const float* sptr = data.ptr<float>();
+            const float* wptr = affine ? weight.ptr<float>() : nullptr;
+            const float* bptr = affine ? bias.ptr<float>() : nullptr;
+            float* dptr = dst.ptr<float>();
+            float* mean_ptr = mean.ptr<float>();
+            float* rstd_ptr = rstd.ptr<float>();
+            size_t begin = task_id * groups_per_task;
+            size_t end = std::min(N * G, begin + groups_per_task);
+            for (size_t i = begin; i < end; ++i) {
+                const float* src = sptr + i * inner_size;
+                float* out = dptr + i * inner_size;
+                float slice_mean, slice_var;
+                norm::row_mean_var(src, inner_size, slice_mean, slice_var);
+                float slice_rstd = 1.f / std::sqrt(slice_var + eps);
+                if (affine) {
+                    size_t g = i % G;
+                    for (size_t j = 0; j < D; ++j) {
+                        size_t c = g * D + j;
+                        float s = slice_rstd * wptr[c];
+                        norm::row_scale_shift(
+                                src + j * HxW, out + j * HxW, HxW, s,
+                                bptr[c] - s * slice_mean);
+                    }
+                } else {
+                    norm::row_scale_shift(
+                            src, out, inner_size, slice_rstd,
+                            -slice_mean * slice_rstd);
+                }
+                //! keep the naive convention: the rstd output holds the variance,
+                //! which is what GroupNormBackward expects
+                mean_ptr[i] = slice_mean;
+                rstd_ptr[i] = slice_var;
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                static_cast<naive::HandleImpl*>(handle()), nr_tasks, kern);
+    }
+    MIDOUT_END();
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
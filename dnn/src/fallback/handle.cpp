@@ -10,20 +10,27 @@
 #include "src/fallback/elemwise_multi_type/opr_impl.h"
 #include "src/fallback/flip/opr_impl.h"
 #include "src/fallback/gaussian_blur/opr_impl.h"
+#include "src/fallback/general_norm/opr_impl.h"
 #include "src/fallback/group_local/opr_impl.h"
+#include "src/fallback/group_norm/opr_impl.h"
+#include "src/fallback/layer_norm/opr_impl.h"
+#include "src/fallback/lstm/opr_impl.h"
 #include "src/fallback/mask_conv/opr_impl.h"
 #include "src/fallback/matrix_mul/opr_impl.h"
+#include "src/fallback/multi_head_attn/opr_impl.h"
 #include "src/fallback/pooling/opr_impl.h"
 #include "src/fallback/powc/opr_impl.h"
 #include "src/fallback/reduce/opr_impl.h"
 #include "src/fallback/relayout/opr_impl.h"
 #include "src/fallback/repeat/opr_impl.h"
 #include "src/fallback/resize/opr_impl.h"
+#include "src/fallback/rnn/opr_impl.h"
 #include "src/fallback/roi_copy/opr_impl.h"
 #include "src/fallback/rotate/opr_impl.h"
 #include "src/fallback/softmax/opr_impl.h"
 #include "src/fallback/split/opr_impl.h"
 #include "src/fallback/tile/opr_impl.h"
+#include "src/fallback/topk/opr_impl.h"
 #include "src/fallback/type_cvt/opr_impl.h"
 #include "src/fallback/warp_perspective/opr_impl.h"
 
@@ -61,6 +68,13 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(Resize)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(BatchedMatrixMulForward)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ConvBias)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(PowC)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(LayerNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(GroupNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(GeneralNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(MultiHeadAttnForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(TopK)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(LSTM)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(RNN)
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpragmas"
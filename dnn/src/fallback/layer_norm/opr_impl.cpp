@@ -0,0 +1,73 @@
+#include "src/fallback/layer_norm/opr_impl.h"
+#include <cmath>
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_layer_norm)
+
+namespace megdnn {
+namespace fallback {
+
+void LayerNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (!usable(data.layout)) {
+        naive::LayerNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    float eps = param().eps;
+    bool affine = param().affine;
+    size_t slice_length = param().normalized_size;
+    size_t n_slices = data.layout.total_nr_elems() / slice_length;
+    size_t nr_tasks =
+            norm::get_nr_tasks(handle(), n_slices, data.layout.total_nr_elems());
+    size_t slices_per_task = div_ceil(n_slices, nr_tasks);
+
+    MIDOUT_BEGIN(megdnn_fallback_layer_norm, void) {
+        auto kern = [=](size_t task_id, size_t) {
+            const float* sptr = data.ptr<float>();
+            const float* wptr = affine ? weight.ptr<float>() : nullptr;
+            const float* bptr = affine ? bias.ptr<float>() : nullptr;
+            float* dptr = dst.ptr<float>();
+            float* mean_ptr = mean.ptr<float>();
+            float* rstd_ptr = rstd.ptr<float>();
+            size_t begin = task_id * slices_per_task;
+            size_t end = std::min(n_slices, begin + slices_per_task);
+            for (size_t i = begin; i < end; ++i) {
+                const float* src = sptr + i * slice_length;
+                float* out = dptr + i * slice_length;
+                float slice_mean, slice_var;
+                norm::row_mean_var(src, slice_length, slice_mean, slice_var);
+                float slice_rstd = 1.f / std::sqrt(slice_var + eps);
+                if (affine) {
+                    norm::row_normalize_affine(
+                            src, wptr, bptr, out, slice_length, slice_mean,
+                            slice_rstd);
+                } else {
+                    norm::row_scale_shift(
+                            src, out, slice_length, slice_rstd,
+                            -slice_mean * slice_rstd);
+                }
+                mean_ptr[i] = slice_mean;
+                rstd_ptr[i] = slice_rstd;
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                static_cast<naive::HandleImpl*>(handle()), nr_tasks, kern);
+    }
+    MIDOUT_END();
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,22 @@
+#pragma once
+#include "src/naive/layer_norm/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+class LayerNormForwardImpl : public naive::LayerNormForwardImpl {
+public:
+    using naive::LayerNormForwardImpl::LayerNormForwardImpl;
+    void exec(
+            _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+            _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+            _megdnn_workspace workspace) override;
+    bool usable(const TensorLayout& data) {
+        return data.dtype.enumv() == DTypeEnum::Float32;
+    }
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
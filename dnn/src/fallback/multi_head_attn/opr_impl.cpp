@@ -0,0 +1,478 @@
+#include "src/fallback/multi_head_attn/opr_impl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "src/fallback/elemwise/gi_impl/gi_mathfun.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/naive/handle.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_mha_forward)
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+using Param = megdnn::MultiHeadAttn::Param;
+using MaskType = Param::AttnMaskType;
+using InputType = Param::TensorCombinationType;
+
+//! queries handled by one task
+constexpr size_t Q_BLOCK = 32;
+//! keys and values folded into the online softmax at a time
+constexpr size_t KV_BLOCK = 64;
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+
+//! attention shapes and the offsets of the projections in qkvo_weight_bias
+struct AttnDesc {
+    size_t batch, seq_q, seq_k, heads;
+    //! row width of q/k/v after the projections; head h reads the columns
+    //! [h * head_dim, (h + 1) * head_dim) of a projected row, and the whole
+    //! row otherwise
+    size_t q_width, k_width, v_width;
+    size_t head_dim, k_head_dim, v_head_dim;
+    size_t wq_off, wk_off, wv_off, wo_off, bq_off, bk_off, bv_off, bo_off;
+
+    AttnDesc(
+            const Param& param, const TensorLayout& queries, const TensorLayout& keys,
+            const TensorLayout& values) {
+        batch = queries[0];
+        seq_q = queries[1];
+        seq_k = keys[1];
+        heads = param.num_heads;
+        q_width = param.qproj_size ? param.qproj_size : queries[2];
+        k_width = param.kproj_size ? param.kproj_size : keys[2];
+        v_width = param.vproj_size ? param.vproj_size : values[2];
+        head_dim = param.qproj_size ? q_width / heads : q_width;
+        k_head_dim = param.kproj_size ? k_width / heads : k_width;
+        v_head_dim = param.vproj_size ? v_width / heads : v_width;
+
+        //! same order as MHAForwardProxyBase::layout_refill
+        size_t end = 0;
+        auto take = [&end](bool exist, size_t size) {
+            size_t offset = end;
+            end += exist ? size : 0;
+            return offset;
+        };
+        wq_off = take(param.qproj_size, queries[2] * param.qproj_size);
+        wk_off = take(param.kproj_size, keys[2] * param.kproj_size);
+        wv_off = take(param.vproj_size, values[2] * param.vproj_size);
+        wo_off = take(param.oproj_size, z_width() * param.oproj_size);
+        bq_off = take(param.qbias && param.qproj_size, param.qproj_size);
+        bk_off = take(param.kbias && param.kproj_size, param.kproj_size);
+        bv_off = take(param.vbias && param.vproj_size, param.vproj_size);
+        bo_off = take(param.obias && param.oproj_size, param.oproj_size);
+    }
+
+    //! width of the concatenated heads, which is the input of the out projection
+    size_t z_width() const { return heads * v_head_dim; }
+};
+
+size_t get_scratch_size(const AttnDesc& desc) {
+    return Q_BLOCK * (desc.head_dim + KV_BLOCK + desc.v_head_dim + 2);
+}
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)->megcore_dispatcher()->nr_threads();
+}
+
+float dot(const float* a, const float* b, size_t n) {
+    GI_FLOAT32_t acc0 = GiZeroFloat32(), acc1 = GiZeroFloat32();
+    size_t i = 0;
+    for (; i + 2 * SIMD_WIDTH <= n; i += 2 * SIMD_WIDTH) {
+        acc0 = GiMlaqFloat32(acc0, GiLoadFloat32(a + i), GiLoadFloat32(b + i));
+        acc1 = GiMlaqFloat32(
+                acc1, GiLoadFloat32(a + i + SIMD_WIDTH),
+                GiLoadFloat32(b + i + SIMD_WIDTH));
+    }
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        acc0 = GiMlaqFloat32(acc0, GiLoadFloat32(a + i), GiLoadFloat32(b + i));
+    }
+    float sum = GiReduceAddFloat32(GiAddFloat32(acc0, acc1));
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+//! y[i] += alpha * x[i]
+void axpy(float alpha, const float* x, float* y, size_t n) {
+    GI_FLOAT32_t valpha = GiBroadcastFloat32(alpha);
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GI_FLOAT32_t vy = GiLoadFloat32(y + i);
+        GiStoreFloat32(y + i, GiMlaqFloat32(vy, GiLoadFloat32(x + i), valpha));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+//! y[i] = x[i] * alpha, x and y may alias
+void scale(const float* x, float* y, size_t n, float alpha) {
+    GI_FLOAT32_t valpha = GiBroadcastFloat32(alpha);
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GiStoreFloat32(y + i, GiMultiplyFloat32(GiLoadFloat32(x + i), valpha));
+    }
+    for (; i < n; ++i) {
+        y[i] = x[i] * alpha;
+    }
+}
+
+//! x[i] += y[i]
+void add(float* x, const float* y, size_t n) {
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GiStoreFloat32(x + i, GiAddFloat32(GiLoadFloat32(x + i), GiLoadFloat32(y + i)));
+    }
+    for (; i < n; ++i) {
+        x[i] += y[i];
+    }
+}
+
+float max_of(const float* x, size_t n) {
+    float result = -std::numeric_limits<float>::infinity();
+    size_t i = 0;
+    if (n >= SIMD_WIDTH) {
+        GI_FLOAT32_t vmax = GiLoadFloat32(x);
+        for (i = SIMD_WIDTH; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+            vmax = GiMaximumFloat32(vmax, GiLoadFloat32(x + i));
+        }
+        result = GiReduceMaxNanFloat32(vmax);
+    }
+    for (; i < n; ++i) {
+        result = std::max(result, x[i]);
+    }
+    return result;
+}
+
+//! x[i] = exp(x[i] - max), returns the sum of the new x
+float exp_sub_sum(float* x, size_t n, float max) {
+    GI_FLOAT32_t vmax = GiBroadcastFloat32(max);
+    GI_FLOAT32_t vsum = GiZeroFloat32();
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GI_FLOAT32_t e =
+                GiExpPsFloat32(GiSubtractFloat32(GiLoadFloat32(x + i), vmax));
+        GiStoreFloat32(x + i, e);
+        vsum = GiAddFloat32(vsum, e);
+    }
+    float sum = GiReduceAddFloat32(vsum);
+    for (; i < n; ++i) {
+        x[i] = std::exp(x[i] - max);
+        sum += x[i];
+    }
+    return sum;
+}
+
+//! the rows of queries of one (batch, head) handled by a task
+struct AttnBlock {
+    const float* q;
+    const float* k;
+    const float* v;
+    //! rows of seq_k elements, nullptr if there is no mask or no weight output
+    const float* mask;
+    float* weight;
+    float* z;
+    size_t q_stride, k_stride, v_stride, z_stride;
+    size_t rows, seq_k, head_dim, v_head_dim;
+    float scaler;
+};
+
+/*!
+ * \brief softmax(q k^T * scaler + mask) v for up to Q_BLOCK rows of q
+ *
+ * Keys and values are visited by blocks of KV_BLOCK rows shared by all the
+ * queries of the task. Each query keeps the running max and sum of its
+ * exponentials, and the accumulated output is rescaled whenever the max
+ * grows, so only Q_BLOCK x KV_BLOCK scores are alive at any time.
+ */
+void attend(const AttnBlock& b, float* scratch) {
+    constexpr float neg_inf = -std::numeric_limits<float>::infinity();
+    float* q = scratch;
+    float* scores = q + Q_BLOCK * b.head_dim;
+    float* acc = scores + Q_BLOCK * KV_BLOCK;
+    float* row_max = acc + Q_BLOCK * b.v_head_dim;
+    float* row_sum = row_max + Q_BLOCK;
+    for (size_t r = 0; r < b.rows; ++r) {
+        //! fold the softmax scaler into the queries
+        scale(b.q + r * b.q_stride, q + r * b.head_dim, b.head_dim, b.scaler);
+        row_max[r] = neg_inf;
+        row_sum[r] = 0;
+    }
+    std::fill_n(acc, b.rows * b.v_head_dim, 0.f);
+
+    for (size_t kv = 0; kv < b.seq_k; kv += KV_BLOCK) {
+        size_t cols = std::min(KV_BLOCK, b.seq_k - kv);
+        for (size_t r = 0; r < b.rows; ++r) {
+            float* s = scores + r * KV_BLOCK;
+            const float* qr = q + r * b.head_dim;
+            for (size_t j = 0; j < cols; ++j) {
+                s[j] = dot(qr, b.k + (kv + j) * b.k_stride, b.head_dim);
+            }
+            if (b.mask) {
+                add(s, b.mask + r * b.seq_k + kv, cols);
+            }
+            if (b.weight) {
+                memcpy(b.weight + r * b.seq_k + kv, s, cols * sizeof(float));
+            }
+            float new_max = std::max(row_max[r], max_of(s, cols));
+            if (new_max == neg_inf) {
+                //! every key seen so far is masked out
+                continue;
+            }
+            float* out = acc + r * b.v_head_dim;
+            if (new_max != row_max[r]) {
+                float correction = std::exp(row_max[r] - new_max);
+                row_sum[r] *= correction;
+                scale(out, out, b.v_head_dim, correction);
+                row_max[r] = new_max;
+            }
+            row_sum[r] += exp_sub_sum(s, cols, new_max);
+            for (size_t j = 0; j < cols; ++j) {
+                axpy(s[j], b.v + (kv + j) * b.v_stride, out, b.v_head_dim);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < b.rows; ++r) {
+        float inv_sum = 1.f / row_sum[r];
+        scale(acc + r * b.v_head_dim, b.z + r * b.z_stride, b.v_head_dim, inv_sum);
+        if (b.weight) {
+            float* w = b.weight + r * b.seq_k;
+            exp_sub_sum(w, b.seq_k, row_max[r]);
+            scale(w, w, b.seq_k, inv_sum);
+        }
+    }
+}
+
+}  // namespace
+
+MatrixMulForward* MultiHeadAttnForwardImpl::get_matmul_opr() {
+    if (!m_matmul_opr) {
+        m_matmul_opr = handle()->create_operator<MatrixMulForward>();
+        m_matmul_opr->param().transposeA = false;
+        m_matmul_opr->param().transposeB = false;
+        m_matmul_opr->param().format = param::MatrixMul::Format::DEFAULT;
+    }
+    return m_matmul_opr.get();
+}
+
+bool MultiHeadAttnForwardImpl::usable(MHA_FORWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    auto&& p = param();
+    //! dropout and the reservespaces for backward are left to the proxy
+    if (p.training || p.add_zero_attn || p.num_heads == 0 ||
+        p.tensor_combination_type == InputType::ONLY_BIASKV ||
+        p.tensor_combination_type == InputType::ALL) {
+        return false;
+    }
+    for (auto&& layout : {queries, keys, values}) {
+        if (layout.dtype.enumv() != DTypeEnum::Float32 || layout.ndim != 3) {
+            return false;
+        }
+    }
+    if ((p.qproj_size || p.kproj_size || p.vproj_size || p.oproj_size) &&
+        qkvo_weight_bias.dtype.enumv() != DTypeEnum::Float32) {
+        return false;
+    }
+    if (p.attn_mask_type == MaskType::DEFAULT_MASK ||
+        p.attn_mask_type == MaskType::USER_DEFINED_MASK) {
+        //! the mask is broadcast to (batch * heads, seq_q, seq_k)
+        if (attn_mask.dtype.enumv() != DTypeEnum::Float32 ||
+            (attn_mask.ndim != 2 && attn_mask.ndim != 3) ||
+            attn_mask[attn_mask.ndim - 2] != queries[1] ||
+            attn_mask[attn_mask.ndim - 1] != keys[1] ||
+            (attn_mask.ndim == 3 && attn_mask[0] != 1 &&
+             attn_mask[0] != queries[0] * p.num_heads)) {
+            return false;
+        }
+    }
+    AttnDesc desc(p, queries, keys, values);
+    return (!p.qproj_size || p.qproj_size % p.num_heads == 0) &&
+           (!p.kproj_size || p.kproj_size % p.num_heads == 0) &&
+           (!p.vproj_size || p.vproj_size % p.num_heads == 0) &&
+           desc.head_dim == desc.k_head_dim;
+}
+
+WorkspaceBundle MultiHeadAttnForwardImpl::get_workspace_bundle(
+        MHA_FORWARD_LAYOUT_CONST_PARAM, void* ptr) {
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    auto&& p = param();
+    AttnDesc desc(p, queries, keys, values);
+    auto matmul = get_matmul_opr();
+    size_t matmul_workspace = 0;
+    auto add_matmul = [&](bool exist, size_t m, size_t k, size_t n) {
+        if (exist) {
+            matmul_workspace = std::max(
+                    matmul_workspace,
+                    matmul->get_workspace_in_bytes(
+                            {{m, k}, dtype::Float32()}, {{k, n}, dtype::Float32()},
+                            {{m, n}, dtype::Float32()}));
+        }
+    };
+    size_t q_rows = desc.batch * desc.seq_q, k_rows = desc.batch * desc.seq_k;
+    add_matmul(p.qproj_size, q_rows, queries[2], p.qproj_size);
+    add_matmul(p.kproj_size, k_rows, keys[2], p.kproj_size);
+    add_matmul(p.vproj_size, k_rows, values[2], p.vproj_size);
+    add_matmul(p.oproj_size, q_rows, desc.z_width(), p.oproj_size);
+    return WorkspaceBundle(
+            ptr,
+            {p.qproj_size ? q_rows * desc.q_width * sizeof(float) : 0,
+             p.kproj_size ? k_rows * desc.k_width * sizeof(float) : 0,
+             p.vproj_size ? k_rows * desc.v_width * sizeof(float) : 0,
+             p.oproj_size ? q_rows * desc.z_width() * sizeof(float) : 0,
+             matmul_workspace,
+             get_nr_threads(handle()) * get_scratch_size(desc) * sizeof(float)});
+}
+
+size_t MultiHeadAttnForwardImpl::get_workspace_in_bytes(
+        MHA_FORWARD_LAYOUT_CONST_PARAM) {
+    if (!usable(MHA_FORWARD_CALL)) {
+        return naive::MultiHeadAttnForwardImpl::get_workspace_in_bytes(
+                MHA_FORWARD_CALL);
+    }
+    return get_workspace_bundle(MHA_FORWARD_CALL).total_size_in_bytes();
+}
+
+void MultiHeadAttnForwardImpl::exec(MHA_FORWARD_EXEC_PARAM) {
+    if (!usable(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL)) {
+        naive::MultiHeadAttnForwardImpl::exec(MHA_FORWARD_CALL, workspace);
+        return;
+    }
+    check_exec(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL, workspace.size);
+
+    auto&& p = param();
+    AttnDesc desc(p, queries.layout, keys.layout, values.layout);
+    auto bundle =
+            get_workspace_bundle(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL, workspace.raw_ptr);
+    auto matmul = get_matmul_opr();
+
+    //! dst = src @ weight + bias, computed on rows of the flattened batch
+    auto project = [&](const TensorND& src, size_t rows, size_t in_width,
+                       size_t out_width, size_t weight_off, bool has_bias,
+                       size_t bias_off, const TensorND& dst) {
+        //! an empty batch or sequence has nothing to project
+        if (!rows) {
+            return;
+        }
+        RefPtr weight_ref = qkvo_weight_bias.get_ref_ptr();
+        weight_ref += weight_off * sizeof(float);
+        TensorND a{{{rows, in_width}, dtype::Float32()}, src.get_ref_ptr()};
+        TensorND b{{{in_width, out_width}, dtype::Float32()}, weight_ref};
+        TensorND c{{{rows, out_width}, dtype::Float32()}, dst.get_ref_ptr()};
+        matmul->exec(a, b, c, bundle.get_workspace(4));
+        if (!has_bias) {
+            return;
+        }
+        TensorND weight_bias = qkvo_weight_bias;
+        size_t nr_tasks = std::min(rows, get_nr_threads(handle()));
+        size_t rows_per_task = div_ceil(rows, nr_tasks);
+        auto kern = [=](size_t task_id, size_t) {
+            float* dptr = c.ptr<float>();
+            const float* bias = weight_bias.ptr<float>() + bias_off;
+            size_t end = std::min(rows, (task_id + 1) * rows_per_task);
+            for (size_t i = task_id * rows_per_task; i < end; ++i) {
+                add(dptr + i * out_width, bias, out_width);
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
+    };
+
+    size_t q_rows = desc.batch * desc.seq_q, k_rows = desc.batch * desc.seq_k;
+    TensorND q = queries, k = keys, v = values;
+    if (p.qproj_size) {
+        q = TensorND{bundle.get(0), {{q_rows, desc.q_width}, dtype::Float32()}};
+        project(queries, q_rows, queries.layout[2], desc.q_width, desc.wq_off, p.qbias,
+                desc.bq_off, q);
+    }
+    if (p.kproj_size) {
+        k = TensorND{bundle.get(1), {{k_rows, desc.k_width}, dtype::Float32()}};
+        project(keys, k_rows, keys.layout[2], desc.k_width, desc.wk_off, p.kbias,
+                desc.bk_off, k);
+    }
+    if (p.vproj_size) {
+        v = TensorND{bundle.get(2), {{k_rows, desc.v_width}, dtype::Float32()}};
+        project(values, k_rows, values.layout[2], desc.v_width, desc.wv_off, p.vbias,
+                desc.bv_off, v);
+    }
+    TensorND z = out;
+    if (p.oproj_size) {
+        z = TensorND{bundle.get(3), {{q_rows, desc.z_width()}, dtype::Float32()}};
+    }
+
+    bool has_mask = p.attn_mask_type == MaskType::DEFAULT_MASK ||
+                    p.attn_mask_type == MaskType::USER_DEFINED_MASK;
+    //! a mask of (seq_q, seq_k) or (1, seq_q, seq_k) is shared by all the heads
+    size_t mask_stride = 0;
+    if (has_mask && attn_mask.layout.ndim == 3 && attn_mask.layout[0] > 1) {
+        mask_stride = desc.seq_q * desc.seq_k;
+    }
+    bool need_weights = p.need_weights;
+    bool q_split = p.qproj_size, k_split = p.kproj_size, v_split = p.vproj_size;
+    float scaler = p.sm_scaler;
+    float* scratch = static_cast<float*>(bundle.get(5));
+    size_t scratch_size = get_scratch_size(desc);
+    size_t nr_q_blocks = div_ceil(desc.seq_q, Q_BLOCK);
+    size_t nr_tasks = desc.batch * desc.heads * nr_q_blocks;
+    MIDOUT_BEGIN(megdnn_fallback_mha_forward, void) {
+        auto kern = [=](size_t task_id, size_t thread_id) {
+            size_t bh = task_id / nr_q_blocks;
+            size_t q_begin = task_id % nr_q_blocks * Q_BLOCK;
+            size_t n = bh / desc.heads, h = bh % desc.heads;
+            AttnBlock b;
+            b.q = q.ptr<float>() + (n * desc.seq_q + q_begin) * desc.q_width +
+                  (q_split ? h * desc.head_dim : 0);
+            b.k = k.ptr<float>() + n * desc.seq_k * desc.k_width +
+                  (k_split ? h * desc.head_dim : 0);
+            b.v = v.ptr<float>() + n * desc.seq_k * desc.v_width +
+                  (v_split ? h * desc.v_head_dim : 0);
+            b.mask = has_mask ? attn_mask.ptr<float>() + bh * mask_stride +
+                                        q_begin * desc.seq_k
+                              : nullptr;
+            b.weight = need_weights ? attn_weight.ptr<float>() +
+                                              (bh * desc.seq_q + q_begin) * desc.seq_k
+                                    : nullptr;
+            b.z = z.ptr<float>() + (n * desc.seq_q + q_begin) * desc.z_width() +
+                  h * desc.v_head_dim;
+            b.q_stride = desc.q_width;
+            b.k_stride = desc.k_width;
+            b.v_stride = desc.v_width;
+            b.z_stride = desc.z_width();
+            b.rows = std::min(Q_BLOCK, desc.seq_q - q_begin);
+            b.seq_k = desc.seq_k;
+            b.head_dim = desc.head_dim;
+            b.v_head_dim = desc.v_head_dim;
+            b.scaler = scaler;
+            attend(b, scratch + thread_id * scratch_size);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
+    }
+    MIDOUT_END();
+
+    if (p.oproj_size) {
+        project(z, q_rows, desc.z_width(), p.oproj_size, desc.wo_off, p.obias,
+                desc.bo_off, out);
+    }
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,38 @@
+#pragma once
+#include <memory>
+#include "megdnn/oprs.h"
+#include "src/common/multi_head_attn/helper.h"
+#include "src/common/utils.h"
+#include "src/naive/multi_head_attn/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief fused float32 inference kernel of MultiHeadAttnForward
+ *
+ * The projections are computed by MatrixMul, then every (batch, head, block
+ * of queries) task streams over blocks of keys/values with an online softmax,
+ * so the L x S score matrix is never materialized unless need_weights is set.
+ * Other cases are forwarded to the naive proxy.
+ */
+class MultiHeadAttnForwardImpl : public naive::MultiHeadAttnForwardImpl {
+public:
+    using naive::MultiHeadAttnForwardImpl::MultiHeadAttnForwardImpl;
+
+    void exec(MHA_FORWARD_EXEC_PARAM) override;
+    size_t get_workspace_in_bytes(MHA_FORWARD_LAYOUT_CONST_PARAM) override;
+
+private:
+    bool usable(MHA_FORWARD_LAYOUT_CONST_PARAM);
+    WorkspaceBundle get_workspace_bundle(
+            MHA_FORWARD_LAYOUT_CONST_PARAM, void* ptr = nullptr);
+    MatrixMulForward* get_matmul_opr();
+
+    std::unique_ptr<MatrixMulForward> m_matmul_opr;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+namespace norm {
+
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+//! elements accumulated in float before being added to the double sums
+constexpr size_t STATS_BLOCK = 1024;
+//! channels normalized together by the strided kernels
+constexpr size_t CHANNEL_BLOCK = 64;
+//! normalizations with fewer elements are executed in one thread
+constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 16384;
+
+static inline size_t get_nr_tasks(Handle* handle, size_t nr_units, size_t nr_elems) {
+    if (nr_elems < MIN_NR_ELEMS_MULTI_THREAD) {
+        return 1;
+    }
+    size_t nr_threads =
+            static_cast<naive::HandleImpl*>(handle)->megcore_dispatcher()->nr_threads();
+    return std::max<size_t>(std::min(nr_units, nr_threads), 1);
+}
+
+/*!
+ * \brief mean and biased variance of n contiguous elements in one pass
+ *
+ * The elements are shifted by the first one to avoid the cancellation of
+ * E[x^2] - E[x]^2; each block of STATS_BLOCK elements is summed by GI in
+ * float and the block sums are accumulated in double.
+ */
+static inline void row_mean_var(const float* x, size_t n, float& mean, float& var) {
+    const float shift = x[0];
+    GI_FLOAT32_t vshift = GiBroadcastFloat32(shift);
+    double sum = 0, sum_sqr = 0;
+    for (size_t begin = 0; begin < n; begin += STATS_BLOCK) {
+        size_t end = std::min(n, begin + STATS_BLOCK);
+        GI_FLOAT32_t vsum0 = GiZeroFloat32(), vsum1 = GiZeroFloat32();
+        GI_FLOAT32_t vsqr0 = GiZeroFloat32(), vsqr1 = GiZeroFloat32();
+        size_t i = begin;
+        for (; i + 2 * SIMD_WIDTH <= end; i += 2 * SIMD_WIDTH) {
+            GI_FLOAT32_t d0 = GiSubtractFloat32(GiLoadFloat32(x + i), vshift);
+            GI_FLOAT32_t d1 =
+                    GiSubtractFloat32(GiLoadFloat32(x + i + SIMD_WIDTH), vshift);
+            vsum0 = GiAddFloat32(vsum0, d0);
+            vsum1 = GiAddFloat32(vsum1, d1);
+            vsqr0 = GiMlaqFloat32(vsqr0, d0, d0);
+            vsqr1 = GiMlaqFloat32(vsqr1, d1, d1);
+        }
+        float block_sum = GiReduceAddFloat32(GiAddFloat32(vsum0, vsum1));
+        float block_sqr = GiReduceAddFloat32(GiAddFloat32(vsqr0, vsqr1));
+        for (; i < end; ++i) {
+            float d = x[i] - shift;
+            block_sum += d;
+            block_sqr += d * d;
+        }
+        sum += block_sum;
+        sum_sqr += block_sqr;
+    }
+    double shifted_mean = sum / n;
+    mean = static_cast<float>(shift + shifted_mean);
+    var = static_cast<float>(std::max(sum_sqr / n - shifted_mean * shifted_mean, 0.0));
+}
+
+//! y[i] = x[i] * scale + shift
+static inline void row_scale_shift(
+        const float* x, float* y, size_t n, float scale, float shift) {
+    GI_FLOAT32_t vscale = GiBroadcastFloat32(scale);
+    GI_FLOAT32_t vshift = GiBroadcastFloat32(shift);
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GiStoreFloat32(y + i, GiMlaqFloat32(vshift, GiLoadFloat32(x + i), vscale));
+    }
+    for (; i < n; ++i) {
+        y[i] = x[i] * scale + shift;
+    }
+}
+
+//! y[i] = (x[i] - mean) * rstd * weight[i] + bias[i]
+static inline void row_normalize_affine(
+        const float* x, const float* weight, const float* bias, float* y, size_t n,
+        float mean, float rstd) {
+    GI_FLOAT32_t vmean = GiBroadcastFloat32(mean);
+    GI_FLOAT32_t vrstd = GiBroadcastFloat32(rstd);
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GI_FLOAT32_t norm = GiMultiplyFloat32(
+                GiSubtractFloat32(GiLoadFloat32(x + i), vmean), vrstd);
+        GI_FLOAT32_t vbias = GiLoadFloat32(bias + i);
+        GiStoreFloat32(y + i, GiMlaqFloat32(vbias, norm, GiLoadFloat32(weight + i)));
+    }
+    for (; i < n; ++i) {
+        y[i] = (x[i] - mean) * rstd * weight[i] + bias[i];
+    }
+}
+
+/*!
+ * \brief mean and biased variance over b of x[b * C + c] for c in [0, width)
+ *
+ * The rows of B are visited in order so that the loads are contiguous; the
+ * shift and the blocking are the same as row_mean_var().
+ */
+static inline void strided_mean_var(
+        const float* x, size_t B, size_t C, size_t width, float* mean, float* var) {
+    megdnn_assert(width <= CHANNEL_BLOCK);
+    float shift[CHANNEL_BLOCK], block_sum[CHANNEL_BLOCK], block_sqr[CHANNEL_BLOCK];
+    double sum[CHANNEL_BLOCK], sum_sqr[CHANNEL_BLOCK];
+    for (size_t c = 0; c < width; ++c) {
+        shift[c] = x[c];
+        sum[c] = sum_sqr[c] = 0;
+    }
+    for (size_t begin = 0; begin < B; begin += STATS_BLOCK) {
+        size_t end = std::min(B, begin + STATS_BLOCK);
+        std::fill_n(block_sum, width, 0.f);
+        std::fill_n(block_sqr, width, 0.f);
+        for (size_t b = begin; b < end; ++b) {
+            const float* row = x + b * C;
+            size_t c = 0;
+            for (; c + SIMD_WIDTH <= width; c += SIMD_WIDTH) {
+                GI_FLOAT32_t d = GiSubtractFloat32(
+                        GiLoadFloat32(row + c), GiLoadFloat32(shift + c));
+                GiStoreFloat32(
+                        block_sum + c, GiAddFloat32(GiLoadFloat32(block_sum + c), d));
+                GiStoreFloat32(
+                        block_sqr + c,
+                        GiMlaqFloat32(GiLoadFloat32(block_sqr + c), d, d));
+            }
+            for (; c < width; ++c) {
+                float d = row[c] - shift[c];
+                block_sum[c] += d;
+                block_sqr[c] += d * d;
+            }
+        }
+        for (size_t c = 0; c < width; ++c) {
+            sum[c] += block_sum[c];
+            sum_sqr[c] += block_sqr[c];
+        }
+    }
+    for (size_t c = 0; c < width; ++c) {
+        double shifted_mean = sum[c] / B;
+        mean[c] = static_cast<float>(shift[c] + shifted_mean);
+        var[c] = static_cast<float>(
+                std::max(sum_sqr[c] / B - shifted_mean * shifted_mean, 0.0));
+    }
+}
+
+/*!
+ * \brief y[b * C + c] = (x[b * C + c] - mean[c]) * rstd[c] * weight[b] + bias[b]
+ * for c in [0, width); weight and bias are ignored if they are nullptr
+ */
+static inline void strided_normalize(
+        const float* x, const float* weight, const float* bias, float* y, size_t B,
+        size_t C, size_t width, const float* mean, const float* rstd) {
+    for (size_t b = 0; b < B; ++b) {
+        const float* src = x + b * C;
+        float* dst = y + b * C;
+        float w = weight ? weight[b] : 1.f, bb = bias ? bias[b] : 0.f;
+        GI_FLOAT32_t vw = GiBroadcastFloat32(w), vb = GiBroadcastFloat32(bb);
+        size_t c = 0;
+        for (; c + SIMD_WIDTH <= width; c += SIMD_WIDTH) {
+            GI_FLOAT32_t norm = GiMultiplyFloat32(
+                    GiSubtractFloat32(GiLoadFloat32(src + c), GiLoadFloat32(mean + c)),
+                    GiLoadFloat32(rstd + c));
+            GiStoreFloat32(dst + c, GiMlaqFloat32(vb, norm, vw));
+        }
+        for (; c < width; ++c) {
+            dst[c] = (src[c] - mean[c]) * rstd[c] * w + bb;
+        }
+    }
+}
+
+}  // namespace norm
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
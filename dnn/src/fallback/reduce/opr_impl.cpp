@@ -14,53 +14,242 @@ MIDOUT_DECL(megdnn_fallback_reduce_optimized)
 namespace {
 
 using namespace megdnn;
+using Mode = param::Reduce::Mode;
+
+//! reductions with fewer elements are always executed in one thread
+constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 16384;
+//! the least number of reduced elements computed by one partial task
+constexpr size_t MIN_NR_ELEMS_PER_PART = 4096;
+
+size_t get_nr_threads(naive::HandleImpl* handle, const TensorLayout& src) {
+    if (src.total_nr_elems() < MIN_NR_ELEMS_MULTI_THREAD) {
+        return 1;
+    }
+    return handle->megcore_dispatcher()->nr_threads();
+}
+
+/*!
+ * \brief number of parts the reduced axis B is split into
+ *
+ * B is only split when the A * C outputs can not feed all the threads, each
+ * part is reduced by one task and the partial results are combined by a tree
+ */
+size_t get_nr_b_parts(size_t AC, size_t B, size_t nr_threads) {
+    if (nr_threads == 1 || AC >= nr_threads) {
+        return 1;
+    }
+    size_t nr_parts = std::min(div_ceil(nr_threads, AC), B / MIN_NR_ELEMS_PER_PART);
+    return std::max<size_t>(nr_parts, 1);
+}
+
+//! workspace used by the float32 C1 kernels to reduce B elements
+size_t get_c1_workspace_in_bytes(size_t B) {
+    // Using B = 247 as an example, you can understand why these parameters exist
+    size_t _60xT_in_4 = (60 * 3) / 4;  // T = 3
+    size_t _60xX_in_4 = 4;             // 0 < X < T, X = 1,2.
+    size_t _XXxT_in_4 = 4;
+    return (B / _60xT_in_4 + _60xX_in_4 + _XXxT_in_4) * sizeof(float);
+}
+
+/*!
+ * \brief the workspace of the reduction
+ *
+ * The first one holds the partial results when B is split, the others are the
+ * kernel workspace of each thread.
+ */
+WorkspaceBundle get_bundle(
+        void* ptr, const TensorLayout& src, Mode mode, size_t A, size_t B, size_t C,
+        size_t nr_threads) {
+    size_t nr_b_parts = get_nr_b_parts(A * C, B, nr_threads);
+    //! all the computing types are no larger than float
+    size_t partial_size = nr_b_parts > 1 ? A * C * nr_b_parts * sizeof(float) : 0;
+    size_t thread_size = 0;
+    if (src.dtype.enumv() == DTypeEnum::Float32 && C == 1 &&
+        (mode == Mode::MEAN || mode == Mode::SUM || mode == Mode::SUM_SQR)) {
+        thread_size = get_c1_workspace_in_bytes(B);
+    }
+    SmallVector<size_t> sizes{partial_size};
+    for (size_t i = 0; i < nr_threads; i++) {
+        sizes.push_back(thread_size);
+    }
+    return {ptr, sizes};
+}
+
+//! combine the partial results in place by a binary tree
+template <typename T, typename Func>
+T tree_combine(T* vals, size_t n, Func&& combine) {
+    for (size_t step = 1; step < n; step *= 2) {
+        for (size_t i = 0; i + step < n; i += 2 * step) {
+            vals[i] = combine(vals[i], vals[i + step]);
+        }
+    }
+    return vals[0];
+}
+
+template <typename T>
+T combine_partial(Mode mode, T lhs, T rhs) {
+    switch (mode) {
+        case Mode::PRODUCT:
+            return lhs * rhs;
+        case Mode::MAX:
+            return std::max(lhs, rhs);
+        case Mode::MIN:
+            return std::min(lhs, rhs);
+        default:
+            return lhs + rhs;
+    }
+}
+
+template <typename Op>
+typename Op::wtype reduce_b(
+        Op& op, size_t offset, size_t C, size_t bl, size_t br) MEGDNN_NOEXCEPT {
+    if (bl + 4096 < br) {
+        size_t mid = bl + (br - bl) / 2;
+        return op.apply(
+                reduce_b(op, offset, C, bl, mid), reduce_b(op, offset, C, mid, br));
+    }
+    typename Op::wtype res = op.INIT;
+    for (size_t b = bl; b < br; ++b) {
+        res = op.apply(res, op.read(offset + b * C));
+    }
+    return res;
+}
+
+//! reduce the outputs [begin, end) of the flattened A x C outputs
+template <typename Op>
+void reduce_exec(size_t B, size_t C, size_t begin, size_t end, Op op) MEGDNN_NOEXCEPT {
+    for (size_t ac = begin; ac < end; ++ac) {
+        size_t a = ac / C, c = ac % C;
+        op.write(ac, reduce_b(op, a * B * C + c, C, 0, B));
+    }
+}
 
 template <typename Op>
-void reduce_exec_C1(size_t A, size_t B, Op op) MEGDNN_NOEXCEPT {
+void dispatch_reduce_exec(
+        naive::HandleImpl* handle, const Op& op, size_t A, size_t B, size_t C,
+        size_t nr_threads, const WorkspaceBundle& bundle) {
     using wtype = typename Op::wtype;
-    rep(a, A) {
-        std::function<wtype(size_t, size_t)> func;
-        func = [&func, B, &op, a](size_t bl, size_t br) -> wtype {
-            if (bl + 4096 < br) {
-                size_t mid = bl + (br - bl) / 2;
-                return op.apply(func(bl, mid), func(mid, br));
-            } else {
-                wtype res = op.INIT;
-                for (size_t b = bl; b < br; ++b) {
-                    res = op.apply(res, op.read(a * B + b));
-                }
-                return res;
+    size_t nr_outputs = A * C;
+    size_t nr_b_parts = get_nr_b_parts(nr_outputs, B, nr_threads);
+    if (nr_b_parts > 1) {
+        auto kern_partial = [=](size_t task_id, size_t) {
+            Op task_op = op;
+            size_t ac = task_id / nr_b_parts, part = task_id % nr_b_parts;
+            size_t a = ac / C, c = ac % C;
+            size_t bl = B * part / nr_b_parts, br = B * (part + 1) / nr_b_parts;
+            static_cast<wtype*>(bundle.get(0))[task_id] =
+                    reduce_b(task_op, a * B * C + c, C, bl, br);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                handle, nr_outputs * nr_b_parts, kern_partial);
+        auto kern_combine = [=]() {
+            Op task_op = op;
+            auto partial = static_cast<wtype*>(bundle.get(0));
+            for (size_t ac = 0; ac < nr_outputs; ++ac) {
+                task_op.write(
+                        ac, tree_combine(partial + ac * nr_b_parts, nr_b_parts, Op::apply));
             }
         };
-        wtype res = func(0, B);
-        op.write(a, res);
+        MEGDNN_DISPATCH_CPU_KERN(handle, kern_combine());
+    } else {
+        size_t nr_tasks = std::min(nr_outputs, nr_threads);
+        auto kern = [=](size_t task_id, size_t) {
+            reduce_exec(
+                    B, C, nr_outputs * task_id / nr_tasks,
+                    nr_outputs * (task_id + 1) / nr_tasks, op);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, kern);
     }
 }
 
-template <typename Op>
-void reduce_exec(size_t A, size_t B, size_t C, Op op) MEGDNN_NOEXCEPT {
-    using wtype = typename Op::wtype;
-    rep(a, A) {
-        rep(c, C) {
-            std::function<wtype(size_t, size_t)> func;
-            func = [&func, B, C, &op, a, c](size_t bl, size_t br) -> wtype {
-                if (bl + 4096 < br) {
-                    size_t mid = bl + (br - bl) / 2;
-                    return op.apply(func(bl, mid), func(mid, br));
-                } else {
-                    wtype res = op.INIT;
-                    for (size_t b = bl; b < br; ++b) {
-                        res = op.apply(res, op.read(a * B * C + b * C + c));
-                    }
-                    return res;
-                }
+template <typename ctype>
+using DoReduceFunc = std::function<void(
+        const ctype*, ctype*, DType, size_t, size_t, size_t, _megdnn_workspace)>;
+
+/*!
+ * \brief dispatch the C1 reduction, A is split over the threads, and B is
+ * also split when A is too small
+ */
+template <typename Reducer>
+void dispatch_reduce_c1(
+        naive::HandleImpl* handle, const DoReduceFunc<typename Reducer::ctype>& do_reduce,
+        Mode mode, const TensorND& src, const TensorND& dst, size_t A, size_t B,
+        size_t nr_threads, const WorkspaceBundle& bundle) {
+    using ctype = typename Reducer::ctype;
+    using PartialReducer = typename C1PartialReducer<Reducer>::type;
+    DType src_dtype = src.layout.dtype;
+    size_t nr_b_parts =
+            C1PartialReducer<Reducer>::valid ? get_nr_b_parts(A, B, nr_threads) : 1;
+    if (nr_b_parts > 1) {
+        DoReduceFunc<ctype> do_partial = Exec<PartialReducer, true>::do_reduce;
+        auto kern_partial = [=](size_t task_id, size_t thread_id) {
+            size_t a = task_id / nr_b_parts, part = task_id % nr_b_parts;
+            size_t bl = B * part / nr_b_parts, br = B * (part + 1) / nr_b_parts;
+            do_partial(
+                    static_cast<const ctype*>(src.raw_ptr()) + a * B + bl,
+                    static_cast<ctype*>(bundle.get(0)) + task_id, src_dtype, 1,
+                    br - bl, 1, bundle.get_workspace(thread_id + 1));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, A * nr_b_parts, kern_partial);
+        auto kern_combine = [=]() {
+            auto partial = static_cast<ctype*>(bundle.get(0));
+            auto dst_ptr = static_cast<ctype*>(dst.raw_ptr());
+            auto combine = [mode](ctype lhs, ctype rhs) -> ctype {
+                return combine_partial(mode, lhs, rhs);
             };
-            wtype res = func(0, B);
-            op.write(a * C + c, res);
-        }
+            for (size_t a = 0; a < A; ++a) {
+                ctype res = tree_combine(partial + a * nr_b_parts, nr_b_parts, combine);
+                dst_ptr[a] = mode == Mode::MEAN ? static_cast<ctype>(res / B) : res;
+            }
+        };
+        MEGDNN_DISPATCH_CPU_KERN(handle, kern_combine());
+    } else {
+        size_t nr_tasks = std::min(A, nr_threads);
+        auto kern = [=](size_t task_id, size_t thread_id) {
+            size_t a_begin = A * task_id / nr_tasks,
+                   a_end = A * (task_id + 1) / nr_tasks;
+            do_reduce(
+                    static_cast<const ctype*>(src.raw_ptr()) + a_begin * B,
+                    static_cast<ctype*>(dst.raw_ptr()) + a_begin, src_dtype,
+                    a_end - a_begin, B, 1, bundle.get_workspace(thread_id + 1));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, kern);
     }
 }
 
+/*!
+ * \brief dispatch the reduction with C > 1, the A x C outputs are split into
+ * SIMD aligned channel blocks
+ */
+template <typename Reducer>
+void dispatch_reduce_c(
+        naive::HandleImpl* handle, const TensorND& src, const TensorND& dst, size_t A,
+        size_t B, size_t C, size_t nr_threads) {
+    using ctype = typename Reducer::ctype;
+    DType src_dtype = src.layout.dtype;
+    size_t simd_width = Reducer::SIMD_WIDTH;
+    size_t nr_c_blocks = 1;
+    if (A < nr_threads) {
+        nr_c_blocks = std::min(div_ceil(nr_threads, A), div_ceil(C, simd_width));
+    }
+    size_t c_block = round_up(div_ceil(C, nr_c_blocks), simd_width);
+    nr_c_blocks = div_ceil(C, c_block);
+    size_t nr_units = A * nr_c_blocks;
+    size_t nr_tasks = std::min(nr_units, nr_threads);
+    auto kern = [=](size_t task_id, size_t) {
+        auto src_ptr = static_cast<const ctype*>(src.raw_ptr());
+        auto dst_ptr = static_cast<ctype*>(dst.raw_ptr());
+        size_t unit_end = nr_units * (task_id + 1) / nr_tasks;
+        for (size_t unit = nr_units * task_id / nr_tasks; unit < unit_end; ++unit) {
+            size_t a = unit / nr_c_blocks, c_begin = unit % nr_c_blocks * c_block;
+            Exec<Reducer, false>::do_reduce_channels(
+                    src_ptr + a * B * C, dst_ptr + a * C, src_dtype, B, C, c_begin,
+                    std::min(C, c_begin + c_block));
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, kern);
+}
+
 }  // anonymous namespace
 
 namespace megdnn {
@@ -68,23 +257,14 @@ namespace fallback {
 
 size_t ReduceImpl::get_workspace_in_bytes(
         const TensorLayout& src, const TensorLayout& dst) {
-    MEGDNN_MARK_USED_VAR(src);
-    MEGDNN_MARK_USED_VAR(dst);
-
-    if (src.dtype.enumv() == DTypeEnum::Float32 &&
-        (param().mode == Mode::MEAN || param().mode == Mode::SUM ||
-         param().mode == Mode::SUM_SQR)) {
-        size_t A, B, C;
-        reduce::get_ABC(src, A, B, C, param().axis);
-        if (C == 1) {
-            // Using B = 247 as an example, you can understand why these parameters exist
-            size_t _60xT_in_4 = (60 * 3) / 4;  // T = 3
-            size_t _60xX_in_4 = 4;             // 0 < X < T, X = 1,2.
-            size_t _XXxT_in_4 = 4;
-            return ((B / _60xT_in_4 + _60xX_in_4 + _XXxT_in_4) * sizeof(float));
-        }
-    }
-    return naive::ReduceForwardImpl::get_workspace_in_bytes(src, dst);
+    size_t A, B, C;
+    reduce::get_ABC(src, A, B, C, param().axis);
+    size_t nr_threads =
+            get_nr_threads(static_cast<naive::HandleImpl*>(handle()), src);
+    auto bundle = get_bundle(nullptr, src, param().mode, A, B, C, nr_threads);
+    return std::max(
+            bundle.total_size_in_bytes(),
+            naive::ReduceForwardImpl::get_workspace_in_bytes(src, dst));
 }
 
 void ReduceImpl::exec(
@@ -102,6 +282,10 @@ void ReduceImpl::exec_fallback(
     check_exec(src.layout, dst.layout, workspace.size);
     size_t A, B, C;
     get_ABC(src.layout, A, B, C, param().axis);
+    auto handle = static_cast<naive::HandleImpl*>(this->handle());
+    size_t nr_threads = get_nr_threads(handle, src.layout);
+    auto bundle = get_bundle(
+            workspace.raw_ptr, src.layout, param().mode, A, B, C, nr_threads);
 
 #define cb_by_op(src_type, dst_type, _wtype, mode_, Op_, kern_func)                   \
     if (param().mode == mode_) {                                                      \
@@ -109,7 +293,7 @@ void ReduceImpl::exec_fallback(
         typedef DTypeTrait<dst_type>::ctype dst_ctype;                                \
         typedef DTypeTrait<_wtype>::ctype wtype;                                      \
         Op_<src_ctype, dst_ctype, wtype> op(src.get_ref_ptr(), dst.get_ref_ptr(), B); \
-        MEGDNN_DISPATCH_CPU_KERN_OPR({ kern_func; });                                 \
+        kern_func;                                                                    \
         return;                                                                       \
     }
 #define cb_by_dtype(dtype_, kern_func, type_tuple)                    \
@@ -173,16 +357,21 @@ void ReduceImpl::exec_fallback(
     }
 #endif
 
-#define cb_by_c(dtype_, C)                                                       \
-    if (C == 1) {                                                                \
-        MIDOUT_BEGIN(megdnn_fb_reduce_c, midout_iv(0)){cb_by_data_type(          \
-                dtype_, param().data_type,                                       \
-                reduce_exec_C1(A MEGDNN_COMMA B MEGDNN_COMMA op))} MIDOUT_END(); \
-    } else {                                                                     \
-        MIDOUT_BEGIN(megdnn_fb_reduce_c, midout_iv(1)){cb_by_data_type(          \
-                dtype_, param().data_type,                                       \
-                reduce_exec(A MEGDNN_COMMA B MEGDNN_COMMA C MEGDNN_COMMA         \
-                                    op))} MIDOUT_END();                          \
+#define cb_by_c(dtype_, C)                                                          \
+    if (C == 1) {                                                                   \
+        MIDOUT_BEGIN(megdnn_fb_reduce_c, midout_iv(0)){cb_by_data_type(             \
+                dtype_, param().data_type,                                          \
+                dispatch_reduce_exec(                                               \
+                        handle MEGDNN_COMMA op MEGDNN_COMMA A MEGDNN_COMMA B        \
+                                MEGDNN_COMMA 1 MEGDNN_COMMA nr_threads MEGDNN_COMMA \
+                                        bundle))} MIDOUT_END();                     \
+    } else {                                                                        \
+        MIDOUT_BEGIN(megdnn_fb_reduce_c, midout_iv(1)){cb_by_data_type(             \
+                dtype_, param().data_type,                                          \
+                dispatch_reduce_exec(                                               \
+                        handle MEGDNN_COMMA op MEGDNN_COMMA A MEGDNN_COMMA B        \
+                                MEGDNN_COMMA C MEGDNN_COMMA nr_threads MEGDNN_COMMA \
+                                        bundle))} MIDOUT_END();                     \
     }
 
 #define cb_all(dtype_) cb_by_c(dtype_, C)
@@ -203,47 +392,40 @@ bool ReduceImpl::exec_optimized(
     reduce::get_ABC(src.layout, A, B, C, param().axis);
     bool execed = false;
     using Mode = param::Reduce::Mode;
+    auto handle = static_cast<naive::HandleImpl*>(this->handle());
+    size_t nr_threads = get_nr_threads(handle, src.layout);
+    auto bundle = get_bundle(
+            workspace.raw_ptr, src.layout, param().mode, A, B, C, nr_threads);
 
-#define DISPATCH_FUNC(Reducer, dtype, ctype, comp_type)                         \
-    if (C == 1) {                                                               \
-        using _Reducer = Reducer<dtype, ctype, comp_type, true>;                \
-        using _ReducerC1SmallB = Reducer<dtype, ctype, comp_type, false>;       \
-        std::function<void(                                                     \
-                const ctype*, ctype*, DType, size_t, size_t, size_t,            \
-                _megdnn_workspace)>                                             \
-                do_reduce = Exec<_Reducer, true>::do_reduce;                    \
-        if (B == 2)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 2>::do_reduce;    \
-        if (B == 3)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 3>::do_reduce;    \
-        if (B == 4)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 4>::do_reduce;    \
-        MIDOUT_BEGIN(                                                           \
-                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,      \
-                midout_iv(0)) {                                                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_reduce(                             \
-                    reinterpret_cast<ctype*>(src.raw_ptr()),                    \
-                    reinterpret_cast<ctype*>(dst.raw_ptr()), src_type, A, B, C, \
-                    workspace));                                                \
-            execed = true;                                                      \
-        }                                                                       \
-        MIDOUT_END();                                                           \
-    } else {                                                                    \
-        using _Reducer = Reducer<dtype, ctype, comp_type, false>;               \
-        std::function<void(                                                     \
-                const ctype*, ctype*, DType, size_t, size_t, size_t,            \
-                _megdnn_workspace)>                                             \
-                do_reduce = Exec<_Reducer, false>::do_reduce;                   \
-        MIDOUT_BEGIN(                                                           \
-                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,      \
-                midout_iv(1)) {                                                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_reduce(                             \
-                    reinterpret_cast<ctype*>(src.raw_ptr()),                    \
-                    reinterpret_cast<ctype*>(dst.raw_ptr()), src_type, A, B, C, \
-                    workspace));                                                \
-            execed = true;                                                      \
-        }                                                                       \
-        MIDOUT_END();                                                           \
+#define DISPATCH_FUNC(Reducer, dtype, ctype, comp_type)                           \
+    if (C == 1) {                                                                 \
+        using _Reducer = Reducer<dtype, ctype, comp_type, true>;                  \
+        using _ReducerC1SmallB = Reducer<dtype, ctype, comp_type, false>;         \
+        DoReduceFunc<ctype> do_reduce = Exec<_Reducer, true>::do_reduce;          \
+        if (B == 2)                                                               \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 2>::do_reduce;      \
+        if (B == 3)                                                               \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 3>::do_reduce;      \
+        if (B == 4)                                                               \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 4>::do_reduce;      \
+        MIDOUT_BEGIN(                                                             \
+                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,        \
+                midout_iv(0)) {                                                   \
+            dispatch_reduce_c1<_Reducer>(                                         \
+                    handle, do_reduce, param().mode, src, dst, A, B, nr_threads,  \
+                    bundle);                                                      \
+            execed = true;                                                        \
+        }                                                                         \
+        MIDOUT_END();                                                             \
+    } else {                                                                      \
+        using _Reducer = Reducer<dtype, ctype, comp_type, false>;                 \
+        MIDOUT_BEGIN(                                                             \
+                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,        \
+                midout_iv(1)) {                                                   \
+            dispatch_reduce_c<_Reducer>(handle, src, dst, A, B, C, nr_threads);   \
+            execed = true;                                                        \
+        }                                                                         \
+        MIDOUT_END();                                                             \
     }
 
 #define DISPATCH_MODE_QUANTIZED(dtype, ctype, comp_type)         \
@@ -287,7 +469,6 @@ bool ReduceImpl::exec_optimized(
     if (src.layout.is_contiguous() &&
         src.layout.dtype.category() == DTypeCategory::QUANTIZED &&
         param().data_type == param::Reduce::DataType::DEFAULT) {
-        DType src_type = src.layout.dtype;
         if (src.layout.dtype.enumv() == DTypeEnum::QuantizedS8) {
             DISPATCH_MODE_QUANTIZED(dt_qint8, int8_t, int32_t)
         }
@@ -295,7 +476,6 @@ bool ReduceImpl::exec_optimized(
             src.layout.is_contiguous() &&
             src.layout.dtype.category() == DTypeCategory::FLOAT &&
             param().data_type == param::Reduce::DataType::DEFAULT) {
-        DType src_type = src.layout.dtype;
         if (src.layout.dtype.enumv() == DTypeEnum::Float32) {
             DISPATCH_MODE_FLOAT(dt_float32, float, float)
         }
@@ -429,26 +429,57 @@ struct Exec<Reducer, false> {
             const typename Reducer::ctype* src, typename Reducer::ctype* dst,
             DType src_dtype, size_t A, size_t B, size_t C, _megdnn_workspace) {
         for (size_t a = 0; a < A; a++) {
-            size_t c = 0;
-            for (; c + Reducer::SIMD_WIDTH <= C; c += Reducer::SIMD_WIDTH) {
-                Reducer reducer(src_dtype, B);
-                for (size_t b = 0; b < B; b++)
-                    reducer.feed(src + c + C * b);
-                reducer.post(dst);
-                dst += Reducer::SIMD_WIDTH;
-            }
-            for (; c < C; c++) {
-                Reducer reducer(src_dtype, B);
-                for (size_t b = 0; b < B; b++)
-                    reducer.feed_remain(src + c + C * b);
-                reducer.post_remain(dst);
-                dst++;
-            }
+            do_reduce_channels(src, dst, src_dtype, B, C, 0, C);
             src += B * C;
+            dst += C;
+        }
+    }
+
+    //! reduce the channels [c_begin, c_end) of one B x C block
+    static void do_reduce_channels(
+            const typename Reducer::ctype* src, typename Reducer::ctype* dst,
+            DType src_dtype, size_t B, size_t C, size_t c_begin, size_t c_end) {
+        size_t c = c_begin;
+        for (; c + Reducer::SIMD_WIDTH <= c_end; c += Reducer::SIMD_WIDTH) {
+            Reducer reducer(src_dtype, B);
+            for (size_t b = 0; b < B; b++)
+                reducer.feed(src + c + C * b);
+            reducer.post(dst + c);
+        }
+        for (; c < c_end; c++) {
+            Reducer reducer(src_dtype, B);
+            for (size_t b = 0; b < B; b++)
+                reducer.feed_remain(src + c + C * b);
+            reducer.post_remain(dst + c);
         }
     }
 };
 
+/*!
+ * \brief the reducer to compute the partial results when the reduced axis of
+ * the C1 case is split over threads
+ *
+ * Mean is computed as sum and scaled after the partial results are combined.
+ */
+template <typename Reducer>
+struct C1PartialReducer {
+    using type = Reducer;
+    static constexpr bool valid = true;
+};
+
+template <>
+struct C1PartialReducer<MeanReducer<dt_float32, float, float, true>> {
+    using type = SumReducer<dt_float32, float, float, true>;
+    static constexpr bool valid = true;
+};
+
+template <>
+struct C1PartialReducer<MeanReducer<dt_qint8, int8_t, int32_t, true>> {
+    //! the partial sum overflows int8, so the reduced axis is not split
+    using type = MeanReducer<dt_qint8, int8_t, int32_t, true>;
+    static constexpr bool valid = false;
+};
+
 // function kern_4x15xT()
 // 1. Loop the calculation with SIMD_WIDTH x 15 x T as a set of data
 // 2. T affects accuracy, i.e. SIMD_ Width x 15 x T data accumulated into SIMD_ Width
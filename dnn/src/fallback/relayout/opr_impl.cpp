@@ -1,6 +1,7 @@
 #include "src/fallback/relayout/opr_impl.h"
 #include "src/common/relayout_helper.h"
 #include "src/common/utils.h"
+#include "src/fallback/general_intrinsic/gi_int.h"
 #include "src/naive/handle.h"
 
 #include <cstring>
@@ -111,6 +112,196 @@ void transpose<dt_qint4>(
 }  // namespace relayout
 }  // namespace megdnn
 
+namespace {
+//! element types whose block transpose is implemented by GI
+struct Transpose1Byte {
+    uint8_t v;
+};
+struct Transpose2Byte {
+    uint16_t v;
+};
+struct Transpose4Byte {
+    uint32_t v;
+};
+
+#if GI_SIMD_LEN_BYTE == 16
+#define GI_ZIP_PAIR(_type, _Type, _dst, _d0, _d1, _src, _s0, _s1)    \
+    GI_##_type##_t _dst##_d0 = GiZipV0##_Type(_src##_s0, _src##_s1), \
+                   _dst##_d1 = GiZipV1##_Type(_src##_s0, _src##_s1)
+
+/*!
+ * A square of N x N elements is transposed by log2(N) rounds of zip, each
+ * round interleaves row i with row i + N / 2
+ */
+void trans_4x4_u32(
+        const Transpose4Byte* src, Transpose4Byte* dst, size_t src_stride,
+        size_t dst_stride) {
+#define ZIP(_dst, _d0, _d1, _src, _s0, _s1) \
+    GI_ZIP_PAIR(INT32, Int32, _dst, _d0, _d1, _src, _s0, _s1)
+    GI_INT32_t r0 = GiLoadInt32(src + 0 * src_stride),
+               r1 = GiLoadInt32(src + 1 * src_stride),
+               r2 = GiLoadInt32(src + 2 * src_stride),
+               r3 = GiLoadInt32(src + 3 * src_stride);
+    ZIP(s, 0, 1, r, 0, 2);
+    ZIP(s, 2, 3, r, 1, 3);
+    ZIP(t, 0, 1, s, 0, 2);
+    ZIP(t, 2, 3, s, 1, 3);
+    GiStoreInt32(dst + 0 * dst_stride, t0);
+    GiStoreInt32(dst + 1 * dst_stride, t1);
+    GiStoreInt32(dst + 2 * dst_stride, t2);
+    GiStoreInt32(dst + 3 * dst_stride, t3);
+#undef ZIP
+}
+
+void trans_8x8_u16(
+        const Transpose2Byte* src, Transpose2Byte* dst, size_t src_stride,
+        size_t dst_stride) {
+#define ZIP(_dst, _src)                                \
+    GI_ZIP_PAIR(INT16, Int16, _dst, 0, 1, _src, 0, 4); \
+    GI_ZIP_PAIR(INT16, Int16, _dst, 2, 3, _src, 1, 5); \
+    GI_ZIP_PAIR(INT16, Int16, _dst, 4, 5, _src, 2, 6); \
+    GI_ZIP_PAIR(INT16, Int16, _dst, 6, 7, _src, 3, 7)
+#define LOAD(_i) GI_INT16_t r##_i = GiLoadInt16(src + _i * src_stride)
+#define STORE(_i) GiStoreInt16(dst + _i * dst_stride, u##_i)
+    LOAD(0);
+    LOAD(1);
+    LOAD(2);
+    LOAD(3);
+    LOAD(4);
+    LOAD(5);
+    LOAD(6);
+    LOAD(7);
+    ZIP(s, r);
+    ZIP(t, s);
+    ZIP(u, t);
+    STORE(0);
+    STORE(1);
+    STORE(2);
+    STORE(3);
+    STORE(4);
+    STORE(5);
+    STORE(6);
+    STORE(7);
+#undef STORE
+#undef LOAD
+#undef ZIP
+}
+
+void trans_16x16_u8(
+        const Transpose1Byte* src, Transpose1Byte* dst, size_t src_stride,
+        size_t dst_stride) {
+#define ZIP(_dst, _src)                                 \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 0, 1, _src, 0, 8);    \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 2, 3, _src, 1, 9);    \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 4, 5, _src, 2, 10);   \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 6, 7, _src, 3, 11);   \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 8, 9, _src, 4, 12);   \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 10, 11, _src, 5, 13); \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 12, 13, _src, 6, 14); \
+    GI_ZIP_PAIR(INT8, Int8, _dst, 14, 15, _src, 7, 15)
+#define LOAD(_i) GI_INT8_t r##_i = GiLoadInt8(src + _i * src_stride)
+#define STORE(_i) GiStoreInt8(dst + _i * dst_stride, v##_i)
+    LOAD(0);
+    LOAD(1);
+    LOAD(2);
+    LOAD(3);
+    LOAD(4);
+    LOAD(5);
+    LOAD(6);
+    LOAD(7);
+    LOAD(8);
+    LOAD(9);
+    LOAD(10);
+    LOAD(11);
+    LOAD(12);
+    LOAD(13);
+    LOAD(14);
+    LOAD(15);
+    ZIP(s, r);
+    ZIP(t, s);
+    ZIP(u, t);
+    ZIP(v, u);
+    STORE(0);
+    STORE(1);
+    STORE(2);
+    STORE(3);
+    STORE(4);
+    STORE(5);
+    STORE(6);
+    STORE(7);
+    STORE(8);
+    STORE(9);
+    STORE(10);
+    STORE(11);
+    STORE(12);
+    STORE(13);
+    STORE(14);
+    STORE(15);
+#undef STORE
+#undef LOAD
+#undef ZIP
+}
+#undef GI_ZIP_PAIR
+
+/*!
+ * \brief transpose a block of h x w by the K x K GI kernel, the remaining
+ * edges are transposed element by element
+ */
+template <size_t K, typename T, typename Kern>
+void transpose_block_tiled(
+        const T* src, T* dst, size_t src_stride, size_t dst_stride, size_t h,
+        size_t w, Kern kern) {
+    using relayout::transpose_fallback::transpose_block_fallback;
+    size_t i = 0;
+    for (; i + K <= h; i += K) {
+        size_t j = 0;
+        for (; j + K <= w; j += K) {
+            kern(src + i * src_stride + j, dst + j * dst_stride + i, src_stride,
+                 dst_stride);
+        }
+        if (j < w) {
+            transpose_block_fallback(
+                    src + i * src_stride + j, dst + j * dst_stride + i, src_stride,
+                    dst_stride, K, w - j);
+        }
+    }
+    if (i < h) {
+        transpose_block_fallback(
+                src + i * src_stride, dst + i, src_stride, dst_stride, h - i, w);
+    }
+}
+#endif
+}  // anonymous namespace
+
+#if GI_SIMD_LEN_BYTE == 16
+namespace megdnn {
+namespace relayout {
+namespace transpose_fallback {
+#define cb(_T, _K, _kern)                                                         \
+    template <>                                                                   \
+    void transpose_block<_T>(                                                     \
+            const _T* src, _T* dst, const size_t src_stride,                      \
+            const size_t dst_stride, size_t block_h, size_t block_w) {            \
+        transpose_block_tiled<_K>(                                                \
+                src, dst, src_stride, dst_stride, block_h, block_w, _kern);       \
+    }                                                                             \
+    template <>                                                                   \
+    void transpose_block<_T>(                                                     \
+            const _T* src, _T* dst, const size_t src_stride,                      \
+            const size_t dst_stride) {                                            \
+        constexpr size_t block_size = transpose_traits<_T>::block_size;           \
+        transpose_block_tiled<_K>(                                                \
+                src, dst, src_stride, dst_stride, block_size, block_size, _kern); \
+    }
+cb(Transpose1Byte, 16, trans_16x16_u8)
+cb(Transpose2Byte, 8, trans_8x8_u16)
+cb(Transpose4Byte, 4, trans_4x4_u32)
+#undef cb
+}  // namespace transpose_fallback
+}  // namespace relayout
+}  // namespace megdnn
+#endif
+
 namespace {
 
 bool is_lastdim_contig(const TensorLayout& layout) {
@@ -248,6 +439,25 @@ void memcpy_noncont2cont_4bit(
     memcpy_4bit(cont, non_cont, cont_offset, nocont_offset, size);
 }
 
+//! relayouts smaller than this are not split over the threads
+constexpr size_t MIN_NR_BYTES_PER_TASK = 64 * 1024;
+
+size_t get_nr_tasks(Handle* handle, size_t nr_bytes, size_t max_nr_tasks) {
+    size_t nr_threads =
+            static_cast<naive::HandleImpl*>(handle)->megcore_dispatcher()->nr_threads();
+    size_t nr_tasks = std::min(nr_threads, nr_bytes / MIN_NR_BYTES_PER_TASK);
+    return std::max<size_t>(std::min(nr_tasks, max_nr_tasks), 1);
+}
+
+/*!
+ * \brief transpose the rows [row_begin, row_end) of one batch
+ *
+ * src and dst point to the batch; stride_m is 0 if src is contiguous
+ */
+typedef void (*transpose_rows_t)(
+        size_t m, size_t n, size_t ch, void* src, void* dst, size_t stride_m,
+        size_t row_begin, size_t row_end);
+
 template <typename T>
 void call_transpose(
         size_t batch, size_t m, size_t n, size_t ch, void* src, void* dst,
@@ -257,54 +467,59 @@ void call_transpose(
             batch, m, n, static_cast<T*>(src), static_cast<T*>(dst), stride_m);
 }
 
+template <typename T>
+void call_transpose_rows(
+        size_t m, size_t n, size_t ch, void* src, void* dst, size_t stride_m,
+        size_t row_begin, size_t row_end) {
+    megdnn_assert(ch == 1);
+    relayout::transpose_fallback::transpose_rows<T>(
+            m, n, static_cast<T*>(src), static_cast<T*>(dst), stride_m ? stride_m : n,
+            row_begin, row_end);
+}
+
 //! one operand contiguous, and the other non-contiguous
 template <int bits>
 void dispatch_on_dtype_cont(
         Handle* handle, const TensorND& cont, const TensorND& nonc,
         memcpy_policy_t mcp_pol) {
-    thin_function<void()> kern;
+    //! nonc is viewed as (shp0, shp1) rows of contiguous row_bytes
+    size_t shp0, shp1, strd0_n, strd1_n, row_bytes;
     switch (nonc.layout.ndim) {
         case 2: {
-            auto shp0 = nonc.layout.shape[0], shp1 = nonc.layout.shape[1];
-            auto strd0_n = nonc.layout.stride[0] * bits / 8;
-            auto strd0_c = shp1 * bits / 8;
-            kern = [=]() {
-                auto cur_ctptr = static_cast<uint8_t*>(cont.raw_ptr());
-                auto cur_ncptr = static_cast<uint8_t*>(nonc.raw_ptr());
-                for (size_t i = 0; i < shp0; ++i) {
-                    mcp_pol(cur_ctptr, cur_ncptr, 0, 0, strd0_c);
-                    cur_ctptr += strd0_c;
-                    cur_ncptr += strd0_n;
-                }
-            };
+            shp0 = nonc.layout.shape[0];
+            shp1 = 1;
+            strd0_n = nonc.layout.stride[0] * bits / 8;
+            strd1_n = 0;
+            row_bytes = nonc.layout.shape[1] * bits / 8;
             break;
         }
         case 3: {
-            auto shp0 = nonc.layout.shape[0], shp1 = nonc.layout.shape[1],
-                 shp2 = nonc.layout.shape[2];
-            auto strd0_n = nonc.layout.stride[0] * bits / 8,
-                 strd1_n = nonc.layout.stride[1] * bits / 8;
-            auto strd1_c = shp2 * bits / 8;
-            kern = [=]() {
-                auto cur_ctptr = static_cast<uint8_t*>(cont.raw_ptr());
-                auto ncptr_row = static_cast<uint8_t*>(nonc.raw_ptr());
-                for (size_t i = 0; i < shp0; ++i) {
-                    auto cur_ncptr = ncptr_row;
-                    for (size_t j = 0; j < shp1; ++j) {
-                        mcp_pol(cur_ctptr, cur_ncptr, 0, 0, strd1_c);
-                        cur_ctptr += strd1_c;
-                        cur_ncptr += strd1_n;
-                    }
-                    ncptr_row += strd0_n;
-                }
-            };
+            shp0 = nonc.layout.shape[0];
+            shp1 = nonc.layout.shape[1];
+            strd0_n = nonc.layout.stride[0] * bits / 8;
+            strd1_n = nonc.layout.stride[1] * bits / 8;
+            row_bytes = nonc.layout.shape[2] * bits / 8;
             break;
         }
         default:
             megdnn_assert(0);
     }
 
-    static_cast<naive::HandleImpl*>(handle)->dispatch_kern(std::move(kern));
+    size_t nr_rows = shp0 * shp1;
+    size_t nr_tasks = get_nr_tasks(handle, nr_rows * row_bytes, nr_rows);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t row = nr_rows * task_id / nr_tasks,
+               row_end = nr_rows * (task_id + 1) / nr_tasks;
+        auto cur_ctptr = static_cast<uint8_t*>(cont.raw_ptr()) + row * row_bytes;
+        auto ncptr = static_cast<uint8_t*>(nonc.raw_ptr());
+        for (; row < row_end; ++row) {
+            size_t i = row / shp1, j = row % shp1;
+            mcp_pol(cur_ctptr, ncptr + i * strd0_n + j * strd1_n, 0, 0, row_bytes);
+            cur_ctptr += row_bytes;
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle), nr_tasks, kern);
 }
 
 template <>
@@ -438,24 +653,76 @@ void transpose_cv_row(
 }
 
 template <typename ctype>
-void transpose_cv(
-        size_t batch, size_t m, size_t n, size_t ch, void* src, void* dst,
-        size_t stride_m) {
+void transpose_cv_rows(
+        size_t m, size_t n, size_t ch, void* src, void* dst, size_t stride_m,
+        size_t row_begin, size_t row_end) {
     megdnn_assert(stride_m == 0);
     constexpr size_t B = BLOCK_SIZE;
-    auto batch_src = static_cast<ctype*>(src);
-    auto batch_dst = static_cast<ctype*>(dst);
-    for (size_t b = 0; b < batch; ++b) {
-        size_t i = 0;
-        for (; i + B <= m; i += B) {
-            transpose_cv_row<ctype>(m, n, ch, i, B, batch_src, batch_dst);
+    size_t i = row_begin;
+    for (; i + B <= row_end; i += B) {
+        transpose_cv_row<ctype>(m, n, ch, i, B, src, dst);
+    }
+    if (i < row_end) {
+        transpose_cv_row<ctype>(m, n, ch, i, row_end - i, src, dst);
+    }
+}
+
+/*!
+ * \brief get the kernel to transpose rows of \p t, t.c is reset to 1 if the
+ * channels are merged into the element type
+ *
+ * \return nullptr if the dtype size is not supported
+ */
+transpose_rows_t get_transpose_rows_kern(
+        const TensorND& src, const TensorND& dst, relayout::TransposeParam& t,
+        bool is_bit4) {
+    auto src_addr = reinterpret_cast<uintptr_t>(src.raw_ptr()),
+         dst_addr = reinterpret_cast<uintptr_t>(dst.raw_ptr());
+    size_t dsize = is_bit4 ? t.c >> 1 : src.layout.dtype.size() * t.c;
+    transpose_rows_t kptr = nullptr;
+    if (dsize == 1) {
+        megdnn_assert(t.c == 1);
+        kptr = call_transpose_rows<Transpose1Byte>;
+    } else if (dsize == 2) {
+        t.c = 1;
+        if (!((src_addr | dst_addr) & (alignof(uint16_t) - 1))) {
+            kptr = call_transpose_rows<Transpose2Byte>;
+        } else {
+            kptr = call_transpose_rows<equiv_ctype_storage<2>>;
+            megdnn_log_error("unaligned addr in relayout");
         }
-        if (i < m) {
-            transpose_cv_row<ctype>(m, n, ch, i, m - i, batch_src, batch_dst);
+    } else if (dsize == 3) {
+        t.c = 1;
+        kptr = call_transpose_rows<equiv_ctype_storage<3>>;
+    } else if (dsize == 4) {
+        t.c = 1;
+        if (!((src_addr | dst_addr) & (alignof(uint32_t) - 1))) {
+            kptr = call_transpose_rows<Transpose4Byte>;
+        } else {
+            kptr = call_transpose_rows<equiv_ctype_storage<4>>;
+            megdnn_log_error("unaligned addr in relayout");
+        }
+    } else if (dsize == 12) {
+        t.c = 1;
+        if (!((src_addr | dst_addr) & (alignof(uint32_t) - 1))) {
+            kptr = call_transpose_rows<equiv_ctype_storage<3, uint32_t>>;
+        } else {
+            kptr = call_transpose_rows<equiv_ctype_storage<12>>;
+            megdnn_log_error("unaligned addr in relayout");
         }
-        batch_src += m * n * ch;
-        batch_dst += m * n * ch;
+    } else if (dsize <= TRANSPOSE_CV_MAX_C) {
+        switch (dst.layout.dtype.enumv()) {
+#define cb(_dt)                                                  \
+    case DTypeTrait<dtype::_dt>::enumv:                          \
+        kptr = transpose_cv_rows<equiv_ctype<dtype::_dt>::type>; \
+        break;
+            MEGDNN_FOREACH_DTYPE_NAME(cb)
+            MEGDNN_FOREACH_PARAMETERIZED_DTYPE(cb)
+#undef cb
+        }
+        megdnn_assert(kptr);
     }
+    return kptr;
 }
 
 }  // anonymous namespace
@@ -497,82 +764,65 @@ void RelayoutForwardImpl::exec_after_preprocess(
         const TensorND& src, const TensorND& dst, relayout::TransposeParam* transpose) {
     if (transpose) {
         bool is_bit4 = is_int4(src.layout);
-        auto kernel = [tparam = *transpose, src, dst, is_bit4]() {
-            auto t = tparam;
-            void (*kptr)(size_t, size_t, size_t, size_t, void*, void*, size_t) =
-                    nullptr;
-            auto src_addr = reinterpret_cast<uintptr_t>(src.raw_ptr()),
-                 dst_addr = reinterpret_cast<uintptr_t>(dst.raw_ptr());
-            size_t dsize = 0;
-            if (is_bit4) {
-                dsize = t.c >> 1;
-            } else {
-                dsize = src.layout.dtype.size() * t.c;
-            }
-            if (is_bit4 && dsize == 0) {
-                kptr = call_transpose<dt_qint4>;
-            } else {
-                if (dsize == 1) {
-                    megdnn_assert(t.c == 1);
-                    kptr = call_transpose<uint8_t>;
-                } else if (dsize == 2) {
-                    t.c = 1;
-                    if (!((src_addr | dst_addr) & (alignof(uint16_t) - 1))) {
-                        kptr = call_transpose<uint16_t>;
-                    } else {
-                        kptr = call_transpose<equiv_ctype_storage<2>>;
-                        megdnn_log_error("unaligned addr in relayout");
-                    }
-                } else if (dsize == 3) {
-                    t.c = 1;
-                    kptr = call_transpose<equiv_ctype_storage<3>>;
-                } else if (dsize == 4) {
-                    t.c = 1;
-                    if (!((src_addr | dst_addr) & (alignof(uint32_t) - 1))) {
-                        kptr = call_transpose<uint32_t>;
-                    } else {
-                        kptr = call_transpose<equiv_ctype_storage<4>>;
-                        megdnn_log_error("unaligned addr in relayout");
-                    }
-                } else if (dsize == 12) {
-                    t.c = 1;
-                    if (!((src_addr | dst_addr) & (alignof(uint32_t) - 1))) {
-                        kptr = call_transpose<equiv_ctype_storage<3, uint32_t>>;
-                    } else {
-                        kptr = call_transpose<equiv_ctype_storage<12>>;
-                        megdnn_log_error("unaligned addr in relayout");
-                    }
-                } else if (dsize <= TRANSPOSE_CV_MAX_C) {
-                    switch (dst.layout.dtype.enumv()) {
-#define cb(_dt)                                             \
-    case DTypeTrait<dtype::_dt>::enumv:                     \
-        kptr = transpose_cv<equiv_ctype<dtype::_dt>::type>; \
-        break;
-                        MEGDNN_FOREACH_DTYPE_NAME(cb)
-                        MEGDNN_FOREACH_PARAMETERIZED_DTYPE(cb)
-#undef cb
-                    }
-                    megdnn_assert(kptr);
-                }
-            }
-
-            if (kptr) {
-                auto sptr = src.raw_ptr();
-                auto dptr = dst.raw_ptr();
-                kptr(t.batch, t.m, t.n, t.c, sptr, dptr, t.stride_m);
-                return;
-            } else {
-                megdnn_assert(t.c != 1, "unsupported dtype size");
+        auto t = *transpose;
+        if (is_bit4 && t.c == 1) {
+            MEGDNN_DISPATCH_CPU_KERN_OPR(call_transpose<dt_qint4>(
+                    t.batch, t.m, t.n, t.c, src.raw_ptr(), dst.raw_ptr(), t.stride_m));
+            return;
+        }
+        size_t dsize = is_bit4 ? t.c >> 1 : src.layout.dtype.size() * t.c;
+        if (dsize != 12 && dsize > TRANSPOSE_CV_MAX_C) {
+            //! no transpose kernel for such large elements, see
+            //! get_transpose_rows_kern()
+            NaiveRelayoutForwardImpl::do_exec(src, dst);
+            return;
+        }
+        size_t src_batch_bytes = t.m * (t.stride_m ? t.stride_m : t.n) * dsize,
+               dst_batch_bytes = t.m * t.n * dsize;
+        //! the rows of all batches are split over the threads, aligned to
+        //! the block of the transpose kernels
+        constexpr size_t ROW_ALIGN = 16;
+        size_t nr_rows = t.batch * t.m;
+        size_t nr_tasks = get_nr_tasks(
+                handle(), nr_rows * t.n * dsize, div_ceil(nr_rows, ROW_ALIGN));
+        auto tparam = t;
+        transpose_rows_t kptr = get_transpose_rows_kern(src, dst, tparam, is_bit4);
+        megdnn_assert(kptr, "unsupported dtype size");
+        auto kern = [=](size_t task_id, size_t) {
+            auto sptr = static_cast<uint8_t*>(src.raw_ptr());
+            auto dptr = static_cast<uint8_t*>(dst.raw_ptr());
+            auto row_bound = [=](size_t id) {
+                return std::min(nr_rows, round_up(nr_rows * id / nr_tasks, ROW_ALIGN));
+            };
+            size_t row = row_bound(task_id), row_end = row_bound(task_id + 1);
+            while (row < row_end) {
+                size_t b = row / tparam.m, i = row % tparam.m;
+                size_t i_end = std::min(tparam.m, i + row_end - row);
+                kptr(tparam.m, tparam.n, tparam.c, sptr + b * src_batch_bytes,
+                     dptr + b * dst_batch_bytes, tparam.stride_m, i, i_end);
+                row += i_end - i;
             }
         };
-        MEGDNN_DISPATCH_CPU_KERN_OPR(kernel());
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
+        return;
     }
 
     using relayout::is_contig;
 
     if (is_contig(dst.layout) && is_contig(src.layout)) {
+        //! chunks are aligned to the cache line
+        constexpr size_t CHUNK_ALIGN = 64;
         auto sz = src.layout.span().dist_byte();
-        MEGDNN_DISPATCH_CPU_KERN_OPR(memcpy(dst.raw_ptr(), src.raw_ptr(), sz));
+        size_t nr_tasks = get_nr_tasks(handle(), sz, div_ceil(sz, CHUNK_ALIGN));
+        auto kern = [=](size_t task_id, size_t) {
+            auto bound = [=](size_t id) {
+                return std::min(sz, round_up(sz * id / nr_tasks, CHUNK_ALIGN));
+            };
+            size_t begin = bound(task_id), end = bound(task_id + 1);
+            memcpy(static_cast<uint8_t*>(dst.raw_ptr()) + begin,
+                   static_cast<uint8_t*>(src.raw_ptr()) + begin, end - begin);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
         return;
     }
     memcpy_policy_t cpy_noncont2cont = memcpy_noncont2cont;
@@ -1,65 +1,115 @@
 #include "src/fallback/repeat/opr_impl.h"
 
 #include <cstring>
-#include <numeric>
 #include "src/common/tile_repeat_helper.h"
 #include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
 #include "src/naive/handle.h"
 
-namespace megdnn {
-namespace fallback {
+namespace {
+
+template <typename T>
+void repeat_elems(const T* src, T* dst, size_t nr_elems, size_t times) {
+    for (size_t i = 0; i < nr_elems; ++i) {
+        T val = src[i];
+        for (size_t j = 0; j < times; ++j) {
+            dst[i * times + j] = val;
+        }
+    }
+}
 
-size_t RepeatImpl::get_workspace_in_bytes(
-        const TensorLayout& src, const TensorLayout& dst) {
-    auto workspace_size = get_workspace_in_bytes_fwd(src, dst);
-    return workspace_size;
+//! write every one of \p nr_elems source elements \p times times
+void repeat_block(
+        const uint8_t* src, uint8_t* dst, size_t nr_elems, size_t elem_bytes,
+        size_t times, bool non_temporal) {
+    using namespace megdnn::fallback;
+    if (times == 1) {
+        copy::copy_bytes(dst, src, nr_elems * elem_bytes, non_temporal);
+        return;
+    }
+    switch (elem_bytes) {
+#define cb(_bytes, _ctype)                                                    \
+    case _bytes:                                                              \
+        repeat_elems(                                                         \
+                reinterpret_cast<const _ctype*>(src),                         \
+                reinterpret_cast<_ctype*>(dst), nr_elems, times);             \
+        return;
+        cb(1, uint8_t) cb(2, uint16_t) cb(4, uint32_t) cb(8, uint64_t)
+#undef cb
+        default:
+            for (size_t i = 0; i < nr_elems; ++i) {
+                for (size_t j = 0; j < times; ++j) {
+                    std::memcpy(
+                            dst + (i * times + j) * elem_bytes, src + i * elem_bytes,
+                            elem_bytes);
+                }
+            }
+    }
 }
 
+}  // anonymous namespace
+
+namespace megdnn {
+namespace fallback {
+
 void RepeatImpl::exec(
         _megdnn_tensor_in src_, _megdnn_tensor_out dst_, _megdnn_workspace workspace) {
     check_exec(src_.layout, dst_.layout, workspace.size);
+    if (dst_.layout.is_empty()) {
+        return;
+    }
+    if (src_.layout.dtype.is_low_bit()) {
+        naive::RepeatForwardImpl::exec(src_, dst_, workspace);
+        return;
+    }
     TensorShape src, dst, times;
     simplify_shape(src_.layout, dst_.layout, param().times, src, dst, times);
-    auto nr_reduces = count_not_ones_in_shape(times);
-    if (nr_reduces == 0) {
-        MEGDNN_DISPATCH_CPU_KERN_OPR(std::memcpy(
-                dst_.raw_ptr(), src_.raw_ptr(), sizeof(float) * dst.total_nr_elems()));
+    if (count_not_ones_in_shape(times) == 0) {
+        copy::dispatch_segments_copy(handle(), dst_, {src_}, 1, true);
         return;
     }
 
-    auto kern = [=]() {
-        auto ndim = times.ndim;
-        WorkspaceBundle workspaces(
-                workspace.raw_ptr, {dst.total_nr_elems() * sizeof(float),
-                                    dst.total_nr_elems() * sizeof(float)});
-        auto workspace0 = static_cast<float*>(workspaces.get(0));
-        auto workspace1 = static_cast<float*>(workspaces.get(1));
-
-        float *current, *next;
-        size_t state;
-
-        init_tile_repeat_state(
-                src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0, workspace1,
-                current, next, state, nr_reduces);
-
-        for (size_t i = ndim; i > 0; --i) {
-            size_t j = i - 1;
-            if (times.shape[j] != 1) {
-                // m = sshape[0]*...*sshape[i-1]
-                auto m = std::accumulate(
-                        src.shape, src.shape + i, 1_z, SafeMultiplies<size_t>());
-                // n = dshape[i]*...
-                auto n = std::accumulate(
-                        dst.shape + i, dst.shape + ndim, 1_z, SafeMultiplies<size_t>());
-                // forward is repeat (m, n) to (m*times, n)
-                tile_or_repeat_single_axis(current, next, m, n, times[j]);
-                update_tile_repeat_state(
-                        src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0,
-                        workspace1, current, next, state, nr_reduces);
+    //! every element of a source row along the last axis is repeated
+    //! times[last] times to form a destination row, and the source rows are
+    //! split into blocks which expand to about CHUNK_BYTES
+    size_t elem_bytes = src_.layout.dtype.size();
+    size_t last = dst.ndim - 1;
+    size_t row_elems = src.shape[last];
+    size_t row_times = times.shape[last];
+    size_t dst_row_bytes = dst.shape[last] * elem_bytes;
+    size_t block_elems =
+            std::max<size_t>(copy::CHUNK_BYTES / (elem_bytes * row_times), 1);
+    size_t nr_rows = dst.total_nr_elems() / dst.shape[last];
+    size_t nr_col_blocks = div_ceil(row_elems, block_elems);
+    size_t nr_units = nr_rows * nr_col_blocks;
+    size_t nr_bytes = nr_rows * dst_row_bytes;
+    size_t nr_tasks = copy::get_nr_tasks(handle(), nr_units, nr_bytes);
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    bool non_temporal = nr_bytes >= copy::MIN_BYTES_NON_TEMPORAL;
+    auto kern = [=](size_t task_id, size_t) {
+        auto sptr = static_cast<const uint8_t*>(src_.raw_ptr());
+        auto dptr = static_cast<uint8_t*>(dst_.raw_ptr());
+        size_t begin = task_id * units_per_task;
+        size_t end = std::min(nr_units, begin + units_per_task);
+        for (size_t unit = begin; unit < end; ++unit) {
+            size_t row = unit / nr_col_blocks;
+            size_t col = unit % nr_col_blocks * block_elems;
+            size_t width = std::min(block_elems, row_elems - col);
+            //! index i of a destination axis reads index i / times of it
+            size_t src_row = 0, src_stride = 1;
+            for (size_t k = last, rest = row; k > 0; --k) {
+                src_row += rest % dst.shape[k - 1] / times.shape[k - 1] * src_stride;
+                rest /= dst.shape[k - 1];
+                src_stride *= src.shape[k - 1];
             }
+            repeat_block(
+                    sptr + (src_row * row_elems + col) * elem_bytes,
+                    dptr + row * dst_row_bytes + col * row_times * elem_bytes, width,
+                    elem_bytes, row_times, non_temporal);
         }
+        copy::store_fence(non_temporal);
     };
-    MEGDNN_DISPATCH_CPU_KERN_OPR(kern());
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
 }
 
 }  // namespace fallback
@@ -0,0 +1,183 @@
+#include "src/fallback/resize/gi/resize_rows.h"
+#include <cstring>
+#include "src/common/rounding_converter.cuh"
+
+using namespace megdnn;
+using namespace fallback;
+using namespace resize;
+
+namespace {
+
+//! interpolate a source line horizontally into floats
+template <typename ctype>
+void interpolate_line(
+        const ctype* sline, float* dline, const LineCoord* coord_w, size_t OW,
+        size_t pixel_len) {
+    if (pixel_len == 1) {
+        for (size_t ow = 0; ow < OW; ++ow) {
+            auto&& cw = coord_w[ow];
+            dline[ow] = sline[cw.idx0] * cw.alpha0 + sline[cw.idx1] * cw.alpha1;
+        }
+        return;
+    }
+    for (size_t ow = 0; ow < OW; ++ow) {
+        auto&& cw = coord_w[ow];
+        const ctype* s0 = sline + cw.idx0 * pixel_len;
+        const ctype* s1 = sline + cw.idx1 * pixel_len;
+        float* d = dline + ow * pixel_len;
+        for (size_t k = 0; k < pixel_len; ++k) {
+            d[k] = s0[k] * cw.alpha0 + s1[k] * cw.alpha1;
+        }
+    }
+}
+
+template <>
+void interpolate_line<float>(
+        const float* sline, float* dline, const LineCoord* coord_w, size_t OW,
+        size_t pixel_len) {
+    using simd_helper = SIMDHelper<float>;
+    constexpr size_t PC = simd_helper::simd_width;
+    if (pixel_len % PC) {
+        for (size_t ow = 0; ow < OW; ++ow) {
+            auto&& cw = coord_w[ow];
+            const float* s0 = sline + cw.idx0 * pixel_len;
+            const float* s1 = sline + cw.idx1 * pixel_len;
+            float* d = dline + ow * pixel_len;
+            for (size_t k = 0; k < pixel_len; ++k) {
+                d[k] = s0[k] * cw.alpha0 + s1[k] * cw.alpha1;
+            }
+        }
+        return;
+    }
+    for (size_t ow = 0; ow < OW; ++ow) {
+        auto&& cw = coord_w[ow];
+        const float* s0 = sline + cw.idx0 * pixel_len;
+        const float* s1 = sline + cw.idx1 * pixel_len;
+        float* d = dline + ow * pixel_len;
+        for (size_t k = 0; k < pixel_len; k += PC) {
+            auto r = GiMultiplyScalerFloat32(simd_helper::load(s0 + k), cw.alpha0);
+            r = simd_helper::fma(r, simd_helper::load(s1 + k), cw.alpha1);
+            simd_helper::store(d + k, r);
+        }
+    }
+}
+
+//! blend two interpolated lines vertically into a destination row
+template <typename ctype>
+void blend_lines(
+        const float* line0, const float* line1, float alpha0, float alpha1,
+        ctype* drow, size_t len) {
+    rounding::RoundingConverter<ctype> output_converter;
+    for (size_t i = 0; i < len; ++i) {
+        drow[i] = output_converter(line0[i] * alpha0 + line1[i] * alpha1);
+    }
+}
+
+template <>
+void blend_lines<float>(
+        const float* line0, const float* line1, float alpha0, float alpha1,
+        float* drow, size_t len) {
+    using simd_helper = SIMDHelper<float>;
+    constexpr size_t PC = simd_helper::simd_width;
+    size_t i = 0;
+    for (; i + PC <= len; i += PC) {
+        auto r = GiMultiplyScalerFloat32(simd_helper::load(line0 + i), alpha0);
+        r = simd_helper::fma(r, simd_helper::load(line1 + i), alpha1);
+        simd_helper::store(drow + i, r);
+    }
+    for (; i < len; ++i) {
+        drow[i] = line0[i] * alpha0 + line1[i] * alpha1;
+    }
+}
+
+template <typename ctype>
+void nearest_line(
+        const ctype* sline, ctype* drow, const LineCoord* coord_w, size_t OW,
+        size_t pixel_len) {
+    if (pixel_len == 1) {
+        for (size_t ow = 0; ow < OW; ++ow) {
+            drow[ow] = sline[coord_w[ow].idx0];
+        }
+        return;
+    }
+    for (size_t ow = 0; ow < OW; ++ow) {
+        std::memcpy(
+                drow + ow * pixel_len, sline + coord_w[ow].idx0 * pixel_len,
+                sizeof(ctype) * pixel_len);
+    }
+}
+
+}  // anonymous namespace
+
+std::vector<LineCoord> resize::get_line_coords(
+        InterpolationMode imode, size_t isize, size_t osize) {
+    std::vector<LineCoord> coords(osize);
+    float scale = static_cast<float>(osize) / isize;
+    for (size_t i = 0; i < osize; ++i) {
+        auto&& coord = coords[i];
+        if (imode == InterpolationMode::INTER_NEAREST) {
+            coord.idx0 = coord.idx1 = get_nearest_src(scale, isize, i);
+            coord.alpha0 = 1.f;
+            coord.alpha1 = 0.f;
+        } else {
+            std::tie(coord.alpha0, coord.idx0, coord.alpha1, coord.idx1) =
+                    get_nearest_linear_coord(imode, scale, isize, i);
+        }
+    }
+    return coords;
+}
+
+template <typename ctype>
+void megdnn::fallback::resize_rows_gi(
+        const ctype* src, ctype* dst, size_t IH, size_t IW, size_t OH, size_t OW,
+        size_t pixel_len, const LineCoord* coord_h, const LineCoord* coord_w,
+        bool is_linear, size_t row_begin, size_t row_end, float* cache) {
+    size_t src_plane = IH * IW * pixel_len, src_line = IW * pixel_len;
+    size_t dst_line = OW * pixel_len;
+    if (!is_linear) {
+        for (size_t row = row_begin; row < row_end; ++row) {
+            const ctype* sline =
+                    src + row / OH * src_plane + coord_h[row % OH].idx0 * src_line;
+            nearest_line(sline, dst + row * dst_line, coord_w, OW, pixel_len);
+        }
+        return;
+    }
+    float* lines[2] = {cache, cache + dst_line};
+    //! the source lines held by lines[], which are only valid in one plane
+    int tags[2] = {-1, -1};
+    size_t plane = row_begin / OH;
+    auto fetch = [&](int idx, int keep) {
+        if (tags[0] == idx)
+            return lines[0];
+        if (tags[1] == idx)
+            return lines[1];
+        int slot = tags[0] == keep ? 1 : 0;
+        interpolate_line(
+                src + plane * src_plane + idx * src_line, lines[slot], coord_w, OW,
+                pixel_len);
+        tags[slot] = idx;
+        return lines[slot];
+    };
+    for (size_t row = row_begin; row < row_end; ++row) {
+        if (row / OH != plane) {
+            plane = row / OH;
+            tags[0] = tags[1] = -1;
+        }
+        auto&& ch = coord_h[row % OH];
+        float* line0 = fetch(ch.idx0, ch.idx1);
+        float* line1 = fetch(ch.idx1, ch.idx0);
+        blend_lines(
+                line0, line1, ch.alpha0, ch.alpha1, dst + row * dst_line, dst_line);
+    }
+}
+
+#define INST(ctype)                                                                \
+    template void megdnn::fallback::resize_rows_gi<ctype>(                         \
+            const ctype*, ctype*, size_t, size_t, size_t, size_t, size_t,          \
+            const LineCoord*, const LineCoord*, bool, size_t, size_t, float*);
+INST(float)
+INST(int8_t)
+INST(uint8_t)
+#undef INST
+
+// vim: syntax=cpp.doxygen
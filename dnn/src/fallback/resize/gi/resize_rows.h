@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include "src/fallback/resize/gi/helper.h"
+#include "src/fallback/resize/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+namespace resize {
+
+//! the two source lines an output line is interpolated from
+struct LineCoord {
+    int idx0, idx1;
+    float alpha0, alpha1;
+};
+
+std::vector<LineCoord> get_line_coords(
+        InterpolationMode imode, size_t isize, size_t osize);
+
+}  // namespace resize
+
+/*!
+ * \brief linear or nearest resize of the output rows [row_begin, row_end) of
+ * contiguous planes
+ *
+ * Every plane has IH x IW source pixels and OH x OW destination pixels of
+ * \p pixel_len elements, and row r is row r % OH of plane r / OH. In linear
+ * mode, the two horizontally interpolated source lines are kept in \p cache of
+ * 2 * OW * pixel_len floats and reused by the following output rows.
+ */
+template <typename ctype>
+void resize_rows_gi(
+        const ctype* src, ctype* dst, size_t IH, size_t IW, size_t OH, size_t OW,
+        size_t pixel_len, const resize::LineCoord* coord_h,
+        const resize::LineCoord* coord_w, bool is_linear, size_t row_begin,
+        size_t row_end, float* cache);
+
+}  // namespace fallback
+}  // namespace megdnn
@@ -5,6 +5,7 @@
 
 #include "src/fallback/resize/gi/direct_nchwxx.h"
 #include "src/fallback/resize/gi/resize_cv.h"
+#include "src/fallback/resize/gi/resize_rows.h"
 #include "src/fallback/resize/gi/upsample2_nchw.h"
 #include "src/fallback/resize/gi/upsample2_nchwxx.h"
 
@@ -14,6 +15,28 @@ MIDOUT_DECL(megdnn_fallback_resize)
 using namespace megdnn;
 using namespace fallback;
 
+namespace {
+
+//! resizes with fewer output elements are executed in one thread
+constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 16384;
+
+//! the tensors viewed as planes of H x W pixels with pixel_len elements each
+struct RowsGeometry {
+    size_t nr_planes, ih, iw, oh, ow, pixel_len;
+};
+
+RowsGeometry get_rows_geometry(
+        param::Resize::Format format, const TensorLayout& src,
+        const TensorLayout& dst) {
+    if (format == param::Resize::Format::NHWC) {
+        return {src[0], src[1], src[2], dst[1], dst[2], src[3]};
+    }
+    size_t pixel_len = format == param::Resize::Format::NCHW44 ? 4 : 1;
+    return {src[0] * src[1], src[2], src[3], dst[2], dst[3], pixel_len};
+}
+
+}  // anonymous namespace
+
 template <typename ctype>
 void ResizeImpl::kern_fallback(const KernParam<ctype>& kern_param) {
     if (kern_param.format == Format::NHWC) {
@@ -101,14 +124,109 @@ void ResizeImpl::kern_fallback_nhwc(const KernParam<ctype>& kern_param) {
     }
 }
 
+size_t ResizeImpl::get_nr_threads() {
+    return static_cast<naive::HandleImpl*>(handle())
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+size_t ResizeImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout& dst) {
+    if (!is_rows_usable(src, dst) ||
+        param().imode != param::Resize::InterpolationMode::INTER_LINEAR) {
+        return 0;
+    }
+    //! two interpolated source lines for each thread
+    auto geo = get_rows_geometry(param().format, src, dst);
+    return get_nr_threads() * 2 * geo.ow * geo.pixel_len * sizeof(float);
+}
+
+bool ResizeImpl::is_rows_usable(const TensorLayout& src, const TensorLayout& dst) {
+    using Format = param::Resize::Format;
+    using IMode = param::Resize::InterpolationMode;
+    auto format = param().format;
+    auto imode = param().imode;
+    auto dtype = src.dtype.enumv();
+    //! nearest NHWC images of 1 or 3 channels round their coordinates as cv
+    if (format == Format::NHWC && imode == IMode::INTER_NEAREST &&
+        (src[3] == 1 || src[3] == 3)) {
+        return false;
+    }
+    return src.is_contiguous() && dst.is_contiguous() && src.dtype == dst.dtype &&
+           (dtype == DTypeEnum::Float32 || dtype == DTypeEnum::Int8 ||
+            dtype == DTypeEnum::QuantizedS8 || dtype == DTypeEnum::Uint8 ||
+            dtype == DTypeEnum::Quantized8Asymm) &&
+           (imode == IMode::INTER_LINEAR || imode == IMode::INTER_NEAREST) &&
+           (format == Format::NCHW || format == Format::NHWC ||
+            format == Format::NCHW44);
+}
+
 void ResizeImpl::exec(
         _megdnn_tensor_in src, _megdnn_tensor_in dst, _megdnn_workspace workspace) {
     check_exec(src.layout, dst.layout, workspace.size);
+    //! the single thread kernels below are kept for their special cases,
+    //! with several threads every plane is split by rows
+    if (get_nr_threads() > 1 && is_rows_usable(src.layout, dst.layout)) {
+        exec_rows(src, dst, workspace);
+        return;
+    }
     exec_gi(src, dst, workspace);
 }
 
+void ResizeImpl::exec_rows(
+        _megdnn_tensor_in src, _megdnn_tensor_in dst, _megdnn_workspace workspace) {
+    auto geo = get_rows_geometry(param().format, src.layout, dst.layout);
+    bool is_linear = param().imode == param::Resize::InterpolationMode::INTER_LINEAR;
+    auto coord_h = resize::get_line_coords(param().imode, geo.ih, geo.oh);
+    auto coord_w = resize::get_line_coords(param().imode, geo.iw, geo.ow);
+    size_t nr_rows = geo.nr_planes * geo.oh;
+    size_t nr_tasks = dst.layout.total_nr_elems() < MIN_NR_ELEMS_MULTI_THREAD
+                            ? 1
+                            : std::max<size_t>(std::min(get_nr_threads(), nr_rows), 1);
+    size_t rows_per_task = div_ceil(nr_rows, nr_tasks);
+    size_t cache_len = 2 * geo.ow * geo.pixel_len;
+#define cb(dt, ct)                                                                    \
+    case DTypeTrait<dt>::enumv: {                                                     \
+        MIDOUT_BEGIN(megdnn_fallback_resize, midout_iv(6), ct) {                      \
+            auto kern = [=](size_t task_id, size_t thread_id) {                       \
+                size_t begin = task_id * rows_per_task;                               \
+                size_t end = std::min(nr_rows, begin + rows_per_task);                \
+                float* cache = is_linear                                              \
+                                     ? workspace.ptr<float>() + thread_id * cache_len \
+                                     : nullptr;                                       \
+                resize_rows_gi<ct>(                                                   \
+                        static_cast<const ct*>(src.raw_ptr()),                        \
+                        static_cast<ct*>(dst.raw_ptr()), geo.ih, geo.iw, geo.oh,      \
+                        geo.ow, geo.pixel_len, coord_h.data(), coord_w.data(),        \
+                        is_linear, begin, end, cache);                                \
+            };                                                                        \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);                \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
+        return;                                                                       \
+    }
+
+    switch (src.layout.dtype.enumv()) {
+        cb(dtype::Float32, float);
+        cb(dtype::Int8, int8_t);
+        cb(dtype::QuantizedS8, int8_t);
+        cb(dtype::Uint8, uint8_t);
+        cb(dtype::Quantized8Asymm, uint8_t);
+        default:
+            megdnn_throw(ssprintf(
+                                 "Unsupported input DType in Resize: %s",
+                                 src.layout.dtype.name())
+                                 .c_str());
+    }
+#undef cb
+}
+
 void ResizeImpl::exec_fallback(
         _megdnn_tensor_in src, _megdnn_tensor_in dst, _megdnn_workspace workspace) {
+    if (is_rows_usable(src.layout, dst.layout)) {
+        exec_rows(src, dst, workspace);
+        return;
+    }
     if (param().format == param::Resize::Format::NCHW4 ||
         param().format == param::Resize::Format::NCHW44 ||
         param().format == param::Resize::Format::NCHW88 ||
@@ -13,9 +13,8 @@ public:
             _megdnn_tensor_in src, _megdnn_tensor_out dst,
             _megdnn_workspace workspace) override;
 
-    size_t get_workspace_in_bytes(const TensorLayout&, const TensorLayout&) override {
-        return 0;
-    }
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dst) override;
 
 private:
     // ctype: C type of input data type.
@@ -30,6 +29,14 @@ private:
 
     void exec_gi(
             _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace);
+
+    //! whether the row-tiled multithread kernels of resize_rows.h apply
+    bool is_rows_usable(const TensorLayout& src, const TensorLayout& dst);
+
+    void exec_rows(
+            _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace);
+
+    size_t get_nr_threads();
 };  // class ResizeImpl
 
 }  // namespace fallback
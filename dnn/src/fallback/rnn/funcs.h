@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+namespace rnn {
+
+//! hidden columns of one batch row handled by one task of the gate kernel
+constexpr size_t NR_COLS_PER_TASK = 64;
+
+MEGDNN_FORCE_INLINE float sigmoid(float x) {
+    return 1.f / (1.f + std::exp(-x));
+}
+
+//! gates of one batch row are [i, f, g, o]; the states are {h, c}; the
+//! epilogues update the columns [begin, end) of the states of one batch row
+struct LSTMCellEpilogue {
+    static constexpr size_t NR_GATES = 4, NR_STATES = 2;
+
+    void operator()(
+            const float* gates, const float* const* prev, float* const* cur,
+            size_t hidden, size_t begin, size_t end) const {
+        const float* gi = gates;
+        const float* gf = gates + hidden;
+        const float* gg = gates + 2 * hidden;
+        const float* go = gates + 3 * hidden;
+        for (size_t j = begin; j < end; ++j) {
+            float c = sigmoid(gf[j]) * prev[1][j] + sigmoid(gi[j]) * std::tanh(gg[j]);
+            cur[1][j] = c;
+            cur[0][j] = sigmoid(go[j]) * std::tanh(c);
+        }
+    }
+};
+
+struct RNNCellEpilogue {
+    static constexpr size_t NR_GATES = 1, NR_STATES = 1;
+    param::RNNCell::NonlineMode nonline_mode;
+
+    void operator()(
+            const float* gates, const float* const*, float* const* cur, size_t,
+            size_t begin, size_t end) const {
+        using NonlineMode = param::RNNCell::NonlineMode;
+        float* h = cur[0];
+        switch (nonline_mode) {
+            case NonlineMode::RELU:
+                for (size_t j = begin; j < end; ++j)
+                    h[j] = std::max(gates[j], 0.f);
+                break;
+            case NonlineMode::TANH:
+                for (size_t j = begin; j < end; ++j)
+                    h[j] = std::tanh(gates[j]);
+                break;
+            default:
+                memcpy(h + begin, gates + begin, (end - begin) * sizeof(float));
+                break;
+        }
+    }
+};
+
+inline bool usable(const TensorLayout& input, const TensorLayout& flatten_weights) {
+    return input.dtype.enumv() == DTypeEnum::Float32 &&
+           flatten_weights.dtype.enumv() == DTypeEnum::Float32 &&
+           input.is_contiguous() && input.shape[0] > 0;
+}
+
+//! layouts of the input projection MatrixMul of a layer with the given input size
+inline void get_matmul_layouts(
+        const TensorLayout& input, size_t input_size, size_t gate_hidden_size,
+        TensorLayout& a, TensorLayout& b, TensorLayout& c) {
+    size_t nr_rows = input.shape[0] * input.shape[1];
+    a = {{nr_rows, input_size}, dtype::Float32()};
+    b = {{gate_hidden_size, input_size}, dtype::Float32()};
+    c = {{nr_rows, gate_hidden_size}, dtype::Float32()};
+}
+
+//! layouts of the h_prev * weight_hh^T MatrixMul of one step
+inline void get_step_matmul_layouts(
+        size_t batch_size, size_t hidden_size, size_t gate_hidden_size,
+        TensorLayout& a, TensorLayout& b, TensorLayout& c) {
+    a = {{batch_size, hidden_size}, dtype::Float32()};
+    b = {{gate_hidden_size, hidden_size}, dtype::Float32()};
+    c = {{batch_size, gate_hidden_size}, dtype::Float32()};
+}
+
+template <class Cell>
+size_t get_workspace_in_bytes(
+        const TensorLayout& input, size_t hidden_size, size_t num_layers, size_t D,
+        Handle* handle) {
+    size_t seq_len = input.shape[0], batch_size = input.shape[1];
+    size_t gate_hidden_size = Cell::NR_GATES * hidden_size;
+    auto matmul = handle->create_operator<MatrixMulForward>();
+    matmul->param().transposeB = true;
+    TensorLayout a, b, c;
+    get_matmul_layouts(input, input.shape[2], gate_hidden_size, a, b, c);
+    size_t matmul_workspace = matmul->get_workspace_in_bytes(a, b, c);
+    if (num_layers > 1) {
+        get_matmul_layouts(input, D * hidden_size, gate_hidden_size, a, b, c);
+        matmul_workspace =
+                std::max(matmul_workspace, matmul->get_workspace_in_bytes(a, b, c));
+    }
+    get_step_matmul_layouts(batch_size, hidden_size, gate_hidden_size, a, b, c);
+    matmul_workspace =
+            std::max(matmul_workspace, matmul->get_workspace_in_bytes(a, b, c));
+    size_t gates = seq_len * batch_size * gate_hidden_size;
+    size_t step_gates = batch_size * gate_hidden_size;
+    size_t layer_output = num_layers > 1 ? seq_len * batch_size * D * hidden_size : 0;
+    return (gates + step_gates + layer_output) * sizeof(float) + matmul_workspace;
+}
+
+/*!
+ * \brief float32 forward of stacked RNN/LSTM layers
+ *
+ * For every cell (layer, direction) the input projection of all the steps is
+ * computed by one MatrixMul. A step computes h_prev * weight_hh^T with another
+ * MatrixMul, which runs on the thread pool even for a single batch row, then
+ * one kernel adds it and the biases to the projected gates and applies the
+ * gate activations. The gate kernel is split over batch rows and blocks of
+ * hidden columns.
+ *
+ * The states of each step are written to reserve_space in the layout used by
+ * naive::rnn::exec_internal, so the naive backward can consume them.
+ */
+template <class Cell>
+void exec_internal(
+        const Cell& cell, _megdnn_tensor_in input, const TensorNDArray& states,
+        const TensorNDArray& states_new, _megdnn_tensor_in flatten_weights,
+        _megdnn_tensor_out output, _megdnn_tensor_out reserve_space,
+        size_t hidden_size, size_t num_layers, size_t D, bool bias, Handle* handle,
+        _megdnn_workspace workspace) {
+    constexpr size_t NR_STATES = Cell::NR_STATES;
+    size_t seq_len = input.layout.shape[0];
+    size_t batch_size = input.layout.shape[1];
+    size_t input_size = input.layout.shape[2];
+    size_t gate_hidden_size = Cell::NR_GATES * hidden_size;
+    size_t state_size = batch_size * hidden_size;
+    size_t output_size = D * hidden_size;
+    auto cpu_handle = static_cast<naive::HandleImpl*>(handle);
+
+    float* gates = reinterpret_cast<float*>(workspace.raw_ptr);
+    float* hh_gates = gates + seq_len * batch_size * gate_hidden_size;
+    float* layer_buf = hh_gates + batch_size * gate_hidden_size;
+    dt_byte* matmul_workspace_ptr = reinterpret_cast<dt_byte*>(
+            layer_buf + (num_layers > 1 ? seq_len * state_size * D : 0));
+    Workspace matmul_workspace(
+            matmul_workspace_ptr,
+            workspace.size - (matmul_workspace_ptr - workspace.raw_ptr));
+
+    auto matmul = handle->create_operator<MatrixMulForward>();
+    matmul->param().transposeB = true;
+
+    size_t weight_offset = 0;
+    TensorND layer_input = input;
+    for (size_t layer = 0; layer < num_layers; ++layer) {
+        //! alternate between output and layer_buf so that the last layer
+        //! writes output
+        TensorND layer_output = (num_layers - 1 - layer) % 2
+                                      ? TensorND{layer_buf, output.layout}
+                                      : output;
+        size_t cell_input_size = layer == 0 ? input_size : output_size;
+        for (size_t d = 0; d < D; ++d) {
+            size_t cell_idx = layer * D + d;
+            size_t weight_ih_offset = weight_offset;
+            size_t weight_hh_offset =
+                    weight_ih_offset + gate_hidden_size * cell_input_size;
+            size_t bias_offset = weight_hh_offset + gate_hidden_size * hidden_size;
+            weight_offset = bias_offset + (bias ? 2 * gate_hidden_size : 0);
+
+            TensorLayout a, b, c;
+            get_matmul_layouts(
+                    input.layout, cell_input_size, gate_hidden_size, a, b, c);
+            RefPtr weight_ih = flatten_weights.get_ref_ptr();
+            weight_ih += weight_ih_offset * sizeof(float);
+            matmul->exec(
+                    {a, layer_input.get_ref_ptr()}, {b, weight_ih}, {gates, c},
+                    matmul_workspace);
+
+            //! the states of step i are in slot i, the initial ones in states
+            auto state_offset = [=](size_t i, size_t s) {
+                return ((cell_idx * seq_len + i) * NR_STATES + s) * state_size;
+            };
+            auto state_ptr = [=](size_t i, size_t s) -> float* {
+                return static_cast<float*>(reserve_space.raw_ptr()) +
+                       state_offset(i, s);
+            };
+            TensorLayout h_layout, w_layout, hh_layout;
+            get_step_matmul_layouts(
+                    batch_size, hidden_size, gate_hidden_size, h_layout, w_layout,
+                    hh_layout);
+            RefPtr weight_hh = flatten_weights.get_ref_ptr();
+            weight_hh += weight_hh_offset * sizeof(float);
+            size_t nr_col_blocks = div_ceil(hidden_size, NR_COLS_PER_TASK);
+            for (size_t i = 0; i < seq_len; ++i) {
+                size_t step = d == 0 ? i : seq_len - 1 - i;
+                RefPtr h_prev = i == 0 ? states[0].get_ref_ptr()
+                                       : reserve_space.get_ref_ptr();
+                h_prev += (i == 0 ? cell_idx * state_size : state_offset(i - 1, 0)) *
+                          sizeof(float);
+                matmul->exec(
+                        {h_layout, h_prev}, {w_layout, weight_hh},
+                        {hh_gates, hh_layout}, matmul_workspace);
+
+                auto kern = [=](size_t task_id, size_t) {
+                    size_t r = task_id / nr_col_blocks;
+                    size_t begin = task_id % nr_col_blocks * NR_COLS_PER_TASK;
+                    size_t end = std::min(hidden_size, begin + NR_COLS_PER_TASK);
+                    float* acc = gates + (step * batch_size + r) * gate_hidden_size;
+                    const float* hh = hh_gates + r * gate_hidden_size;
+                    const float* bias_ih = flatten_weights.ptr<float>() + bias_offset;
+                    const float* bias_hh = bias_ih + gate_hidden_size;
+                    for (size_t g = 0; g < gate_hidden_size; g += hidden_size) {
+                        for (size_t j = g + begin; j < g + end; ++j) {
+                            acc[j] += hh[j];
+                            if (bias)
+                                acc[j] += bias_ih[j] + bias_hh[j];
+                        }
+                    }
+                    const float* prev_row[NR_STATES];
+                    float* cur_row[NR_STATES];
+                    for (size_t s = 0; s < NR_STATES; ++s) {
+                        prev_row[s] = (i == 0 ? states[s].ptr<float>() +
+                                                        cell_idx * state_size
+                                              : state_ptr(i - 1, s)) +
+                                      r * hidden_size;
+                        cur_row[s] = state_ptr(i, s) + r * hidden_size;
+                    }
+                    cell(acc, prev_row, cur_row, hidden_size, begin, end);
+                    float* dst = layer_output.ptr<float>() +
+                                 (step * batch_size + r) * output_size +
+                                 d * hidden_size;
+                    memcpy(dst + begin, cur_row[0] + begin,
+                           (end - begin) * sizeof(float));
+                };
+                MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+                        cpu_handle, batch_size * nr_col_blocks, kern);
+            }
+
+            auto copy_states = [=]() {
+                for (size_t s = 0; s < NR_STATES; ++s) {
+                    memcpy(states_new[s].ptr<float>() + cell_idx * state_size,
+                           state_ptr(seq_len - 1, s), state_size * sizeof(float));
+                }
+            };
+            MEGDNN_DISPATCH_CPU_KERN(cpu_handle, copy_states());
+        }
+        layer_input = layer_output;
+    }
+}
+
+}  // namespace rnn
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,47 @@
+#include "src/fallback/rnn/opr_impl.h"
+#include "src/fallback/rnn/funcs.h"
+
+#include "midout.h"
+MIDOUT_DECL(megdnn_fallback_rnn_fwd)
+
+namespace megdnn {
+namespace fallback {
+
+void RNNImpl::exec(
+        _megdnn_tensor_in input, _megdnn_tensor_in hx,
+        _megdnn_tensor_in flatten_weights, _megdnn_tensor_out output,
+        _megdnn_tensor_out hy, _megdnn_tensor_out reserve_space,
+        _megdnn_workspace workspace) {
+    if (!rnn::usable(input.layout, flatten_weights.layout)) {
+        naive::RNNImpl::exec(
+                input, hx, flatten_weights, output, hy, reserve_space, workspace);
+        return;
+    }
+    MIDOUT_BEGIN(megdnn_fallback_rnn_fwd, void) {
+        auto _param = param();
+        rnn::exec_internal(
+                rnn::RNNCellEpilogue{_param.nonlineMode}, input, {hx}, {hy},
+                flatten_weights, output, reserve_space, _param.hidden_size,
+                _param.num_layers, _param.bidirectional ? 2 : 1, _param.bias,
+                handle(), workspace);
+    }
+    MIDOUT_END();
+}
+
+size_t RNNImpl::get_workspace_in_bytes(
+        const TensorLayout& input, const TensorLayout& hx,
+        const TensorLayout& flatten_weights, const TensorLayout& output,
+        const TensorLayout& hy, const TensorLayout& reserve_space) {
+    if (!rnn::usable(input, flatten_weights)) {
+        return naive::RNNImpl::get_workspace_in_bytes(
+                input, hx, flatten_weights, output, hy, reserve_space);
+    }
+    return rnn::get_workspace_in_bytes<rnn::RNNCellEpilogue>(
+            input, param().hidden_size, param().num_layers,
+            param().bidirectional ? 2 : 1, handle());
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,26 @@
+#pragma once
+#include "src/naive/rnn/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+class RNNImpl : public naive::RNNImpl {
+public:
+    using naive::RNNImpl::RNNImpl;
+
+    void exec(
+            _megdnn_tensor_in input, _megdnn_tensor_in hx,
+            _megdnn_tensor_in flatten_weights, _megdnn_tensor_out output,
+            _megdnn_tensor_out hy, _megdnn_tensor_out reserve_space,
+            _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout& input, const TensorLayout& hx,
+            const TensorLayout& flatten_weights, const TensorLayout& output,
+            const TensorLayout& hy, const TensorLayout& reserve_space) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -1,146 +1,149 @@
 #include "src/fallback/softmax/opr_impl.h"
-#include <cstring>
-#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "src/fallback/elemwise/gi_impl/gi_mathfun.h"
 #include "src/naive/handle.h"
 
 namespace megdnn {
 namespace fallback {
 
-static void do_softmax(
-        const float* sptr, float* dptr, size_t A, size_t B, size_t C,
-        _megdnn_workspace workspace) {
-    constexpr auto float_min = std::numeric_limits<float>::min();
-    constexpr auto step = GI_SIMD_LEN_BYTE / sizeof(float);
-    // TODO: When C=2,3,4..., src_ptr span is relatively large, the performance may
-    // be poor
+namespace {
+
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+//! vectors of a row whose max is taken before their exponentials are summed
+constexpr size_t ROW_CHUNK = 4;
+//! rows of B whose max is taken before their exponentials are summed
+constexpr size_t B_CHUNK = 4;
+//! channels handled together by the strided kernel
+constexpr size_t CHANNEL_BLOCK = 64;
+//! softmax over fewer elements is executed in one thread
+constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 16384;
+constexpr float LOWEST = std::numeric_limits<float>::lowest();
+
+inline GI_FLOAT32_t exp_sub(GI_FLOAT32_t a, GI_FLOAT32_t b) {
+    return GiExpPsFloat32(GiSubtractFloat32(a, b));
+}
 
-    if (C != 1) {
-        WorkspaceBundle workspace_bundle{
-                workspace.raw_ptr, {A * C * sizeof(float), A * C * sizeof(float)}};
-        float* max = workspace_bundle.get_workspace(0).raw_ptr->as<float>();
-        GI_FLOAT32_t v_max = GiBroadcastFloat32(float_min);
-        size_t i = 0;
-        for (; i + step <= A * C; i += step)
-            GiStoreFloat32(max + i, v_max);
-        for (; i < A * C; i++)
-            max[i] = float_min;
+/*!
+ * \brief softmax of n contiguous elements
+ *
+ * The max and the sum of exponentials are gathered in a single pass: every
+ * chunk of ROW_CHUNK vectors raises the running max of each lane first, the
+ * lane sums are rescaled to the new max and the exponentials of the chunk,
+ * which is still in L1, are added. The second pass writes exp(x - max) / sum.
+ */
+void softmax_inner(const float* src, float* dst, size_t n) {
+    constexpr size_t chunk = ROW_CHUNK * SIMD_WIDTH;
+    GI_FLOAT32_t vmax = GiBroadcastFloat32(LOWEST);
+    GI_FLOAT32_t vsum = GiZeroFloat32();
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= n;) {
+        size_t len = i + chunk <= n ? chunk : SIMD_WIDTH;
+        GI_FLOAT32_t new_max = vmax;
+        for (size_t k = 0; k < len; k += SIMD_WIDTH) {
+            new_max = GiMaximumFloat32(new_max, GiLoadFloat32(src + i + k));
+        }
+        vsum = GiMultiplyFloat32(vsum, exp_sub(vmax, new_max));
+        for (size_t k = 0; k < len; k += SIMD_WIDTH) {
+            vsum = GiAddFloat32(vsum, exp_sub(GiLoadFloat32(src + i + k), new_max));
+        }
+        vmax = new_max;
+        i += len;
+    }
+    float lane_max[SIMD_WIDTH], lane_sum[SIMD_WIDTH];
+    GiStoreFloat32(lane_max, vmax);
+    GiStoreFloat32(lane_sum, vsum);
+    float max = LOWEST;
+    for (size_t l = 0; l < SIMD_WIDTH; ++l) {
+        max = std::max(max, lane_max[l]);
+    }
+    for (size_t j = i; j < n; ++j) {
+        max = std::max(max, src[j]);
+    }
+    float sum = 0;
+    for (size_t l = 0; l < SIMD_WIDTH; ++l) {
+        sum += lane_sum[l] * std::exp(lane_max[l] - max);
+    }
+    for (size_t j = i; j < n; ++j) {
+        sum += std::exp(src[j] - max);
+    }
 
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto max_ptr = max + a * C;
-                auto limit = max_ptr + C;
-                auto src_ptr = sptr + a * B * C + b * C;
+    float inv_sum = 1.f / sum;
+    GI_FLOAT32_t vinv_sum = GiBroadcastFloat32(inv_sum);
+    vmax = GiBroadcastFloat32(max);
+    i = 0;
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+        GI_FLOAT32_t v = exp_sub(GiLoadFloat32(src + i), vmax);
+        GiStoreFloat32(dst + i, GiMultiplyFloat32(v, vinv_sum));
+    }
+    for (; i < n; ++i) {
+        dst[i] = std::exp(src[i] - max) * inv_sum;
+    }
+}
 
-                for (; max_ptr + step <= limit; max_ptr += step, src_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
-                    v_max = GiMaximumFloat32(v_max, v_p);
-                    GiStoreFloat32(max_ptr, v_max);
-                }
-                for (; max_ptr < limit; ++max_ptr, ++src_ptr) {
-                    *max_ptr = std::max(*src_ptr, *max_ptr);
-                }
+/*!
+ * \brief softmax over b of x[b * C + c] for c in [0, width)
+ *
+ * Vectorized over the channels: the running max and sum of each channel
+ * live in stack arrays, and B is walked by chunks of B_CHUNK rows in the
+ * same way softmax_inner() walks its row.
+ */
+void softmax_strided(const float* src, float* dst, size_t B, size_t C, size_t width) {
+    float max[CHANNEL_BLOCK], sum[CHANNEL_BLOCK];
+    std::fill_n(max, width, LOWEST);
+    std::fill_n(sum, width, 0.f);
+    for (size_t b = 0; b < B; b += B_CHUNK) {
+        size_t rows = std::min(B_CHUNK, B - b);
+        const float* sptr = src + b * C;
+        size_t c = 0;
+        for (; c + SIMD_WIDTH <= width; c += SIMD_WIDTH) {
+            GI_FLOAT32_t old_max = GiLoadFloat32(max + c);
+            GI_FLOAT32_t new_max = old_max;
+            for (size_t r = 0; r < rows; ++r) {
+                new_max = GiMaximumFloat32(new_max, GiLoadFloat32(sptr + r * C + c));
             }
-        }
-
-        float* sum = workspace_bundle.get_workspace(1).raw_ptr->as<float>();
-        memset(sum, 0, A * C * sizeof(float));
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto max_ptr = max + a * C;
-                auto limit = max_ptr + C;
-                auto sum_ptr = sum + a * C;
-                auto src_ptr = sptr + a * B * C + C * b;
-                auto dst_ptr = dptr + a * B * C + C * b;
-                for (; max_ptr + step <= limit; max_ptr += step, sum_ptr += step,
-                                                src_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
-                    GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
-                    v_p = GiExpPsFloat32(GiSubtractFloat32(v_p, v_max));
-                    v_sum = GiAddFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                    GiStoreFloat32(sum_ptr, v_sum);
-                }
-                for (; max_ptr < limit; ++max_ptr, ++sum_ptr, ++src_ptr, ++dst_ptr) {
-                    *dst_ptr = exp(*src_ptr - *max_ptr);
-                    *sum_ptr += *dst_ptr;
-                }
+            GI_FLOAT32_t scale = exp_sub(old_max, new_max);
+            GI_FLOAT32_t vsum = GiMultiplyFloat32(GiLoadFloat32(sum + c), scale);
+            for (size_t r = 0; r < rows; ++r) {
+                vsum = GiAddFloat32(
+                        vsum, exp_sub(GiLoadFloat32(sptr + r * C + c), new_max));
             }
+            GiStoreFloat32(max + c, new_max);
+            GiStoreFloat32(sum + c, vsum);
         }
-
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto sum_ptr = sum + a * C;
-                auto limit = sum_ptr + C;
-                auto dst_ptr = dptr + a * B * C + C * b;
-                for (; sum_ptr + step <= limit; sum_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(dst_ptr);
-                    GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
-                    v_p = GiDivideFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                }
-                for (; sum_ptr < limit; ++sum_ptr, ++dst_ptr)
-                    *dst_ptr = *dst_ptr / *sum_ptr;
+        for (; c < width; ++c) {
+            float new_max = max[c];
+            for (size_t r = 0; r < rows; ++r) {
+                new_max = std::max(new_max, sptr[r * C + c]);
             }
-        }
-    } else {
-        for (size_t a = 0; a < A; a++) {
-            auto max = float_min;
-            {
-                auto src_ptr = sptr + a * B;
-                auto limit = src_ptr + B;
-                GI_FLOAT32_t v_max = GiBroadcastFloat32(max);
-
-                for (; src_ptr + step <= limit; src_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    v_max = GiMaximumFloat32(v_max, v_p);
-                }
-                max = std::max(max, GiReduceMaxNanFloat32(v_max));
-                for (; src_ptr < limit; ++src_ptr) {
-                    max = std::max(*src_ptr, max);
-                }
+            sum[c] *= std::exp(max[c] - new_max);
+            for (size_t r = 0; r < rows; ++r) {
+                sum[c] += std::exp(sptr[r * C + c] - new_max);
             }
+            max[c] = new_max;
+        }
+    }
 
-            auto sum = 0.f;
-            {
-                auto src_ptr = sptr + a * B;
-                auto limit = src_ptr + B;
-                auto dst_ptr = dptr + a * B;
-                GI_FLOAT32_t v_sum = GiZeroFloat32();
-                GI_FLOAT32_t v_max = GiBroadcastFloat32(max);
-
-                for (; src_ptr + step <= limit; src_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    v_p = GiExpPsFloat32(GiSubtractFloat32(v_p, v_max));
-                    GiStoreFloat32(dst_ptr, v_p);
-                    v_sum = GiAddFloat32(v_sum, v_p);
-                }
-                sum += GiReduceAddFloat32(v_sum);
-                for (; src_ptr < limit; ++src_ptr, ++dst_ptr) {
-                    *dst_ptr = exp(*src_ptr - max);
-                    sum += *dst_ptr;
-                }
-            }
-            {
-                auto dst_ptr = dptr + a * B;
-                auto limit = dst_ptr + B;
-                sum = 1 / sum;
-                GI_FLOAT32_t v_sum = GiBroadcastFloat32(sum);
-                for (; dst_ptr + step <= limit; dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(dst_ptr);
-                    v_p = GiMultiplyFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                }
-                for (; dst_ptr < limit; ++dst_ptr) {
-                    *dst_ptr *= sum;
-                }
-            }
+    for (size_t c = 0; c < width; ++c) {
+        sum[c] = 1.f / sum[c];
+    }
+    for (size_t b = 0; b < B; ++b) {
+        const float* sptr = src + b * C;
+        float* dptr = dst + b * C;
+        size_t c = 0;
+        for (; c + SIMD_WIDTH <= width; c += SIMD_WIDTH) {
+            GI_FLOAT32_t v = exp_sub(GiLoadFloat32(sptr + c), GiLoadFloat32(max + c));
+            GiStoreFloat32(dptr + c, GiMultiplyFloat32(v, GiLoadFloat32(sum + c)));
+        }
+        for (; c < width; ++c) {
+            dptr[c] = std::exp(sptr[c] - max[c]) * sum[c];
         }
     }
 }
 
+}  // namespace
+
 void SoftmaxForwardImpl::exec(
         _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
     auto axis = param().axis;
@@ -154,13 +157,37 @@ void SoftmaxForwardImpl::exec(
         return;
     }
 
-    typedef DTypeTrait<dtype::Float32>::ctype Float32;
-    auto sptr = src.ptr<Float32>();
-    auto dptr = dst.ptr<Float32>();
-
     size_t A, B, C;
     reduce::get_ABC(src.layout, A, B, C, axis);
-    MEGDNN_DISPATCH_CPU_KERN_OPR(do_softmax(sptr, dptr, A, B, C, workspace));
+    //! A x blocks of C are independent, split them over the threads
+    size_t nr_c_blocks = C == 1 ? 1 : div_ceil(C, CHANNEL_BLOCK);
+    size_t nr_units = A * nr_c_blocks;
+    size_t nr_tasks = 1;
+    if (src.layout.total_nr_elems() >= MIN_NR_ELEMS_MULTI_THREAD) {
+        size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                    ->megcore_dispatcher()
+                                    ->nr_threads();
+        nr_tasks = std::min(nr_units, nr_threads);
+    }
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    auto kern = [=](size_t task_id, size_t) {
+        const float* sptr = src.ptr<dt_float32>();
+        float* dptr = dst.ptr<dt_float32>();
+        size_t end = std::min(nr_units, (task_id + 1) * units_per_task);
+        for (size_t unit = task_id * units_per_task; unit < end; ++unit) {
+            if (C == 1) {
+                softmax_inner(sptr + unit * B, dptr + unit * B, B);
+                continue;
+            }
+            size_t a = unit / nr_c_blocks;
+            size_t c = unit % nr_c_blocks * CHANNEL_BLOCK;
+            size_t offset = a * B * C + c;
+            softmax_strided(
+                    sptr + offset, dptr + offset, B, C,
+                    std::min(CHANNEL_BLOCK, C - c));
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
 }
 
 }  // namespace fallback
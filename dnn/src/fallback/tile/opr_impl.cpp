@@ -1,67 +1,107 @@
 #include "src/fallback/tile/opr_impl.h"
 
 #include <cstring>
-#include <numeric>
 #include "src/common/tile_repeat_helper.h"
 #include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
 #include "src/naive/handle.h"
 
-namespace megdnn {
-namespace fallback {
+namespace {
+
+//! shorter rows are replicated from the already written part of the block, so
+//! that the length of every memcpy is doubled
+constexpr size_t MIN_ROW_BYTES_DIRECT = 256;
 
-size_t TileImpl::get_workspace_in_bytes(
-        const TensorLayout& src, const TensorLayout& dst) {
-    auto workspace_size = get_workspace_in_bytes_fwd(src, dst);
-    return workspace_size;
+/*!
+ * \brief fill bytes [col, col + width) of a destination row, which repeats
+ * the source row of \p row_bytes bytes
+ */
+void tile_row_block(
+        uint8_t* dst, const uint8_t* src_row, size_t row_bytes, size_t col,
+        size_t width, bool non_temporal) {
+    using namespace megdnn::fallback;
+    size_t offset = col % row_bytes;
+    size_t done = std::min(row_bytes - offset, width);
+    copy::copy_bytes(dst, src_row + offset, done, non_temporal);
+    if (row_bytes >= MIN_ROW_BYTES_DIRECT) {
+        while (done < width) {
+            size_t len = std::min(row_bytes, width - done);
+            copy::copy_bytes(dst + done, src_row, len, non_temporal);
+            done += len;
+        }
+        return;
+    }
+    if (done < width) {
+        size_t len = std::min(offset, width - done);
+        std::memcpy(dst + done, src_row, len);
+        done += len;
+    }
+    //! dst[0, done) now holds a whole number of rows
+    while (done < width) {
+        size_t len = std::min(done, width - done);
+        std::memcpy(dst + done, dst, len);
+        done += len;
+    }
 }
 
+}  // anonymous namespace
+
+namespace megdnn {
+namespace fallback {
+
 void TileImpl::exec(
         _megdnn_tensor_in src_, _megdnn_tensor_out dst_, _megdnn_workspace workspace) {
     check_exec(src_.layout, dst_.layout, workspace.size);
+    if (dst_.layout.is_empty()) {
+        return;
+    }
+    if (src_.layout.dtype.is_low_bit()) {
+        naive::TileForwardImpl::exec(src_, dst_, workspace);
+        return;
+    }
     TensorShape src, dst, times;
     simplify_shape(src_.layout, dst_.layout, param().times, src, dst, times);
-    auto nr_reduces = count_not_ones_in_shape(times);
-    if (nr_reduces == 0) {
-        MEGDNN_DISPATCH_CPU_KERN_OPR(std::memcpy(
-                dst_.raw_ptr(), src_.raw_ptr(), sizeof(float) * dst.total_nr_elems()));
+    if (count_not_ones_in_shape(times) == 0) {
+        copy::dispatch_segments_copy(handle(), dst_, {src_}, 1, true);
         return;
     }
 
-    auto kern = [=]() {
-        auto ndim = times.ndim;
-        WorkspaceBundle workspaces(
-                workspace.raw_ptr, {dst.total_nr_elems() * sizeof(float),
-                                    dst.total_nr_elems() * sizeof(float)});
-        auto workspace0 = static_cast<float*>(workspaces.get(0));
-        auto workspace1 = static_cast<float*>(workspaces.get(1));
-
-        float *current, *next;
-        size_t state;
-
-        init_tile_repeat_state(
-                src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0, workspace1,
-                current, next, state, nr_reduces);
-
-        for (size_t i = ndim; i > 0; --i) {
-            size_t j = i - 1;
-            if (times.shape[j] != 1) {
-                // m = sshape[0]*...*sshape[i-2]
-                auto m = std::accumulate(
-                        src.shape, src.shape + j, 1_z, SafeMultiplies<size_t>());
-                // n = sshape[i-1]*dshape[i]*...
-                auto n = std::accumulate(
-                                 dst.shape + i, dst.shape + ndim, 1_z,
-                                 SafeMultiplies<size_t>()) *
-                         src.shape[j];
-                // forward is repeat (m, n) to (m*times, n)
-                tile_or_repeat_single_axis(current, next, m, n, times[j]);
-                update_tile_repeat_state(
-                        src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0,
-                        workspace1, current, next, state, nr_reduces);
+    //! the source rows along the last axis are repeated times[last] times to
+    //! form the destination rows, which are split into chunks of CHUNK_BYTES
+    size_t elem_bytes = src_.layout.dtype.size();
+    size_t last = dst.ndim - 1;
+    size_t src_row_bytes = src.shape[last] * elem_bytes;
+    size_t dst_row_bytes = dst.shape[last] * elem_bytes;
+    size_t nr_rows = dst.total_nr_elems() / dst.shape[last];
+    size_t nr_col_blocks = div_ceil(dst_row_bytes, copy::CHUNK_BYTES);
+    size_t nr_units = nr_rows * nr_col_blocks;
+    size_t nr_bytes = nr_rows * dst_row_bytes;
+    size_t nr_tasks = copy::get_nr_tasks(handle(), nr_units, nr_bytes);
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    bool non_temporal = nr_bytes >= copy::MIN_BYTES_NON_TEMPORAL;
+    auto kern = [=](size_t task_id, size_t) {
+        auto sptr = static_cast<const uint8_t*>(src_.raw_ptr());
+        auto dptr = static_cast<uint8_t*>(dst_.raw_ptr());
+        size_t begin = task_id * units_per_task;
+        size_t end = std::min(nr_units, begin + units_per_task);
+        for (size_t unit = begin; unit < end; ++unit) {
+            size_t row = unit / nr_col_blocks;
+            size_t col = unit % nr_col_blocks * copy::CHUNK_BYTES;
+            size_t width = std::min(copy::CHUNK_BYTES, dst_row_bytes - col);
+            //! index i of a destination axis reads index i % src.shape of it
+            size_t src_row = 0, src_stride = 1;
+            for (size_t k = last, rest = row; k > 0; --k) {
+                src_row += rest % dst.shape[k - 1] % src.shape[k - 1] * src_stride;
+                rest /= dst.shape[k - 1];
+                src_stride *= src.shape[k - 1];
             }
+            tile_row_block(
+                    dptr + row * dst_row_bytes + col, sptr + src_row * src_row_bytes,
+                    src_row_bytes, col, width, non_temporal);
         }
+        copy::store_fence(non_temporal);
     };
-    MEGDNN_DISPATCH_CPU_KERN_OPR(kern());
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
 }
 
 }  // namespace fallback
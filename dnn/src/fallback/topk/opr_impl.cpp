@@ -0,0 +1,448 @@
+#include "src/fallback/topk/opr_impl.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include "src/common/utils.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/naive/handle.h"
+
+#include "midout.h"
+MIDOUT_DECL(megdnn_fallback_topk)
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+//! rows with fewer elements in total are selected in one thread
+constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 16384;
+//! long rows are split into chunks of at least this many elements, whose
+//! candidates are merged afterwards
+constexpr size_t MIN_CHUNK_LEN = 32768;
+//! the heap is used for k up to MAX_HEAP_K and at most 1 / HEAP_RATIO of n,
+//! above it most elements would pass the threshold and radix select wins
+constexpr size_t MAX_HEAP_K = 1024;
+constexpr size_t HEAP_RATIO = 16;
+//! elements whose max / min are compared to the threshold of the heap at once
+constexpr size_t FILTER_BLOCK = 4 * GI_SIMD_LEN_BYTE / sizeof(float);
+
+template <typename ctype>
+using Item = std::pair<ctype, uint32_t>;
+
+template <bool descending, typename ctype>
+inline bool better(ctype a, ctype b) {
+    return descending ? a > b : a < b;
+}
+
+//! map a value to a key whose unsigned order is the order of the values
+inline uint32_t to_ordered(float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+inline uint32_t to_ordered(int32_t v) {
+    return static_cast<uint32_t>(v) ^ 0x80000000u;
+}
+
+template <bool descending, typename ctype>
+inline uint32_t to_key(ctype v) {
+    return descending ? ~to_ordered(v) : to_ordered(v);
+}
+
+/*!
+ * whether any of the FILTER_BLOCK elements at \p ptr is better than \p thr;
+ * most blocks are rejected at once when k << n
+ */
+template <bool descending, typename ctype>
+inline bool block_has_better(const ctype* ptr, ctype thr) {
+    for (size_t i = 0; i < FILTER_BLOCK; ++i) {
+        if (better<descending>(ptr[i], thr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <bool descending>
+inline bool block_has_better(const float* ptr, float thr) {
+    constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+    GI_FLOAT32_t v0 = GiLoadFloat32(ptr);
+    GI_FLOAT32_t v1 = GiLoadFloat32(ptr + SIMD_WIDTH);
+    GI_FLOAT32_t v2 = GiLoadFloat32(ptr + SIMD_WIDTH * 2);
+    GI_FLOAT32_t v3 = GiLoadFloat32(ptr + SIMD_WIDTH * 3);
+    //! a nan reaching the reduction keeps the block, never drops a candidate
+    if (descending) {
+        GI_FLOAT32_t vmax = GiMaximumFloat32(
+                GiMaximumFloat32(v0, v1), GiMaximumFloat32(v2, v3));
+        return !(GiReduceMaxNanFloat32(vmax) <= thr);
+    } else {
+        GI_FLOAT32_t vmin = GiMinimumFloat32(
+                GiMinimumFloat32(v0, v1), GiMinimumFloat32(v2, v3));
+        return !(GiReduceMinNanFloat32(vmin) >= thr);
+    }
+}
+
+//! replace the worst item on top of the heap by \p item
+template <bool descending, typename ctype>
+void heap_replace_top(Item<ctype>* heap, size_t size, Item<ctype> item) {
+    size_t i = 0;
+    for (;;) {
+        size_t child = i * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size &&
+            better<descending>(heap[child].first, heap[child + 1].first)) {
+            ++child;
+        }
+        if (!better<descending>(item.first, heap[child].first)) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = item;
+}
+
+/*!
+ * \brief keep the k best items in a heap with the worst one on top
+ *
+ * Only the blocks holding an element better than the top are looked into.
+ */
+template <bool descending, typename ctype>
+void heap_select(const ctype* data, size_t n, size_t k, Item<ctype>* out) {
+    for (size_t i = 0; i < k; ++i) {
+        out[i] = {data[i], static_cast<uint32_t>(i)};
+    }
+    auto cmp = [](const Item<ctype>& a, const Item<ctype>& b) {
+        return better<descending>(a.first, b.first);
+    };
+    std::make_heap(out, out + k, cmp);
+    auto scan = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (better<descending>(data[i], out[0].first)) {
+                heap_replace_top<descending>(
+                        out, k, Item<ctype>{data[i], static_cast<uint32_t>(i)});
+            }
+        }
+    };
+    size_t i = k;
+    for (; i + FILTER_BLOCK <= n; i += FILTER_BLOCK) {
+        if (block_has_better<descending>(data + i, out[0].first)) {
+            scan(i, i + FILTER_BLOCK);
+        }
+    }
+    scan(i, n);
+}
+
+//! the bucket of the remain-th key, remain is made relative to the bucket
+inline size_t find_bucket(const size_t* hist, size_t& remain) {
+    size_t bucket = 0;
+    while (remain > hist[bucket]) {
+        remain -= hist[bucket];
+        ++bucket;
+    }
+    return bucket;
+}
+
+/*!
+ * \brief select the k best items by the radix of their ordered keys
+ *
+ * Every pass fixes one byte of the key of the k-th item, starting from the
+ * highest one, and the keys sharing the prefix found so far are compacted
+ * into \p keys, which must hold n keys. The items with keys below the k-th
+ * one and enough of its equals are gathered at last.
+ */
+template <bool descending, typename ctype>
+void radix_select(
+        const ctype* data, size_t n, size_t k, Item<ctype>* out, uint32_t* keys) {
+    size_t hist[256];
+    size_t remain = k;
+    memset(hist, 0, sizeof(hist));
+    for (size_t i = 0; i < n; ++i) {
+        ++hist[to_key<descending>(data[i]) >> 24];
+    }
+    uint32_t bucket = find_bucket(hist, remain);
+    uint32_t kth = bucket << 24;
+    size_t nr_keys = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t key = to_key<descending>(data[i]);
+        if ((key >> 24) == bucket) {
+            keys[nr_keys++] = key;
+        }
+    }
+    for (int shift = 16; shift >= 0; shift -= 8) {
+        memset(hist, 0, sizeof(hist));
+        for (size_t i = 0; i < nr_keys; ++i) {
+            ++hist[(keys[i] >> shift) & 0xff];
+        }
+        bucket = find_bucket(hist, remain);
+        kth |= bucket << shift;
+        if (shift) {
+            size_t nr_kept = 0;
+            for (size_t i = 0; i < nr_keys; ++i) {
+                if (((keys[i] >> shift) & 0xff) == bucket) {
+                    keys[nr_kept++] = keys[i];
+                }
+            }
+            nr_keys = nr_kept;
+        }
+    }
+    //! remain is the number of items equal to the k-th one to be taken
+    size_t nr_out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t key = to_key<descending>(data[i]);
+        if (key < kth) {
+            out[nr_out++] = {data[i], static_cast<uint32_t>(i)};
+        } else if (key == kth && remain) {
+            out[nr_out++] = {data[i], static_cast<uint32_t>(i)};
+            --remain;
+        }
+    }
+    megdnn_assert_internal(nr_out == k);
+}
+
+//! select the k best of n items into out, in no particular order
+template <bool descending, typename ctype>
+void select(const ctype* data, size_t n, size_t k, Item<ctype>* out, uint32_t* keys) {
+    if (k <= MAX_HEAP_K && k * HEAP_RATIO <= n) {
+        heap_select<descending>(data, n, k, out);
+    } else {
+        radix_select<descending>(data, n, k, out, keys);
+    }
+}
+
+//! write the selected items of a row as the mode asks
+template <bool descending, typename ctype>
+void write_row(
+        param::TopK::Mode mode, Item<ctype>* items, size_t k, ctype* values,
+        int32_t* indices) {
+    using Mode = param::TopK::Mode;
+    if (mode == Mode::KTH_ONLY) {
+        ctype kth = items[0].first;
+        for (size_t i = 1; i < k; ++i) {
+            if (better<descending>(kth, items[i].first)) {
+                kth = items[i].first;
+            }
+        }
+        values[0] = kth;
+        return;
+    }
+    //! sorted as naive does, ties are ordered by their indices
+    if (mode == Mode::VALUE_IDX_SORTED) {
+        if (descending) {
+            std::sort(items, items + k, std::greater<Item<ctype>>{});
+        } else {
+            std::sort(items, items + k, std::less<Item<ctype>>{});
+        }
+    }
+    for (size_t i = 0; i < k; ++i) {
+        values[i] = items[i].first;
+        indices[i] = items[i].second;
+    }
+}
+
+/*!
+ * The rows are distributed to the threads when there are enough of them.
+ * Otherwise long rows are split into chunks, the k best items of every
+ * chunk are selected in parallel and merged by a second selection.
+ */
+struct Plan {
+    size_t m, n, k, nr_chunks, chunk_len;
+
+    Plan(int k_, size_t m_, size_t n_, size_t nr_threads) : m{m_}, n{n_} {
+        k = std::min<size_t>(std::abs(k_), n);
+        nr_chunks = 1;
+        chunk_len = n;
+        if (nr_threads > 1 && m < nr_threads && n >= MIN_CHUNK_LEN * 2) {
+            size_t nr = std::min(n / MIN_CHUNK_LEN, div_ceil(nr_threads, m));
+            if (k * HEAP_RATIO <= n / nr) {
+                nr_chunks = nr;
+                chunk_len = div_ceil(n, nr);
+            }
+        }
+    }
+
+    //! length of the candidates of a row when it is chunked
+    size_t nr_candidates() const { return nr_chunks * k; }
+
+    size_t nr_keys() const {
+        return nr_chunks == 1 ? n : std::max(chunk_len, nr_candidates());
+    }
+
+    template <typename ctype>
+    size_t scratch_in_bytes() const {
+        return nr_keys() * sizeof(uint32_t) + k * sizeof(Item<ctype>);
+    }
+
+    template <typename ctype>
+    size_t candidates_in_bytes() const {
+        if (nr_chunks == 1) {
+            return 0;
+        }
+        return m * nr_candidates() * (sizeof(ctype) + sizeof(uint32_t));
+    }
+};
+
+}  // anonymous namespace
+
+bool TopKImpl::is_fast_usable(const TensorLayout& data) {
+    return (data.dtype.enumv() == DTypeEnum::Float32 ||
+            data.dtype.enumv() == DTypeEnum::Int32) &&
+           data.ndim == 2 && data.stride[1] == 1 &&
+           data[1] <= std::numeric_limits<uint32_t>::max();
+}
+
+size_t TopKImpl::get_nr_threads() {
+    return static_cast<naive::HandleImpl*>(handle())
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+size_t TopKImpl::get_workspace_in_bytes(
+        int k, const TensorLayout& data, const TensorLayout& values,
+        const TensorLayout& indices) {
+    if (!is_fast_usable(data)) {
+        return naive::TopKImpl::get_workspace_in_bytes(k, data, values, indices);
+    }
+    size_t nr_threads = get_nr_threads();
+    Plan plan{k, data[0], data[1], nr_threads};
+    //! float and int32 share the sizes
+    return nr_threads * plan.scratch_in_bytes<float>() +
+           plan.candidates_in_bytes<float>();
+}
+
+template <typename ctype>
+void TopKImpl::exec_fast(
+        int k, const TensorND& data, const TensorND& values, int32_t* indices,
+        const Workspace& workspace) {
+    size_t nr_threads = get_nr_threads();
+    Plan plan{k, data.layout[0], data.layout[1], nr_threads};
+    if (!plan.m || !plan.k) {
+        return;
+    }
+    bool descending = k < 0;
+    auto mode = param().mode;
+    ptrdiff_t lda = data.layout.stride[0];
+    size_t out_len = mode == Param::Mode::KTH_ONLY ? 1 : plan.k;
+    size_t scratch_size = plan.scratch_in_bytes<ctype>();
+    size_t candidates_offset = nr_threads * scratch_size;
+    auto get_scratch = [plan, scratch_size](
+                               uint8_t* ptr, size_t thread_id, uint32_t*& keys,
+                               Item<ctype>*& items) {
+        ptr += thread_id * scratch_size;
+        keys = reinterpret_cast<uint32_t*>(ptr);
+        items = reinterpret_cast<Item<ctype>*>(ptr + plan.nr_keys() * sizeof(uint32_t));
+    };
+    auto select_row = [descending](
+                              const ctype* row, size_t n, size_t k, Item<ctype>* items,
+                              uint32_t* keys) {
+        if (descending) {
+            select<true>(row, n, k, items, keys);
+        } else {
+            select<false>(row, n, k, items, keys);
+        }
+    };
+    auto write = [mode, descending](
+                         Item<ctype>* items, size_t k, ctype* values,
+                         int32_t* indices) {
+        if (descending) {
+            write_row<true>(mode, items, k, values, indices);
+        } else {
+            write_row<false>(mode, items, k, values, indices);
+        }
+    };
+
+    if (plan.nr_chunks == 1) {
+        size_t nr_tasks = plan.m * plan.n < MIN_NR_ELEMS_MULTI_THREAD
+                                ? 1
+                                : std::min(plan.m, nr_threads);
+        size_t rows_per_task = div_ceil(plan.m, nr_tasks);
+        auto kern = [=](size_t task_id, size_t thread_id) {
+            uint32_t* keys;
+            Item<ctype>* items;
+            get_scratch(workspace.ptr<uint8_t>(), thread_id, keys, items);
+            size_t row_end = std::min(plan.m, (task_id + 1) * rows_per_task);
+            for (size_t i = task_id * rows_per_task; i < row_end; ++i) {
+                select_row(data.ptr<ctype>() + i * lda, plan.n, plan.k, items, keys);
+                write(items, plan.k, values.ptr<ctype>() + i * out_len,
+                      indices ? indices + i * out_len : nullptr);
+            }
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
+        return;
+    }
+
+    //! the values of the candidates of all the rows, followed by their indices
+    size_t nr_candidates = plan.nr_candidates();
+    auto get_candidates = [=](size_t row, ctype*& cand_values, uint32_t*& cand_idx) {
+        uint8_t* ptr = workspace.ptr<uint8_t>() + candidates_offset;
+        cand_values = reinterpret_cast<ctype*>(ptr) + row * nr_candidates;
+        ptr += plan.m * nr_candidates * sizeof(ctype);
+        cand_idx = reinterpret_cast<uint32_t*>(ptr) + row * nr_candidates;
+    };
+    auto select_chunk = [=](size_t task_id, size_t thread_id) {
+        uint32_t* keys;
+        Item<ctype>* items;
+        get_scratch(workspace.ptr<uint8_t>(), thread_id, keys, items);
+        size_t row = task_id / plan.nr_chunks, chunk = task_id % plan.nr_chunks;
+        size_t begin = chunk * plan.chunk_len;
+        size_t len = std::min(plan.chunk_len, plan.n - begin);
+        megdnn_assert_internal(len >= plan.k);
+        select_row(data.ptr<ctype>() + row * lda + begin, len, plan.k, items, keys);
+        ctype* cand_values;
+        uint32_t* cand_idx;
+        get_candidates(row, cand_values, cand_idx);
+        for (size_t i = 0, j = chunk * plan.k; i < plan.k; ++i, ++j) {
+            cand_values[j] = items[i].first;
+            cand_idx[j] = items[i].second + begin;
+        }
+    };
+    auto merge_row = [=](size_t row, size_t thread_id) {
+        uint32_t* keys;
+        Item<ctype>* items;
+        get_scratch(workspace.ptr<uint8_t>(), thread_id, keys, items);
+        ctype* cand_values;
+        uint32_t* cand_idx;
+        get_candidates(row, cand_values, cand_idx);
+        select_row(cand_values, nr_candidates, plan.k, items, keys);
+        for (size_t i = 0; i < plan.k; ++i) {
+            items[i].second = cand_idx[items[i].second];
+        }
+        write(items, plan.k, values.ptr<ctype>() + row * out_len,
+              indices ? indices + row * out_len : nullptr);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(select_chunk, plan.m * plan.nr_chunks);
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(merge_row, plan.m);
+}
+
+void TopKImpl::do_exec(
+        int k, _megdnn_tensor_in data, _megdnn_tensor_out values, int32_t* indices,
+        _megdnn_workspace workspace) {
+    if (is_fast_usable(data.layout)) {
+        switch (data.layout.dtype.enumv()) {
+#define cb(dt, ct)                                                  \
+    case DTypeTrait<dt>::enumv: {                                   \
+        MIDOUT_BEGIN(megdnn_fallback_topk, midout_iv(0), ct) {      \
+            exec_fast<ct>(k, data, values, indices, workspace);     \
+            return;                                                 \
+        }                                                           \
+        MIDOUT_END();                                               \
+        break;                                                      \
+    }
+            cb(dtype::Float32, dt_float32);
+            cb(dtype::Int32, dt_int32);
+#undef cb
+            default:
+                break;
+        }
+    }
+    naive::TopKImpl::do_exec(k, data, values, indices, workspace);
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,32 @@
+#pragma once
+#include "src/naive/topk/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+class TopKImpl : public naive::TopKImpl {
+protected:
+    void do_exec(
+            int k, _megdnn_tensor_in data, _megdnn_tensor_out values, int32_t* indices,
+            _megdnn_workspace workspace) override;
+
+public:
+    using naive::TopKImpl::TopKImpl;
+
+    size_t get_workspace_in_bytes(
+            int k, const TensorLayout& data, const TensorLayout& values,
+            const TensorLayout& indices) override;
+
+private:
+    bool is_fast_usable(const TensorLayout& data);
+    size_t get_nr_threads();
+    template <typename ctype>
+    void exec_fast(
+            int k, const TensorND& data, const TensorND& values, int32_t* indices,
+            const Workspace& workspace);
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
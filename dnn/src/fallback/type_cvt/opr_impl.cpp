@@ -506,7 +506,21 @@ void TypeCvtImpl::exec(_megdnn_tensor_in src, _megdnn_tensor_out dst) {
         dst.layout.dtype.enumv() != DTypeEnum::QuantizedS1 &&
         src.layout.dtype.enumv() != DTypeEnum::QuantizedS1) {
         if (!exec_optimized(src, dst)) {
-            MEGDNN_DISPATCH_CPU_KERN_OPR(run_contiguous(src, dst));
+            //! elementwise conversion: every block is converted as a 1-dim
+            //! tensor of its own
+            DType src_dtype = src.layout.dtype, dst_dtype = dst.layout.dtype;
+            dispatch_blocks(
+                    src.layout.total_nr_elems(), [=](size_t offset, size_t nr_elems) {
+                        auto sptr = static_cast<dt_byte*>(src.raw_ptr());
+                        auto dptr = static_cast<dt_byte*>(dst.raw_ptr());
+                        TensorND src_block{
+                                sptr + src_dtype.size(offset),
+                                TensorLayout({nr_elems}, src_dtype)};
+                        TensorND dst_block{
+                                dptr + dst_dtype.size(offset),
+                                TensorLayout({nr_elems}, dst_dtype)};
+                        run_contiguous(src_block, dst_block);
+                    });
         }
     } else {
         naive::TypeCvtImpl::exec(src, dst);
@@ -519,15 +533,21 @@ bool TypeCvtImpl::exec_optimized(_megdnn_tensor_in src, _megdnn_tensor_out dst)
     bool execed = false;
     using namespace dtype;
     size_t nr_elems = src.layout.total_nr_elems();
+#define DISPATCH_TYPECVT(_TypeCvter, _stype, _dtype)                         \
+    dispatch_blocks(nr_elems, [=](size_t offset, size_t nr_elems_block) {    \
+        do_typecvt<_TypeCvter>(                                              \
+                src.compatible_ptr<_stype>() + offset,                       \
+                dst.compatible_ptr<_dtype>() + offset, src_dtype, dst_dtype, \
+                nr_elems_block);                                             \
+    });                                                                      \
+    execed = true
+
 #define DISPATCH_QUANTIZED(_stype_enumv, _stype, _dtype_enumv, _dtype, _midout_iv) \
     if (src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&                    \
         dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                    \
         MIDOUT_BEGIN(megdnn_fb_typecvt_optimized, midout_iv(_midout_iv)) {         \
             using _TypeCvter = QuantizedTypeCvter<_stype, _dtype>;                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_typecvt<_TypeCvter>(                   \
-                    src.compatible_ptr<_stype>(), dst.compatible_ptr<_dtype>(),    \
-                    src_dtype, dst_dtype, nr_elems));                              \
-            execed = true;                                                         \
+            DISPATCH_TYPECVT(_TypeCvter, _stype, _dtype);                          \
         }                                                                          \
         MIDOUT_END();                                                              \
     }
@@ -536,6 +556,7 @@ bool TypeCvtImpl::exec_optimized(_megdnn_tensor_in src, _megdnn_tensor_out dst)
     DISPATCH_QUANTIZED(QuantizedS8, int8_t, QuantizedS8, int8_t, 3);
     DISPATCH_QUANTIZED(QuantizedS32, int32_t, QuantizedS32, int32_t, 4);
     DISPATCH_QUANTIZED(float, float, QuantizedS8, int8_t, 5);
+    DISPATCH_QUANTIZED(float, float, Quantized8Asymm, uint8_t, 9);
 #undef DISPATCH_QUANTIZED
 
 #define DISPATCH_FIX2FLOAT(_stype_enumv, _stype, _dtype_enumv, _dtype, _midout_iv) \
@@ -543,27 +564,28 @@ bool TypeCvtImpl::exec_optimized(_megdnn_tensor_in src, _megdnn_tensor_out dst)
         dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                    \
         MIDOUT_BEGIN(megdnn_fb_typecvt_optimized, midout_iv(_midout_iv)) {         \
             using _TypeCvter = Fix2FloatTypeCvter<_stype, _dtype>;                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_typecvt<_TypeCvter>(                   \
-                    src.compatible_ptr<_stype>(), dst.compatible_ptr<_dtype>(),    \
-                    src_dtype, dst_dtype, src.layout.total_nr_elems()));           \
-            execed = true;                                                         \
+            DISPATCH_TYPECVT(_TypeCvter, _stype, _dtype);                          \
         }                                                                          \
         MIDOUT_END();                                                              \
     }
     DISPATCH_FIX2FLOAT(Int16, int16_t, Float32, float, 6);
     DISPATCH_FIX2FLOAT(Int8, int8_t, Float32, float, 7);
-
-    if (src_dtype.enumv() == DTypeTrait<QuantizedS8>::enumv &&
-        dst_dtype.enumv() == DTypeTrait<Float32>::enumv) {
-        MIDOUT_BEGIN(megdnn_fb_typecvt_optimized, midout_iv(8)) {
-            using TypeCvter = Quan2FloatTypeCvter<int8_t, float>;
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_typecvt<TypeCvter>(
-                    src.compatible_ptr<int8_t>(), dst.compatible_ptr<float>(),
-                    src_dtype, dst_dtype, src.layout.total_nr_elems()));
-            execed = true;
-        }
-        MIDOUT_END();
-    }
+#undef DISPATCH_FIX2FLOAT
+
+#define DISPATCH_QUAN2FLOAT(_stype_enumv, _stype, _dtype_enumv, _dtype, _midout_iv) \
+    if (src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&                     \
+        dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                     \
+        MIDOUT_BEGIN(megdnn_fb_typecvt_optimized, midout_iv(_midout_iv)) {          \
+            using _TypeCvter = Quan2FloatTypeCvter<_stype, _dtype>;                 \
+            DISPATCH_TYPECVT(_TypeCvter, _stype, _dtype);                           \
+        }                                                                           \
+        MIDOUT_END();                                                               \
+    }
+    DISPATCH_QUAN2FLOAT(QuantizedS8, int8_t, Float32, float, 8);
+    DISPATCH_QUAN2FLOAT(Quantized8Asymm, uint8_t, Float32, float, 10);
+    DISPATCH_QUAN2FLOAT(QuantizedS32, int32_t, Float32, float, 11);
+#undef DISPATCH_QUAN2FLOAT
+#undef DISPATCH_TYPECVT
     return execed;
 }
 
@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
 #include "src/naive/type_cvt/opr_impl.h"
 
 namespace megdnn {
@@ -11,6 +14,37 @@ public:
     using naive::TypeCvtImpl::TypeCvtImpl;
     void exec(_megdnn_tensor_in src, _megdnn_tensor_out dst) override;
     bool is_thread_safe() const override { return true; }
+
+protected:
+    //! elements of a block are a multiple of this, so that blocks start on a
+    //! cache line and every SIMD kernel only sees a remainder at the very end
+    static constexpr size_t BLOCK_ALIGN = 64;
+    //! conversions of fewer elements are executed in one thread
+    static constexpr size_t MIN_NR_ELEMS_MULTI_THREAD = 32768;
+
+    /*!
+     * \brief split nr_elems contiguous elements into one block per thread and
+     * dispatch kern(offset, nr_elems_of_block) on the thread pool
+     */
+    template <typename Kern>
+    void dispatch_blocks(size_t nr_elems, Kern kern) {
+        if (!nr_elems) {
+            return;
+        }
+        size_t nr_tasks = 1;
+        if (nr_elems >= MIN_NR_ELEMS_MULTI_THREAD) {
+            nr_tasks = static_cast<naive::HandleImpl*>(handle())
+                               ->megcore_dispatcher()
+                               ->nr_threads();
+        }
+        size_t block = round_up(div_ceil(nr_elems, nr_tasks), BLOCK_ALIGN);
+        nr_tasks = div_ceil(nr_elems, block);
+        auto run = [=](size_t task_id, size_t) {
+            size_t offset = task_id * block;
+            kern(offset, std::min(block, nr_elems - offset));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, nr_tasks);
+    }
 };
 
 }  // namespace fallback
@@ -194,6 +194,51 @@ struct QuantizedTypeCvter<int8_t, int8_t> {
     }
 };
 
+template <>
+struct QuantizedTypeCvter<float, uint8_t> {
+    using stype = float;
+    using dst_type = uint8_t;
+    static constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(uint8_t);
+    static constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+    float scale;
+    uint8_t zp;
+    GI_FLOAT32_FIXLEN_t vscale, vlower, vupper;
+    GI_INT32_FIXLEN_t vzp;
+
+    QuantizedTypeCvter(DType src_dtype, DType dst_dtype) {
+        MEGDNN_MARK_USED_VAR(src_dtype);
+        scale = 1.f / dst_dtype.param<dtype::Quantized8Asymm>().scale;
+        zp = dst_dtype.param<dtype::Quantized8Asymm>().zero_point;
+        vscale = GiFloat32Type2FixLenType(GiBroadcastFloat32(scale));
+        //! clamping before rounding keeps the int32 conversion in range
+        vlower = GiFloat32Type2FixLenType(GiBroadcastFloat32(-float(zp)));
+        vupper = GiFloat32Type2FixLenType(GiBroadcastFloat32(255.f - zp));
+        vzp = GiInt32Type2FixLenType(GiBroadcastInt32(zp));
+    }
+
+    GI_INT32_t quantize(const float* src) {
+        GI_FLOAT32_t vitem = GiMultiplyFloat32(
+                GiLoadFloat32(src), GiFixLenType2GiFloat32Type(vscale));
+        vitem = GiMaximumFloat32(vitem, GiFixLenType2GiFloat32Type(vlower));
+        vitem = GiMinimumFloat32(vitem, GiFixLenType2GiFloat32Type(vupper));
+        return GiAddInt32(
+                QConverter::round<GI_INT32_t, GI_FLOAT32_t>(vitem),
+                GiFixLenType2GiInt32Type(vzp));
+    }
+
+    void cvt(const float* src, uint8_t* dst) {
+        GI_INT32_t vret0 = quantize(src);
+        GI_INT32_t vret1 = quantize(src + SIMD_STEP);
+        GI_INT32_t vret2 = quantize(src + 2 * SIMD_STEP);
+        GI_INT32_t vret3 = quantize(src + 3 * SIMD_STEP);
+        GiStoreUint8(dst, GiCvtFromInt32V4ToUint8(vret0, vret1, vret2, vret3));
+    }
+
+    void cvt_remain(const float* src, uint8_t* dst) {
+        *dst = saturate<uint8_t, float>(std::round(*src * scale) + zp, 0.f, 255.f);
+    }
+};
+
 template <typename ctype, typename dtype>
 struct Fix2FloatTypeCvter;
 
@@ -286,6 +331,66 @@ struct Quan2FloatTypeCvter<int8_t, float> {
     void cvt_remain(const int8_t* src, float* dst) { *dst = *src * _scale; }
 };
 
+template <>
+struct Quan2FloatTypeCvter<uint8_t, float> {
+    using stype = uint8_t;
+    using dst_type = float;
+    static constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(uint8_t);
+    static constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+    float _scale = 0.0f;
+    uint8_t _zp = 0;
+    GI_FLOAT32_FIXLEN_t vscale;
+    GI_INT32_FIXLEN_t vzp;
+
+    Quan2FloatTypeCvter(DType src_dtype, DType dst_dtype) {
+        _scale = src_dtype.param<dtype::Quantized8Asymm>().scale;
+        _zp = src_dtype.param<dtype::Quantized8Asymm>().zero_point;
+        vscale = GiFloat32Type2FixLenType(GiBroadcastFloat32(_scale));
+        vzp = GiInt32Type2FixLenType(GiBroadcastInt32(_zp));
+        MEGDNN_MARK_USED_VAR(dst_dtype);
+    }
+
+    GI_FLOAT32_t dequantize(GI_INT32_t vsrc) {
+        return GiMultiplyFloat32(
+                GiCastToFloat32(GiSubtractInt32(vsrc, GiFixLenType2GiInt32Type(vzp))),
+                GiFixLenType2GiFloat32Type(vscale));
+    }
+
+    void cvt(const uint8_t* src, float* dst) {
+        GI_UINT8_t data = GiLoadUint8(src);
+        GI_INT16_t vitem0 = GiCvtUint8toInt16Low(data);
+        GI_INT16_t vitem1 = GiCvtUint8toInt16High(data);
+        GiStoreFloat32(dst, dequantize(GiMoveLowLongInt16(vitem0)));
+        GiStoreFloat32(dst + SIMD_STEP, dequantize(GiMoveHighLongInt16(vitem0)));
+        GiStoreFloat32(dst + 2 * SIMD_STEP, dequantize(GiMoveLowLongInt16(vitem1)));
+        GiStoreFloat32(dst + 3 * SIMD_STEP, dequantize(GiMoveHighLongInt16(vitem1)));
+    }
+    void cvt_remain(const uint8_t* src, float* dst) { *dst = (*src - _zp) * _scale; }
+};
+
+template <>
+struct Quan2FloatTypeCvter<int32_t, float> {
+    using stype = int32_t;
+    using dst_type = float;
+    static constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(int32_t);
+    float _scale = 0.0f;
+    GI_FLOAT32_FIXLEN_t vscale;
+
+    Quan2FloatTypeCvter(DType src_dtype, DType dst_dtype) {
+        _scale = src_dtype.param<dtype::QuantizedS32>().scale;
+        vscale = GiFloat32Type2FixLenType(GiBroadcastFloat32(_scale));
+        MEGDNN_MARK_USED_VAR(dst_dtype);
+    }
+
+    void cvt(const int32_t* src, float* dst) {
+        GiStoreFloat32(
+                dst, GiMultiplyFloat32(
+                             GiCastToFloat32(GiLoadInt32(src)),
+                             GiFixLenType2GiFloat32Type(vscale)));
+    }
+    void cvt_remain(const int32_t* src, float* dst) { *dst = *src * _scale; }
+};
+
 template <typename TypeCvter>
 void do_typecvt(
         const typename TypeCvter::stype* src, typename TypeCvter::dst_type* dst,
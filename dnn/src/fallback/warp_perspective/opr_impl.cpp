@@ -35,20 +35,29 @@ WorkspaceBundle get_bundle(size_t OH, size_t OW) {
     return bundle;
 }
 
+//! source offsets of the four neighbours and the two alphas of an output pixel
+size_t get_rows_table_in_bytes(size_t OW) {
+    return (sizeof(ptrdiff_t) * 4 + sizeof(float) * 2) * OW;
+}
+
 }  // anonymous namespace
 
 namespace megdnn {
 namespace fallback {
 
 size_t WarpPerspectiveImpl::get_workspace_in_bytes(
-        const TensorLayout&, const TensorLayout&, const TensorLayout&,
+        const TensorLayout& src, const TensorLayout& mat, const TensorLayout&,
         const TensorLayout& dst) {
+    size_t ws = 0;
     if (param().format == param::WarpPerspective::Format::NCHW) {
         size_t OH = dst.shape[2], OW = dst.shape[3];
-        return get_bundle(OH, OW).total_size_in_bytes();
-    } else {
-        return 0;
+        ws = get_bundle(OH, OW).total_size_in_bytes();
+    }
+    if (is_rows_usable(src, mat, dst)) {
+        size_t OW = dst.shape[3];
+        ws = std::max(ws, get_nr_threads() * get_rows_table_in_bytes(OW));
     }
+    return ws;
 }
 
 size_t WarpPerspectiveImpl::get_workspace_in_bytes(
@@ -112,7 +121,13 @@ void WarpPerspectiveImpl::exec(
     //! When single thread, it will optimize when resize is usable
     //! When multi threads, it can't use the resize optimizaion, because
     //! not all N can use resize optimizaion, so it can't use the same
-    //! logic in parallel in all N, so it will go to naive
+    //! logic in parallel in all N, so it will go to the row kernel
+    bool is_fusion_dtype = src.layout.dtype.enumv() != dst.layout.dtype.enumv();
+    if ((nr_threads > 1_z || is_fusion_dtype) &&
+        is_rows_usable(src.layout, mat.layout, dst.layout)) {
+        exec_rows(src, mat, mat_idx, dst, workspace);
+        return;
+    }
     if (param().format == Format::NCHW && nr_threads == 1_z) {
 #define cb(dt, ct, mct)                                                               \
     case DTypeTrait<dt>::enumv: {                                                     \
@@ -432,6 +447,176 @@ void WarpPerspectiveImpl::kern_resize(const KernParam<ctype, mtype>& kern_param)
     }
 }
 
+bool WarpPerspectiveImpl::is_rows_usable(
+        const TensorLayout& src, const TensorLayout& mat, const TensorLayout& dst) {
+    if (param().imode != InterpolationMode::LINEAR ||
+        mat.dtype.enumv() != DTypeEnum::Float32 || !src.is_contiguous() ||
+        !dst.is_contiguous()) {
+        return false;
+    }
+    auto src_type = src.dtype.enumv(), dst_type = dst.dtype.enumv();
+    bool is_u8_in =
+            src_type == DTypeEnum::Uint8 || src_type == DTypeEnum::Quantized8Asymm;
+    if (is_u8_in && dst_type == DTypeEnum::Float32) {
+        return param().format == Format::NCHW || param().format == Format::NHWC_NCHW;
+    }
+    return param().format == Format::NCHW && src_type == dst_type &&
+           (is_u8_in || src_type == DTypeEnum::Float32 ||
+            src_type == DTypeEnum::Int8 || src_type == DTypeEnum::QuantizedS8);
+}
+
+size_t WarpPerspectiveImpl::get_nr_threads() {
+    return static_cast<naive::HandleImpl*>(handle())
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+void WarpPerspectiveImpl::exec_rows(
+        _megdnn_tensor_in src, _megdnn_tensor_in mat, _megdnn_tensor_in mat_idx,
+        _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    size_t nr_rows = dst.layout[0] * dst.layout[2];
+    if (!nr_rows) {
+        return;
+    }
+    size_t nr_tasks = std::min(nr_rows, get_nr_threads());
+    size_t rows_per_task = div_ceil(nr_rows, nr_tasks);
+    size_t table_size = get_rows_table_in_bytes(dst.layout[3]);
+    bool is_border_constant = param().bmode == BorderMode::CONSTANT;
+#define cb(dt, ct, dst_dt, dst_ct)                                                    \
+    if (src.layout.dtype.enumv() == DTypeTrait<dt>::enumv &&                          \
+        dst.layout.dtype.enumv() == DTypeTrait<dst_dt>::enumv) {                      \
+        auto kparam = KernParam<ct, float>::from_tensors(                             \
+                param().format, param().bmode, param().border_val, src, mat, mat_idx, \
+                dst, workspace);                                                      \
+        MIDOUT_BEGIN(megdnn_fallback_warpperspective, midout_iv(3), ct, dst_ct) {     \
+            auto run = [kparam, this, nr_rows, rows_per_task, table_size,             \
+                        is_border_constant](size_t task_id, size_t thread_id) {       \
+                size_t row_begin = task_id * rows_per_task;                           \
+                size_t row_end = std::min(nr_rows, row_begin + rows_per_task);        \
+                void* table = kparam.workspace.raw_ptr + thread_id * table_size;      \
+                if (is_border_constant) {                                             \
+                    kern_rows<true, ct, dst_ct>(kparam, row_begin, row_end, table);   \
+                } else {                                                              \
+                    kern_rows<false, ct, dst_ct>(kparam, row_begin, row_end, table);  \
+                }                                                                     \
+            };                                                                        \
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, nr_tasks);                 \
+            return;                                                                   \
+        }                                                                             \
+        MIDOUT_END();                                                                 \
+    }
+    cb(dtype::Float32, float, dtype::Float32, float);
+    cb(dtype::Int8, int8_t, dtype::Int8, int8_t);
+    cb(dtype::QuantizedS8, int8_t, dtype::QuantizedS8, int8_t);
+    cb(dtype::Uint8, uint8_t, dtype::Uint8, uint8_t);
+    cb(dtype::Quantized8Asymm, uint8_t, dtype::Quantized8Asymm, uint8_t);
+    cb(dtype::Uint8, uint8_t, dtype::Float32, float);
+    cb(dtype::Quantized8Asymm, uint8_t, dtype::Float32, float);
+#undef cb
+    megdnn_throw(ssprintf(
+                         "Unsupported DType in WarpPerspective row kernel: %s -> %s",
+                         src.layout.dtype.name(), dst.layout.dtype.name())
+                         .c_str());
+}
+
+/*!
+ * The coordinates of an output row are computed once as naive does and shared
+ * by all the channels, which are then written one contiguous row at a time.
+ * u8 inputs with float outputs are converted as kern_naive_dimshuffle_typecvt.
+ */
+template <bool is_border_constant, typename ctype, typename dst_ctype>
+void WarpPerspectiveImpl::kern_rows(
+        const KernParam<ctype, float>& kern_param, size_t row_begin, size_t row_end,
+        void* table) {
+    using mtype = float;
+    UNPACK_WARP_PERSPECTIVE_FWD_KERN_PARAM(kern_param);
+    MEGDNN_MARK_USED_VAR(N_MAT);
+    MEGDNN_MARK_USED_VAR(bmode);
+    MEGDNN_MARK_USED_VAR(sptrs);
+    bool is_src_nhwc = kern_param.format == Format::NHWC_NCHW;
+    size_t sstrd_c = is_src_nhwc ? 1 : IH * IW;
+    size_t sstrd_h = is_src_nhwc ? IW * C : IW;
+    size_t sstrd_w = is_src_nhwc ? C : 1;
+    constexpr bool is_typecvt = !std::is_same<ctype, dst_ctype>::value;
+    float zero_point = 0.f, scale = 1.f;
+    if (kern_param.src_dtype.enumv() == DTypeEnum::Quantized8Asymm) {
+        auto dtype_param =
+                kern_param.src_dtype.template param<dtype::Quantized8Asymm>();
+        zero_point = dtype_param.zero_point;
+        scale = dtype_param.scale;
+    }
+    MEGDNN_MARK_USED_VAR(zero_point);
+    MEGDNN_MARK_USED_VAR(scale);
+
+    ptrdiff_t* tab_offset = static_cast<ptrdiff_t*>(table);
+    float* tab_alpha = reinterpret_cast<float*>(tab_offset + 4 * OW);
+    auto dst = reinterpret_cast<dst_ctype*>(dptr);
+    rounding::RoundingConverter<dst_ctype> output_converter;
+    auto get_offset = [&](int h, int w) -> ptrdiff_t {
+        if (h == -1 || w == -1) {
+            return -1;
+        }
+        return static_cast<ptrdiff_t>(h * sstrd_h + w * sstrd_w);
+    };
+    for (size_t row = row_begin; row < row_end; ++row) {
+        size_t n = row / OH, oh = row % OH;
+        const mtype* mat = mptr + n * 3 * 3;
+        const ctype* src = sptr;
+        if (midx_ptr) {
+            size_t idx = midx_ptr[n];
+            megdnn_assert(
+                    idx < N_SRC, "mat_idx out of bound: mat_idx[%zu]=%zu src_batch=%zu",
+                    n, idx, N_SRC);
+            src += idx * C * IH * IW;
+        } else {
+            src += n * C * IH * IW;
+        }
+        for (size_t ow = 0; ow < OW; ++ow) {
+            float numeratorw = mat[0] * ow + mat[1] * oh + mat[2];
+            float numeratorh = mat[3] * ow + mat[4] * oh + mat[5];
+            float denominator = mat[6] * ow + mat[7] * oh + mat[8];
+            float alphaw = numeratorw / denominator;
+            float alphah = numeratorh / denominator;
+
+            int iw0 = get_real_coord(std::floor(alphaw) + 0, IW);
+            int iw1 = get_real_coord(std::floor(alphaw) + 1, IW);
+            int ih0 = get_real_coord(std::floor(alphah) + 0, IH);
+            int ih1 = get_real_coord(std::floor(alphah) + 1, IH);
+
+            ptrdiff_t* offset = tab_offset + ow * 4;
+            offset[0] = get_offset(ih0, iw0);
+            offset[1] = get_offset(ih0, iw1);
+            offset[2] = get_offset(ih1, iw0);
+            offset[3] = get_offset(ih1, iw1);
+            tab_alpha[ow * 2] = alphaw - std::floor(alphaw);
+            tab_alpha[ow * 2 + 1] = alphah - std::floor(alphah);
+        }
+        for (size_t c = 0; c < C; ++c) {
+            const ctype* psrc = src + c * sstrd_c;
+            dst_ctype* pdst = dst + (n * C + c) * OH * OW + oh * OW;
+            auto visit_src = [psrc, border_val](ptrdiff_t offset) -> float {
+                return (is_border_constant && offset < 0) ? border_val : psrc[offset];
+            };
+            for (size_t ow = 0; ow < OW; ++ow) {
+                const ptrdiff_t* offset = tab_offset + ow * 4;
+                float alphaw = tab_alpha[ow * 2], alphah = tab_alpha[ow * 2 + 1];
+                float val = visit_src(offset[0]) * (1.0f - alphaw) * (1.0f - alphah) +
+                            visit_src(offset[1]) * alphaw * (1.0f - alphah) +
+                            visit_src(offset[2]) * (1.0f - alphaw) * alphah +
+                            visit_src(offset[3]) * alphaw * alphah;
+                if (is_border_constant) {
+                    // nan check
+                    val = std::isfinite(val) ? val : border_val;
+                }
+                if (is_typecvt) {
+                    val = (val - zero_point) * scale;
+                }
+                pdst[ow] = output_converter(val);
+            }
+        }
+    }
+}
+
 }  // namespace fallback
 }  // namespace megdnn
 
@@ -33,6 +33,18 @@ private:
     bool is_resize_optimizable(ctype* mat);
     template <bool is_border_constant, typename ctype, typename mtype>
     void kern_resize(const KernParam<ctype, mtype>& kern_param);
+
+    //! whether the linear row kernel, which also fuses u8 -> f32, is usable
+    bool is_rows_usable(
+            const TensorLayout& src, const TensorLayout& mat, const TensorLayout& dst);
+    size_t get_nr_threads();
+    void exec_rows(
+            _megdnn_tensor_in src, _megdnn_tensor_in mat, _megdnn_tensor_in mat_idx,
+            _megdnn_tensor_out dst, _megdnn_workspace workspace);
+    template <bool is_border_constant, typename ctype, typename dst_ctype>
+    void kern_rows(
+            const KernParam<ctype, float>& kern_param, size_t row_begin,
+            size_t row_end, void* table);
 };
 
 }  // namespace fallback
@@ -12,25 +12,33 @@ namespace {
 
 using Param = megdnn::Dropout::Param;
 
-dt_float32 get_random_number(uint64_t x) {
+//! number of elements handled by each task of the forward opr; a multiple of
+//! four so that no Philox block is shared by two tasks
+constexpr size_t NR_ELEMS_PER_TASK = 16384;
+
+dt_float32 get_random_number(uint32_t x) {
     union {
         uint32_t i;
         dt_float32 f;
     } u;
-    u.i = (0x7F << 23) | (x >> 41);
+    u.i = (0x7F << 23) | (x >> 9);
     return 2 - u.f;
 }
 
 template <typename T>
 void forward(
-        T* inp, T* oup, void* raw_reserved, size_t len, Xoroshiro128plus& rng,
-        float drop_prob) {
+        T* inp, T* oup, void* raw_reserved, size_t begin, size_t end, Philox4x32 rng,
+        uint64_t offset, float drop_prob) {
     uint8_t* reserved = reinterpret_cast<uint8_t*>(raw_reserved);
     float scale = 1.0f / (1.0f - drop_prob);
-    for (size_t i = 0; i < len; ++i) {
-        float rn = get_random_number(rng());
-        reserved[i] = rn < drop_prob ? 0 : 1;
-        oup[i] = static_cast<T>(reserved[i] ? static_cast<float>(inp[i]) * scale : 0.f);
+    for (size_t i = begin; i < end; i += 4) {
+        auto block = rng(offset, i / 4);
+        for (size_t j = 0; j < 4 && i + j < end; ++j) {
+            float rn = get_random_number(block.v[j]);
+            reserved[i + j] = rn < drop_prob ? 0 : 1;
+            oup[i + j] = static_cast<T>(
+                    reserved[i + j] ? static_cast<float>(inp[i + j]) * scale : 0.f);
+        }
     }
 }
 
@@ -62,14 +70,23 @@ void DropoutForwardImpl::exec(
     uint64_t seed = param().seed;
     float prob = param().drop_prob;
 
-    m_rng.ensure_seed(seed);
+    auto rng = m_rng.ensure_seed(seed).generator();
+    auto offset = m_rng.next_offset();
+    // the mask only depends on (seed, offset), whatever the number of threads
+    size_t nr_tasks = std::max<size_t>(div_ceil(length, NR_ELEMS_PER_TASK), 1);
 
-#define cb(DType)                                                                  \
-    if (inp.layout.dtype == DType()) {                                             \
-        using T = typename DTypeTrait<DType>::ctype;                               \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(forward<T>(                                   \
-                inp.ptr<T>(), oup.ptr<T>(), mask.raw_ptr(), length, m_rng, prob)); \
-        return;                                                                    \
+#define cb(DType)                                                           \
+    if (inp.layout.dtype == DType()) {                                      \
+        using T = typename DTypeTrait<DType>::ctype;                        \
+        auto kern = [=](size_t task_id, size_t) {                           \
+            size_t begin = task_id * NR_ELEMS_PER_TASK;                     \
+            size_t end = std::min(begin + NR_ELEMS_PER_TASK, length);       \
+            forward<T>(                                                     \
+                    inp.ptr<T>(), oup.ptr<T>(), mask.raw_ptr(), begin, end, \
+                    rng, offset, prob);                                     \
+        };                                                                  \
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);          \
+        return;                                                             \
     }
     MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
 #undef cb
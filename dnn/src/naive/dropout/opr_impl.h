@@ -5,8 +5,8 @@
 namespace megdnn {
 namespace naive {
 
-class DropoutForwardImpl final : public DropoutForward {
-    Xoroshiro128plus m_rng;
+class DropoutForwardImpl final : public DropoutForward, public CounterBasedRNG {
+    PhiloxState m_rng;
 
 public:
     using DropoutForward::DropoutForward;
@@ -18,6 +18,9 @@ public:
             const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
         return 0;
     }
+
+    uint64_t offset() const override { return m_rng.offset(); }
+    void set_offset(uint64_t offset) override { m_rng.set_offset(offset); }
 };
 
 class DropoutBackwardImpl final : public DropoutBackward {
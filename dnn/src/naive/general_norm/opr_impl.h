@@ -4,7 +4,7 @@
 namespace megdnn {
 namespace naive {
 
-class GeneralNormForwardImpl final : public GeneralNormForward {
+class GeneralNormForwardImpl : public GeneralNormForward {
 public:
     using GeneralNormForward::GeneralNormForward;
     void exec(
@@ -11,7 +11,7 @@
 namespace megdnn {
 namespace naive {
 
-class MultiHeadAttnForwardImpl final : public MultiHeadAttnForward {
+class MultiHeadAttnForwardImpl : public MultiHeadAttnForward {
 public:
     using MultiHeadAttnForward::MultiHeadAttnForward;
     MHAForwardProxyOpr proxy_opr;
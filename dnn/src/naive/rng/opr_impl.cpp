@@ -47,10 +47,77 @@ dt_bfloat16 uniform_int2float(uint64_t x) {
 }
 #endif
 
+//! number of elements filled by each task of the Philox based oprs; a multiple
+//! of four so that no Philox block is shared by two tasks
+constexpr size_t PHILOX_NR_ELEMS_PER_TASK = 16384;
+
 template <typename ctype>
-void fill_uniform(Xoroshiro128plus* rng, ctype* dst, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
-        dst[i] = uniform_int2float<ctype>((*rng)());
+ctype philox_uniform(uint32_t x) {
+    return uniform_int2float<ctype>(static_cast<uint64_t>(x) << 32);
+}
+
+/*!
+ * \brief split \p size elements into tasks and run \p fill(begin, end) for
+ *      each of them on the thread pool of \p handle
+ *
+ * Element i is always generated from word i % 4 of Philox block i / 4, so the
+ * output does not depend on how the tasks are scheduled.
+ */
+template <typename Fill>
+void dispatch_philox(HandleImpl* handle, size_t size, Fill fill) {
+    size_t nr_tasks =
+            std::max<size_t>(div_ceil(size, PHILOX_NR_ELEMS_PER_TASK), 1);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * PHILOX_NR_ELEMS_PER_TASK;
+        fill(begin, std::min(begin + PHILOX_NR_ELEMS_PER_TASK, size));
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, nr_tasks, kern);
+}
+
+template <typename ctype>
+void fill_uniform(
+        Philox4x32 rng, uint64_t offset, ctype* dst, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i += 4) {
+        auto block = rng(offset, i / 4);
+        for (size_t j = 0; j < 4 && i + j < end; ++j) {
+            dst[i + j] = philox_uniform<ctype>(block.v[j]);
+        }
+    }
+}
+
+template <typename ctype>
+void fill_gaussian(
+        Philox4x32 rng, uint64_t offset, ctype* dst, size_t begin, size_t end,
+        float mean, float stddev) {
+    // gen gaussian by Box-Muller transform, two pairs per Philox block
+    for (size_t i = begin; i < end; i += 4) {
+        auto block = rng(offset, i / 4);
+        float z[4];
+        for (size_t j = 0; j < 4; j += 2) {
+            float u1 = philox_uniform<float>(block.v[j]),
+                  u2 = philox_uniform<float>(block.v[j + 1]),
+                  r = stddev * std::sqrt(-2 * std::log(u1)),
+                  theta = static_cast<float>(2 * M_PI) * u2;
+            z[j] = r * std::cos(theta) + mean;
+            z[j + 1] = r * std::sin(theta) + mean;
+        }
+        for (size_t j = 0; j < 4 && i + j < end; ++j) {
+            dst[i + j] = ctype(z[j]);
+        }
+    }
+}
+
+template <typename T, typename U>
+void fill_exponential(
+        Philox4x32 rng, uint64_t offset, U* dst, const U* rate, size_t begin,
+        size_t end) {
+    for (size_t i = begin; i < end; i += 4) {
+        auto block = rng(offset, i / 4);
+        for (size_t j = 0; j < 4 && i + j < end; ++j) {
+            T r = static_cast<T>(rate[i + j]);
+            T u = philox_uniform<T>(block.v[j]);
+            dst[i + j] = static_cast<U>(-std::log(u) / r);
+        }
     }
 }
 
@@ -278,15 +345,6 @@ void fill_permutation(Xoroshiro128plus* rng, T* dst, size_t size) {
     }
 }
 
-template <typename T, typename U>
-void fill_exponential(Xoroshiro128plus* rng, U* dst, U* rate, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
-        T r = static_cast<T>(rate[i]);
-        T u = uniform_sample<T>(rng);
-        dst[i] = static_cast<U>(-std::log(u) / r);
-    }
-}
-
 template <typename T>
 void shuffle_fwd(
         const T* __restrict sptr, T* __restrict dptr, const dt_int32* iptr,
@@ -340,13 +398,17 @@ uint64_t Xoroshiro128plus::operator()() {
 void UniformRNGImpl::exec(_megdnn_tensor_inout dst, _megdnn_workspace workspace) {
     check_exec(dst.layout, workspace.size);
     auto size = dst.layout.total_nr_elems();
-    auto prng = &m_rng.ensure_seed(m_param.seed);
+    auto rng = m_rng.ensure_seed(m_param.seed).generator();
+    auto offset = m_rng.next_offset();
+    auto handle = static_cast<HandleImpl*>(this->handle());
     switch (dst.layout.dtype.enumv()) {
-#define cb(_dt)                                                                        \
-    case DTypeTrait<_dt>::enumv: {                                                     \
-        using ctype = DTypeTrait<_dt>::ctype;                                          \
-        MEGDNN_DISPATCH_CPU_KERN_OPR({ fill_uniform(prng, dst.ptr<ctype>(), size); }); \
-        return;                                                                        \
+#define cb(_dt)                                                       \
+    case DTypeTrait<_dt>::enumv: {                                    \
+        using ctype = DTypeTrait<_dt>::ctype;                         \
+        dispatch_philox(handle, size, [=](size_t begin, size_t end) { \
+            fill_uniform(rng, offset, dst.ptr<ctype>(), begin, end);  \
+        });                                                           \
+        return;                                                       \
     }
         MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
 #undef cb
@@ -358,15 +420,18 @@ void UniformRNGImpl::exec(_megdnn_tensor_inout dst, _megdnn_workspace workspace)
 void GaussianRNGImpl::exec(_megdnn_tensor_inout dst, _megdnn_workspace workspace) {
     check_exec(dst.layout, workspace.size);
     auto size = dst.layout.total_nr_elems();
-    auto prng = &m_rng.ensure_seed(m_param.seed);
+    auto rng = m_rng.ensure_seed(m_param.seed).generator();
+    auto offset = m_rng.next_offset();
+    auto handle = static_cast<HandleImpl*>(this->handle());
+    float mean = m_param.mean, std = m_param.std;
     switch (dst.layout.dtype.enumv()) {
-#define cb(_dt)                                                                      \
-    case DTypeTrait<_dt>::enumv: {                                                   \
-        using ctype = DTypeTrait<_dt>::ctype;                                        \
-        ctype mean(m_param.mean), std(m_param.std);                                  \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                                \
-                { fill_gaussian<ctype>(prng, dst.ptr<ctype>(), size, mean, std); }); \
-        return;                                                                      \
+#define cb(_dt)                                                                  \
+    case DTypeTrait<_dt>::enumv: {                                               \
+        using ctype = DTypeTrait<_dt>::ctype;                                    \
+        dispatch_philox(handle, size, [=](size_t begin, size_t end) {            \
+            fill_gaussian(rng, offset, dst.ptr<ctype>(), begin, end, mean, std); \
+        });                                                                      \
+        return;                                                                  \
     }
         MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
 #undef cb
@@ -548,15 +613,19 @@ void ExponentialRNGImpl::exec(
         _megdnn_tensor_in rate, _megdnn_tensor_inout dst, _megdnn_workspace workspace) {
     check_exec(rate.layout, dst.layout, workspace.size);
     auto size = dst.layout.total_nr_elems();
-    auto prng = &m_rng.ensure_seed(m_param.seed);
+    auto rng = m_rng.ensure_seed(m_param.seed).generator();
+    auto offset = m_rng.next_offset();
+    auto handle = static_cast<HandleImpl*>(this->handle());
     switch (dst.layout.dtype.enumv()) {
-#define cb(_dt)                                                                       \
-    case DTypeTrait<_dt>::enumv: {                                                    \
-        using ctype = DTypeTrait<_dt>::ctype;                                         \
-        MEGDNN_DISPATCH_CPU_KERN_OPR({                                                \
-            fill_exponential<float>(prng, dst.ptr<ctype>(), rate.ptr<ctype>(), size); \
-        };);                                                                          \
-        return;                                                                       \
+#define cb(_dt)                                                              \
+    case DTypeTrait<_dt>::enumv: {                                           \
+        using ctype = DTypeTrait<_dt>::ctype;                                \
+        dispatch_philox(handle, size, [=](size_t begin, size_t end) {        \
+            fill_exponential<float>(                                         \
+                    rng, offset, dst.ptr<ctype>(), rate.ptr<ctype>(), begin, \
+                    end);                                                    \
+        });                                                                  \
+        return;                                                              \
     }
         MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
 #undef cb
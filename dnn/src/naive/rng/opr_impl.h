@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "megdnn/oprs.h"
+#include "src/naive/rng/philox.h"
 
 namespace megdnn {
 namespace naive {
@@ -42,24 +43,30 @@ public:
     uint64_t operator()();
 };
 
-class UniformRNGImpl : public UniformRNG {
-    Xoroshiro128plus m_rng;
+class UniformRNGImpl : public UniformRNG, public CounterBasedRNG {
+    PhiloxState m_rng;
 
 public:
     using UniformRNG::UniformRNG;
     void exec(_megdnn_tensor_inout dst, _megdnn_workspace) override;
 
     size_t get_workspace_in_bytes(const TensorLayout&) override { return 0; }
+
+    uint64_t offset() const override { return m_rng.offset(); }
+    void set_offset(uint64_t offset) override { m_rng.set_offset(offset); }
 };
 
-class GaussianRNGImpl : public GaussianRNG {
-    Xoroshiro128plus m_rng;
+class GaussianRNGImpl : public GaussianRNG, public CounterBasedRNG {
+    PhiloxState m_rng;
 
 public:
     using GaussianRNG::GaussianRNG;
     void exec(_megdnn_tensor_inout dst, _megdnn_workspace) override;
 
     size_t get_workspace_in_bytes(const TensorLayout&) override { return 0; }
+
+    uint64_t offset() const override { return m_rng.offset(); }
+    void set_offset(uint64_t offset) override { m_rng.set_offset(offset); }
 };
 
 class GammaRNGImpl : public GammaRNG {
@@ -158,8 +165,8 @@ public:
     }
 };
 
-class ExponentialRNGImpl : public ExponentialRNG {
-    Xoroshiro128plus m_rng;
+class ExponentialRNGImpl : public ExponentialRNG, public CounterBasedRNG {
+    PhiloxState m_rng;
 
 public:
     using ExponentialRNG::ExponentialRNG;
@@ -170,6 +177,9 @@ public:
     size_t get_workspace_in_bytes(const TensorLayout&, const TensorLayout&) override {
         return 0;
     }
+
+    uint64_t offset() const override { return m_rng.offset(); }
+    void set_offset(uint64_t offset) override { m_rng.set_offset(offset); }
 };
 
 }  // namespace naive
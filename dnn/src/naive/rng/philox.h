@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+
+#include "megdnn/arch.h"
+
+namespace megdnn {
+namespace naive {
+
+/*!
+ * \brief the counter based Philox4x32-10 PRNG described in "Parallel Random
+ *      Numbers: As Easy as 1, 2, 3" (Salmon et al., SC'11)
+ *
+ * The output is a pure function of (seed, counter), so every block of a
+ * stream can be generated independently and in any order. Here the 128-bit
+ * counter is split into a 64-bit subsequence, selected by the opr offset, and
+ * a 64-bit position inside it; each position yields four 32-bit words.
+ */
+class Philox4x32 {
+    static constexpr uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    static constexpr uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    uint32_t m_key[2];
+
+    static MEGDNN_FORCE_INLINE void mulhilo(
+            uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+        uint64_t p = static_cast<uint64_t>(a) * b;
+        hi = static_cast<uint32_t>(p >> 32);
+        lo = static_cast<uint32_t>(p);
+    }
+
+public:
+    struct Block {
+        uint32_t v[4];
+    };
+
+    explicit Philox4x32(uint64_t seed)
+            : m_key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+    Block operator()(uint64_t subsequence, uint64_t position) const {
+        uint32_t c0 = static_cast<uint32_t>(position),
+                 c1 = static_cast<uint32_t>(position >> 32),
+                 c2 = static_cast<uint32_t>(subsequence),
+                 c3 = static_cast<uint32_t>(subsequence >> 32);
+        uint32_t k0 = m_key[0], k1 = m_key[1];
+        for (int round = 0; round < 10; ++round) {
+            uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(M0, c0, hi0, lo0);
+            mulhilo(M1, c2, hi1, lo1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += W0;
+            k1 += W1;
+        }
+        return {{c0, c1, c2, c3}};
+    }
+};
+
+/*!
+ * \brief (seed, offset) state of an opr using Philox4x32
+ *
+ * Each exec takes one subsequence of the stream; the offset restarts from zero
+ * when the seed changes, like Xoroshiro128plus::ensure_seed does.
+ */
+class PhiloxState {
+    uint64_t m_seed = 0, m_offset = 0;
+
+public:
+    PhiloxState& ensure_seed(uint64_t seed) {
+        if (seed != m_seed) {
+            m_seed = seed;
+            m_offset = 0;
+        }
+        return *this;
+    }
+
+    Philox4x32 generator() const { return Philox4x32{m_seed}; }
+
+    //! the subsequence of the next exec, then advance to the one after it
+    uint64_t next_offset() { return m_offset++; }
+
+    uint64_t offset() const { return m_offset; }
+
+    void set_offset(uint64_t offset) { m_offset = offset; }
+};
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,205 @@
+#include "megdnn/oprs.h"
+#include "src/x86/conv_bias/f32/algos.h"
+#include "src/x86/conv_bias/f32/avx2_chanwise_kern.h"
+#include "src/x86/conv_bias/opr_impl.h"
+
+#include "midout.h"
+
+using namespace megdnn;
+using namespace x86;
+using namespace avx2_chanwise_f32;
+using conv_fun = std::function<void(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index)>;
+MIDOUT_DECL(megdnn_x86_conv_bias_fp32_chanwise_avx2)
+namespace {
+
+using NoneOpF32 = NoneOp<SIMDType::AVX2, dt_float32>;
+using ReluOpF32 = ReluOp<SIMDType::AVX2, dt_float32>;
+using HSwishOpF32 = HSwishOp<SIMDType::AVX2, dt_float32>;
+using SigmoidOpF32 = SigmoidOp<SIMDType::AVX2, dt_float32>;
+
+PaddedPlane get_padded_plane(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return {static_cast<int>(param.osz[0]), static_cast<int>(param.osz[1]),
+            static_cast<int>(fm.spatial[0]), static_cast<int>(fm.stride[0])};
+}
+
+/*!
+ * Every kern computes a block of channels of one batch, small planes are
+ * grouped so that a kern does enough work, but every thread still gets at
+ * least one block.
+ */
+size_t get_channel_block(const ConvBiasImpl::NCBKernSizeParam& param) {
+    constexpr size_t MIN_PIXELS_PER_KERN = 4096;
+    const size_t group = param.filter_meta.group;
+    const size_t nr_pixels = param.osz[0] * param.osz[1];
+    const size_t max_block = div_ceil<size_t>(group, param.nr_threads);
+    return std::max<size_t>(
+            1, std::min(div_ceil(MIN_PIXELS_PER_KERN, nr_pixels), max_block));
+}
+
+WorkspaceBundle get_bundle(const ConvBiasImpl::NCBKernSizeParam& param) {
+    return {nullptr, {get_padded_plane(param).size_in_bytes() * param.nr_threads}};
+}
+
+template <size_t filter, BiasMode bias_mode, typename Op, int stride>
+void do_conv_kern(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index) {
+    auto&& fm = kern_param.filter_meta;
+    const int ih = kern_param.isz[0], iw = kern_param.isz[1];
+    const int oh = kern_param.osz[0], ow = kern_param.osz[1];
+    const int ph = fm.padding[0], pw = fm.padding[1];
+    const size_t batch_id = ncb_index.ndrange_id[0];
+    const size_t channel_block = get_channel_block(kern_param);
+    const size_t channel_start = ncb_index.ndrange_id[1] * channel_block;
+    const size_t channel_end =
+            std::min<size_t>(channel_start + channel_block, fm.group);
+
+    const PaddedPlane plane = get_padded_plane(kern_param);
+    float* sptr = reinterpret_cast<float*>(
+            static_cast<int8_t*>(bundle.get(0)) +
+            ncb_index.thread_id * plane.size_in_bytes());
+    Op op;
+    for (size_t channel = channel_start; channel < channel_end; ++channel) {
+        copy_padding<stride>(
+                kern_param.src<float>(batch_id, channel), sptr, plane, ih, iw, ph, pw);
+        const float* bptr = kern_param.bias<float>(batch_id, channel);
+        const float channel_bias =
+                bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS ? bptr[0] : 0.f;
+        conv_chanwise<bias_mode, Op, filter, stride>(
+                sptr, kern_param.filter<float>(channel), bptr, channel_bias,
+                kern_param.dst<float>(batch_id, channel), plane, oh, ow, op);
+    }
+}
+
+}  // namespace
+
+#define DO_CONV_KERN_FUN(filter, bias_mode, op, stride)            \
+    MIDOUT_BEGIN(                                                  \
+            megdnn_x86_conv_bias_fp32_chanwise_avx2,               \
+            midout_iv(#filter #bias_mode #stride #op##_hash)) {    \
+        do_conv_fun = do_conv_kern<filter, bias_mode, op, stride>; \
+    }                                                              \
+    MIDOUT_END();
+
+#define GET_STRIDE_PARAM(filter, bias_mode, op)         \
+    switch (param.filter_meta.stride[0]) {              \
+        case 1:                                         \
+            DO_CONV_KERN_FUN(filter, bias_mode, op, 1); \
+            break;                                      \
+        case 2:                                         \
+            DO_CONV_KERN_FUN(filter, bias_mode, op, 2); \
+            break;                                      \
+        default:                                        \
+            megdnn_assert(0);                           \
+    }
+
+#define GET_OP_PARAM(filter, bias_mode)                       \
+    switch (param.nonlineMode) {                              \
+        case param::ConvBias::NonlineMode::IDENTITY:          \
+            GET_STRIDE_PARAM(filter, bias_mode, NoneOpF32)    \
+            break;                                            \
+        case param::ConvBias::NonlineMode::RELU:              \
+            GET_STRIDE_PARAM(filter, bias_mode, ReluOpF32)    \
+            break;                                            \
+        case param::ConvBias::NonlineMode::H_SWISH:           \
+            GET_STRIDE_PARAM(filter, bias_mode, HSwishOpF32)  \
+            break;                                            \
+        case param::ConvBias::NonlineMode::SIGMOID:           \
+            GET_STRIDE_PARAM(filter, bias_mode, SigmoidOpF32) \
+            break;                                            \
+        default:                                              \
+            megdnn_assert(0);                                 \
+            break;                                            \
+    }
+
+#define GET_BIAS_MODE_PARAM(filter)                                \
+    switch (param.bias_mode) {                                     \
+        case BiasMode::NO_BIAS:                                    \
+            GET_OP_PARAM(filter, BiasMode::NO_BIAS)                \
+            break;                                                 \
+        case BiasMode::BROADCAST_CHANNEL_BIAS:                     \
+            GET_OP_PARAM(filter, BiasMode::BROADCAST_CHANNEL_BIAS) \
+            break;                                                 \
+        case BiasMode::BIAS:                                       \
+            GET_OP_PARAM(filter, BiasMode::BIAS)                   \
+            break;                                                 \
+        default:                                                   \
+            megdnn_assert(0);                                      \
+            break;                                                 \
+    }
+
+#define DISPATCH_CONV_KERN()                \
+    switch (param.filter_meta.spatial[0]) { \
+        case 2:                             \
+            GET_BIAS_MODE_PARAM(2)          \
+            break;                          \
+        case 3:                             \
+            GET_BIAS_MODE_PARAM(3)          \
+            break;                          \
+        case 5:                             \
+            GET_BIAS_MODE_PARAM(5)          \
+            break;                          \
+        case 7:                             \
+            GET_BIAS_MODE_PARAM(7)          \
+            break;                          \
+        default:                            \
+            megdnn_assert(0);               \
+            break;                          \
+    }
+
+bool ConvBiasImpl::AlgoF32ChanWiseAvx2::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    auto&& fm = param.filter_meta;
+    auto fh = fm.spatial[0];
+    bool ok_type = param.src_type.enumv() == DTypeEnum::Float32 &&
+                   param.filter_type.enumv() == DTypeEnum::Float32 &&
+                   param.dst_type.enumv() == DTypeEnum::Float32;
+    bool ok_chanwise = fm.format == param::ConvBias::Format::NCHW && fm.icpg == 1 &&
+                       fm.ocpg == 1 && fm.spatial_ndim == 2;
+    bool ok_filter = fh == fm.spatial[1] && (fh == 2 || fh == 3 || fh == 5 || fh == 7);
+    bool ok_stride = fm.stride[0] == fm.stride[1] &&
+                     (fm.stride[0] == 1 || fm.stride[0] == 2) && fm.dilation[0] == 1 &&
+                     fm.dilation[1] == 1 && !fm.should_flip;
+    return ok_type && ok_chanwise && ok_filter && ok_stride &&
+           is_supported(SIMDType::AVX2) && is_supported(SIMDType::FMA);
+}
+
+size_t ConvBiasImpl::AlgoF32ChanWiseAvx2::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_x86_conv_bias_fp32_chanwise_avx2,
+            midout_iv("AlgoF32ChanWiseAvx2::get_workspace"_hash)) {
+        return get_bundle(param).total_size_in_bytes();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoF32ChanWiseAvx2::dispatch_kerns(
+        const NCBKernSizeParam& param) const {
+    conv_fun do_conv_fun = nullptr;
+    DISPATCH_CONV_KERN();
+    megdnn_assert(do_conv_fun);
+
+    WorkspaceBundle wbundle = get_bundle(param);
+    auto do_conv = [wbundle, do_conv_fun](
+                           const NCBKernParam& kern_param,
+                           const NCBKernIndex& ncb_index) mutable {
+        wbundle.set(kern_param.workspace_ptr);
+        do_conv_fun(wbundle, kern_param, ncb_index);
+    };
+    size_t nr_channel_blocks =
+            div_ceil<size_t>(param.filter_meta.group, get_channel_block(param));
+    return {{do_conv, {param.n, nr_channel_blocks, 1_z}}};
+}
+
+#undef DO_CONV_KERN_FUN
+#undef GET_STRIDE_PARAM
+#undef GET_OP_PARAM
+#undef GET_BIAS_MODE_PARAM
+#undef DISPATCH_CONV_KERN
+
+// vim: syntax=cpp.doxygen
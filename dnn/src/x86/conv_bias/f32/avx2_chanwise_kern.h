@@ -0,0 +1,154 @@
+#pragma once
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstring>
+#include "src/fallback/conv_bias/common.h"
+#include "src/x86/elemwise_op.h"
+
+namespace megdnn {
+namespace x86 {
+namespace avx2_chanwise_f32 {
+
+//! width of a __m256 of float, the kernels compute 8 output pixels at once
+constexpr int SIMD_LEN = 8;
+
+/*!
+ * \brief the padded input plane of one channel
+ *
+ * Each row holds the input pixels from -pw on of one input row, rows
+ * out of the input and pixels out of the row are zero. For stride 2 the row
+ * is split into its even pixels followed by its odd pixels, half_len floats
+ * each, so that the 8 pixels read by one output vector are contiguous.
+ */
+struct PaddedPlane {
+    int rows, row_stride, half_len;
+    PaddedPlane(int oh, int ow, int filter, int stride) {
+        const int ow_round = round_up(ow, SIMD_LEN);
+        rows = (oh - 1) * stride + filter;
+        if (stride == 1) {
+            half_len = 0;
+            row_stride = ow_round + filter - 1;
+        } else {
+            half_len = ow_round + (filter - 1) / 2;
+            row_stride = 2 * half_len;
+        }
+    }
+    size_t size_in_bytes() const { return sizeof(float) * rows * row_stride; }
+};
+
+template <int stride>
+static inline void copy_padding(
+        const float* src, float* dst, const PaddedPlane& plane, int ih, int iw,
+        int ph, int pw) {
+    for (int r = 0; r < plane.rows; ++r) {
+        const int h = r - ph;
+        float* drow = dst + r * plane.row_stride;
+        memset(drow, 0, sizeof(float) * plane.row_stride);
+        if (h < 0 || h >= ih) {
+            continue;
+        }
+        const float* srow = src + h * iw;
+        if (stride == 1) {
+            memcpy(drow + pw, srow, sizeof(float) * iw);
+        } else {
+            const int w_end = std::min(iw, plane.row_stride - pw);
+            for (int w = 0; w < w_end; ++w) {
+                const int c = w + pw;
+                drow[(c & 1) * plane.half_len + (c >> 1)] = srow[w];
+            }
+        }
+    }
+}
+
+/*!
+ * compute ow_block * 8 output pixels of one row starting at src, which is the
+ * first padded input pixel of the row for stride 1 and the first even one for
+ * stride 2; bias and the nonlinearity are applied before the only store
+ */
+template <BiasMode bias_mode, typename Op, int filter, int stride, int ow_block>
+MEGDNN_ATTRIBUTE_TARGET("avx2,fma")
+MEGDNN_ALWAYS_INLINE void compute_row_block(
+        const float* src, const __m256 (&weight)[filter * filter], const float* bias,
+        float channel_bias, float* dst, int row_stride, int half_len, const Op& op) {
+    __m256 c[ow_block];
+    for (int p = 0; p < ow_block; ++p) {
+        if (bias_mode == BiasMode::BIAS) {
+            c[p] = _mm256_loadu_ps(bias + p * SIMD_LEN);
+        } else if (bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+            c[p] = _mm256_set1_ps(channel_bias);
+        } else {
+            c[p] = _mm256_setzero_ps();
+        }
+    }
+    for (int fh = 0; fh < filter; ++fh) {
+        const float* srow = src + fh * row_stride;
+        for (int fw = 0; fw < filter; ++fw) {
+            const float* sptr = stride == 1 ? srow + fw
+                                            : srow + (fw & 1) * half_len + (fw >> 1);
+            for (int p = 0; p < ow_block; ++p) {
+                c[p] = _mm256_fmadd_ps(
+                        _mm256_loadu_ps(sptr + p * SIMD_LEN), weight[fh * filter + fw],
+                        c[p]);
+            }
+        }
+    }
+    for (int p = 0; p < ow_block; ++p) {
+        _mm256_storeu_ps(dst + p * SIMD_LEN, op(c[p]));
+    }
+}
+
+/*!
+ * \brief channel wise conv of one channel on its padded input plane
+ *
+ * dst and a BIAS mode bias are [oh, ow], channel_bias is the bias of the
+ * channel in BROADCAST_CHANNEL_BIAS mode.
+ */
+template <BiasMode bias_mode, typename Op, int filter, int stride>
+MEGDNN_ATTRIBUTE_TARGET("avx2,fma")
+void conv_chanwise(
+        const float* src, const float* filter_ptr, const float* bias,
+        float channel_bias, float* dst, const PaddedPlane& plane, int oh, int ow,
+        const Op& op) {
+    constexpr int ow_big_block = 4;
+    __m256 weight[filter * filter];
+    for (int i = 0; i < filter * filter; ++i) {
+        weight[i] = _mm256_set1_ps(filter_ptr[i]);
+    }
+    const int row_stride = plane.row_stride, half_len = plane.half_len;
+    for (int h = 0; h < oh; ++h) {
+        const float* srow = src + h * stride * row_stride;
+        const float* brow = bias + h * ow;
+        float* drow = dst + h * ow;
+        int w = 0;
+        for (; w + ow_big_block * SIMD_LEN <= ow; w += ow_big_block * SIMD_LEN) {
+            compute_row_block<bias_mode, Op, filter, stride, ow_big_block>(
+                    srow + w, weight, brow + w, channel_bias, drow + w, row_stride,
+                    half_len, op);
+        }
+        for (; w + SIMD_LEN <= ow; w += SIMD_LEN) {
+            compute_row_block<bias_mode, Op, filter, stride, 1>(
+                    srow + w, weight, brow + w, channel_bias, drow + w, row_stride,
+                    half_len, op);
+        }
+        if (w < ow) {
+            //! the padded plane covers the whole vector, only dst and bias of
+            //! the tail go through a temporary buffer
+            const int remain = ow - w;
+            float tmp[SIMD_LEN] = {0};
+            if (bias_mode == BiasMode::BIAS) {
+                memcpy(tmp, brow + w, sizeof(float) * remain);
+            }
+            compute_row_block<bias_mode, Op, filter, stride, 1>(
+                    srow + w, weight, tmp, channel_bias, tmp, row_stride, half_len,
+                    op);
+            memcpy(drow + w, tmp, sizeof(float) * remain);
+        }
+    }
+}
+
+}  // namespace avx2_chanwise_f32
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
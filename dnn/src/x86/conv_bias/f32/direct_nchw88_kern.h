@@ -0,0 +1,310 @@
+#pragma once
+
+#include <immintrin.h>
+#include <cstring>
+#include "src/fallback/conv_bias/common.h"
+#include "src/x86/elemwise_op.h"
+
+namespace megdnn {
+namespace x86 {
+namespace nchw88 {
+
+//! channels in one nchw88 block, it is also the width of a __m256 of float
+constexpr int PACK = 8;
+
+/*!
+ * \brief copy input rows [ih_start, ih_start + ih_real) of every plane into
+ *      dst, whose rows are iw2 pixels wide, and fill the padding with zero
+ *
+ * A plane is [ih, iw, pack]: one channel block of nchw88 (pack = 8) or one
+ * channel of nchw (pack = 1).
+ */
+template <int pack>
+static inline void pack_src_padding(
+        const float* src, float* dst, int nr_planes, int ih, int iw, int ih_start,
+        int ih_real, int pw, int iw2) {
+    const int right_pad = iw2 - iw - pw;
+    for (int c = 0; c < nr_planes; ++c) {
+        const float* sptr = src + c * ih * iw * pack;
+        float* dptr = dst + c * ih_real * iw2 * pack;
+        for (int r = 0; r < ih_real; ++r) {
+            const int h = ih_start + r;
+            float* drow = dptr + r * iw2 * pack;
+            if (h < 0 || h >= ih) {
+                memset(drow, 0, sizeof(float) * iw2 * pack);
+                continue;
+            }
+            memset(drow, 0, sizeof(float) * pw * pack);
+            memcpy(drow + pw * pack, sptr + h * iw * pack, sizeof(float) * iw * pack);
+            memset(drow + (pw + iw) * pack, 0, sizeof(float) * right_pad * pack);
+        }
+    }
+}
+
+//! bias of BIAS mode has the layout of dst, so ld_bias is the stride of dst
+template <BiasMode bias_mode, int c_dim, int ow_block>
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+MEGDNN_ALWAYS_INLINE void init_acc(
+        __m256 (&c)[c_dim][ow_block], const float* bias, int ld_bias) {
+    for (int i = 0; i < c_dim; ++i) {
+        for (int p = 0; p < ow_block; ++p) {
+            if (bias_mode == BiasMode::BIAS) {
+                c[i][p] = _mm256_loadu_ps(bias + i * ld_bias + p * PACK);
+            } else if (bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+                c[i][p] = _mm256_loadu_ps(bias + i * PACK);
+            } else {
+                c[i][p] = _mm256_setzero_ps();
+            }
+        }
+    }
+}
+
+template <typename Op, int c_dim, int ow_block>
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+MEGDNN_ALWAYS_INLINE void store_acc(
+        __m256 (&c)[c_dim][ow_block], float* dst, int ld_dst, const Op& op) {
+    for (int i = 0; i < c_dim; ++i) {
+        for (int p = 0; p < ow_block; ++p) {
+            _mm256_storeu_ps(dst + i * ld_dst + p * PACK, op(c[i][p]));
+        }
+    }
+}
+
+/*!
+ * The kernels below compute ow_block pixels of one output row for c_dim
+ * blocks of 8 output channels, keeping c_dim * ow_block accumulators in
+ * registers and applying bias and nonlinearity before the only store.
+ *
+ * src points to the first input pixel of the row in the padded input, the
+ * next input channel (block) is ld_src_ic away; weight points to the first
+ * output channel block, the next one is ld_weight away; dst and a BIAS mode
+ * bias point to the first output pixel and the next output channel block is
+ * ld_dst away.
+ */
+
+//! src [ic/8, ih2, iw2, 8], weight [ic/8, fh, fw, 8(ic), 8(oc)]
+template <
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim,
+        int ow_block>
+struct KerNCHW88 {
+    static constexpr int SRC_PACK = PACK;
+    MEGDNN_ATTRIBUTE_TARGET("avx2,fma")
+    static void impl(
+            const float* src, const float* weight, const float* bias, float* dst,
+            int ic, int ld_src_ic, int iw2, int ld_weight, int ld_dst, const Op& op) {
+        __m256 c[c_dim][ow_block];
+        init_acc<bias_mode>(c, bias, ld_dst);
+        for (int ic_idx = 0; ic_idx < ic; ic_idx += PACK) {
+            for (int fh = 0; fh < filter; ++fh) {
+                for (int fw = 0; fw < filter; ++fw) {
+                    const float* sptr = src + (fh * iw2 + fw) * PACK;
+                    const float* wptr = weight + (fh * filter + fw) * PACK * PACK;
+                    for (int k = 0; k < PACK; ++k) {
+                        __m256 w[c_dim];
+                        for (int i = 0; i < c_dim; ++i)
+                            w[i] = _mm256_loadu_ps(wptr + i * ld_weight + k * PACK);
+                        for (int p = 0; p < ow_block; ++p) {
+                            __m256 s =
+                                    _mm256_broadcast_ss(sptr + p * stride * PACK + k);
+                            for (int i = 0; i < c_dim; ++i)
+                                c[i][p] = _mm256_fmadd_ps(s, w[i], c[i][p]);
+                        }
+                    }
+                }
+            }
+            src += ld_src_ic;
+            weight += filter * filter * PACK * PACK;
+        }
+        store_acc(c, dst, ld_dst, op);
+    }
+};
+
+//! src [ic, ih2, iw2] of nchw, weight [fh, fw, ic, 8(oc)]
+template <
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim,
+        int ow_block>
+struct KerNCHWNCHW88 {
+    static constexpr int SRC_PACK = 1;
+    MEGDNN_ATTRIBUTE_TARGET("avx2,fma")
+    static void impl(
+            const float* src, const float* weight, const float* bias, float* dst,
+            int ic, int ld_src_ic, int iw2, int ld_weight, int ld_dst, const Op& op) {
+        __m256 c[c_dim][ow_block];
+        init_acc<bias_mode>(c, bias, ld_dst);
+        for (int fh = 0; fh < filter; ++fh) {
+            for (int fw = 0; fw < filter; ++fw) {
+                const float* wptr = weight + (fh * filter + fw) * ic * PACK;
+                for (int ic_idx = 0; ic_idx < ic; ++ic_idx) {
+                    const float* sptr = src + ic_idx * ld_src_ic + fh * iw2 + fw;
+                    __m256 w[c_dim];
+                    for (int i = 0; i < c_dim; ++i)
+                        w[i] = _mm256_loadu_ps(wptr + i * ld_weight + ic_idx * PACK);
+                    for (int p = 0; p < ow_block; ++p) {
+                        __m256 s = _mm256_broadcast_ss(sptr + p * stride);
+                        for (int i = 0; i < c_dim; ++i)
+                            c[i][p] = _mm256_fmadd_ps(s, w[i], c[i][p]);
+                    }
+                }
+            }
+        }
+        store_acc(c, dst, ld_dst, op);
+    }
+};
+
+//! src [ih2, iw2, 8] and weight [fh, fw, 8] of one channel block
+template <
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim,
+        int ow_block>
+struct KerChanWiseNCHW88 {
+    static_assert(c_dim == 1, "channel wise kernel computes one block");
+    static constexpr int SRC_PACK = PACK;
+    MEGDNN_ATTRIBUTE_TARGET("avx2,fma")
+    static void impl(
+            const float* src, const float* weight, const float* bias, float* dst, int,
+            int, int iw2, int, int ld_dst, const Op& op) {
+        __m256 c[1][ow_block];
+        init_acc<bias_mode>(c, bias, ld_dst);
+        for (int fh = 0; fh < filter; ++fh) {
+            for (int fw = 0; fw < filter; ++fw) {
+                const float* sptr = src + (fh * iw2 + fw) * PACK;
+                __m256 w = _mm256_loadu_ps(weight + (fh * filter + fw) * PACK);
+                for (int p = 0; p < ow_block; ++p) {
+                    __m256 s = _mm256_loadu_ps(sptr + p * stride * PACK);
+                    c[0][p] = _mm256_fmadd_ps(s, w, c[0][p]);
+                }
+            }
+        }
+        store_acc(c, dst, ld_dst, op);
+    }
+};
+
+template <
+        template <BiasMode, typename, int, int, int, int> class Ker,
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim,
+        int ow_block>
+struct KerRemain {
+    //! run the kernel of remain (<= ow_block) pixels
+    static void impl(
+            int remain, const float* src, const float* weight, const float* bias,
+            float* dst, int ic, int ld_src_ic, int iw2, int ld_weight, int ld_dst,
+            const Op& op) {
+        if (remain == ow_block) {
+            Ker<bias_mode, Op, filter, stride, c_dim, ow_block>::impl(
+                    src, weight, bias, dst, ic, ld_src_ic, iw2, ld_weight, ld_dst, op);
+        } else {
+            KerRemain<Ker, bias_mode, Op, filter, stride, c_dim, ow_block - 1>::impl(
+                    remain, src, weight, bias, dst, ic, ld_src_ic, iw2, ld_weight,
+                    ld_dst, op);
+        }
+    }
+};
+
+template <
+        template <BiasMode, typename, int, int, int, int> class Ker,
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim>
+struct KerRemain<Ker, bias_mode, Op, filter, stride, c_dim, 0> {
+    static void impl(
+            int, const float*, const float*, const float*, float*, int, int, int, int,
+            int, const Op&) {}
+};
+
+//! all the output rows of an oh block for c_dim output channel blocks
+template <
+        template <BiasMode, typename, int, int, int, int> class Ker,
+        BiasMode bias_mode, typename Op, int filter, int stride, int c_dim,
+        int ow_step>
+static void conv_oc_block(
+        const float* src, const float* weight, const float* bias, float* dst, int ic,
+        int ld_src_ic, int iw2, int ld_weight, int oh_block, int ow, int ld_dst,
+        const Op& op) {
+    using KerMain = Ker<bias_mode, Op, filter, stride, c_dim, ow_step>;
+    constexpr int src_pack = KerMain::SRC_PACK;
+    const int ow_end = ow / ow_step * ow_step;
+    for (int oh = 0; oh < oh_block; ++oh) {
+        const float* src_row = src + oh * stride * iw2 * src_pack;
+        for (int ow_idx = 0; ow_idx < ow; ow_idx += ow_step) {
+            const float* sptr = src_row + ow_idx * stride * src_pack;
+            const int dst_offset = (oh * ow + ow_idx) * PACK;
+            const float* bptr = bias_mode == BiasMode::BIAS ? bias + dst_offset : bias;
+            if (ow_idx < ow_end) {
+                KerMain::impl(
+                        sptr, weight, bptr, dst + dst_offset, ic, ld_src_ic, iw2,
+                        ld_weight, ld_dst, op);
+            } else {
+                KerRemain<Ker, bias_mode, Op, filter, stride, c_dim, ow_step - 1>::impl(
+                        ow - ow_idx, sptr, weight, bptr, dst + dst_offset, ic,
+                        ld_src_ic, iw2, ld_weight, ld_dst, op);
+            }
+        }
+    }
+}
+
+//! pairs of output channel blocks share the input loads, an odd last block
+//! takes twice the pixels instead, both keep 8 accumulators
+template <
+        template <BiasMode, typename, int, int, int, int> class Ker,
+        BiasMode bias_mode, typename Op, int filter, int stride>
+static void conv_all_oc(
+        const float* src, const float* weight, const float* bias, float* dst, int oc,
+        int ic, int ld_src_ic, int iw2, int ld_weight, int oh_block, int ow,
+        int ld_dst, const Op& op) {
+    const int nr_oc_blocks = oc / PACK;
+    auto bias_ptr = [=](int oc_block) {
+        return bias_mode == BiasMode::BIAS ? bias + oc_block * ld_dst
+                                           : bias + oc_block * PACK;
+    };
+    int oc_block = 0;
+    for (; oc_block + 2 <= nr_oc_blocks; oc_block += 2) {
+        conv_oc_block<Ker, bias_mode, Op, filter, stride, 2, 4>(
+                src, weight + oc_block * ld_weight, bias_ptr(oc_block),
+                dst + oc_block * ld_dst, ic, ld_src_ic, iw2, ld_weight, oh_block, ow,
+                ld_dst, op);
+    }
+    if (oc_block < nr_oc_blocks) {
+        conv_oc_block<Ker, bias_mode, Op, filter, stride, 1, 8>(
+                src, weight + oc_block * ld_weight, bias_ptr(oc_block),
+                dst + oc_block * ld_dst, ic, ld_src_ic, iw2, ld_weight, oh_block, ow,
+                ld_dst, op);
+    }
+}
+
+/*!
+ * \brief nchw88 dense conv of an oh block of one group
+ *
+ * src is the padded input of the block [ic/8, ih2, iw2, 8], dst and bias of
+ * BIAS mode point to the first row of the block in tensors with ld_dst
+ * floats per output channel block
+ */
+template <BiasMode bias_mode, typename Op, int filter, int stride>
+void conv_direct_nchw88(
+        const float* src, const float* weight, const float* bias, float* dst, int oc,
+        int ic, int ih2, int iw2, int oh_block, int ow, int ld_dst, const Op& op) {
+    conv_all_oc<KerNCHW88, bias_mode, Op, filter, stride>(
+            src, weight, bias, dst, oc, ic, ih2 * iw2 * PACK, iw2,
+            ic * filter * filter * PACK, oh_block, ow, ld_dst, op);
+}
+
+//! first layer conv with nchw src [ic, ih2, iw2] and nchw88 dst
+template <BiasMode bias_mode, typename Op, int filter, int stride>
+void conv_direct_nchw_nchw88(
+        const float* src, const float* weight, const float* bias, float* dst, int oc,
+        int ic, int ih2, int iw2, int oh_block, int ow, int ld_dst, const Op& op) {
+    conv_all_oc<KerNCHWNCHW88, bias_mode, Op, filter, stride>(
+            src, weight, bias, dst, oc, ic, ih2 * iw2, iw2,
+            filter * filter * ic * PACK, oh_block, ow, ld_dst, op);
+}
+
+//! channel wise conv of one channel block, src [ih2, iw2, 8]
+template <BiasMode bias_mode, typename Op, int filter, int stride>
+void conv_chanwise_nchw88(
+        const float* src, const float* weight, const float* bias, float* dst,
+        int iw2, int oh_block, int ow, const Op& op) {
+    conv_oc_block<KerChanWiseNCHW88, bias_mode, Op, filter, stride, 1, 8>(
+            src, weight, bias, dst, 0, 0, iw2, 0, oh_block, ow, 0, op);
+}
+
+}  // namespace nchw88
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,366 @@
+#include "megdnn/oprs.h"
+#include "src/common/nchw_nchwxx_valid.h"
+#include "src/fallback/conv_bias/gi/block_helper.h"
+#include "src/x86/conv_bias/f32/algos.h"
+#include "src/x86/conv_bias/f32/direct_nchw88_kern.h"
+#include "src/x86/conv_bias/opr_impl.h"
+
+#include "midout.h"
+
+using namespace megdnn;
+using namespace x86;
+using namespace nchw88;
+using conv_fun = std::function<void(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index)>;
+MIDOUT_DECL(megdnn_x86_conv_bias_fp32_nchw88)
+namespace {
+
+using NoneOpF32 = NoneOp<SIMDType::AVX2, dt_float32>;
+using ReluOpF32 = ReluOp<SIMDType::AVX2, dt_float32>;
+using HSwishOpF32 = HSwishOp<SIMDType::AVX2, dt_float32>;
+using SigmoidOpF32 = SigmoidOp<SIMDType::AVX2, dt_float32>;
+
+/*!
+ * Every kern computes an oh block of one (batch, group); it first copies the
+ * input rows of the block with their padding into its own workspace, whose
+ * pixels are pixel_elems floats, so that the block stays in L2.
+ */
+int get_oh_block(const ConvBiasImpl::NCBKernSizeParam& param, int pixel_elems) {
+    auto&& fm = param.filter_meta;
+    const int iw2 = param.isz[1] + 2 * fm.padding[1];
+    const int stride_h = fm.stride[0];
+    return l2_block_helper(
+            param.nr_threads, param.osz[0],
+            pixel_elems * iw2 * sizeof(float) * stride_h);
+}
+
+size_t get_perthread_src_bytes(
+        const ConvBiasImpl::NCBKernSizeParam& param, int pixel_elems) {
+    auto&& fm = param.filter_meta;
+    const int iw2 = param.isz[1] + 2 * fm.padding[1];
+    const int stride_h = fm.stride[0];
+    const int ih2 =
+            get_oh_block(param, pixel_elems) * stride_h + fm.spatial[0] - stride_h;
+    return pixel_elems * ih2 * iw2 * sizeof(float);
+}
+
+WorkspaceBundle get_bundle(
+        const ConvBiasImpl::NCBKernSizeParam& param, int pixel_elems) {
+    return {nullptr, {get_perthread_src_bytes(param, pixel_elems) * param.nr_threads}};
+}
+
+CpuNDRange get_ncb_range(
+        const ConvBiasImpl::NCBKernSizeParam& param, size_t nr_groups,
+        int pixel_elems) {
+    int oh_block = get_oh_block(param, pixel_elems);
+    return {param.n, nr_groups,
+            static_cast<size_t>(div_ceil<int>(param.osz[0], oh_block))};
+}
+
+//! the rows of one oh block, the pointers of the tensors are set by the kern
+struct OhBlock {
+    int oh_start, oh_real, ih_start, ih_real;
+    OhBlock(const ConvBiasImpl::NCBKernParam& kern_param, int oh_idx,
+            int pixel_elems) {
+        auto&& fm = kern_param.filter_meta;
+        const int stride_h = fm.stride[0];
+        const int oh_block = get_oh_block(kern_param, pixel_elems);
+        oh_start = oh_idx * oh_block;
+        oh_real = std::min<int>(kern_param.osz[0] - oh_start, oh_block);
+        ih_start = oh_start * stride_h - static_cast<int>(fm.padding[0]);
+        ih_real = oh_real * stride_h + fm.spatial[0] - stride_h;
+    }
+};
+
+float* get_src_workspace(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index, int pixel_elems) {
+    return reinterpret_cast<float*>(
+            static_cast<int8_t*>(bundle.get(0)) +
+            ncb_index.thread_id * get_perthread_src_bytes(kern_param, pixel_elems));
+}
+
+template <size_t filter, BiasMode bias_mode, typename Op, int stride>
+void do_conv_kern_nchw88(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index) {
+    auto&& fm = kern_param.filter_meta;
+    const int ic = fm.icpg, oc = fm.ocpg;
+    const int ih = kern_param.isz[0], iw = kern_param.isz[1];
+    const int ow = kern_param.osz[1], pw = fm.padding[1];
+    const int iw2 = iw + 2 * pw;
+    const size_t batch_id = ncb_index.ndrange_id[0];
+    const size_t group_id = ncb_index.ndrange_id[1];
+    OhBlock block(kern_param, ncb_index.ndrange_id[2], ic);
+
+    float* sptr = get_src_workspace(bundle, kern_param, ncb_index, ic);
+    pack_src_padding<PACK>(
+            kern_param.src<float>(batch_id, group_id), sptr, ic / PACK, ih, iw,
+            block.ih_start, block.ih_real, pw, iw2);
+
+    const int dst_offset = block.oh_start * ow * PACK;
+    const float* bptr = kern_param.bias<float>(batch_id, group_id) +
+                        (bias_mode == BiasMode::BIAS ? dst_offset : 0);
+    Op op;
+    conv_direct_nchw88<bias_mode, Op, filter, stride>(
+            sptr, kern_param.filter<float>(group_id), bptr,
+            kern_param.dst<float>(batch_id, group_id) + dst_offset, oc, ic,
+            block.ih_real, iw2, block.oh_real, ow, kern_param.osz[0] * ow * PACK, op);
+}
+
+template <size_t filter, BiasMode bias_mode, typename Op, int stride>
+void do_conv_kern_nchw_nchw88(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index) {
+    auto&& fm = kern_param.filter_meta;
+    const int ic = fm.icpg, oc = fm.ocpg;
+    const int ih = kern_param.isz[0], iw = kern_param.isz[1];
+    const int ow = kern_param.osz[1], pw = fm.padding[1];
+    const int iw2 = iw + 2 * pw;
+    const size_t batch_id = ncb_index.ndrange_id[0];
+    OhBlock block(kern_param, ncb_index.ndrange_id[2], ic);
+
+    float* sptr = get_src_workspace(bundle, kern_param, ncb_index, ic);
+    pack_src_padding<1>(
+            kern_param.src<float>(batch_id, 0), sptr, ic, ih, iw, block.ih_start,
+            block.ih_real, pw, iw2);
+
+    const int dst_offset = block.oh_start * ow * PACK;
+    const float* bptr = kern_param.bias<float>(batch_id, 0) +
+                        (bias_mode == BiasMode::BIAS ? dst_offset : 0);
+    Op op;
+    conv_direct_nchw_nchw88<bias_mode, Op, filter, stride>(
+            sptr, kern_param.filter<float>(0), bptr,
+            kern_param.dst<float>(batch_id, 0) + dst_offset, oc, ic, block.ih_real,
+            iw2, block.oh_real, ow, kern_param.osz[0] * ow * PACK, op);
+}
+
+template <size_t filter, BiasMode bias_mode, typename Op, int stride>
+void do_conv_kern_chanwise_nchw88(
+        const WorkspaceBundle& bundle, const ConvBiasImpl::NCBKernParam& kern_param,
+        const ConvBiasImpl::NCBKernIndex& ncb_index) {
+    const int ih = kern_param.isz[0], iw = kern_param.isz[1];
+    const int ow = kern_param.osz[1], pw = kern_param.filter_meta.padding[1];
+    const int iw2 = iw + 2 * pw;
+    const size_t batch_id = ncb_index.ndrange_id[0];
+    const size_t group_id = ncb_index.ndrange_id[1];
+    OhBlock block(kern_param, ncb_index.ndrange_id[2], PACK);
+
+    float* sptr = get_src_workspace(bundle, kern_param, ncb_index, PACK);
+    pack_src_padding<PACK>(
+            kern_param.src<float>(batch_id, group_id, 0, PACK, 1), sptr, 1, ih, iw,
+            block.ih_start, block.ih_real, pw, iw2);
+
+    const int dst_offset = block.oh_start * ow * PACK;
+    const float* bptr = kern_param.bias<float>(batch_id, group_id, 0, PACK, 1) +
+                        (bias_mode == BiasMode::BIAS ? dst_offset : 0);
+    Op op;
+    conv_chanwise_nchw88<bias_mode, Op, filter, stride>(
+            sptr, kern_param.filter<float>(group_id, PACK), bptr,
+            kern_param.dst<float>(batch_id, group_id, 0, PACK, 1) + dst_offset, iw2,
+            block.oh_real, ow, op);
+}
+
+bool is_avx2_fma_supported() {
+    return is_supported(SIMDType::AVX2) && is_supported(SIMDType::FMA);
+}
+
+bool is_filter_stride_supported(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    auto fh = fm.spatial[0];
+    return fm.spatial_ndim == 2 && fh == fm.spatial[1] &&
+           (fh == 2 || fh == 3 || fh == 5 || fh == 7) && fm.dilation[0] == 1 &&
+           fm.dilation[1] == 1 &&
+           ((fm.stride[0] == 1 && fm.stride[1] == 1) ||
+            (fm.stride[0] == 2 && fm.stride[1] == 2)) &&
+           !fm.should_flip;
+}
+
+bool is_float32(const ConvBiasImpl::NCBKernSizeParam& param) {
+    return param.src_type.enumv() == DTypeEnum::Float32 &&
+           param.filter_type.enumv() == DTypeEnum::Float32 &&
+           param.dst_type.enumv() == DTypeEnum::Float32;
+}
+
+}  // namespace
+
+// NOTE: remain_w is not used to gen hash of midout for compatible with
+// shape runtime
+#define DO_CONV_KERN_FUN(kern, filter, bias_mode, op, stride)         \
+    MIDOUT_BEGIN(                                                     \
+            megdnn_x86_conv_bias_fp32_nchw88,                         \
+            midout_iv(#kern #filter #bias_mode #stride #op##_hash)) { \
+        do_conv_fun = kern<filter, bias_mode, op, stride>;            \
+    }                                                                 \
+    MIDOUT_END();
+
+#define GET_STRIDE_PARAM(kern, filter, bias_mode, op)         \
+    switch (param.filter_meta.stride[0]) {                    \
+        case 1:                                               \
+            DO_CONV_KERN_FUN(kern, filter, bias_mode, op, 1); \
+            break;                                            \
+        case 2:                                               \
+            DO_CONV_KERN_FUN(kern, filter, bias_mode, op, 2); \
+            break;                                            \
+        default:                                              \
+            megdnn_assert(0);                                 \
+    }
+
+#define GET_OP_PARAM(kern, filter, bias_mode)                       \
+    switch (param.nonlineMode) {                                    \
+        case param::ConvBias::NonlineMode::IDENTITY:                \
+            GET_STRIDE_PARAM(kern, filter, bias_mode, NoneOpF32)    \
+            break;                                                  \
+        case param::ConvBias::NonlineMode::RELU:                    \
+            GET_STRIDE_PARAM(kern, filter, bias_mode, ReluOpF32)    \
+            break;                                                  \
+        case param::ConvBias::NonlineMode::H_SWISH:                 \
+            GET_STRIDE_PARAM(kern, filter, bias_mode, HSwishOpF32)  \
+            break;                                                  \
+        case param::ConvBias::NonlineMode::SIGMOID:                 \
+            GET_STRIDE_PARAM(kern, filter, bias_mode, SigmoidOpF32) \
+            break;                                                  \
+        default:                                                    \
+            megdnn_assert(0);                                       \
+            break;                                                  \
+    }
+
+#define GET_BIAS_MODE_PARAM(kern, filter)                                \
+    switch (param.bias_mode) {                                           \
+        case BiasMode::NO_BIAS:                                          \
+            GET_OP_PARAM(kern, filter, BiasMode::NO_BIAS)                \
+            break;                                                       \
+        case BiasMode::BROADCAST_CHANNEL_BIAS:                           \
+            GET_OP_PARAM(kern, filter, BiasMode::BROADCAST_CHANNEL_BIAS) \
+            break;                                                       \
+        case BiasMode::BIAS:                                             \
+            GET_OP_PARAM(kern, filter, BiasMode::BIAS)                   \
+            break;                                                       \
+        default:                                                         \
+            megdnn_assert(0);                                            \
+            break;                                                       \
+    }
+
+#define DISPATCH_CONV_KERN(kern)            \
+    switch (param.filter_meta.spatial[0]) { \
+        case 2:                             \
+            GET_BIAS_MODE_PARAM(kern, 2)    \
+            break;                          \
+        case 3:                             \
+            GET_BIAS_MODE_PARAM(kern, 3)    \
+            break;                          \
+        case 5:                             \
+            GET_BIAS_MODE_PARAM(kern, 5)    \
+            break;                          \
+        case 7:                             \
+            GET_BIAS_MODE_PARAM(kern, 7)    \
+            break;                          \
+        default:                            \
+            megdnn_assert(0);               \
+            break;                          \
+    }
+
+#define RETURN_NCB_KERNS(nr_groups, pixel_elems)                    \
+    megdnn_assert(do_conv_fun);                                     \
+    WorkspaceBundle wbundle = get_bundle(param, pixel_elems);       \
+    auto do_conv = [wbundle, do_conv_fun](                          \
+                           const NCBKernParam& kern_param,          \
+                           const NCBKernIndex& ncb_index) mutable { \
+        wbundle.set(kern_param.workspace_ptr);                      \
+        do_conv_fun(wbundle, kern_param, ncb_index);                \
+    };                                                              \
+    return {{do_conv, get_ncb_range(param, nr_groups, pixel_elems)}};
+
+/* ===================== direct nchw88 algo ===================== */
+bool ConvBiasImpl::AlgoF32DirectNCHW88::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    auto&& fm = param.filter_meta;
+    bool ok_type = is_float32(param) && fm.format == param::Convolution::Format::NCHW88;
+    bool ok_src_dst = fm.icpg % 8 == 0 && fm.ocpg % 8 == 0;
+    return ok_type && ok_src_dst && is_filter_stride_supported(param) &&
+           is_avx2_fma_supported();
+}
+
+size_t ConvBiasImpl::AlgoF32DirectNCHW88::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_x86_conv_bias_fp32_nchw88,
+            midout_iv("AlgoF32DirectNCHW88::get_workspace"_hash)) {
+        return get_bundle(param, param.filter_meta.icpg).total_size_in_bytes();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoF32DirectNCHW88::dispatch_kerns(
+        const NCBKernSizeParam& param) const {
+    conv_fun do_conv_fun = nullptr;
+    DISPATCH_CONV_KERN(do_conv_kern_nchw88);
+    RETURN_NCB_KERNS(param.filter_meta.group, param.filter_meta.icpg);
+}
+
+/* ===================== direct nchw-nchw88 algo ===================== */
+bool ConvBiasImpl::AlgoF32DirectNCHWNCHW88::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    return nchw_nchwxx_valid<NchwNchwxxType::NCHW88>(
+                   param.src_type.enumv(), param.filter_type.enumv(),
+                   param.dst_type.enumv(), param.filter_meta, param.bias_mode,
+                   param.nonlineMode) &&
+           is_filter_stride_supported(param) && is_avx2_fma_supported();
+}
+
+size_t ConvBiasImpl::AlgoF32DirectNCHWNCHW88::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_x86_conv_bias_fp32_nchw88,
+            midout_iv("AlgoF32DirectNCHWNCHW88::get_workspace"_hash)) {
+        return get_bundle(param, param.filter_meta.icpg).total_size_in_bytes();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoF32DirectNCHWNCHW88::
+        dispatch_kerns(const NCBKernSizeParam& param) const {
+    conv_fun do_conv_fun = nullptr;
+    DISPATCH_CONV_KERN(do_conv_kern_nchw_nchw88);
+    RETURN_NCB_KERNS(1_z, param.filter_meta.icpg);
+}
+
+/* ===================== channel wise nchw88 algo ===================== */
+bool ConvBiasImpl::AlgoF32ChanWiseNCHW88::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    auto&& fm = param.filter_meta;
+    bool ok_type = is_float32(param) && fm.format == param::Convolution::Format::NCHW88;
+    bool ok_chanwise = fm.icpg == 1 && fm.ocpg == 1 && fm.group % 8 == 0;
+    return ok_type && ok_chanwise && is_filter_stride_supported(param) &&
+           is_avx2_fma_supported();
+}
+
+size_t ConvBiasImpl::AlgoF32ChanWiseNCHW88::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_x86_conv_bias_fp32_nchw88,
+            midout_iv("AlgoF32ChanWiseNCHW88::get_workspace"_hash)) {
+        return get_bundle(param, PACK).total_size_in_bytes();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoF32ChanWiseNCHW88::dispatch_kerns(
+        const NCBKernSizeParam& param) const {
+    conv_fun do_conv_fun = nullptr;
+    DISPATCH_CONV_KERN(do_conv_kern_chanwise_nchw88);
+    RETURN_NCB_KERNS(param.filter_meta.group / PACK, PACK);
+}
+
+#undef DO_CONV_KERN_FUN
+#undef GET_STRIDE_PARAM
+#undef GET_OP_PARAM
+#undef GET_BIAS_MODE_PARAM
+#undef DISPATCH_CONV_KERN
+#undef RETURN_NCB_KERNS
+
+// vim: syntax=cpp.doxygen
@@ -26,6 +26,10 @@ class ConvBiasImpl::AlgoPack : NonCopyableObj {
     AlgoAVX2DirectConvStride2 avx2_stride2_direct;
     AlgoChanWiseAvx2Stride1Qint8 avx2_stride1_chanwsie_qint8;
     AlgoChanWiseAvx2Stride2Qint8 avx2_stride2_chanwsie_qint8;
+    AlgoF32DirectNCHW88 f32_direct_nchw88;
+    AlgoF32DirectNCHWNCHW88 f32_direct_nchw_nchw88;
+    AlgoF32ChanWiseNCHW88 f32_chanwise_nchw88;
+    AlgoF32ChanWiseAvx2 f32_chanwise_avx2;
 #if MEGDNN_X86_WITH_MKL_DNN
     AlgoMkldnnMatmulQint8 mkldnn_matmul_qint8;
     //! Because the mkldnnconv need handle
@@ -47,6 +51,10 @@ public:
         m_all_no_winograd_algo.emplace_back(&mkldnn_matmul_qint8);
         m_all_no_winograd_algo.emplace_back(&mkldnn_qint8);
 #endif
+        m_all_no_winograd_algo.emplace_back(&f32_chanwise_nchw88);
+        m_all_no_winograd_algo.emplace_back(&f32_direct_nchw_nchw88);
+        m_all_no_winograd_algo.emplace_back(&f32_direct_nchw88);
+        m_all_no_winograd_algo.emplace_back(&f32_chanwise_avx2);
         m_all_no_winograd_algo.emplace_back(&stride1_direct);
         m_all_no_winograd_algo.emplace_back(&stride2_direct);
         m_all_no_winograd_algo.emplace_back(&avx2_stride1_chanwsie_qint8);
@@ -159,8 +167,12 @@ SmallVector<AlgoCategory> ConvBiasImpl::suggest_algo_category_order(
     auto FH = param.filter_meta.spatial[0];
     auto FW = param.filter_meta.spatial[1];
     //! TODO: now winograd only support fast-run
-    //! nchw88 use mkl-dnn which algo is direct
+    //! nchw88 use the avx2 direct algos or mkl-dnn, which are direct, and
+    //! conv1x1 runs on the mk8 matmul
     if (param.filter_meta.format == param::ConvBias::Format::NCHW88) {
+        if (FH == 1 && FW == 1) {
+            return {AlgoCategory::IM2COL, AlgoCategory::DIRECT};
+        }
         return {AlgoCategory::DIRECT, AlgoCategory::IM2COL};
     }
     //! im2col + matmul
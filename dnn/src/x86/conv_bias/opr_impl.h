@@ -47,6 +47,10 @@ private:
     class AlgoAVX2DirectConvStride2;
     class AlgoChanWiseAvx2Stride1Qint8;
     class AlgoChanWiseAvx2Stride2Qint8;
+    class AlgoF32DirectNCHW88;
+    class AlgoF32DirectNCHWNCHW88;
+    class AlgoF32ChanWiseNCHW88;
+    class AlgoF32ChanWiseAvx2;
 #if MEGDNN_X86_WITH_MKL_DNN
     class AlgoMkldnnConv;
     class AlgoMkldnnQint8;
@@ -104,24 +104,26 @@ namespace x86 {
         cb_binary(CALLER, SIMDType::NONE)        \
     }
 
-#define FOR_BIAS(bias_mode)                                                     \
-    switch (bias_mode) {                                                        \
-        case BiasMode::NO_BIAS:                                                 \
-            FOR_NONLINEAR_NOBIAS();                                             \
-            break;                                                              \
-        case BiasMode::BROADCAST_CHANNEL_BIAS:                                  \
-            if (pack_oc_size == 1) {                                            \
-                FOR_NONLINEAR(CALL_BINARY_BROADCAST);                           \
-            } else {                                                            \
-                megdnn_assert(pack_oc_size == 4, "Only support nchw44 in x86"); \
-                FOR_NONLINEAR(CALL_BINARY_BROADCAST_NCHWXX);                    \
-            }                                                                   \
-            break;                                                              \
-        case BiasMode::BIAS:                                                    \
-            FOR_NONLINEAR(CALL_BINARY);                                         \
-            break;                                                              \
-        default:                                                                \
-            break;                                                              \
+#define FOR_BIAS(bias_mode)                                       \
+    switch (bias_mode) {                                          \
+        case BiasMode::NO_BIAS:                                   \
+            FOR_NONLINEAR_NOBIAS();                               \
+            break;                                                \
+        case BiasMode::BROADCAST_CHANNEL_BIAS:                    \
+            if (pack_oc_size == 1) {                              \
+                FOR_NONLINEAR(CALL_BINARY_BROADCAST);             \
+            } else {                                              \
+                megdnn_assert(                                    \
+                        pack_oc_size == 4 || pack_oc_size == 8,   \
+                        "Only support nchw44 and nchw88 in x86"); \
+                FOR_NONLINEAR(CALL_BINARY_BROADCAST_NCHWXX);      \
+            }                                                     \
+            break;                                                \
+        case BiasMode::BIAS:                                      \
+            FOR_NONLINEAR(CALL_BINARY);                           \
+            break;                                                \
+        default:                                                  \
+            break;                                                \
     }
 
 template <
@@ -136,8 +138,8 @@ struct PostProcess {
             size_t pack_oc_size = 1) {
         MEGDNN_MARK_USED_VAR(pack_oc_size);
         megdnn_assert(
-                pack_oc_size == 1 || pack_oc_size == 4,
-                "PostProcess only support nchw/44 in x86");
+                pack_oc_size == 1 || pack_oc_size == 4 || pack_oc_size == 8,
+                "PostProcess only support nchw/44/88 in x86");
         megdnn::param::Elemwise::Mode elem_mode = megdnn::param::Elemwise::Mode::ADD;
         if (bias_mode != megdnn::ConvBiasForward::BiasMode::NO_BIAS) {
             switch (nonlineMode) {
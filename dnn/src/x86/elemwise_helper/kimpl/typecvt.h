@@ -33,6 +33,20 @@ namespace x86 {
     __m128 fval_2 = _mm_cvtepi32_ps(val_2); \
     __m128 fval_3 = _mm_cvtepi32_ps(val_3);
 
+#define CONVERT_8BIT_INT32_AVX(_type)                                         \
+    __m128i vsrc_lo = _mm256_extracti128_si256(vsrc, 0);                      \
+    __m128i vsrc_hi = _mm256_extracti128_si256(vsrc, 1);                      \
+    __m256i val_0 = _mm256_cvtep##_type##_epi32(vsrc_lo);                     \
+    __m256i val_1 = _mm256_cvtep##_type##_epi32(_mm_bsrli_si128(vsrc_lo, 8)); \
+    __m256i val_2 = _mm256_cvtep##_type##_epi32(vsrc_hi);                     \
+    __m256i val_3 = _mm256_cvtep##_type##_epi32(_mm_bsrli_si128(vsrc_hi, 8));
+
+#define CONVERT_INT32_F32_AVX                  \
+    __m256 fval_0 = _mm256_cvtepi32_ps(val_0); \
+    __m256 fval_1 = _mm256_cvtepi32_ps(val_1); \
+    __m256 fval_2 = _mm256_cvtepi32_ps(val_2); \
+    __m256 fval_3 = _mm256_cvtepi32_ps(val_3);
+
 template <SIMDType simd_type, typename src_ctype, typename dst_ctype = src_ctype>
 struct TypeCvtOp;
 
@@ -242,7 +256,7 @@ struct TypeCvtOp<SIMDType::AVX2, dt_qint32, dt_qint8>
 
     MEGDNN_ATTRIBUTE_TARGET("avx2")
     void operator()(const __m256ix2& vsrc, dt_qint8* dst) const {
-        _mm_store_si128((__m128i*)(dst), (operator()(vsrc)));
+        _mm_storeu_si128((__m128i*)(dst), (operator()(vsrc)));
     }
 
     MEGDNN_ATTRIBUTE_TARGET("avx2")
@@ -514,6 +528,108 @@ struct TypeCvtOp<SIMDType::SSE4_2, dt_qint32, dt_float32>
     }
 };
 
+template <>
+struct TypeCvtOp<SIMDType::AVX2, dt_float32, dt_qint8>
+        : UnaryOpBase<SIMDType::AVX2, dt_float32, dt_qint8> {
+    using UnaryOpBase::UnaryOpBase;
+    constexpr static size_t SIMD_WIDTH = 8;
+
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256x2& vsrc, dt_qint8* dst) const {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), operator()(vsrc));
+    }
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    __m128i operator()(const __m256x2& vsrc) const {
+        auto vitem0 = _mm256_mul_ps(vsrc.val[0], _mm256_set1_ps(this->scale));
+        auto vitem1 = _mm256_mul_ps(vsrc.val[1], _mm256_set1_ps(this->scale));
+        return QConverter::convert<__m128i, __m256x2>({{vitem0, vitem1}});
+    }
+    void operator()(src_ctype src, dst_ctype* dst) {
+        *reinterpret_cast<int8_t*>(dst) =
+                saturate<int8_t, float>(std::round(src * scale), -128, 127);
+    }
+};
+
+template <>
+struct TypeCvtOp<SIMDType::AVX2, dt_float32, dt_quint8>
+        : UnaryOpBase<SIMDType::AVX2, dt_float32, dt_quint8> {
+    using UnaryOpBase::UnaryOpBase;
+    constexpr static size_t SIMD_WIDTH = 8;
+
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256x2& vsrc, dt_quint8* dst) const {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), operator()(vsrc));
+    }
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    __m128i operator()(const __m256x2& vsrc) const {
+        auto vitem0 = _mm256_mul_ps(vsrc.val[0], _mm256_set1_ps(this->scale));
+        auto vitem1 = _mm256_mul_ps(vsrc.val[1], _mm256_set1_ps(this->scale));
+        return QConverter::convert<__m128i, __m256x2, __m256i>(
+                {{vitem0, vitem1}}, _mm256_set1_epi32(this->dzp));
+    }
+    void operator()(src_ctype src, dst_ctype* dst) {
+        *reinterpret_cast<uint8_t*>(dst) =
+                saturate<uint8_t, float>(std::round(src * scale) + dzp, 0, 255);
+    }
+};
+
+template <>
+struct TypeCvtOp<SIMDType::AVX2, dt_qint8, dt_float32>
+        : UnaryOpBase<SIMDType::AVX2, dt_qint8, dt_float32> {
+    using UnaryOpBase::UnaryOpBase;
+    constexpr static size_t SIMD_WIDTH = 32;
+
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256ix2& vsrc, dt_float32* dst) const {
+        operator()(vsrc.val[0], reinterpret_cast<float*>(dst));
+        operator()(vsrc.val[1], reinterpret_cast<float*>(dst) + SIMD_WIDTH);
+    }
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256i& vsrc, float* dst) const {
+        CONVERT_8BIT_INT32_AVX(i8)
+        CONVERT_INT32_F32_AVX
+        auto vscale = _mm256_set1_ps(this->scale);
+        _mm256_storeu_ps(dst, _mm256_mul_ps(fval_0, vscale));
+        _mm256_storeu_ps(dst + 8, _mm256_mul_ps(fval_1, vscale));
+        _mm256_storeu_ps(dst + 16, _mm256_mul_ps(fval_2, vscale));
+        _mm256_storeu_ps(dst + 24, _mm256_mul_ps(fval_3, vscale));
+    }
+    void operator()(src_ctype src, dst_ctype* dst) {
+        *reinterpret_cast<float*>(dst) = src.as_int8() * scale;
+    }
+};
+
+template <>
+struct TypeCvtOp<SIMDType::AVX2, dt_quint8, dt_float32>
+        : UnaryOpBase<SIMDType::AVX2, dt_quint8, dt_float32> {
+    using UnaryOpBase::UnaryOpBase;
+    constexpr static size_t SIMD_WIDTH = 32;
+
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256ix2& vsrc, dt_float32* dst) const {
+        operator()(vsrc.val[0], reinterpret_cast<float*>(dst));
+        operator()(vsrc.val[1], reinterpret_cast<float*>(dst) + SIMD_WIDTH);
+    }
+    MEGDNN_ATTRIBUTE_TARGET("avx2")
+    void operator()(const __m256i& vsrc, float* dst) const {
+        CONVERT_8BIT_INT32_AVX(u8)
+        auto vszp = _mm256_set1_epi32(this->szp);
+        val_0 = _mm256_sub_epi32(val_0, vszp);
+        val_1 = _mm256_sub_epi32(val_1, vszp);
+        val_2 = _mm256_sub_epi32(val_2, vszp);
+        val_3 = _mm256_sub_epi32(val_3, vszp);
+        CONVERT_INT32_F32_AVX
+        auto vscale = _mm256_set1_ps(this->scale);
+        _mm256_storeu_ps(dst, _mm256_mul_ps(fval_0, vscale));
+        _mm256_storeu_ps(dst + 8, _mm256_mul_ps(fval_1, vscale));
+        _mm256_storeu_ps(dst + 16, _mm256_mul_ps(fval_2, vscale));
+        _mm256_storeu_ps(dst + 24, _mm256_mul_ps(fval_3, vscale));
+    }
+    void operator()(src_ctype src, dst_ctype* dst) {
+        *reinterpret_cast<float*>(dst) = (src.as_uint8() - szp) * scale;
+    }
+};
+
 template <>
 struct TypeCvtOp<SIMDType::NONE, dt_float32, dt_float32>
         : UnaryOpBase<SIMDType::NONE, dt_float32, dt_float32> {
@@ -525,6 +641,8 @@ struct TypeCvtOp<SIMDType::NONE, dt_float32, dt_float32>
 #undef CONVERT_INT8_INT32
 #undef CONVERT_UINT8_INT32
 #undef CONVERT_INT32_F32
+#undef CONVERT_8BIT_INT32_AVX
+#undef CONVERT_INT32_F32_AVX
 }  // namespace x86
 }  // namespace megdnn
    // vim: syntax=cpp.doxygen
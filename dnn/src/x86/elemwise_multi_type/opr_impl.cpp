@@ -74,9 +74,10 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
         thin_function<void(const src_ctype*, dst_ctype*, DType, DType, size_t)> run =  \
                 OpCallerUnary<_op<_simd_type, src_ctype, dst_ctype>, _simd_type>::run; \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                                  \
-                run(src.ptr<src_ctype>(), dst.ptr<dst_ctype>(), src.layout.dtype,      \
-                    dst.layout.dtype, nr_elems));                                      \
+        dispatch_elems(nr_elems, [=](size_t offset, size_t len) {                      \
+            run(src.ptr<src_ctype>() + offset, dst.ptr<dst_ctype>() + offset,          \
+                src.layout.dtype, dst.layout.dtype, len);                              \
+        });                                                                            \
         return;                                                                        \
     }
     TensorND src = param[0];
@@ -166,9 +167,11 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
                 run = OpCallerBinary<                                                \
                         _op<_simd_type, src_ctype, dst_ctype>, _simd_type,           \
                         VEC_VEC>::run;                                               \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(run(                                            \
-                src0.ptr<src_ctype>(), src1.ptr<src_ctype>(), dst.ptr<dst_ctype>(),  \
-                src0.layout.dtype, src1.layout.dtype, dst.layout.dtype, nr_elems));  \
+        dispatch_elems(nr_elems, [=](size_t offset, size_t len) {                    \
+            run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>() + offset,      \
+                dst.ptr<dst_ctype>() + offset, src0.layout.dtype, src1.layout.dtype, \
+                dst.layout.dtype, len);                                              \
+        });                                                                          \
         return;                                                                      \
     }
         DISPATCH_SIMD();
@@ -190,21 +193,22 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
             auto &lhs = src0, &rhs = src1;
             if (swap_case)
                 std::swap(lhs, rhs);
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)              \
-    case _mode: {                                                                   \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                      \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                      \
-        thin_function<void(                                                         \
-                const src_ctype*, const src_ctype, dst_ctype*, DType, DType, DType, \
-                size_t)>                                                            \
-                run = OpCallerBinary<                                               \
-                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,          \
-                        VEC_SCALAR>::run;                                           \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                               \
-                run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>()[0],                \
-                    dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,     \
-                    dst.layout.dtype, src0.layout.total_nr_elems()));               \
-        return;                                                                     \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)                \
+    case _mode: {                                                                     \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                        \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                        \
+        thin_function<void(                                                           \
+                const src_ctype*, const src_ctype, dst_ctype*, DType, DType, DType,   \
+                size_t)>                                                              \
+                run = OpCallerBinary<                                                 \
+                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,            \
+                        VEC_SCALAR>::run;                                             \
+        dispatch_elems(src0.layout.total_nr_elems(), [=](size_t offset, size_t len) { \
+            run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>()[0],             \
+                dst.ptr<dst_ctype>() + offset, src0.layout.dtype, src1.layout.dtype,  \
+                dst.layout.dtype, len);                                               \
+        });                                                                           \
+        return;                                                                       \
     }
 
             DISPATCH_SIMD();
@@ -215,21 +219,22 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
         //! SCALAR + VEC
         if (!commutable && is_vector(src1.layout) &&
             is_broadcasted_scalar(src0.layout)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)              \
-    case _mode: {                                                                   \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                      \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                      \
-        thin_function<void(                                                         \
-                const src_ctype, const src_ctype*, dst_ctype*, DType, DType, DType, \
-                size_t)>                                                            \
-                run = OpCallerBinary<                                               \
-                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,          \
-                        SCALAR_VEC>::run;                                           \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                               \
-                run(src0.ptr<src_ctype>()[0], src1.ptr<src_ctype>(),                \
-                    dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,     \
-                    dst.layout.dtype, src1.layout.total_nr_elems()));               \
-        return;                                                                     \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)                \
+    case _mode: {                                                                     \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                        \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                        \
+        thin_function<void(                                                           \
+                const src_ctype, const src_ctype*, dst_ctype*, DType, DType, DType,   \
+                size_t)>                                                              \
+                run = OpCallerBinary<                                                 \
+                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,            \
+                        SCALAR_VEC>::run;                                             \
+        dispatch_elems(src1.layout.total_nr_elems(), [=](size_t offset, size_t len) { \
+            run(src0.ptr<src_ctype>()[0], src1.ptr<src_ctype>() + offset,             \
+                dst.ptr<dst_ctype>() + offset, src0.layout.dtype, src1.layout.dtype,  \
+                dst.layout.dtype, len);                                               \
+        });                                                                           \
+        return;                                                                       \
     }
             DISPATCH_SIMD();
 
@@ -264,10 +269,14 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
                 run = OpCallerBinary<                                                \
                         _op<_simd_type, src_ctype, dst_ctype>, _simd_type,           \
                         VEC_BCAST101>::run;                                          \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                                \
-                run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                    \
-                    dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,      \
-                    dst.layout.dtype, binfo.x, binfo.y, binfo.z));                   \
+        dispatch_channels(                                                           \
+                binfo.x, binfo.y, binfo.z,                                           \
+                [=](size_t row, size_t nr_rows, size_t channel) {                    \
+                    run(src0.ptr<src_ctype>() + row * binfo.z,                       \
+                        src1.ptr<src_ctype>() + channel,                             \
+                        dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,     \
+                        src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.z);   \
+                });                                                                  \
         return;                                                                      \
     }
 
@@ -288,10 +297,14 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
                 run = OpCallerBinary<                                                \
                         _op<_simd_type, src_ctype, dst_ctype>, _simd_type,           \
                         BCAST101_VEC>::run;                                          \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                                \
-                run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                    \
-                    dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,      \
-                    dst.layout.dtype, binfo.x, binfo.y, binfo.z));                   \
+        dispatch_channels(                                                           \
+                binfo.x, binfo.y, binfo.z,                                           \
+                [=](size_t row, size_t nr_rows, size_t channel) {                    \
+                    run(src0.ptr<src_ctype>() + channel,                             \
+                        src1.ptr<src_ctype>() + row * binfo.z,                       \
+                        dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,     \
+                        src1.layout.dtype, dst.layout.dtype, 1, nr_rows, binfo.z);   \
+                });                                                                  \
         return;                                                                      \
     }
 
@@ -343,21 +356,23 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
     //! VEC + VEC + VEC
     if (is_vector(src0.layout) && is_vector(src1.layout) && is_vector(src2.layout)) {
         size_t nr_elems = src0.layout.total_nr_elems();
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)               \
-    case _mode: {                                                                    \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                       \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                       \
-        thin_function<void(                                                          \
-                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,    \
-                DType, DType, DType, DType, size_t)>                                 \
-                run = OpCallerTernary<                                               \
-                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,           \
-                        VEC_VEC_VEC>::run;                                           \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(run(                                            \
-                src0.ptr<src_ctype>(), src1.ptr<src_ctype>(), src2.ptr<src_ctype>(), \
-                dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,          \
-                src2.layout.dtype, dst.layout.dtype, nr_elems));                     \
-        return;                                                                      \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)            \
+    case _mode: {                                                                 \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                    \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                    \
+        thin_function<void(                                                       \
+                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*, \
+                DType, DType, DType, DType, size_t)>                              \
+                run = OpCallerTernary<                                            \
+                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,        \
+                        VEC_VEC_VEC>::run;                                        \
+        dispatch_elems(nr_elems, [=](size_t offset, size_t len) {                 \
+            run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>() + offset,   \
+                src2.ptr<src_ctype>() + offset, dst.ptr<dst_ctype>() + offset,    \
+                src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,          \
+                dst.layout.dtype, len);                                           \
+        });                                                                       \
+        return;                                                                   \
     }
         DISPATCH_SIMD();
 #undef DISPATCH_SINGLE_MODE
@@ -366,22 +381,23 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
     //! VEC + VEC + SCALAR
     if (is_vector(src0.layout) && is_vector(src1.layout) &&
         is_broadcasted_scalar(src2.layout)) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)                 \
-    case _mode: {                                                                      \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                         \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                         \
-        thin_function<void(                                                            \
-                const src_ctype*, const src_ctype*, const src_ctype, dst_ctype*,       \
-                DType, DType, DType, DType, size_t)>                                   \
-                run = OpCallerTernary<                                                 \
-                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,             \
-                        VEC_VEC_SCALAR>::run;                                          \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                                  \
-                run(src0.ptr<src_ctype>(), src1.ptr<src_ctype>(),                      \
-                    src2.ptr<src_ctype>()[0], dst.ptr<dst_ctype>(), src0.layout.dtype, \
-                    src1.layout.dtype, src2.layout.dtype, dst.layout.dtype,            \
-                    src0.layout.total_nr_elems()));                                    \
-        return;                                                                        \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)                \
+    case _mode: {                                                                     \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                        \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                        \
+        thin_function<void(                                                           \
+                const src_ctype*, const src_ctype*, const src_ctype, dst_ctype*,      \
+                DType, DType, DType, DType, size_t)>                                  \
+                run = OpCallerTernary<                                                \
+                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,            \
+                        VEC_VEC_SCALAR>::run;                                         \
+        dispatch_elems(src0.layout.total_nr_elems(), [=](size_t offset, size_t len) { \
+            run(src0.ptr<src_ctype>() + offset, src1.ptr<src_ctype>() + offset,       \
+                src2.ptr<src_ctype>()[0], dst.ptr<dst_ctype>() + offset,              \
+                src0.layout.dtype, src1.layout.dtype, src2.layout.dtype,              \
+                dst.layout.dtype, len);                                               \
+        });                                                                           \
+        return;                                                                       \
     }
         DISPATCH_SIMD();
 #undef DISPATCH_SINGLE_MODE
@@ -394,21 +410,27 @@ void ElemwiseMultiTypeImpl::on_quantized_mode(
                            is_broadcasted_channel_like(src0.layout, binfo) &&
                            src0.layout.eq_shape(src2.layout);
         if (normal_case) {
-#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)               \
-    case _mode: {                                                                    \
-        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                       \
-        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                       \
-        thin_function<void(                                                          \
-                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,    \
-                DType, DType, DType, DType, size_t, size_t, size_t)>                 \
-                run = OpCallerTernary<                                               \
-                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,           \
-                        BCAST101_VEC_BCAST101>::run;                                 \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(run(                                            \
-                src0.ptr<src_ctype>(), src1.ptr<src_ctype>(), src2.ptr<src_ctype>(), \
-                dst.ptr<dst_ctype>(), src0.layout.dtype, src1.layout.dtype,          \
-                src2.layout.dtype, dst.layout.dtype, binfo.x, binfo.y, binfo.z));    \
-        return;                                                                      \
+#define DISPATCH_SINGLE_MODE(_src_dt, _dst_dt, _mode, _op, _simd_type)             \
+    case _mode: {                                                                  \
+        using src_ctype = typename DTypeTrait<_src_dt>::ctype;                     \
+        using dst_ctype = typename DTypeTrait<_dst_dt>::ctype;                     \
+        thin_function<void(                                                        \
+                const src_ctype*, const src_ctype*, const src_ctype*, dst_ctype*,  \
+                DType, DType, DType, DType, size_t, size_t, size_t)>               \
+                run = OpCallerTernary<                                             \
+                        _op<_simd_type, src_ctype, dst_ctype>, _simd_type,         \
+                        BCAST101_VEC_BCAST101>::run;                               \
+        dispatch_channels(                                                         \
+                binfo.x, binfo.y, binfo.z,                                         \
+                [=](size_t row, size_t nr_rows, size_t channel) {                  \
+                    run(src0.ptr<src_ctype>() + channel,                           \
+                        src1.ptr<src_ctype>() + row * binfo.z,                     \
+                        src2.ptr<src_ctype>() + channel,                           \
+                        dst.ptr<dst_ctype>() + row * binfo.z, src0.layout.dtype,   \
+                        src1.layout.dtype, src2.layout.dtype, dst.layout.dtype, 1, \
+                        nr_rows, binfo.z);                                         \
+                });                                                                \
+        return;                                                                    \
     }
             DISPATCH_SIMD();
 #undef DISPATCH_SINGLE_MODE
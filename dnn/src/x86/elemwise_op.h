@@ -269,21 +269,25 @@ struct OpCallerBinary<Op, SIMDType::SSE4_2, VEC_BCAST101xX> {
             typename Op::dst_ctype* dst, DType src0_dtype, DType src1_dtype,
             DType dst_dtype, size_t batch, size_t channel, size_t channel_stride,
             size_t channel_block_dim) {
-        megdnn_assert(channel_block_dim == 4, "only imp for nchw44");
+        megdnn_assert(
+                channel_block_dim == 4 || channel_block_dim == 8,
+                "only imp for nchw44 and nchw88");
         Op op(src0_dtype, src1_dtype, dst_dtype);
         ParamElemVisitor<typename Op::src_ctype, SIMDType::SSE4_2> vis0;
         ParamElemVisitor<typename Op::src_ctype, SIMDType::SSE4_2> vis1;
+        //! a channel block of nchw88 spans the two halves of one step
+        size_t src1_hi_offset = channel_block_dim == 8 ? Op::SIMD_WIDTH : 0;
+        size_t img_step = 2 * Op::SIMD_WIDTH / channel_block_dim;
         for (size_t b = 0; b < batch; b++) {
             const typename Op::src_ctype* src1_ptr = src1;
             for (size_t c = 0; c < channel; c++) {
                 auto src1_block_ptr = src1_ptr + c * channel_block_dim;
-                auto channel_block_vec = vis1(src1_block_ptr);
+                auto channel_block_vec0 = vis1(src1_block_ptr);
+                auto channel_block_vec1 = vis1(src1_block_ptr + src1_hi_offset);
                 size_t img_index = 0;
-                auto src0_offset = Op::SIMD_WIDTH / channel_block_dim;
-                for (; img_index + 2 * src0_offset <= channel_stride;
-                     img_index += 2 * src0_offset) {
+                for (; img_index + img_step <= channel_stride; img_index += img_step) {
                     op({{vis0(src0), vis0(src0 + Op::SIMD_WIDTH)}},
-                       {{channel_block_vec, channel_block_vec}}, dst);
+                       {{channel_block_vec0, channel_block_vec1}}, dst);
                     src0 += Op::SIMD_WIDTH * 2;
                     dst += Op::SIMD_WIDTH * 2;
                 }
@@ -307,19 +311,23 @@ struct OpCallerBinary<Op, SIMDType::AVX2, VEC_BCAST101xX> {
             typename Op::dst_ctype* dst, DType src0_dtype, DType src1_dtype,
             DType dst_dtype, size_t batch, size_t channel, size_t channel_stride,
             size_t channel_block_dim) {
-        megdnn_assert(channel_block_dim == 4, "only imp for nchw44");
+        megdnn_assert(
+                channel_block_dim == 4 || channel_block_dim == 8,
+                "only imp for nchw44 and nchw88");
         Op op(src0_dtype, src1_dtype, dst_dtype);
         ParamElemVisitor<typename Op::src_ctype, SIMDType::AVX2> vis0;
         ParamElemVisitorHalfBoardCast<typename Op::src_ctype, SIMDType::AVX2> vis1;
+        size_t img_step = 2 * Op::SIMD_WIDTH / channel_block_dim;
         for (size_t b = 0; b < batch; b++) {
             const typename Op::src_ctype* src1_ptr = src1;
             for (size_t c = 0; c < channel; c++) {
                 auto src1_block_ptr = src1_ptr + c * channel_block_dim;
-                auto channel_block_vec = vis1(src1_block_ptr);
+                //! a channel block of nchw88 fills a whole vector
+                auto channel_block_vec = channel_block_dim == 8
+                                               ? vis0(src1_block_ptr)
+                                               : vis1(src1_block_ptr);
                 size_t img_index = 0;
-                auto src0_offset = Op::SIMD_WIDTH / channel_block_dim;
-                for (; img_index + 2 * src0_offset <= channel_stride;
-                     img_index += 2 * src0_offset) {
+                for (; img_index + img_step <= channel_stride; img_index += img_step) {
                     op({{vis0(src0), vis0(src0 + Op::SIMD_WIDTH)}},
                        {{channel_block_vec, channel_block_vec}}, dst);
                     src0 += Op::SIMD_WIDTH * 2;
@@ -6,6 +6,114 @@
 
 using namespace megdnn;
 using namespace x86;
+
+namespace {
+
+#if !MEGDNN_DISABLE_FLOAT16
+//! every AVX2 cpu also implements F16C, which is not detected on its own
+MEGDNN_ATTRIBUTE_TARGET("avx2,f16c")
+void cvt_f16_to_f32(const dt_float16* src, float* dst, size_t nr_elems) {
+    size_t i = 0;
+    for (; i + 16 <= nr_elems; i += 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v0));
+        _mm256_storeu_ps(dst + i + 8, _mm256_cvtph_ps(v1));
+    }
+    for (; i < nr_elems; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+/*!
+ * dt_float16 rounds ties away from zero, which F16C does not implement: add
+ * half of an fp16 ulp to the magnitude and let the conversion truncate
+ */
+MEGDNN_ATTRIBUTE_TARGET("avx2,f16c")
+__m128i round_f32_to_f16(__m256 vsrc) {
+    __m256i bits = _mm256_castps_si256(vsrc);
+    __m256i sign = _mm256_and_si256(bits, _mm256_set1_epi32(0x80000000));
+    __m256i mag = _mm256_xor_si256(bits, sign);
+    //! normal fp16 keep 10 of the 23 mantissa bits of fp32
+    __m256i rounded = _mm256_add_epi32(mag, _mm256_set1_epi32(0x1000));
+    //! below 2^-14 fp16 are subnormal, with a fixed ulp of 2^-24
+    __m256i subnormal = _mm256_castps_si256(
+            _mm256_add_ps(_mm256_castsi256_ps(mag), _mm256_set1_ps(2.98023224e-8f)));
+    __m256i is_subnormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x38800000), mag);
+    rounded = _mm256_blendv_epi8(rounded, subnormal, is_subnormal);
+    //! truncation saturates to 65504, values rounded up to 65536 overflow
+    __m256i is_overflow = _mm256_cmpgt_epi32(rounded, _mm256_set1_epi32(0x477fffff));
+    rounded = _mm256_blendv_epi8(rounded, _mm256_set1_epi32(0x7f800000), is_overflow);
+    //! inf and nan are kept
+    __m256i is_special = _mm256_cmpgt_epi32(mag, _mm256_set1_epi32(0x7f7fffff));
+    rounded = _mm256_blendv_epi8(rounded, mag, is_special);
+    return _mm256_cvtps_ph(
+            _mm256_castsi256_ps(_mm256_or_si256(rounded, sign)), _MM_FROUND_TO_ZERO);
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2,f16c")
+void cvt_f32_to_f16(const float* src, dt_float16* dst, size_t nr_elems) {
+    size_t i = 0;
+    for (; i + 16 <= nr_elems; i += 16) {
+        __m128i v0 = round_f32_to_f16(_mm256_loadu_ps(src + i));
+        __m128i v1 = round_f32_to_f16(_mm256_loadu_ps(src + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), v1);
+    }
+    for (; i < nr_elems; ++i) {
+        dst[i] = static_cast<dt_float16>(src[i]);
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void cvt_bf16_to_f32(const dt_bfloat16* src, float* dst, size_t nr_elems) {
+    size_t i = 0;
+    for (; i + 8 <= nr_elems; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(v, 16)));
+    }
+    for (; i < nr_elems; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+//! round to nearest even as float2bfloat16() does, NaNs stay quiet
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+__m256i round_f32_to_bf16(__m256 vsrc) {
+    __m256i bits = _mm256_castps_si256(vsrc);
+    __m256i exp_mask = _mm256_set1_epi32(0x7f800000);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i rounded =
+            _mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+    __m256i low_zero = _mm256_cmpeq_epi32(
+            _mm256_and_si256(bits, _mm256_set1_epi32(0xffff)), _mm256_setzero_si256());
+    __m256i nan_bit = _mm256_andnot_si256(low_zero, _mm256_set1_epi32(0x10000));
+    __m256i special = _mm256_or_si256(bits, nan_bit);
+    __m256i is_special =
+            _mm256_cmpeq_epi32(_mm256_and_si256(bits, exp_mask), exp_mask);
+    return _mm256_srli_epi32(_mm256_blendv_epi8(rounded, special, is_special), 16);
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void cvt_f32_to_bf16(const float* src, dt_bfloat16* dst, size_t nr_elems) {
+    size_t i = 0;
+    for (; i + 16 <= nr_elems; i += 16) {
+        __m256i v0 = round_f32_to_bf16(_mm256_loadu_ps(src + i));
+        __m256i v1 = round_f32_to_bf16(_mm256_loadu_ps(src + i + 8));
+        //! packus works within 128-bit lanes, restore the element order
+        __m256i v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v0, v1), 0xd8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    for (; i < nr_elems; ++i) {
+        dst[i] = static_cast<dt_bfloat16>(src[i]);
+    }
+}
+
+#endif
+
+}  // anonymous namespace
+
 #define DISPATCH_CONVERT_TYPE                                                   \
     DISPATCH_QUANTIZED(QuantizedS32, dt_qint32, Quantized8Asymm, dt_quint8);    \
     DISPATCH_QUANTIZED(Quantized8Asymm, dt_quint8, Quantized8Asymm, dt_quint8); \
@@ -23,34 +131,67 @@ using namespace x86;
     DISPATCH_QUANTIZED(Quantized8Asymm, dt_quint8, Float32, dt_float32);        \
     DISPATCH_QUANTIZED(QuantizedS32, dt_qint32, Float32, dt_float32);
 
+//! the pairs that also have an AVX2 TypeCvtOp, mostly model inputs and outputs
+#define DISPATCH_CONVERT_TYPE_AVX2                                       \
+    DISPATCH_QUANTIZED(QuantizedS32, dt_qint32, QuantizedS8, dt_qint8);  \
+    DISPATCH_QUANTIZED(Float32, dt_float32, QuantizedS8, dt_qint8);      \
+    DISPATCH_QUANTIZED(Float32, dt_float32, Quantized8Asymm, dt_quint8); \
+    DISPATCH_QUANTIZED(QuantizedS8, dt_qint8, Float32, dt_float32);      \
+    DISPATCH_QUANTIZED(Quantized8Asymm, dt_quint8, Float32, dt_float32);
+
 void TypeCvtImpl::exec(_megdnn_tensor_in src, _megdnn_tensor_out dst) {
     DType src_dtype = src.layout.dtype;
     DType dst_dtype = dst.layout.dtype;
     size_t nr_elems = src.layout.total_nr_elems();
     bool execed = false;
     if (src.layout.is_contiguous() && dst.layout.is_contiguous()) {
-        if (is_supported(SIMDType::SSE4_2)) {
-            using namespace dtype;
-#define DISPATCH_QUANTIZED(_stype_enumv, _stype, _dtype_enumv, _dtype)          \
-    if (src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&                 \
-        dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                 \
-        using op = TypeCvtOp<SIMDType::SSE4_2, _stype, _dtype>;                 \
-        thin_function<void(const _stype*, _dtype*, DType, DType, size_t)> run = \
-                OpCallerUnary<op, SIMDType::SSE4_2>::run;                       \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                           \
-                run(src.compatible_ptr<_stype>(), dst.compatible_ptr<_dtype>(), \
-                    src_dtype, dst_dtype, nr_elems));                           \
-        execed = true;                                                          \
+        using namespace dtype;
+#define DISPATCH_QUANTIZED(_stype_enumv, _stype, _dtype_enumv, _dtype)             \
+    if (!execed && src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&         \
+        dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                    \
+        using op = TypeCvtOp<SIMD_TYPE, _stype, _dtype>;                           \
+        dispatch_blocks(nr_elems, [=](size_t offset, size_t nr_elems_block) {      \
+            OpCallerUnary<op, SIMD_TYPE>::run(                                     \
+                    src.compatible_ptr<_stype>() + offset,                         \
+                    dst.compatible_ptr<_dtype>() + offset, src_dtype, dst_dtype,   \
+                    nr_elems_block);                                               \
+        });                                                                        \
+        execed = true;                                                             \
     }
+#define DISPATCH_FLOAT(_stype_enumv, _stype, _dtype_enumv, _dtype, _cvt)      \
+    if (!execed && src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&    \
+        dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {               \
+        dispatch_blocks(nr_elems, [=](size_t offset, size_t nr_elems_block) { \
+            _cvt(src.ptr<_stype>() + offset, dst.ptr<_dtype>() + offset,      \
+                 nr_elems_block);                                             \
+        });                                                                   \
+        execed = true;                                                        \
+    }
+        if (is_supported(SIMDType::AVX2)) {
+#define SIMD_TYPE SIMDType::AVX2
+            DISPATCH_CONVERT_TYPE_AVX2
+#undef SIMD_TYPE
+#if !MEGDNN_DISABLE_FLOAT16
+            DISPATCH_FLOAT(Float16, dt_float16, Float32, dt_float32, cvt_f16_to_f32);
+            DISPATCH_FLOAT(Float32, dt_float32, Float16, dt_float16, cvt_f32_to_f16);
+            DISPATCH_FLOAT(BFloat16, dt_bfloat16, Float32, dt_float32, cvt_bf16_to_f32);
+            DISPATCH_FLOAT(Float32, dt_float32, BFloat16, dt_bfloat16, cvt_f32_to_bf16);
+#endif
+        }
+        if (is_supported(SIMDType::SSE4_2)) {
+#define SIMD_TYPE SIMDType::SSE4_2
             DISPATCH_CONVERT_TYPE
-#undef DISPATCH_QUANTIZED
+#undef SIMD_TYPE
         }
+#undef DISPATCH_FLOAT
+#undef DISPATCH_QUANTIZED
     }
     if (!execed) {
         fallback::TypeCvtImpl::exec(src, dst);
     }
 }
 
+#undef DISPATCH_CONVERT_TYPE_AVX2
 #undef DISPATCH_CONVERT_TYPE
 
 // vim: syntax=cpp.doxygen
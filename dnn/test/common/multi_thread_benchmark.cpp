@@ -0,0 +1,51 @@
+#include "test/common/multi_thread_benchmark.h"
+
+#include <cstdio>
+
+namespace megdnn {
+namespace test {
+
+#if MEGDNN_WITH_BENCHMARK
+void benchmark_multi_thread(
+        const std::vector<MultiThreadBenchmarkCase>& cases,
+        TaskExecutorConfig&& multi_thread_config,
+        TaskExecutorConfig&& single_thread_config, int debug_level,
+        bool compare_naive) {
+    auto multi_thread_handle =
+            create_cpu_handle(debug_level, true, &multi_thread_config);
+    auto single_thread_handle =
+            create_cpu_handle(debug_level, true, &single_thread_config);
+    std::unique_ptr<Handle> naive_handle;
+    if (compare_naive) {
+        naive_handle = create_cpu_handle(2, false);
+    }
+    auto time_str = [](float time, float bytes) {
+        if (!bytes) {
+            return ssprintf("%fms", time);
+        }
+        return ssprintf("%fms %fGB/s", time, bytes / time / 1e6);
+    };
+    for (auto&& c : cases) {
+        float multi_thread_time = c.run(multi_thread_handle.get());
+        float single_thread_time = c.run(single_thread_handle.get());
+        std::string naive;
+        if (compare_naive) {
+            float naive_time = c.run(naive_handle.get());
+            naive = ssprintf(
+                    ", naive %s, speedup over naive %f",
+                    time_str(naive_time, c.bytes).c_str(),
+                    naive_time / single_thread_time);
+        }
+        printf("%s: %zu threads %s, single thread %s%s, speedup %f\n",
+               c.name.c_str(), multi_thread_config.nr_thread,
+               time_str(multi_thread_time, c.bytes).c_str(),
+               time_str(single_thread_time, c.bytes).c_str(), naive.c_str(),
+               single_thread_time / multi_thread_time);
+    }
+}
+#endif  // MEGDNN_WITH_BENCHMARK
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,40 @@
+#pragma once
+#include "megdnn/handle.h"
+#include "test/common/utils.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace megdnn {
+namespace test {
+
+#if MEGDNN_WITH_BENCHMARK
+//! a case of benchmark_multi_thread
+struct MultiThreadBenchmarkCase {
+    //! printed before the times of the case
+    std::string name;
+    //! run the case on the given handle and return its time in ms
+    std::function<float(Handle*)> run;
+    //! bytes read and written by the case, its bandwidth is printed if nonzero
+    float bytes = 0;
+};
+
+/*!
+ * \brief run the cases on cpu handles of \p debug_level with the multi thread
+ *      and the single thread config, and print their times and the speedup
+ *
+ * If \p compare_naive is true, the cases also run on the naive handle, and the
+ * speedup of the single thread over the naive one is printed as well.
+ */
+void benchmark_multi_thread(
+        const std::vector<MultiThreadBenchmarkCase>& cases,
+        TaskExecutorConfig&& multi_thread_config,
+        TaskExecutorConfig&& single_thread_config, int debug_level = 0,
+        bool compare_naive = false);
+#endif  // MEGDNN_WITH_BENCHMARK
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "megdnn/basic_types.h"
+
+namespace megdnn {
+namespace test {
+namespace rnn {
+
+//! shapes of a RNN or LSTM forward shared by the tests of both oprs
+struct TestArg {
+    size_t seq_len, batch_size, input_size, hidden_size, num_layers;
+    bool bidirectional, bias;
+
+    size_t D() const { return bidirectional ? 2 : 1; }
+
+    TensorShape input() const { return {seq_len, batch_size, input_size}; }
+
+    //! shape of hx, and of cx for LSTM
+    TensorShape state() const { return {num_layers * D(), batch_size, hidden_size}; }
+
+    //! flatten weights of a cell with \p nr_gates gates
+    TensorShape flatten_weights(size_t nr_gates) const {
+        size_t columns = 0;
+        for (size_t layer = 0; layer < num_layers; ++layer) {
+            columns +=
+                    D() * ((layer == 0 ? input_size : D() * hidden_size) + hidden_size);
+        }
+        columns += bias ? 2 * D() * num_layers : 0;
+        return {nr_gates * hidden_size, columns};
+    }
+};
+
+static inline std::vector<TestArg> get_args() {
+    std::vector<TestArg> args;
+    for (bool bias : {false, true})
+        for (bool bidirectional : {false, true})
+            for (size_t num_layers : {1, 3})
+                //! the hidden sizes cover partial and several column blocks
+                for (size_t batch_size : {1, 5})
+                    for (size_t hidden_size : {1, 20, 70}) {
+                        args.push_back(
+                                {6, batch_size, 7, hidden_size, num_layers,
+                                 bidirectional, bias});
+                    }
+    return args;
+}
+
+}  // namespace rnn
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
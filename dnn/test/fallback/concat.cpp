@@ -1,6 +1,8 @@
 #include "test/fallback/fixture.h"
 
+#include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/task_record_check.h"
 namespace megdnn {
 namespace test {
@@ -40,6 +42,67 @@ TEST_F(FALLBACK, CONCAT_RECORD) {
         checker.set_dtype(i, dtype::Float32());
     checker.set_param(param).exec(shapes);
 }
+
+TEST_F(FALLBACK_MULTI_THREADS, CONCAT) {
+    using Param = Concat::Param;
+    for (auto dtype : std::vector<DType>{
+                 dtype::Float32(), dtype::Float16(), dtype::Int8(),
+                 dtype::QuantizedS8(0.5f)}) {
+        Checker<Concat> checker(handle());
+        for (size_t axis = 0; axis < 4; ++axis) {
+            Param param;
+            param.axis = axis;
+            //! several segments per chunk, and chunks across segments
+            TensorShapeArray shapes(4, TensorShape({4, 16, 32, 40}));
+            for (size_t i = 0; i < 4; ++i) {
+                shapes[i].shape[axis] = i * 5 + 1;
+            }
+            shapes.emplace_back();
+            for (size_t i = 0; i < shapes.size(); ++i)
+                checker.set_dtype(i, dtype);
+            checker.set_param(param).exec(shapes);
+        }
+    }
+    //! large enough for the non-temporal stores
+    Checker<Concat> checker(handle());
+    Param param;
+    param.axis = 1;
+    checker.set_param(param).exec({{2, 24, 128, 128}, {2, 40, 128, 128}, {}});
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_CONCAT) {
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](const TensorShapeArray& shapes, size_t axis) {
+        Concat::Param param;
+        param.axis = axis;
+        auto run = [shapes, param](Handle* handle) {
+            Benchmarker<Concat> benchmarker(handle);
+            benchmarker.set_times(10).set_display(false).set_param(param);
+            return benchmarker.exec(shapes) / 10;
+        };
+        TensorLayout dst;
+        auto opr = handle()->create_operator<Concat>();
+        opr->param() = param;
+        TensorLayoutArray srcs;
+        for (size_t i = 0; i + 1 < shapes.size(); ++i) {
+            srcs.emplace_back(shapes[i], dtype::Float32());
+        }
+        opr->deduce_layout(srcs, dst);
+        cases.push_back(
+                {ssprintf("concat %s on axis %zu", dst.to_string().c_str(), axis), run,
+                 dst.span().dist_byte() * 2.f});
+    };
+    //! feature pyramid and U-Net skip connections
+    add_case({{1, 256, 64, 64}, {1, 256, 64, 64}, {}}, 1);
+    add_case({{1, 64, 256, 256}, {1, 64, 256, 256}, {}}, 1);
+    add_case({{1, 128, 128, 128}, {1, 64, 128, 128}, {1, 32, 128, 128}, {}}, 1);
+    add_case({{8, 256, 28, 28}, {8, 256, 28, 28}, {}}, 0);
+    add_case({{1, 32, 512, 512}, {1, 32, 512, 512}, {}}, 3);
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -1,8 +1,10 @@
 #include "test/fallback/fixture.h"
 
 #include <ctime>
+#include "test/common/benchmarker.h"
 #include "test/common/checker.h"
 #include "test/common/elemwise.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/task_record_check.h"
 #include "test/common/tensor.h"
 
@@ -384,6 +386,51 @@ TEST_F(FALLBACK, ELEMWISE_FORWARD_TERNARY_RECORD) {
     run();
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, ELEMWISE_FORWARD_BINARY) {
+    using Mode = ElemwiseForward::Param::Mode;
+    Checker<ElemwiseForward> checker(handle());
+
+    //! large enough to be split over threads, with rows not filling a cache line
+    auto run = [&](Mode mode) {
+        checker.set_param(mode);
+        // VEC_VEC, VEC_SCALAR and SCALAR_VEC
+        checker.execs({{2, 33, 57, 31}, {2, 33, 57, 31}, {}});
+        checker.execs({{2, 33, 57, 31}, {1, 1, 1, 1}, {}});
+        checker.execs({{1}, {2, 33, 57, 31}, {}});
+        // VEC_BCAST101 and BCAST101_VEC
+        checker.execs({{3, 33, 57, 31}, {1, 33, 1, 1}, {}});
+        checker.execs({{1, 33, 1, 1}, {3, 33, 57, 31}, {}});
+        // VEC_BCASTX0X and BCASTX0X_VEC
+        checker.execs({{4, 21, 781}, {4, 1, 781}, {}});
+        checker.execs({{4, 1, 781}, {4, 21, 781}, {}});
+        // VEC_BCAST111C and BCAST111C_VEC
+        checker.execs({{2, 57, 31, 33}, {1, 1, 1, 33}, {}});
+        checker.execs({{1, 1, 1, 33}, {2, 57, 31, 33}, {}});
+        // VEC_BCAST101xX and BCAST101xX_VEC
+        checker.execs({{3, 7, 61, 29, 4}, {1, 7, 1, 1, 4}, {}});
+        checker.execs({{1, 7, 1, 1, 4}, {3, 7, 61, 29, 4}, {}});
+        checker.execs({{3, 5, 31, 29, 8}, {1, 5, 1, 1, 8}, {}});
+        checker.execs({{1, 5, 1, 1, 8}, {3, 5, 31, 29, 8}, {}});
+        // small ones stay on one thread
+        checker.execs({{3, 4, 5, 6}, {1, 4, 1, 1}, {}});
+        checker.execs({{17}, {17}, {}});
+    };
+
+    checker.set_dtype(0, dtype::Int32());
+    checker.set_dtype(1, dtype::Int32());
+    run(Mode::ADD);
+    run(Mode::SUB);
+
+    UniformFloatRNG rng(1e-5, 7e1);
+    checker.set_rng(0, &rng);
+    checker.set_rng(1, &rng);
+    checker.set_epsilon(1e-5);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(1, dtype::Float32());
+    run(Mode::MUL);
+    run(Mode::SUB);
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_ELEMWISE) {
     auto naive_handle = create_cpu_handle(2);
@@ -427,6 +474,37 @@ TEST_F(FALLBACK, BENCHMARK_ELEMWISE) {
     // non-contig, fallback to naive
     run({1024, 1024, 32}, {1024, 1, 32});
 }
+
+TEST_F(FALLBACK, BENCHMARK_ELEMWISE_BINARY_MULTI_THREADS) {
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](const TensorShape& shp0, const TensorShape& shp1) {
+        auto run = [shp0, shp1](Handle* handle) {
+            Benchmarker<Elemwise> benchmarker(handle);
+            benchmarker.set_times(10).set_display(false).set_param(
+                    {Elemwise::Mode::ADD});
+            return benchmarker.exec({shp0, shp1, {}}) / 10;
+        };
+        TensorShape shpo;
+        Elemwise::deduce_shape({shp0, shp1}, shpo);
+        float bytes = (shp0.total_nr_elems() + shp1.total_nr_elems() +
+                       shpo.total_nr_elems()) *
+                      sizeof(float);
+        cases.push_back(
+                {ssprintf(
+                         "%s+%s", shp0.to_string().c_str(), shp1.to_string().c_str()),
+                 run, bytes});
+    };
+    //! residual add
+    add_case({1, 64, 256, 256}, {1, 64, 256, 256});
+    //! bias add in nchw, nhwc and nchw44
+    add_case({8, 256, 56, 56}, {1, 256, 1, 1});
+    add_case({8, 56, 56, 256}, {1, 1, 1, 256});
+    add_case({8, 64, 56, 56, 4}, {1, 64, 1, 1, 4});
+    //! scale and broadcast on the middle axis
+    add_case({1, 64, 256, 256}, {1});
+    add_case({64, 256, 1024}, {64, 1, 1024});
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}}, 1);
+}
 #endif
 
 // vim: syntax=cpp.doxygen
@@ -184,6 +184,40 @@ TEST_F(FALLBACK, ELEMWISE_QUANTIZED_MODE_TERNARY) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, ELEMWISE_QUANTIZED_MODE) {
+    using Mode = ElemwiseMultiType::Param::Mode;
+    Checker<ElemwiseMultiType> checker(handle());
+    UniformIntRNG rng_int8{-127, 127};
+    checker.set_rng(0, &rng_int8)
+            .set_rng(1, &rng_int8)
+            .set_rng(2, &rng_int8)
+            .set_dtype(0, dtype::QuantizedS8(1.45f))
+            .set_dtype(1, dtype::QuantizedS8(1.15f))
+            .set_dtype(2, dtype::QuantizedS8(1.75f))
+            .set_dtype(3, dtype::QuantizedS8(1.35f));
+
+    //! large enough to be split over threads, with uneven tails
+    checker.set_param({Mode::QRELU}).set_dtype(1, dtype::QuantizedS8(1.35f));
+    checker.execs({{100003}, {}});
+    checker.execs({{2, 33, 57, 31}, {}});
+
+    checker.set_param({Mode::QSUB}).set_dtype(2, dtype::QuantizedS8(1.35f));
+    checker.execs({{100003}, {100003}, {}});
+    checker.execs({{2, 33, 57, 31}, {1, 1, 1, 1}, {}});
+    checker.execs({{1}, {2, 33, 57, 31}, {}});
+    checker.execs({{2, 33, 57, 31}, {1, 33, 1, 1}, {}});
+    checker.execs({{1, 33, 1, 1}, {2, 33, 57, 31}, {}});
+    checker.execs({{3, 7, 61, 29, 4}, {1, 7, 1, 1, 4}, {}});
+    checker.execs({{1, 7, 1, 1, 4}, {3, 7, 61, 29, 4}, {}});
+
+    checker.set_param({Mode::QFUSE_MUL_ADD3}).set_dtype(2, dtype::QuantizedS8(1.75f));
+    checker.execs({{100003}, {100003}, {100003}, {}});
+    checker.execs({{2, 33, 57, 31}, {2, 33, 57, 31}, {1, 1, 1, 1}, {}});
+    checker.execs({{1, 33, 1, 1}, {2, 33, 57, 31}, {1, 33, 1, 1}, {}});
+    checker.execs({{3, 7, 61, 29, 4}, {1, 7, 1, 1, 4}, {3, 7, 61, 29, 4}, {}});
+    checker.execs({{1, 7, 1, 1, 4}, {3, 7, 61, 29, 4}, {1, 7, 1, 1, 4}, {}});
+}
+
 TEST_F(FALLBACK, ELEMWISE_MULTI_TYPE_RECORD_FMA3_INT16x32x32x32) {
     TaskRecordChecker<ElemwiseMultiType> checker{1};
     checker.set_param({ElemwiseMultiType::Mode::FUSE_MUL_ADD3_INT16x32x32x32});
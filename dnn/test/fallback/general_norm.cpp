@@ -0,0 +1,98 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
+
+#include <tuple>
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, GENERALNORM_FORWARD) {
+    using Param = GeneralNormForward::Param;
+    Param param;
+    param.eps = 1e-5;
+    Checker<GeneralNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 3);
+    checker.set_rng(0, &rng);
+
+    auto run = [&](DType d, const TensorShape& shape, uint64_t axis_start,
+                   uint64_t axis_end) {
+        TensorShape affine_shape;
+        affine_shape.ndim = axis_end - axis_start;
+        for (size_t i = axis_start; i < axis_end; ++i) {
+            affine_shape[i - axis_start] = shape[i];
+        }
+        param.axis_start = axis_start;
+        param.axis_end = axis_end;
+        checker.set_param(param)
+                .set_dtype(0, d)
+                .set_dtype(1, d)
+                .set_dtype(2, d)
+                .set_dtype(3, d)
+                .set_dtype(4, dtype::Float32())
+                .set_dtype(5, dtype::Float32())
+                .execs({shape, affine_shape, affine_shape, {}, {}, {}});
+    };
+
+    for (bool affine : {true, false}) {
+        param.affine = affine;
+        for (size_t A : {10, 30})
+            for (size_t B : {10, 30}) {
+                TensorShape shape{A, B, A, B};
+                run(dtype::Float32(), shape, 0, 1);
+                run(dtype::Float32(), shape, 1, 2);
+                run(dtype::Float32(), shape, 1, 3);
+                run(dtype::Float32(), shape, 1, 4);
+                run(dtype::Float32(), shape, 3, 4);
+            }
+        //! strided normalization with several channel blocks and a tail
+        run(dtype::Float32(), {3, 200, 131}, 1, 2);
+        run(dtype::Float32(), {1, 4000, 5}, 1, 2);
+        run(dtype::Float32(), {64, 1024}, 1, 2);
+    }
+    param.affine = true;
+    checker.set_epsilon(1e-2);
+    run(dtype::Float16(), {10, 30, 10}, 1, 2);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK_MULTI_THREADS, BENCHMARK_GENERALNORM_FORWARD) {
+    constexpr size_t RUNS = 50;
+    //! (shape, axis_start, axis_end)
+    std::vector<std::tuple<TensorShape, size_t, size_t>> shapes{
+            {{512, 768}, 1, 2},
+            {{2048, 1024}, 1, 2},
+            {{8, 1024, 256}, 1, 2},
+            {{1, 65536, 64}, 1, 2}};
+    std::vector<MultiThreadBenchmarkCase> cases;
+    for (auto&& s : shapes) {
+        TensorShape shape = std::get<0>(s);
+        GeneralNormForward::Param param;
+        param.axis_start = std::get<1>(s);
+        param.axis_end = std::get<2>(s);
+        auto run = [shape, param](Handle* handle) {
+            Benchmarker<GeneralNormForward> benchmarker(handle);
+            TensorShape affine_shape{shape[param.axis_start]};
+            benchmarker.set_times(RUNS).set_display(false).set_param(param);
+            return benchmarker.execs({shape, affine_shape, affine_shape, {}, {}, {}}) /
+                   RUNS;
+        };
+        cases.push_back(
+                {ssprintf(
+                         "%s axis [%zu, %zu)", shape.to_string().c_str(),
+                         static_cast<size_t>(param.axis_start),
+                         static_cast<size_t>(param.axis_end)),
+                 run});
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,79 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
+
+#include <array>
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, GROUPNORM_FORWARD) {
+    using Param = GroupNormForward::Param;
+    Param param;
+    param.eps = 1e-6;
+    Checker<GroupNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 3);
+    checker.set_rng(0, &rng);
+
+    auto run = [&](DType d, size_t N, size_t C, size_t H, size_t W, size_t group) {
+        param.group = group;
+        checker.set_param(param)
+                .set_dtype(0, d)
+                .set_dtype(1, d)
+                .set_dtype(2, d)
+                .set_dtype(3, d)
+                .set_dtype(4, dtype::Float32())
+                .set_dtype(5, dtype::Float32())
+                .execs({{N, C, H, W}, {C}, {C}, {N, C, H, W}, {N, group}, {N, group}});
+    };
+
+    for (bool affine : {true, false}) {
+        param.affine = affine;
+        for (size_t group : {1, 3})
+            for (size_t C : {6, 9}) {
+                run(dtype::Float32(), 2, C, 2, 1, group);
+                run(dtype::Float32(), 4, C, 33, 31, group);
+            }
+        run(dtype::Float32(), 1, 64, 56, 56, 32);
+        run(dtype::Float32(), 2, 32, 128, 65, 1);
+    }
+    param.affine = true;
+    checker.set_epsilon(1e-2);
+    run(dtype::Float16(), 2, 6, 5, 5, 3);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK_MULTI_THREADS, BENCHMARK_GROUPNORM_FORWARD) {
+    constexpr size_t RUNS = 50;
+    //! (N, C, H, W, group)
+    std::vector<std::array<size_t, 5>> shapes{
+            {1, 64, 56, 56, 32}, {8, 128, 28, 28, 32}, {2, 256, 64, 64, 1}};
+    std::vector<MultiThreadBenchmarkCase> cases;
+    for (auto&& s : shapes) {
+        auto run = [s](Handle* handle) {
+            Benchmarker<GroupNormForward> benchmarker(handle);
+            GroupNormForward::Param param;
+            param.group = s[4];
+            benchmarker.set_times(RUNS).set_display(false).set_param(param);
+            return benchmarker.execs(
+                           {{s[0], s[1], s[2], s[3]}, {s[1]}, {s[1]}, {}, {}, {}}) /
+                   RUNS;
+        };
+        cases.push_back(
+                {ssprintf(
+                         "{%zu, %zu, %zu, %zu} group %zu", s[0], s[1], s[2], s[3],
+                         s[4]),
+                 run});
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
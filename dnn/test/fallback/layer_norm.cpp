@@ -0,0 +1,84 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, LAYERNORM_FORWARD) {
+    using Param = LayerNormForward::Param;
+    Param param;
+    param.eps = 1e-6;
+    param.normalized_dim = 1;
+    Checker<LayerNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 3);
+    checker.set_rng(0, &rng);
+
+    auto run = [&](DType d, size_t n_slices, size_t slice_len) {
+        param.normalized_size = slice_len;
+        checker.set_param(param)
+                .set_dtype(0, d)
+                .set_dtype(1, d)
+                .set_dtype(2, d)
+                .set_dtype(3, d)
+                .set_dtype(4, dtype::Float32())
+                .set_dtype(5, dtype::Float32())
+                .execs({{n_slices, slice_len},
+                        {slice_len},
+                        {slice_len},
+                        {n_slices, slice_len},
+                        {n_slices},
+                        {n_slices}});
+    };
+
+    for (bool affine : {true, false}) {
+        param.affine = affine;
+        //! small shapes run in one thread, the others are split by slices
+        for (size_t n_slices : {1, 3, 10, 97})
+            for (size_t slice_len : {1, 7, 30, 768, 2051}) {
+                run(dtype::Float32(), n_slices, slice_len);
+            }
+        run(dtype::Float32(), 2, 40000);
+    }
+    param.affine = true;
+    checker.set_epsilon(1e-2);
+    run(dtype::Float16(), 30, 30);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK_MULTI_THREADS, BENCHMARK_LAYERNORM_FORWARD) {
+    constexpr size_t RUNS = 50;
+    //! (n_slices, normalized_size) of typical transformer activations
+    std::vector<std::pair<size_t, size_t>> shapes{
+            {128, 768}, {512, 768}, {2048, 1024}, {16, 65536}};
+    std::vector<MultiThreadBenchmarkCase> cases;
+    for (auto&& shape : shapes) {
+        auto run = [shape](Handle* handle) {
+            Benchmarker<LayerNormForward> benchmarker(handle);
+            LayerNormForward::Param param;
+            param.normalized_dim = 1;
+            param.normalized_size = shape.second;
+            benchmarker.set_times(RUNS).set_display(false).set_param(param);
+            return benchmarker.execs(
+                           {{shape.first, shape.second},
+                            {shape.second},
+                            {shape.second},
+                            {},
+                            {},
+                            {}}) /
+                   RUNS;
+        };
+        cases.push_back({ssprintf("{%zu, %zu}", shape.first, shape.second), run});
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
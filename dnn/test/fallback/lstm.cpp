@@ -0,0 +1,41 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/common/rnn.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+void run_lstm(Handle* handle) {
+    Checker<LSTM> checker(handle, true);
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 1);
+    for (size_t i = 0; i < 4; ++i)
+        checker.set_rng(i, &rng);
+    LSTM::Param param;
+    for (auto&& arg : rnn::get_args()) {
+        param.bias = arg.bias;
+        param.bidirectional = arg.bidirectional;
+        param.num_layers = arg.num_layers;
+        param.hidden_size = arg.hidden_size;
+        checker.set_param(param).exec(
+                {arg.input(), arg.state(), arg.state(), arg.flatten_weights(4), {}, {},
+                 {}, {}});
+    }
+}
+}  // namespace
+
+TEST_F(FALLBACK, LSTM_FORWARD) {
+    run_lstm(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, LSTM_FORWARD) {
+    run_lstm(handle());
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
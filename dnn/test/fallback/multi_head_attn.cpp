@@ -0,0 +1,133 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+size_t get_weight_len(const MultiHeadAttnForward::Param& param) {
+    size_t weight_len = 0;
+    if (param.qproj_size)
+        weight_len += (param.embeding_size + param.qbias) * param.qproj_size;
+    if (param.kproj_size)
+        weight_len += (param.k_size + param.kbias) * param.kproj_size;
+    if (param.vproj_size)
+        weight_len += (param.v_size + param.vbias) * param.vproj_size;
+    if (param.oproj_size) {
+        size_t z_width = param.vproj_size ? param.vproj_size
+                                          : param.num_heads * param.v_size;
+        weight_len += (z_width + param.obias) * param.oproj_size;
+    }
+    return weight_len;
+}
+}  // namespace
+
+TEST_F(FALLBACK_MULTI_THREADS, MULTIHEADATTN_FORWARD) {
+    using Param = MultiHeadAttnForward::Param;
+    using MaskType = Param::AttnMaskType;
+    using InputType = Param::TensorCombinationType;
+    Param param;
+    param.training = false;
+
+    auto run = [&](size_t batch, size_t seq_q, size_t seq_k, size_t num_heads,
+                   size_t embeding_size, size_t proj_size, bool bias,
+                   bool need_weights, size_t mask_batch) {
+        param.num_heads = num_heads;
+        param.embeding_size = embeding_size;
+        param.k_size = embeding_size;
+        param.v_size = embeding_size + 2;
+        param.qproj_size = param.kproj_size = param.vproj_size = proj_size;
+        param.oproj_size = proj_size ? proj_size + 4 : 0;
+        param.qbias = param.kbias = param.vbias = param.obias = bias && proj_size;
+        param.need_weights = need_weights;
+        size_t head_dim = proj_size ? proj_size / num_heads : embeding_size;
+        param.sm_scaler = 1.f / std::sqrt(head_dim);
+        TensorShape attn_mask{};
+        if (mask_batch) {
+            param.attn_mask_type = MaskType::USER_DEFINED_MASK;
+            param.tensor_combination_type = InputType::ONLY_MASK;
+            attn_mask = {mask_batch, seq_q, seq_k};
+        } else {
+            param.attn_mask_type = MaskType::NO_MASK;
+            param.tensor_combination_type = InputType::NONE;
+        }
+        //! the proxy dispatches several kernels, and the bypass set is sticky
+        Checker<MultiHeadAttnForward> checker(handle(), false);
+        checker.set_epsilon(1e-4);
+        if (!need_weights) {
+            checker.set_bypass(8);
+        }
+        checker.set_param(param).set_bypass(9).set_bypass(10);
+        checker.execs(
+                {{batch, seq_q, param.embeding_size},
+                 {batch, seq_k, param.k_size},
+                 {batch, seq_k, param.v_size},
+                 {get_weight_len(param)},
+                 attn_mask,
+                 {},
+                 {},
+                 {},
+                 {},
+                 {},
+                 {}});
+    };
+
+    for (size_t seq_q : {1, 11, 70})
+        for (size_t seq_k : {1, 12, 130})
+            for (size_t num_heads : {1, 2, 4})
+                for (size_t proj_size : {0, 8})
+                    for (bool need_weights : {false, true}) {
+                        run(3, seq_q, seq_k, num_heads, 8, proj_size, true,
+                            need_weights, 0);
+                    }
+    for (size_t mask_batch : {1, 6})
+        for (bool bias : {false, true}) {
+            run(3, 33, 65, 2, 16, 16, bias, true, mask_batch);
+            run(3, 33, 65, 2, 16, 0, bias, false, mask_batch);
+        }
+    //! training mode is forwarded to the naive proxy
+    param.training = true;
+    param.attn_prob = param.out_prob = 0.f;
+    run(2, 5, 6, 2, 8, 8, true, true, 0);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK_MULTI_THREADS, BENCHMARK_MULTIHEADATTN_FORWARD) {
+    using Param = MultiHeadAttnForward::Param;
+    Param param;
+    param.training = false;
+    param.need_weights = false;
+    param.num_heads = 8;
+    param.embeding_size = param.k_size = param.v_size = 512;
+    param.qproj_size = param.kproj_size = param.vproj_size = param.oproj_size = 512;
+    param.sm_scaler = 1.f / 8;
+    TensorShape weight{get_weight_len(param)};
+
+    std::vector<MultiThreadBenchmarkCase> cases;
+    for (size_t seq : {128, 512, 1024, 2048, 4096}) {
+        auto run = [param, weight, seq](Handle* handle) {
+            //! the naive proxy materializes the (batch * heads, L, S) scores
+            size_t times = seq > 1024
+                                 ? (handle->type() == Handle::HandleType::NAIVE ? 1 : 2)
+                                 : 10;
+            Benchmarker<MultiHeadAttnForward> benchmarker(handle);
+            benchmarker.set_times(times).set_display(false).set_param(param);
+            return benchmarker.execs(
+                           {{1, seq, 512}, {1, seq, 512}, {1, seq, 512}, weight, {},
+                            {}, {}, {}, {}, {}, {}}) /
+                   times;
+        };
+        cases.push_back({ssprintf("seq %zu", seq), run});
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}}, 0, true);
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -3,6 +3,7 @@
 #include "megdnn/oprs.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/task_record_check.h"
 #include "test/common/tensor.h"
 #include "test/common/workspace_wrapper.h"
@@ -302,6 +303,47 @@ TEST_F(FALLBACK, REDUCE_RECORD) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, REDUCE_MULTI_THREAD) {
+    using Param = Reduce::Param;
+    using Mode = Param::Mode;
+    Checker<Reduce> checker(handle());
+    //! shapes split by A, by B (few outputs) and by channel blocks of C
+    std::vector<TensorShape> shapes{
+            {64, 1024, 1}, {1, 100003, 1}, {3, 40000, 1}, {2, 8192, 7},
+            {4, 256, 129}, {1, 4096, 32}, {1, 65536, 2}};
+    UniformIntRNG int_rng{INT8_MIN >> 1, INT8_MAX >> 1};
+    UniformFloatRNG float_rng(-1, 1);
+    for (auto&& shape : shapes) {
+        for (auto mode : {Mode::MEAN, Mode::MAX, Mode::MIN}) {
+            checker.set_rng(0, &int_rng)
+                    .set_epsilon(1e-3)
+                    .set_dtype(0, dtype::QuantizedS8(1.3f))
+                    .set_param(Param(mode, 1))
+                    .execs({shape, {}});
+        }
+        for (auto mode : {Mode::SUM, Mode::MEAN, Mode::SUM_SQR, Mode::MAX, Mode::MIN}) {
+            //! the partial sums of B are combined in another order
+            checker.set_rng(0, &float_rng)
+                    .set_epsilon(shape[1] > 10000 ? 1e-2 : 1e-3)
+                    .set_dtype(0, dtype::Float32())
+                    .set_param(Param(mode, 1))
+                    .execs({shape, {}});
+        }
+    }
+    UniformFloatRNG product_rng(0.99, 1.01);
+    checker.set_rng(0, &product_rng).set_epsilon(1e-2);
+    for (auto&& shape : std::vector<TensorShape>{{2, 16384, 1}, {64, 512, 3}}) {
+        for (auto mode : {Mode::SUM, Mode::PRODUCT, Mode::MAX}) {
+            checker.set_dtype(0, dtype::Float16())
+                    .set_param(Param(mode, 1))
+                    .execs({shape, {}});
+        }
+        checker.set_dtype(0, dtype::Float32())
+                .set_param(Param(Mode::PRODUCT, 1))
+                .execs({shape, {}});
+    }
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_REDUCE_VS_CONV) {
     auto run = [&]() {
@@ -423,6 +465,31 @@ TEST_F(FALLBACK, BENCHMARK_REDUCE) {
     };
     run();
 }
+
+TEST_F(FALLBACK_MULTI_THREADS, BENCHMARK_REDUCE) {
+    using Mode = param::Reduce::Mode;
+    constexpr size_t RUNS = 50;
+    std::vector<TensorShape> shapes{
+            {1, 3 * 224 * 224 * 100, 1}, {4, 1000000, 1}, {256, 65536, 1},
+            {1, 100000, 64}, {32, 1024, 256}, {24, 240 * 128, 4}};
+    std::vector<MultiThreadBenchmarkCase> cases;
+    for (auto mode : {Mode::SUM, Mode::MEAN, Mode::SUM_SQR, Mode::MAX}) {
+        for (auto&& shape : shapes) {
+            auto run = [mode, shape](Handle* handle) {
+                Benchmarker<Reduce> benchmarker(handle);
+                benchmarker.set_times(RUNS).set_display(false).set_param(
+                        param::Reduce(mode, 1));
+                return benchmarker.execs({shape, {}}) / RUNS;
+            };
+            cases.push_back(
+                    {ssprintf(
+                             "mode %d %s", static_cast<int>(mode),
+                             shape.to_string().c_str()),
+                     run});
+        }
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
 #endif
 
 // vim: syntax=cpp.doxygen
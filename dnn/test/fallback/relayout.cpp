@@ -34,6 +34,19 @@ TEST_F(FALLBACK, RELAYOUT_RECORD) {
     checker.exec({{2, 2, 2}, {2, 2, 2}});
 }
 
+TEST_F(FALLBACK, RELAYOUT_TRANSPOSE_LARGE_ELEM) {
+    //! the channels are merged into an element larger than the transpose
+    //! block, which has no transpose kernel
+    Checker<Relayout> checker(handle());
+    for (DType dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        TensorLayout src = TensorLayout({2, 5, 7, 32}, dtype).dimshuffle({0, 2, 1, 3});
+        checker.set_dtype(0, dtype).set_dtype(1, dtype).execl(
+                {src, {TensorShape(src), dtype}});
+        src = TensorLayout({3, 9, 4, 100}, dtype).dimshuffle({0, 2, 1, 3});
+        checker.execl({src, {TensorShape(src), dtype}});
+    }
+}
+
 TEST_F(FALLBACK, RELAYOUT_Q4) {
     Checker<Relayout> checker(handle());
     UniformIntRNG rng_int4{-7, 7};
@@ -88,6 +101,40 @@ TEST_F(FALLBACK, RELAYOUT_Q4) {
                      dtype::QuantizedS4{1.f}}});
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, RELAYOUT_MULTI_THREAD) {
+    Checker<Relayout> checker(handle());
+    auto run_dimshuffle = [&](const TensorShape& shape,
+                              const std::vector<size_t>& pattern, DType dtype) {
+        TensorLayout src = TensorLayout(shape, dtype).dimshuffle(pattern);
+        checker.set_dtype(0, dtype).set_dtype(1, dtype).execl(
+                {src, {TensorShape(src), dtype}});
+    };
+    for (DType dtype :
+         std::vector<DType>{dtype::Int8(), dtype::Float16(), dtype::Float32()}) {
+        //! batched transpose with rows not aligned to the blocks
+        run_dimshuffle({3, 301, 257}, {0, 2, 1}, dtype);
+        run_dimshuffle({1, 1024, 67}, {0, 2, 1}, dtype);
+        //! nchw <-> nhwc, the channels are merged into the element
+        run_dimshuffle({2, 3, 129, 130}, {0, 2, 3, 1}, dtype);
+        run_dimshuffle({2, 129, 130, 3}, {0, 3, 1, 2}, dtype);
+        //! nchw <-> nchw44
+        run_dimshuffle({2, 8, 4, 67, 65}, {0, 1, 3, 4, 2}, dtype);
+        run_dimshuffle({2, 8, 67, 65, 4}, {0, 1, 4, 2, 3}, dtype);
+        //! elements too large for the transpose kernels
+        run_dimshuffle({2, 33, 65, 96}, {0, 2, 1, 3}, dtype);
+
+        //! contiguous copy and the copy from or to a subtensor
+        checker.set_dtype(0, dtype).set_dtype(1, dtype);
+        checker.execl({{{1 << 20}, dtype}, {{1 << 20}, dtype}});
+        checker.execl({{{513, 300}, {320, 1}, dtype}, {{513, 300}, dtype}});
+        checker.execl({{{513, 300}, dtype}, {{513, 300}, {320, 1}, dtype}});
+        checker.execl(
+                {{{7, 61, 300}, {64 * 320, 320, 1}, dtype}, {{7, 61, 300}, dtype}});
+        //! transpose of a subtensor
+        checker.execl({{{600, 700}, {1, 640}, dtype}, {{600, 700}, dtype}});
+    }
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_RELAYOUT_CV) {
     relayout::run_cv_benchmark(handle());
@@ -21,6 +21,24 @@ TEST_F(FALLBACK, REPEAT_RECORD) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, REPEAT) {
+    auto args = tile_repeat::get_args();
+    //! split along the rows and inside long rows, the last one is large
+    //! enough for the non-temporal stores
+    args.emplace_back(TensorShape{1, 1}, TensorShape{512, 1024});
+    args.emplace_back(TensorShape{2, 1, 3}, TensorShape{16, 256, 64});
+    args.emplace_back(TensorShape{3, 2}, TensorShape{3, 100000});
+    args.emplace_back(TensorShape{4}, TensorShape{300000});
+    args.emplace_back(TensorShape{2, 2}, TensorShape{1024, 1024});
+    for (auto dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        Checker<RepeatForward> checker(handle());
+        checker.set_dtype(0, dtype).set_dtype(1, dtype);
+        for (auto&& arg : args) {
+            checker.set_param(arg.param()).execs({arg.src, {}});
+        }
+    }
+}
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -1,5 +1,7 @@
 #include "test/common/resize.h"
+#include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/task_record_check.h"
 #include "test/fallback/fixture.h"
 namespace megdnn {
@@ -199,6 +201,96 @@ TEST_F(FALLBACK, RESIZE_NCHW44_FP32) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, RESIZE) {
+    using IMode = param::Resize::InterpolationMode;
+    using Format = param::Resize::Format;
+    std::vector<resize::TestArg> args;
+    for (auto imode : {IMode::INTER_LINEAR, IMode::INTER_NEAREST}) {
+        param::Resize param;
+        param.imode = imode;
+        param.format = Format::NCHW;
+        args.emplace_back(param, TensorShape{2, 3, 3, 4}, TensorShape{2, 3, 6, 8});
+        args.emplace_back(param, TensorShape{2, 3, 90, 160}, TensorShape{2, 3, 67, 97});
+        args.emplace_back(param, TensorShape{1, 3, 67, 97}, TensorShape{1, 3, 90, 160});
+        param.format = Format::NHWC;
+        args.emplace_back(param, TensorShape{2, 3, 4, 5}, TensorShape{2, 6, 8, 5});
+        args.emplace_back(param, TensorShape{2, 90, 160, 3}, TensorShape{2, 67, 97, 3});
+        args.emplace_back(
+                param, TensorShape{1, 67, 97, 8}, TensorShape{1, 90, 160, 8});
+        param.format = Format::NCHW44;
+        args.emplace_back(
+                param, TensorShape{2, 2, 3, 4, 4}, TensorShape{2, 2, 6, 8, 4});
+        args.emplace_back(
+                param, TensorShape{1, 2, 90, 160, 4}, TensorShape{1, 2, 67, 97, 4});
+    }
+    Checker<Resize> checker(handle());
+    for (auto&& arg : args) {
+        checker.set_param(arg.param)
+                .set_dtype(0, dtype::Float32())
+                .set_dtype(1, dtype::Float32())
+                .set_epsilon(1e-3)
+                .execs({arg.src, arg.dst});
+        if (arg.param.format == Format::NCHW44) {
+            continue;
+        }
+        checker.set_param(arg.param)
+                .set_dtype(0, dtype::Uint8())
+                .set_dtype(1, dtype::Uint8())
+                .set_epsilon(1 + 1e-3)
+                .execs({arg.src, arg.dst});
+        //! nearest NHWC images of 3 channels are only supported by cv for u8
+        if (arg.param.format == Format::NHWC && arg.src[3] == 3 &&
+            arg.param.imode == IMode::INTER_NEAREST) {
+            continue;
+        }
+        checker.set_param(arg.param)
+                .set_dtype(0, dtype::Int8())
+                .set_dtype(1, dtype::Int8())
+                .set_epsilon(1 + 1e-3)
+                .execs({arg.src, arg.dst});
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_RESIZE) {
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](const resize::TestArg& arg, DType dtype) {
+        auto run = [arg, dtype](Handle* handle) {
+            Benchmarker<Resize> benchmarker(handle);
+            benchmarker.set_times(10)
+                    .set_display(false)
+                    .set_param(arg.param)
+                    .set_dtype(0, dtype)
+                    .set_dtype(1, dtype);
+            return benchmarker.execs({arg.src, arg.dst}) / 10;
+        };
+        cases.push_back(
+                {ssprintf(
+                         "resize %s %s -> %s", dtype.name(),
+                         arg.src.to_string().c_str(), arg.dst.to_string().c_str()),
+                 run});
+    };
+    using IMode = param::Resize::InterpolationMode;
+    using Format = param::Resize::Format;
+    //! 1080p frames resized to detector inputs
+    for (auto imode : {IMode::INTER_LINEAR, IMode::INTER_NEAREST}) {
+        param::Resize param;
+        param.imode = imode;
+        param.format = Format::NHWC;
+        add_case({param, {4, 1080, 1920, 3}, {4, 540, 960, 3}}, dtype::Uint8());
+        add_case({param, {4, 1080, 1920, 3}, {4, 608, 608, 3}}, dtype::Float32());
+        param.format = Format::NCHW;
+        add_case({param, {4, 3, 1080, 1920}, {4, 3, 608, 608}}, dtype::Uint8());
+        add_case({param, {4, 3, 1080, 1920}, {4, 3, 720, 1280}}, dtype::Float32());
+        param.format = Format::NCHW44;
+        add_case(
+                {param, {4, 1, 1080, 1920, 4}, {4, 1, 608, 608, 4}},
+                dtype::Float32());
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
 }  // namespace test
 }  // namespace megdnn
 // vim: syntax=cpp.doxygen
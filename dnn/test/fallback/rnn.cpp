@@ -0,0 +1,43 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/common/rnn.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+void run_rnn(Handle* handle) {
+    using NonlineMode = RNN::Param::NonlineMode;
+    Checker<RNN> checker(handle, true);
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 1);
+    for (size_t i = 0; i < 3; ++i)
+        checker.set_rng(i, &rng);
+    RNN::Param param;
+    for (auto mode : {NonlineMode::IDENTITY, NonlineMode::RELU, NonlineMode::TANH})
+        for (auto&& arg : rnn::get_args()) {
+            param.nonlineMode = mode;
+            param.bias = arg.bias;
+            param.bidirectional = arg.bidirectional;
+            param.num_layers = arg.num_layers;
+            param.hidden_size = arg.hidden_size;
+            checker.set_param(param).exec(
+                    {arg.input(), arg.state(), arg.flatten_weights(1), {}, {}, {}});
+        }
+}
+}  // namespace
+
+TEST_F(FALLBACK, RNN_FORWARD) {
+    run_rnn(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, RNN_FORWARD) {
+    run_rnn(handle());
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
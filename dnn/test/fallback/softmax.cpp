@@ -3,6 +3,7 @@
 #include "megdnn/oprs.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/task_record_check.h"
 #include "test/common/tensor.h"
 #include "test/common/workspace_wrapper.h"
@@ -50,6 +51,53 @@ TEST_F(FALLBACK, SOFTMAX_FORWARD) {
     checker.set_param(param6).exec(TensorShapeArray{{11, 5, 5, 5, 5, 7, 7}, {}});
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, SOFTMAX_FORWARD_MULTI_THREAD) {
+    Checker<Softmax> checker(handle());
+    checker.set_epsilon(1e-4);
+    auto run = [&](const TensorShape& shape, int axis) {
+        checker.set_param(Softmax::Param{axis}).exec(TensorShapeArray{shape, {}});
+    };
+    //! long contiguous rows
+    run({4, 10000}, 1);
+    run({3, 7, 4099}, 2);
+    run({64, 257}, -1);
+    //! strided reductions, the channels are split into blocks of 64
+    for (size_t C : {2, 3, 5, 64, 70, 131}) {
+        run({5, 1000, C}, 1);
+        run({2, 33, C}, 1);
+        run({1000, C}, 0);
+    }
+    //! large magnitudes must not overflow the exponential
+    UniformFloatRNG rng(-1000.f, 1000.f);
+    checker.set_rng(0, &rng);
+    run({4, 10000}, 1);
+    run({3, 2000, 70}, 1);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_SOFTMAX_FORWARD) {
+    constexpr size_t RUNS = 20;
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](const TensorShape& shape, int axis) {
+        auto run = [shape, axis](Handle* handle) {
+            Benchmarker<Softmax> benchmarker(handle);
+            benchmarker.set_times(RUNS).set_display(false).set_param(
+                    Softmax::Param{axis});
+            return benchmarker.exec(TensorShapeArray{shape, {}}) / RUNS;
+        };
+        cases.push_back(
+                {ssprintf("softmax %s axis %d", shape.to_string().c_str(), axis),
+                 run});
+    };
+    add_case({64, 32000}, 1);
+    add_case({32, 12, 512, 512}, 3);
+    add_case({32, 1000, 3}, 1);
+    add_case({64, 1000, 64}, 1);
+    add_case({32, 256, 56, 56}, 1);
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -34,6 +34,32 @@ TEST_F(FALLBACK, SPLIT_RECORD) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, SPLIT) {
+    using Param = Split::Param;
+    for (auto dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        Checker<Split> checker(handle());
+        for (size_t axis = 0; axis < 4; ++axis) {
+            Param param;
+            param.axis = axis;
+            TensorShapeArray shapes(5, TensorShape({4, 16, 32, 40}));
+            shapes[0].shape[axis] = 0;
+            for (size_t i = 1; i < 5; ++i) {
+                shapes[i].shape[axis] = i * 5 - 4;
+                shapes[0].shape[axis] += shapes[i].shape[axis];
+            }
+            for (size_t i = 0; i < shapes.size(); ++i)
+                checker.set_dtype(i, dtype);
+            checker.set_param(param).exec(shapes);
+        }
+    }
+    //! large enough for the non-temporal stores
+    Checker<Split> checker(handle());
+    Param param;
+    param.axis = 1;
+    checker.set_param(param).exec(
+            {{2, 64, 128, 128}, {2, 24, 128, 128}, {2, 40, 128, 128}});
+}
+
 }  // namespace test
 }  // namespace megdnn
 
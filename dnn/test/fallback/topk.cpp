@@ -0,0 +1,87 @@
+#include "test/common/topk.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
+#include "test/common/rng.h"
+#include "test/fallback/fixture.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK, TOP_K) {
+    run_topk_test<dtype::Float32>(handle());
+}
+
+TEST_F(FALLBACK, TOP_K_I32) {
+    run_topk_test<dtype::Int32>(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, TOP_K) {
+    run_topk_test<dtype::Float32>(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, TOP_K_I32) {
+    run_topk_test<dtype::Int32>(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, TOP_K_LONG_ROWS) {
+    using Mode = TopK::Param::Mode;
+    Checker<TopK> checker(handle());
+    UniformFloatRNG rng0(-100.f, 100.f);
+    NoReplacementRNG rng(&rng0);
+    checker.set_rng(0, &rng);
+    //! the rows are split into chunks for small k, and selected whole by
+    //! radix for large k
+    for (auto mode : {Mode::KTH_ONLY, Mode::VALUE_IDX_SORTED}) {
+        for (int k : {1, 100, -100, -3000, 20000}) {
+            checker.set_proxy(k);
+            checker.set_param(mode);
+            TensorLayout layout{{2, 300000}, dtype::Float32()};
+            if (mode == Mode::KTH_ONLY) {
+                checker.execl({layout, {}});
+            } else {
+                checker.execl({layout, {}, {}});
+            }
+        }
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_TOP_K) {
+    using Mode = TopK::Param::Mode;
+    UniformFloatRNG rng(-100.f, 100.f);
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](int k, const TensorShape& shape, Mode mode) {
+        auto run = [&rng, k, shape, mode](Handle* handle) {
+            Benchmarker<TopK> benchmarker(handle);
+            std::unique_ptr<OprProxy<TopK>> proxy{new OprProxy<TopK>{k}};
+            benchmarker.set_proxy(proxy);
+            benchmarker.set_times(10).set_display(false).set_rng(0, &rng).set_param(
+                    mode);
+            if (mode == Mode::KTH_ONLY) {
+                return benchmarker.execs({shape, {}}) / 10;
+            }
+            return benchmarker.execs({shape, {}, {}}) / 10;
+        };
+        cases.push_back(
+                {ssprintf(
+                         "topk %s k=%d mode=%d", shape.to_string().c_str(), k,
+                         static_cast<int>(mode)),
+                 run});
+    };
+    //! detection scores and recommendation ranking
+    for (auto mode :
+         {Mode::KTH_ONLY, Mode::VALUE_IDX_NOSORT, Mode::VALUE_IDX_SORTED}) {
+        add_case(-100, {1, 1000000}, mode);
+        add_case(-1000, {1, 1000000}, mode);
+        add_case(-100, {16, 100000}, mode);
+        add_case(-50000, {4, 100000}, mode);
+    }
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}}, 0, true);
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
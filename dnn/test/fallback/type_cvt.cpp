@@ -56,6 +56,31 @@ TEST_F(FALLBACK, TYPE_CVT_RECORD) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, TYPE_CVT_MULTI_THREAD) {
+    Checker<TypeCvt> checker(handle());
+    UniformFloatRNG rng(-200.f, 200.f);
+    UniformIntRNG rng8{INT8_MIN, INT8_MAX};
+    UniformIntRNG rngu8{0, UINT8_MAX};
+    UniformIntRNG rng32{INT32_MIN >> 1, INT32_MAX >> 1};
+    auto run = [&](DType src_dtype, DType dst_dtype, RNG* rng) {
+        checker.set_rng(0, rng).set_dtype(0, src_dtype).set_dtype(1, dst_dtype);
+        for (size_t size : {33, 32768, 32768 + 7, 100003}) {
+            checker.execs({{size}, {size}});
+        }
+    };
+    run(dtype::Float32(), dtype::QuantizedS8(0.7f), &rng);
+    run(dtype::Float32(), dtype::Quantized8Asymm(0.9f, static_cast<uint8_t>(37)),
+        &rng);
+    run(dtype::QuantizedS8(0.3f), dtype::Float32(), &rng8);
+    run(dtype::Quantized8Asymm(0.3f, static_cast<uint8_t>(8)), dtype::Float32(),
+        &rngu8);
+    run(dtype::QuantizedS32(0.0003f), dtype::QuantizedS8(0.2f), &rng32);
+    run(dtype::QuantizedS32(0.0003f), dtype::Float32(), &rng32);
+    run(dtype::Float32(), dtype::Float16(), &rng);
+    run(dtype::BFloat16(), dtype::Float32(), &rng);
+    run(dtype::Int16(), dtype::Float32(), &rng8);
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_TYPE_CVT) {
     auto handle_naive = create_cpu_handle(2);
@@ -1,6 +1,8 @@
 #include "test/fallback/fixture.h"
 
+#include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 #include "test/common/random_state.h"
 #include "test/common/rng.h"
 #include "test/common/task_record_check.h"
@@ -356,6 +358,102 @@ TEST_F(FALLBACK, WARP_PERSPECTIVE_MULTI_SRC_WITH_IDX_NHWC) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, WARP_PERSPECTIVE) {
+    using Param = WarpPerspective::Param;
+    using BMode = WarpPerspective::BorderMode;
+    Param param;
+    param.imode = Param::InterpolationMode::LINEAR;
+    param.border_val = 0.3f;
+    WarpPerspectiveMatRNG rng;
+    for (auto bmode :
+         {BMode::WRAP, BMode::REFLECT, BMode::REFLECT_101, BMode::REPLICATE,
+          BMode::CONSTANT}) {
+        param.bmode = bmode;
+        param.format = Param::Format::NCHW;
+        Checker<WarpPerspectiveForward> checker(handle());
+        checker.set_rng(1, &rng).set_param(param);
+        checker.set_dtype(0, dtype::Float32()).set_dtype(2, dtype::Float32());
+        checker.execs({{4, 3, 10, 11}, {4, 3, 3}, {4, 3, 12, 13}});
+        checker.execs({{2, 3, 67, 97}, {2, 3, 3}, {2, 3, 90, 160}});
+        checker.set_epsilon(1 + 1e-3);
+        checker.set_dtype(0, dtype::Uint8()).set_dtype(2, dtype::Uint8());
+        checker.execs({{2, 3, 67, 97}, {2, 3, 3}, {2, 3, 90, 160}});
+        checker.set_dtype(0, dtype::Int8()).set_dtype(2, dtype::Int8());
+        checker.execs({{2, 3, 67, 97}, {2, 3, 3}, {2, 3, 90, 160}});
+
+        //! u8 inputs converted to float
+        checker.set_epsilon(1e-3);
+        checker.set_dtype(0, dtype::Uint8()).set_dtype(2, dtype::Float32());
+        checker.execs({{2, 3, 67, 97}, {2, 3, 3}, {2, 3, 90, 160}});
+        checker.set_dtype(0, dtype::Quantized8Asymm(0.4f, static_cast<uint8_t>(10)));
+        checker.execs({{2, 3, 67, 97}, {2, 3, 3}, {2, 3, 90, 160}});
+        param.format = Param::Format::NHWC_NCHW;
+        checker.set_param(param);
+        checker.set_dtype(0, dtype::Uint8());
+        checker.execs({{2, 10, 11, 3}, {2, 3, 3}, {2, 3, 11, 12}});
+        checker.execs({{2, 67, 97, 3}, {2, 3, 3}, {2, 3, 90, 160}});
+    }
+    {
+        Checker<WarpPerspective, WarpPerspectiveMatIdxProxy> checker(handle());
+        constexpr int N_SRC = 5;
+        UniformIntRNG mat_idx_rng{0, N_SRC - 1};
+        param.bmode = BMode::REFLECT;
+        param.format = Param::Format::NCHW;
+        checker.set_rng(1, &rng).set_rng(2, &mat_idx_rng).set_param(param);
+        checker.set_dtype(0, dtype::Uint8())
+                .set_dtype(1, dtype::Float32())
+                .set_dtype(2, dtype::Int32())
+                .set_dtype(3, dtype::Float32());
+        checker.execs({{N_SRC, 3, 67, 97}, {4, 3, 3}, {4}, {4, 3, 90, 160}});
+        param.format = Param::Format::NHWC_NCHW;
+        checker.set_param(param);
+        checker.execs({{N_SRC, 67, 97, 3}, {4, 3, 3}, {4}, {4, 3, 90, 160}});
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_WARP_PERSPECTIVE) {
+    using Param = WarpPerspective::Param;
+    WarpPerspectiveMatRNG rng;
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_case = [&](Param::Format format, const TensorShapeArray& shapes,
+                        DType src_dtype, DType dst_dtype) {
+        Param param;
+        param.format = format;
+        param.bmode = WarpPerspective::BorderMode::CONSTANT;
+        auto run = [&rng, param, shapes, src_dtype, dst_dtype](Handle* handle) {
+            Benchmarker<WarpPerspective> benchmarker(handle);
+            benchmarker.set_times(10)
+                    .set_display(false)
+                    .set_param(param)
+                    .set_rng(1, &rng)
+                    .set_dtype(0, src_dtype)
+                    .set_dtype(1, dtype::Float32())
+                    .set_dtype(2, dst_dtype);
+            return benchmarker.execs(shapes) / 10;
+        };
+        cases.push_back(
+                {ssprintf(
+                         "warp_perspective %s %s -> %s %s", src_dtype.name(),
+                         shapes[0].to_string().c_str(), dst_dtype.name(),
+                         shapes[2].to_string().c_str()),
+                 run});
+    };
+    //! crops of 1080p frames warped to network inputs
+    add_case(
+            Param::Format::NCHW, {{4, 3, 1080, 1920}, {4, 3, 3}, {4, 3, 608, 608}},
+            dtype::Float32(), dtype::Float32());
+    add_case(
+            Param::Format::NCHW, {{4, 3, 1080, 1920}, {4, 3, 3}, {4, 3, 608, 608}},
+            dtype::Uint8(), dtype::Float32());
+    add_case(
+            Param::Format::NHWC_NCHW,
+            {{4, 1080, 1920, 3}, {4, 3, 3}, {4, 3, 608, 608}}, dtype::Uint8(),
+            dtype::Float32());
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
 }  // namespace test
 }  // namespace megdnn
 
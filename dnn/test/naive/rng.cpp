@@ -1,6 +1,8 @@
 #include "test/naive/rng.h"
 #include "megdnn.h"
+#include "src/naive/rng/philox.h"
 #include "test/common/tensor.h"
+#include "test/common/utils.h"
 #include "test/naive/fixture.h"
 
 namespace megdnn {
@@ -443,6 +445,62 @@ void run_dropout(Handle* handle) {
     run({100000}, 0.3);
 }
 
+/*!
+ * \brief check that the output of a counter based opr is the same on a single
+ *      thread handle, and that it can be regenerated by restoring the offset
+ *
+ * \param exec runs the opr on the given handle and returns its output
+ */
+template <typename Opr, typename Exec>
+void run_counter_based(Handle* handle, Exec exec) {
+    auto single_thread_handle = create_cpu_handle(2);
+    auto opr = handle->create_operator<Opr>();
+    auto single_thread_opr = single_thread_handle->create_operator<Opr>();
+    opr->param().seed = single_thread_opr->param().seed = 42;
+    auto counter_based = dynamic_cast<CounterBasedRNG*>(opr.get());
+    ASSERT_NE(counter_based, nullptr);
+
+    uint64_t offset = counter_based->offset();
+    auto expected = exec(handle, opr.get());
+    ASSERT_EQ(expected, exec(single_thread_handle.get(), single_thread_opr.get()));
+    ASSERT_NE(expected, exec(handle, opr.get()));
+    counter_based->set_offset(offset);
+    ASSERT_EQ(expected, exec(handle, opr.get()));
+}
+
+template <typename Opr>
+std::vector<float> exec_rng(Handle* handle, Opr* opr) {
+    Tensor<float> t(handle, {TensorShape{100003}, dtype::Float32()});
+    opr->exec(t.tensornd(), {});
+    megdnn_sync(handle);
+    return {t.ptr(), t.ptr() + t.layout().total_nr_elems()};
+}
+
+std::vector<float> exec_exponential(Handle* handle, ExponentialRNG* opr) {
+    TensorLayout ly{TensorShape{100003}, dtype::Float32()};
+    Tensor<float> rate(handle, ly), out(handle, ly);
+    for (size_t i = 0; i < ly.total_nr_elems(); ++i) {
+        rate.ptr()[i] = 0.5f + i % 7;
+    }
+    opr->exec(rate.tensornd(), out.tensornd(), {});
+    megdnn_sync(handle);
+    return {out.ptr(), out.ptr() + ly.total_nr_elems()};
+}
+
+std::vector<float> exec_dropout(Handle* handle, DropoutForward* opr) {
+    opr->param().drop_prob = 0.3;
+    TensorLayout ly{TensorShape{100003}, dtype::Float32()};
+    TensorLayout mask_ly{{opr->get_mask_size_in_bytes(ly)}, dtype::Byte()};
+    Tensor<float> inp(handle, ly), oup(handle, ly);
+    Tensor<DTypeTrait<dt_byte>::ctype> mask(handle, mask_ly);
+    for (size_t i = 0; i < ly.total_nr_elems(); ++i) {
+        inp.ptr()[i] = 1;
+    }
+    opr->exec(inp.tensornd(), oup.tensornd(), mask.tensornd(), {});
+    megdnn_sync(handle);
+    return {oup.ptr(), oup.ptr() + ly.total_nr_elems()};
+}
+
 }  // namespace
 
 TEST_F(NAIVE, UNIFORM_RNG_F32) {
@@ -547,6 +605,42 @@ TEST_F(NAIVE, DROPOUT_F16) {
     run_dropout<dtype::Float16>(handle());
 }
 
+TEST_F(NAIVE, PHILOX4X32_KAT) {
+    //! known-answer vectors of philox4x32_10 from Random123, the counter words
+    //! are (position, subsequence) and the key words are the seed
+    struct Case {
+        uint32_t ctr[4], key[2], expected[4];
+    };
+    const Case cases[] = {
+            {{0, 0, 0, 0},
+             {0, 0},
+             {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+            {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+             {0xffffffff, 0xffffffff},
+             {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+            {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+             {0xa4093822, 0x299f31d0},
+             {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+    };
+    auto join = [](uint32_t lo, uint32_t hi) {
+        return static_cast<uint64_t>(hi) << 32 | lo;
+    };
+    for (auto&& c : cases) {
+        naive::Philox4x32 philox{join(c.key[0], c.key[1])};
+        auto block = philox(join(c.ctr[2], c.ctr[3]), join(c.ctr[0], c.ctr[1]));
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_EQ(c.expected[i], block.v[i]) << "word " << i;
+        }
+    }
+}
+
+TEST_F(NAIVE_MULTI_THREADS, COUNTER_BASED_RNG) {
+    run_counter_based<UniformRNG>(handle(), exec_rng<UniformRNG>);
+    run_counter_based<GaussianRNG>(handle(), exec_rng<GaussianRNG>);
+    run_counter_based<ExponentialRNG>(handle(), exec_exponential);
+    run_counter_based<DropoutForward>(handle(), exec_dropout);
+}
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -282,6 +282,72 @@ TEST_F(X86_MULTI_THREADS, AVX2_CHANWISE_DIRECT_STRIDE2_QuantizedS8x8x8) {
             handle(), 2, "X86_CONV_BIAS_CHANWISE_AVX2_INT8_STRIDE2");
 }
 
+static void avx2_chanwise_direct_float32(
+        Handle* handle, uint32_t stride, const char* algo) {
+    if (!megdnn::x86::is_supported(x86::SIMDType::AVX2) ||
+        !megdnn::x86::is_supported(x86::SIMDType::FMA))
+        return;
+    using namespace conv_bias;
+    std::vector<TestArg> args;
+
+    auto run = [&](size_t ic, size_t w, size_t h, size_t kernel, size_t p,
+                   NonlineMode nonline_mode) {
+        if (w + 2 * p < kernel || h + 2 * p < kernel)
+            return;
+        param::ConvBias param;
+        param.stride_h = stride;
+        param.stride_w = stride;
+        param.pad_h = p;
+        param.pad_w = p;
+        param.nonlineMode = nonline_mode;
+
+        param.sparse = param::ConvBias::Sparse::GROUP;
+        size_t oh = (h + 2 * p - kernel) / stride + 1;
+        size_t ow = (w + 2 * p - kernel) / stride + 1;
+        //! no bias
+        args.emplace_back(
+                param, TensorShape{2, ic, h, w}, TensorShape{ic, 1, 1, kernel, kernel},
+                TensorShape{});
+        //! bias channel
+        args.emplace_back(
+                param, TensorShape{2, ic, h, w}, TensorShape{ic, 1, 1, kernel, kernel},
+                TensorShape{1, ic, 1, 1});
+        //! full bias
+        args.emplace_back(
+                param, TensorShape{2, ic, h, w}, TensorShape{ic, 1, 1, kernel, kernel},
+                TensorShape{2, ic, oh, ow});
+    };
+
+    for (size_t kernel : {2, 3, 5, 7})
+        for (size_t pad : {0, 1, 3})
+            for (size_t ic : {1, 5, 17, 20})
+                for (size_t h : {7, 16, 38})
+                    for (size_t w : {16, 25, 40, 55})
+                        for (NonlineMode nonline_mode :
+                             {NonlineMode::IDENTITY, NonlineMode::RELU,
+                              NonlineMode::H_SWISH, NonlineMode::SIGMOID})
+                            run(ic, w, h, kernel, pad, nonline_mode);
+
+    Checker<ConvBias> checker(handle);
+    checker.set_before_exec_callback(
+            conv_bias::ConvBiasAlgoChecker<ConvBiasForward>(algo));
+    for (auto&& arg : args) {
+        checker.set_param(arg.param).exec({arg.src, arg.filter, arg.bias, {}, {}});
+    }
+}
+
+TEST_F(X86_MULTI_THREADS, AVX2_CHANWISE_DIRECT_STRIDE1_FLOAT32) {
+    avx2_chanwise_direct_float32(handle(), 1, "X86_CONV_BIAS_F32_CHANWISE_AVX2");
+}
+
+TEST_F(X86_MULTI_THREADS, AVX2_CHANWISE_DIRECT_STRIDE2_FLOAT32) {
+    avx2_chanwise_direct_float32(handle(), 2, "X86_CONV_BIAS_F32_CHANWISE_AVX2");
+}
+
+TEST_F(X86, AVX2_CHANWISE_DIRECT_FLOAT32) {
+    avx2_chanwise_direct_float32(handle(), 1, "X86_CONV_BIAS_F32_CHANWISE_AVX2");
+}
+
 TEST_F(X86_MULTI_THREADS, AVX2_CONV_BIAS_DIRECT_STRIDE1_INT8x8x32) {
     using namespace conv_bias;
     std::vector<TestArg> args;
@@ -850,6 +916,131 @@ TEST_F(X86_MULTI_THREADS, CONV_BIAS_DIRECT_STRIDE2_GROUP) {
     }
 }
 
+namespace {
+bool is_avx2_fma_supported() {
+    return megdnn::x86::is_supported(x86::SIMDType::AVX2) &&
+           megdnn::x86::is_supported(x86::SIMDType::FMA);
+}
+
+std::vector<conv_bias::TestArg> get_nchw88_chanwise_or_hybrid_args(
+        std::vector<size_t> kernel_vec, size_t stride, bool is_input_nchw) {
+    using namespace conv_bias;
+    using NLMode = param::ConvBias::NonlineMode;
+    std::vector<TestArg> args;
+
+    auto pack = [&](size_t n, size_t c, size_t h, size_t w, size_t kernel,
+                    NLMode nlmode, megdnn::BiasMode bias_mode) {
+        size_t pad = kernel / 2;
+        size_t oh = (h + 2 * pad - kernel) / stride + 1;
+        size_t ow = (w + 2 * pad - kernel) / stride + 1;
+        param::ConvBias param;
+        param.format = param::ConvBias::Format::NCHW88;
+        param.stride_h = param.stride_w = stride;
+        param.pad_h = param.pad_w = pad;
+        param.nonlineMode = nlmode;
+        //! c is ic of the nchw input or the channel blocks of channel wise
+        TensorShape src{n, c, h, w, 8}, filter{c, 1, 1, kernel, kernel, 8};
+        size_t oc_blocks = c;
+        if (is_input_nchw) {
+            oc_blocks = 2;
+            src = {n, c, h, w};
+            filter = {oc_blocks, kernel, kernel, c, 8};
+        } else {
+            param.sparse = param::ConvBias::Sparse::GROUP;
+        }
+        TensorShape bias;
+        if (bias_mode == megdnn::BiasMode::BROADCAST_CHANNEL_BIAS) {
+            bias = {1, oc_blocks, 1, 1, 8};
+        } else if (bias_mode == megdnn::BiasMode::BIAS) {
+            bias = {n, oc_blocks, oh, ow, 8};
+        }
+        args.emplace_back(param, src, filter, bias);
+    };
+
+    std::vector<megdnn::BiasMode> bias_modes = {
+            megdnn::BiasMode::NO_BIAS, megdnn::BiasMode::BROADCAST_CHANNEL_BIAS};
+    //! the nchw input of the first layer does not support full bias
+    if (!is_input_nchw) {
+        bias_modes.push_back(megdnn::BiasMode::BIAS);
+    }
+    for (auto bias_mode : bias_modes)
+        for (auto nlmode :
+             {NLMode::IDENTITY, NLMode::RELU, NLMode::H_SWISH, NLMode::SIGMOID})
+            for (size_t n : {1, 2})
+                for (size_t c : is_input_nchw ? std::vector<size_t>{1, 3}
+                                              : std::vector<size_t>{1, 2, 5})
+                    for (size_t size : {7, 9, 20})
+                        for (size_t kernel : kernel_vec)
+                            pack(n, c, size, size + 3, kernel, nlmode, bias_mode);
+    return args;
+}
+}  // namespace
+
+#define FULL_NLMODE_WITH_SIGMOID                                                 \
+    {param::ConvBias::NonlineMode::IDENTITY, param::ConvBias::NonlineMode::RELU, \
+     param::ConvBias::NonlineMode::H_SWISH, param::ConvBias::NonlineMode::SIGMOID}
+#define FULL_BIAS_MODE                                                    \
+    {megdnn::BiasMode::NO_BIAS, megdnn::BiasMode::BROADCAST_CHANNEL_BIAS, \
+     megdnn::BiasMode::BIAS}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_F32_DIRECT_NCHW88_STRIDE1) {
+    if (!is_avx2_fma_supported())
+        return;
+    check_conv_bias(
+            conv_bias::get_nchw88_conv_bias_args(
+                    {2, 3, 5, 7}, FULL_NLMODE_WITH_SIGMOID, FULL_BIAS_MODE, 1),
+            handle(), "X86_CONV_BIAS_F32_DIRECT_NCHW88_AVX2");
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_F32_DIRECT_NCHW88_STRIDE2) {
+    if (!is_avx2_fma_supported())
+        return;
+    check_conv_bias(
+            conv_bias::get_nchw88_conv_bias_args(
+                    {2, 3, 5, 7}, FULL_NLMODE_WITH_SIGMOID, FULL_BIAS_MODE, 2),
+            handle(), "X86_CONV_BIAS_F32_DIRECT_NCHW88_AVX2");
+}
+
+TEST_F(X86, CONV_BIAS_F32_DIRECT_NCHW88) {
+    if (!is_avx2_fma_supported())
+        return;
+    check_conv_bias(
+            conv_bias::get_nchw88_conv_bias_args(
+                    {3}, FULL_NLMODE_WITH_SIGMOID, FULL_BIAS_MODE, 1),
+            handle(), "X86_CONV_BIAS_F32_DIRECT_NCHW88_AVX2");
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_F32_DIRECT_NCHW_NCHW88) {
+    if (!is_avx2_fma_supported())
+        return;
+    for (size_t stride : {1, 2}) {
+        check_conv_bias(
+                get_nchw88_chanwise_or_hybrid_args({2, 3, 5, 7}, stride, true),
+                handle(), "X86_CONV_BIAS_F32_DIRECT_NCHW_NCHW88_AVX2");
+    }
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_F32_CHANWISE_NCHW88) {
+    if (!is_avx2_fma_supported())
+        return;
+    for (size_t stride : {1, 2}) {
+        check_conv_bias(
+                get_nchw88_chanwise_or_hybrid_args({2, 3, 5, 7}, stride, false),
+                handle(), "X86_CONV_BIAS_F32_CHANWISE_NCHW88_AVX2");
+    }
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_CONV1X1_S1_F32_NCHW88) {
+    if (!is_avx2_fma_supported())
+        return;
+    check_conv_bias(
+            conv_bias::get_nchw88_conv_bias_args(
+                    {1}, FULL_NLMODE_WITH_SIGMOID, FULL_BIAS_MODE, 1, 0),
+            handle(), "CONV1x1:X86_F32MK8_8X8:24");
+}
+#undef FULL_NLMODE_WITH_SIGMOID
+#undef FULL_BIAS_MODE
+
 TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_INT8X8X32) {
     using namespace conv_bias;
     std::vector<TestArg> args;
@@ -5,6 +5,8 @@
 #include "test/common/task_record_check.h"
 #include "test/x86/fixture.h"
 
+#include "src/fallback/elemwise/gi_impl/avx2/utils.h"
+
 using namespace megdnn;
 using namespace test;
 
@@ -234,6 +236,53 @@ TEST_F(X86, ELEMWISE_UNARY_RECORD) {
     BUILD_UNARY_TEST_CASE_FLOAT
 }
 
+TEST_F(X86, ELEMWISE_FALLBACK_GI_AVX2) {
+    using Mode = ElemwiseForward::Param::Mode;
+    Checker<ElemwiseForward> checker(fallback_handle());
+    UniformFloatRNG rng(-7e1, 7e1), rng_pos(1e-2, 7e1);
+    checker.set_epsilon(1e-5);
+    for (size_t i = 0; i < 3; ++i) {
+        checker.set_dtype(i, dtype::Float32()).set_rng(i, &rng);
+    }
+
+    auto run = [&]() {
+        for (auto mode : {Mode::RELU, Mode::ABS}) {
+            checker.set_param(mode).execs({{1, 1556011}, {}});
+            checker.set_param(mode).execs({{3, 4, 7}, {}});
+        }
+        for (auto mode :
+             {Mode::ADD, Mode::SUB, Mode::MUL, Mode::MIN, Mode::MAX,
+              Mode::FUSE_ADD_RELU}) {
+            checker.set_param(mode);
+            checker.execs({{3, 4, 7}, {3, 4, 7}, {}});
+            checker.execs({{1024, 77}, {1024, 77}, {}});
+            checker.execs({{3, 4, 7}, {1}, {}});
+            checker.execs({{1}, {3, 4, 37}, {}});
+            checker.execs({{3, 4, 5, 7}, {1, 4, 1, 1}, {}});
+            checker.execs({{1, 4, 1, 1}, {3, 4, 5, 33}, {}});
+        }
+        checker.set_param(Mode::TRUE_DIV).set_rng(1, &rng_pos);
+        checker.execs({{3, 4, 7}, {3, 4, 7}, {}});
+        checker.execs({{1}, {3, 4, 37}, {}});
+        checker.execs({{1, 4, 1, 1}, {3, 4, 5, 33}, {}});
+        checker.set_rng(1, &rng);
+
+        checker.set_param(Mode::FUSE_MUL_ADD3);
+        checker.execs({{3, 4, 37}, {3, 4, 37}, {3, 4, 37}, {}});
+        checker.execs({{3, 4, 37}, {3, 4, 37}, {1}, {}});
+    };
+
+    //! the x86 handle runs its own algos first, so the 256-bit gi algos are
+    //! only reachable from the fallback handle; they are selected only if cpu
+    //! has avx2 and fma
+    run();
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+    fallback::gi_avx2_disable(true);
+    run();
+    fallback::gi_avx2_disable(false);
+#endif
+}
+
 #undef BINARY_COMPLATE_TEST_CASE
 #undef BUILD_BINARY_COMPLATE_TEST_CASE_FLOAT32
 
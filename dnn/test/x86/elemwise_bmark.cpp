@@ -5,6 +5,8 @@
 #include "test/common/checker.h"
 #include "test/common/rng.h"
 
+#include "src/fallback/elemwise/gi_impl/avx2/utils.h"
+
 using namespace megdnn;
 using namespace test;
 
@@ -294,6 +296,54 @@ TEST_F(X86, BENCHMARK_TERNARY_FMA3) {
 #undef FLOAT_BENCHMARK_CASES
 }
 
+TEST_F(X86, BENCHMARK_ELEM_GI_AVX2) {
+    using Mode = param::Elemwise::Mode;
+    constexpr size_t RUN = 50;
+    auto run = [&](const TensorShapeArray& shapes, Mode mode, const char* mode_str) {
+        SmallVector<TensorLayout> layouts;
+        for (auto&& shape : shapes) {
+            layouts.emplace_back(shape, dtype::Float32());
+        }
+        layouts.emplace_back();
+        auto opr = handle()->create_operator<Elemwise>();
+        opr->param() = mode;
+        opr->deduce_layout({layouts.begin(), layouts.end() - 1}, layouts.back());
+
+        auto bench = [&](Handle* handle) {
+            Benchmarker<Elemwise> benchmarker(handle);
+            benchmarker.set_times(RUN).set_display(false).set_param(mode);
+            return benchmarker.execl(layouts) / RUN;
+        };
+        //! gi algos of fallback with 128-bit and 256-bit, then x86 algos
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+        fallback::gi_avx2_disable(true);
+#endif
+        auto gi128_time = bench(fallback_handle());
+#if MEGDNN_FALLBACK_ELEMWISE_AVX2
+        fallback::gi_avx2_disable(false);
+#endif
+        auto gi256_time = bench(fallback_handle());
+        auto x86_time = bench(handle());
+        printf("%s %s: gi128=%.3fms gi256=%.3fms x86=%.3fms gi256 speedup: %.2fx, "
+               "x86/gi256: %.2fx\n",
+               layouts[0].to_string().c_str(), mode_str, gi128_time, gi256_time,
+               x86_time, gi128_time / gi256_time, gi256_time / x86_time);
+    };
+#define RUN_CASE(shapes, mode) run(shapes, Mode::mode, #mode)
+    TensorShapeArray vec_vec = {{1556011}, {1556011}},
+                     vec_scalar = {{1556011}, {1}},
+                     vec_bcast101 = {{9, 64, 33, 127}, {1, 64, 1, 1}};
+    RUN_CASE(vec_vec, ADD);
+    RUN_CASE(vec_scalar, ADD);
+    RUN_CASE(vec_bcast101, ADD);
+    RUN_CASE(vec_vec, TRUE_DIV);
+    RUN_CASE(vec_bcast101, FUSE_ADD_RELU);
+    RUN_CASE(TensorShapeArray({{1556011}}), RELU);
+    RUN_CASE(TensorShapeArray({{1556011}, {1556011}, {1556011}}), FUSE_MUL_ADD3);
+    RUN_CASE(TensorShapeArray({{1556011}, {1556011}, {1}}), FUSE_MUL_ADD3);
+#undef RUN_CASE
+}
+
 #undef BENCHMARK_CASES
 #undef INT_RUN
 #undef FLOAT_RUN
@@ -411,6 +411,38 @@ TEST_F(X86, ELEMWISE_QUANTIZED_MODE_TERNARY) {
     }
 }
 
+TEST_F(X86_MULTI_THREADS, ELEMWISE_QUANTIZED_MODE) {
+    using Mode = ElemwiseMultiType::Param::Mode;
+    Checker<ElemwiseMultiType> checker(handle());
+    UniformIntRNG rng_uint8{0, 225};
+    checker.set_rng(0, &rng_uint8)
+            .set_rng(1, &rng_uint8)
+            .set_rng(2, &rng_uint8)
+            .set_dtype(0, dtype::Quantized8Asymm(1.35f, static_cast<uint8_t>(128)))
+            .set_dtype(1, dtype::Quantized8Asymm(1.15f, static_cast<uint8_t>(128)))
+            .set_dtype(2, dtype::Quantized8Asymm(1.75f, static_cast<uint8_t>(128)))
+            .set_dtype(3, dtype::Quantized8Asymm(1.45f, static_cast<uint8_t>(128)));
+
+    //! large enough to be split over threads, with uneven tails
+    checker.set_param({Mode::QRELU})
+            .set_dtype(1, dtype::Quantized8Asymm(1.45f, static_cast<uint8_t>(128)));
+    checker.execs({{100003}, {}});
+
+    checker.set_param({Mode::QSUB})
+            .set_dtype(2, dtype::Quantized8Asymm(1.45f, static_cast<uint8_t>(128)));
+    checker.execs({{100003}, {100003}, {}});
+    checker.execs({{2, 33, 57, 31}, {1, 1, 1, 1}, {}});
+    checker.execs({{1}, {2, 33, 57, 31}, {}});
+    checker.execs({{2, 33, 57, 31}, {1, 33, 1, 1}, {}});
+    checker.execs({{1, 33, 1, 1}, {2, 33, 57, 31}, {}});
+
+    checker.set_param({Mode::QFUSE_MUL_ADD3})
+            .set_dtype(2, dtype::Quantized8Asymm(1.75f, static_cast<uint8_t>(128)));
+    checker.execs({{100003}, {100003}, {100003}, {}});
+    checker.execs({{2, 33, 57, 31}, {2, 33, 57, 31}, {1, 1, 1, 1}, {}});
+    checker.execs({{1, 33, 1, 1}, {2, 33, 57, 31}, {1, 33, 1, 1}, {}});
+}
+
 TEST_F(X86, ELEMWISE_QUANTIZED_MODE_TERNARY_RECORD) {
     using Mode = ElemwiseMultiType::Param::Mode;
     TaskRecordChecker<ElemwiseMultiType> checker(0);
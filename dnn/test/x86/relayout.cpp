@@ -0,0 +1,85 @@
+#include "test/x86/fixture.h"
+
+#include "test/common/benchmarker.h"
+#include "test/common/multi_thread_benchmark.h"
+
+namespace megdnn {
+namespace test {
+
+#if MEGDNN_WITH_BENCHMARK
+namespace {
+struct RelayoutCase {
+    const char* name;
+    TensorLayout src, dst;
+};
+
+//! src is the dimshuffled view of contiguous \p shape, dst is contiguous
+RelayoutCase dimshuffle_case(
+        const char* name, const TensorShape& shape, const std::vector<size_t>& pattern,
+        DType dtype) {
+    TensorLayout src = TensorLayout(shape, dtype).dimshuffle(pattern);
+    return {name, src, TensorLayout(TensorShape(src), dtype)};
+}
+
+//! NCHW to NCHW44 reformat, or the reverse one if \p to_nchw is true
+RelayoutCase nchw44_case(
+        const char* name, size_t N, size_t C, size_t H, size_t W, DType dtype,
+        bool to_nchw) {
+    TensorLayout nchw({N, C / 4, 4, H, W}, dtype), nchw44({N, C / 4, H, W, 4}, dtype);
+    if (to_nchw) {
+        return {name, nchw44.dimshuffle({0, 1, 4, 2, 3}), nchw};
+    }
+    return {name, nchw.dimshuffle({0, 1, 3, 4, 2}), nchw44};
+}
+}  // namespace
+
+TEST_F(X86_BENCHMARK_MULTI_THREADS, BENCHMARK_RELAYOUT) {
+    constexpr size_t RUNS = 20;
+    std::vector<RelayoutCase> cases;
+    cases.push_back({"contiguous copy", {{64 * 1024 * 1024}, dtype::Float32()},
+                     {{64 * 1024 * 1024}, dtype::Float32()}});
+    {
+        //! crop a subtensor out of a padded tensor
+        TensorLayout src({2048, 2000}, {2048, 1}, dtype::Float32());
+        cases.push_back({"subtensor copy", src, {{2048, 2000}, dtype::Float32()}});
+    }
+    cases.push_back(dimshuffle_case(
+            "transpose fp32", {4096, 4096}, {1, 0}, dtype::Float32()));
+    cases.push_back(
+            dimshuffle_case("transpose fp16", {4096, 4096}, {1, 0}, dtype::Float16()));
+    cases.push_back(
+            dimshuffle_case("transpose int8", {4096, 4096}, {1, 0}, dtype::Int8()));
+    cases.push_back(dimshuffle_case(
+            "nchw->nhwc fp32", {8, 64, 112, 112}, {0, 2, 3, 1}, dtype::Float32()));
+    cases.push_back(dimshuffle_case(
+            "nhwc->nchw fp32", {8, 112, 112, 64}, {0, 3, 1, 2}, dtype::Float32()));
+    cases.push_back(dimshuffle_case(
+            "nhwc->nchw u8 c3", {8, 512, 512, 3}, {0, 3, 1, 2}, dtype::Uint8()));
+    cases.push_back(nchw44_case(
+            "nchw->nchw44 fp32", 8, 64, 112, 112, dtype::Float32(), false));
+    cases.push_back(nchw44_case(
+            "nchw44->nchw fp32", 8, 64, 112, 112, dtype::Float32(), true));
+    cases.push_back(nchw44_case(
+            "nchw->nchw44 qint8", 8, 64, 112, 112, dtype::QuantizedS8(1.f), false));
+
+    std::vector<MultiThreadBenchmarkCase> bench_cases;
+    for (auto&& c : cases) {
+        TensorLayout src = c.src, dst = c.dst;
+        auto run = [src, dst](Handle* handle) {
+            Benchmarker<Relayout> benchmarker(handle);
+            benchmarker.set_times(RUNS).set_display(false);
+            return benchmarker.execl({src, dst}) / RUNS;
+        };
+        //! both the read and the write are counted
+        bench_cases.push_back(
+                {ssprintf("%-20s %s", c.name, src.to_string().c_str()), run,
+                 2.f * dst.span().dist_byte()});
+    }
+    benchmark_multi_thread(bench_cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -1,5 +1,6 @@
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/multi_thread_benchmark.h"
 
 #include "test/common/task_record_check.h"
 #include "test/x86/fixture.h"
@@ -175,6 +176,37 @@ TEST_F(X86, TYPE_CVT_2) {
             .set_dtype(1, dtype::Quantized8Asymm(0.0479196f, static_cast<uint8_t>(144)))
             .execs({{1, 32, 24, 128}, {1, 32, 24, 128}});
 }
+TEST_F(X86_MULTI_THREADS, TYPE_CVT_MULTI_THREAD) {
+    Checker<TypeCvt> checker(handle());
+    UniformFloatRNG rng(-200.f, 200.f);
+    UniformIntRNG rng8{INT8_MIN, INT8_MAX};
+    UniformIntRNG rngu8{0, UINT8_MAX};
+    UniformIntRNG rng32{INT32_MIN >> 1, INT32_MAX >> 1};
+    auto run = [&](DType src_dtype, DType dst_dtype, RNG* rng) {
+        checker.set_rng(0, rng).set_dtype(0, src_dtype).set_dtype(1, dst_dtype);
+        //! the blocks of every thread must cover the tensor exactly
+        for (size_t size : {33, 32768, 32768 + 7, 100003}) {
+            checker.execs({{size}, {size}});
+        }
+        checker.execs({{3, 224, 224}, {3, 224, 224}});
+    };
+    run(dtype::Float32(), dtype::QuantizedS8(0.7f), &rng);
+    run(dtype::Float32(), dtype::Quantized8Asymm(0.9f, static_cast<uint8_t>(37)),
+        &rng);
+    run(dtype::Float32(), dtype::QuantizedS32(0.01f), &rng);
+    run(dtype::QuantizedS8(0.3f), dtype::Float32(), &rng8);
+    run(dtype::Quantized8Asymm(0.3f, static_cast<uint8_t>(8)), dtype::Float32(),
+        &rngu8);
+    run(dtype::QuantizedS32(0.0003f), dtype::QuantizedS8(0.2f), &rng32);
+    run(dtype::QuantizedS32(0.0003f), dtype::Float32(), &rng32);
+    run(dtype::Float32(), dtype::Float16(), &rng);
+    run(dtype::Float16(), dtype::Float32(), &rng);
+    run(dtype::Float32(), dtype::BFloat16(), &rng);
+    run(dtype::BFloat16(), dtype::Float32(), &rng);
+    run(dtype::Float32(), dtype::Int32(), &rng);
+    run(dtype::Uint8(), dtype::Float32(), &rngu8);
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(X86, BENCHMARK_TYPE_CVT) {
     auto handle_naive = create_cpu_handle(2);
@@ -210,6 +242,41 @@ TEST_F(X86, BENCHMARK_TYPE_CVT) {
     run(shapes, dtype::Float32{}, dtype::Float16{}, "Float32->Float16");
     run(shapes, dtype::Float16{}, dtype::Float32{}, "Float16->Float32");
 }
+
+TEST_F(X86_BENCHMARK_MULTI_THREADS, BENCHMARK_TYPE_CVT_MULTI_THREAD) {
+    constexpr size_t RUNS = 20;
+    std::vector<MultiThreadBenchmarkCase> cases;
+    auto add_cases = [&](DType src_type, DType dst_type, const char* msg) {
+        //! a network input image and a large feature map
+        for (TensorShape shape : {TensorShape{1, 3, 1080, 1920}, {1, 64, 256, 256}}) {
+            auto run = [src_type, dst_type, shape](Handle* handle) {
+                Benchmarker<TypeCvt> benchmarker(handle);
+                benchmarker.set_display(false).set_times(RUNS);
+                benchmarker.set_dtype(0, src_type).set_dtype(1, dst_type);
+                return benchmarker.execs({shape, shape}) / RUNS;
+            };
+            cases.push_back(
+                    {ssprintf("run %s %s", shape.to_string().c_str(), msg), run});
+        }
+    };
+    add_cases(dtype::Float32(), dtype::QuantizedS8(0.5f), "Float32->QuantizedS8");
+    add_cases(
+            dtype::Float32(), dtype::Quantized8Asymm(0.5f, static_cast<uint8_t>(128)),
+            "Float32->Quantized8Asymm");
+    add_cases(dtype::QuantizedS8(0.5f), dtype::Float32(), "QuantizedS8->Float32");
+    add_cases(
+            dtype::Quantized8Asymm(0.5f, static_cast<uint8_t>(128)), dtype::Float32(),
+            "Quantized8Asymm->Float32");
+    add_cases(
+            dtype::QuantizedS32(0.5f), dtype::QuantizedS8(0.2f),
+            "QuantizedS32->QuantizedS8");
+    add_cases(dtype::Float32(), dtype::Float16(), "Float32->Float16");
+    add_cases(dtype::Float16(), dtype::Float32(), "Float16->Float32");
+    add_cases(dtype::Float32(), dtype::BFloat16(), "Float32->BFloat16");
+    add_cases(dtype::BFloat16(), dtype::Float32(), "BFloat16->Float32");
+    add_cases(dtype::Uint8(), dtype::Float32(), "Uint8->Float32");
+    benchmark_multi_thread(cases, {4, {0, 1, 2, 3}}, {1, {0}});
+}
 #endif
 
 }  // namespace test
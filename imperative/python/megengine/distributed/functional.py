@@ -31,6 +31,7 @@ _device2backend = {
     "gpu": "nccl",
     "cuda": "nccl",
     "rocm": "rccl",
+    "cpu": "shm",
 }
 
 
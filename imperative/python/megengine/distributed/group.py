@@ -94,8 +94,8 @@ class Group:
 
 WORLD = Group([])
 
-_devices = {"gpu", "cuda", "rocm", "cambricon", "atlas"}
-_backends = {"nccl", "rccl", "cncl", "hccl", "auto"}
+_devices = {"gpu", "cuda", "rocm", "cambricon", "atlas", "cpu"}
+_backends = {"nccl", "rccl", "cncl", "hccl", "shm", "auto"}
 
 
 def init_process_group(
@@ -115,7 +115,8 @@ def init_process_group(
         world_size: total number of processes participating in the job.
         rank: rank of the current process.
         device: the GPU device id to bind this process to.
-        backend: communicator backend, currently support 'nccl' and 'rccl'.
+        backend: communicator backend, currently support 'nccl' and 'rccl', and
+            'shm' for processes on cpu devices of the same host.
     """
     physical_device_type = what_is_xpu() if device_type == "xpu" else device_type
     if not isinstance(master_ip, str):
@@ -1,5 +1,8 @@
 #include "./interpreter_impl.h"
 
+#include <cmath>
+#include <limits>
+
 #include "range/v3/all.hpp"
 
 #include "megbrain/common.h"
@@ -7,6 +10,7 @@
 #include "megbrain/imperative/ops/autogen.h"
 #include "megbrain/imperative/ops/backward_graph.h"
 #include "megbrain/imperative/ops/opr_attr.h"
+#include "megbrain/imperative/ops/rng.h"
 #include "megbrain/imperative/ops/utility.h"
 #include "megbrain/imperative/utils/to_string.h"
 
@@ -621,7 +625,7 @@ void ChannelImpl::set_option(std::string name, size_t value) {
 void ChannelImpl::clear_candidates() {
     MGB_LOCK_GUARD(m_spin);
     assert_available();
-    m_dtr.candidates.clear();
+    m_dtr.clear_candidates();
 }
 
 TensorInfo* ChannelImpl::alloc() {
@@ -706,8 +710,18 @@ void ChannelImpl::real_free(TensorInfo* ptr) {
     if (ptr->size_exceeds_thd(state.options.dtr_evictee_minimum_size)) {
         m_dtr.erase_candidate(ptr);
     }
+    SmallVector<TensorInfo*> neighbors;
+    if (ptr->evict_type == EvictType::DROP) {
+        // their neighbor cost no longer includes ptr
+        neighbors = m_dtr.neighbor_candidates(ptr);
+    }
     detach_users(ptr);
     ptr->detach_producer();
+    for (auto i : neighbors) {
+        if (i->cand_index != UINT_MAX) {
+            m_dtr.update_candidate(i);
+        }
+    }
     bool has_value = ptr->ptr != nullptr;
     if (has_value) {
         MGB_RECORD_EVENT(TensorReleaseEvent, ptr->id);
@@ -969,7 +983,13 @@ void ChannelImpl::flush_apply_stack() {
         auto [cmd_backup, recomp_backup, reason_backup] =
                 std::make_tuple(cmd, recomp, reason);
         m_apply_stack.pop();
-        do_apply_op(cmd_backup, reason_backup);
+        if (recomp_backup) {
+            // random ops regenerate the outputs of their first run
+            rng::OffsetRecorder rng_replayer{recomp_backup->producer->rng_offsets};
+            do_apply_op(cmd_backup, reason_backup);
+        } else {
+            do_apply_op(cmd_backup, reason_backup);
+        }
         if (recomp_backup) {
             MGB_RECORD_EVENT(
                     TensorCommandFinishEvent, recomp_backup->id,
@@ -990,19 +1010,26 @@ bool ChannelImpl::auto_evict(size_t force_num) {
         return false;
     }
     size_t current_memory = m_dtr.comp_node.get_used_memory();
+    // queried once per round, every drop that releases memory only grows it
+    size_t max_free_block = m_dtr.comp_node.get_max_block_size_available();
     size_t flag = false;
     while ((state.options.dtr_eviction_threshold > 0 &&
             current_memory > state.options.dtr_eviction_threshold) ||
            force_num > 0) {
         MGB_RECORD_EVENT(AutoEvictEvent);
         sample_on_device(m_dtr.comp_node, false);
-        auto best = m_dtr.find_best_tensor(state.options.enable_dtr_sqrt_sampling);
+        m_dtr.nr_evaluated = 0;
+        auto best = m_dtr.find_best_tensor(
+                state.options.enable_dtr_sqrt_sampling, max_free_block);
         if (!best) {
-            MGB_RECORD_EVENT(AutoEvictFinishEvent);
+            MGB_RECORD_EVENT(
+                    AutoEvictFinishEvent, m_dtr.candidates.size(), m_dtr.nr_evaluated);
             break;
         }
         if (best->ptr.unique() && best->ptr->blob().unique()) {
             current_memory -= best->memory;
+            // the released block may merge with a free block on each side
+            max_free_block = 2 * max_free_block + best->memory;
             if (force_num > 0) {
                 force_num--;
             }
@@ -1013,7 +1040,8 @@ bool ChannelImpl::auto_evict(size_t force_num) {
             m_dtr.update_dsu_after_evict(best);
         }
         sample_on_device(m_dtr.comp_node, false);
-        MGB_RECORD_EVENT(AutoEvictFinishEvent);
+        MGB_RECORD_EVENT(
+                AutoEvictFinishEvent, m_dtr.candidates.size(), m_dtr.nr_evaluated);
     }
     return flag;
 }
@@ -1230,6 +1258,7 @@ void ChannelImpl::process_one_task(Command& icmd) {
                     return;
                 }
             }
+            rng::OffsetRecorder rng_recorder;
             if (state.options.enable_dtr_auto_drop) {
                 m_apply_stack.push({cmd, 0, nullptr, "cmd"});
                 flush_apply_stack();
@@ -1269,9 +1298,11 @@ void ChannelImpl::process_one_task(Command& icmd) {
                 bool inplace =
                         any_of(cartesian_product(cmd.inputs, cmd.outputs), is_inplace);
 
-                if (!inplace && !cross_cn && !m_dtr.is_bad_op(get_name(*cmd.op))) {
-                    TensorInfo::ComputePath::make(
+                if (!inplace && !cross_cn && !m_dtr.is_bad_op(get_name(*cmd.op)) &&
+                    rng_recorder.replayable()) {
+                    auto path = TensorInfo::ComputePath::make(
                             cmd.id, cmd.op, cmd.inputs, cmd.outputs);
+                    path->rng_offsets = rng_recorder.offsets();
                     size_t detach_cnt = 0;
                     if (!strcmp(get_name(*cmd.op), "BatchNorm") &&
                         cmd.outputs.size() == 6) {
@@ -1292,6 +1323,12 @@ void ChannelImpl::process_one_task(Command& icmd) {
                     for (auto input : cmd.inputs) {
                         input->ref_cnt -= detach_cnt;
                     }
+                    // the outputs became candidates before they got a producer
+                    for (auto output : cmd.outputs) {
+                        if (output->cand_index != UINT_MAX) {
+                            m_dtr.update_candidate(output);
+                        }
+                    }
                 }
             }
         } else if constexpr (std::is_same_v<T, Del>) {
@@ -1585,6 +1622,7 @@ void ChannelImpl::DynamicSublinear::update_dsu_after_recompute(TensorInfo* ptr)
     dsu_fa->t -= ptr->compute_time;
     ptr->dsu_ptr->parent.reset();
     ptr->dsu_ptr->t = ptr->compute_time;
+    update_neighbor_keys(ptr);
 }
 
 void ChannelImpl::DynamicSublinear::update_dsu_after_evict(TensorInfo* ptr) {
@@ -1598,6 +1636,7 @@ void ChannelImpl::DynamicSublinear::update_dsu_after_evict(TensorInfo* ptr) {
             merge(ptr->dsu_ptr, i->dsu_ptr);
         }
     }
+    update_neighbor_keys(ptr);
 }
 
 double ChannelImpl::DynamicSublinear::estimate_neighbor_cost(TensorInfo* ptr) {
@@ -1623,47 +1662,90 @@ double ChannelImpl::DynamicSublinear::estimate_neighbor_cost(TensorInfo* ptr) {
     return cost;
 }
 
+double ChannelImpl::DynamicSublinear::estimate_score(TensorInfo* ptr) {
+    if (!ptr->producer || !ptr->ptr || ptr->evict_type != EvictType::NONE) {
+        return std::numeric_limits<double>::infinity();
+    }
+    ++nr_evaluated;
+    double neighbor_cost = estimate_neighbor_cost(ptr);
+    size_t begin_ptr = reinterpret_cast<size_t>(ptr->ptr->blob()->storage().get());
+    auto side_info = ptr->ptr->comp_node().get_free_left_and_right(
+            begin_ptr, begin_ptr + ptr->ptr->blob()->size());
+    double free_mem = side_info.first + side_info.second;
+    return ptr->eval_func(
+            neighbor_cost, free_mem, estimate_timestamp, 1.0, 1.0, 1.0, 1.0001);
+}
+
+double ChannelImpl::DynamicSublinear::estimate_key(TensorInfo* ptr) {
+    if (!ptr->producer) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // estimate_neighbor_cost takes at least the compute time of each evicted
+    // neighbor, the parameters are the ones of estimate_score
+    double cost = 0;
+    for (auto i : ptr->producer->inputs) {
+        if (i->evict_type == EvictType::DROP) {
+            cost += i->compute_time;
+        }
+    }
+    for (auto i : ptr->producer->outputs) {
+        if (i && i->evict_type == EvictType::DROP) {
+            cost += i->compute_time;
+        }
+    }
+    return (cost + 1e-3) * pow(1.0001, (double)ptr->recompute_times) /
+           (ptr->memory / 1024.0 / 1024.0);
+}
+
 TensorInfo* ChannelImpl::DynamicSublinear::find_best_tensor(
-        bool enable_dtr_sqrt_sampling = false) {
+        bool enable_dtr_sqrt_sampling, size_t max_free_block) {
     if (candidates.empty())
         return nullptr;
 
+    if (!enable_dtr_sqrt_sampling) {
+        if (cand_used_times.empty()) {
+            return nullptr;
+        }
+        // the free memory around a tensor is at most two free blocks, and no
+        // candidate was used before the oldest one
+        double max_free_mem = 2.0 * max_free_block;
+        double scale =
+                1 / ((1 + max_free_mem / *cand_memories.begin()) *
+                     (estimate_timestamp - *cand_used_times.begin() + 1e-3));
+        TensorInfo* best = nullptr;
+        double min_score = std::numeric_limits<double>::infinity();
+        for (auto&& [key, ptr] : cand_by_key) {
+            // leave some room for the rounding errors of the bound
+            if (key * scale * (1 - 1e-9) >= min_score) {
+                break;
+            }
+            double score = estimate_score(ptr);
+            if (score < min_score) {
+                min_score = score;
+                best = ptr;
+            }
+        }
+        return best;
+    }
+
     double min_msps = -1;
     TensorInfo* best = nullptr;
     size_t sz = 1;
-    if (enable_dtr_sqrt_sampling) {
-        while (sz * sz <= candidates.size())
-            sz++;
-        sz--;
-    } else {
-        sz = candidates.size();
-    }
+    while (sz * sz <= candidates.size())
+        sz++;
+    sz--;
 
     size_t ti = rand() % sz;
     for (size_t vi = 0; vi < sz; vi++) {
-        if (!enable_dtr_sqrt_sampling) {
-            ti = vi;
-        }
         auto i = candidates[ti];
-        if (i->producer && i->ptr && i->evict_type == EvictType::NONE) {
-            double neighbor_cost = estimate_neighbor_cost(i);
-            size_t begin_ptr =
-                    reinterpret_cast<size_t>(i->ptr->blob()->storage().get());
-            auto side_info = i->ptr->comp_node().get_free_left_and_right(
-                    begin_ptr, begin_ptr + i->ptr->blob()->size());
-            double free_mem = side_info.first + side_info.second;
-            double msps = i->eval_func(
-                    neighbor_cost, free_mem, estimate_timestamp, 1.0, 1.0, 1.0, 1.0001);
-            if (min_msps < 0 || msps < min_msps) {
-                min_msps = msps;
-                best = i;
-            }
-        }
-        if (enable_dtr_sqrt_sampling) {
-            ti += rand() % sz;
-            if (ti > candidates.size())
-                break;
+        double msps = estimate_score(i);
+        if (!std::isinf(msps) && (min_msps < 0 || msps < min_msps)) {
+            min_msps = msps;
+            best = i;
         }
+        ti += rand() % sz;
+        if (ti > candidates.size())
+            break;
     }
     return best;
 }
@@ -1696,6 +1778,8 @@ void ChannelImpl::DynamicSublinear::insert_candidate(TensorInfo* ptr) {
             ptr->cand_index);
     ptr->cand_index = candidates.size();
     candidates.push_back(ptr);
+    ptr->cand_key = estimate_key(ptr);
+    index_candidate(ptr);
     if (!comp_node.valid()) {
         comp_node = ptr->ptr->comp_node();
     }
@@ -1709,13 +1793,81 @@ void ChannelImpl::DynamicSublinear::erase_candidate(TensorInfo* ptr) {
     }
     // some tensors may be erased already, just skip them
     if (ptr->cand_index != UINT_MAX) {
-        std::swap(candidates[ptr->cand_index], candidates.back());
+        unindex_candidate(ptr);
+        candidates[ptr->cand_index] = candidates.back();
         candidates[ptr->cand_index]->cand_index = ptr->cand_index;
         candidates.pop_back();
         ptr->cand_index = UINT_MAX;
     }
 }
 
+void ChannelImpl::DynamicSublinear::update_candidate(TensorInfo* ptr) {
+    unindex_candidate(ptr);
+    ptr->cand_key = estimate_key(ptr);
+    index_candidate(ptr);
+}
+
+SmallVector<TensorInfo*> ChannelImpl::DynamicSublinear::neighbor_candidates(
+        TensorInfo* ptr) {
+    SmallVector<TensorInfo*> ret;
+    auto add = [&ret](TensorInfo* i) {
+        if (i && i->cand_index != UINT_MAX) {
+            ret.push_back(i);
+        }
+    };
+    // ptr is a neighbor of its siblings and of the outputs of its users
+    if (ptr->producer) {
+        for (auto i : ptr->producer->outputs) {
+            add(i);
+        }
+    }
+    for (auto user : ptr->users) {
+        for (auto i : user->outputs) {
+            add(i);
+        }
+    }
+    return ret;
+}
+
+void ChannelImpl::DynamicSublinear::update_neighbor_keys(TensorInfo* ptr) {
+    for (auto i : neighbor_candidates(ptr)) {
+        update_candidate(i);
+    }
+}
+
+void ChannelImpl::DynamicSublinear::index_candidate(TensorInfo* ptr) {
+    cand_by_key.emplace(ptr->cand_key, ptr);
+    if (!std::isinf(ptr->cand_key)) {
+        cand_used_times.insert(ptr->last_used_time);
+        cand_memories.insert(ptr->memory);
+    }
+}
+
+void ChannelImpl::DynamicSublinear::unindex_candidate(TensorInfo* ptr) {
+    cand_by_key.erase({ptr->cand_key, ptr});
+    if (!std::isinf(ptr->cand_key)) {
+        cand_used_times.erase(cand_used_times.find(ptr->last_used_time));
+        cand_memories.erase(cand_memories.find(ptr->memory));
+    }
+}
+
+void ChannelImpl::DynamicSublinear::clear_candidates() {
+    for (auto i : candidates) {
+        i->cand_index = UINT_MAX;
+    }
+    candidates.clear();
+    cand_by_key.clear();
+    cand_used_times.clear();
+    cand_memories.clear();
+}
+
 void ChannelImpl::DynamicSublinear::update_used_time(TensorInfo* ptr) {
+    bool is_candidate = ptr->cand_index != UINT_MAX;
+    if (is_candidate) {
+        unindex_candidate(ptr);
+    }
     ptr->last_used_time = estimate_timestamp;
+    if (is_candidate) {
+        index_candidate(ptr);
+    }
 }
@@ -3,6 +3,7 @@
 #include <deque>
 #include <future>
 #include <list>
+#include <set>
 #include <stack>
 #include <thread>
 #include <unordered_set>
@@ -24,6 +25,8 @@ namespace mgb::imperative::interpreter::intl {
 
 using Handle = Interpreter::Handle;
 
+class DynamicSublinearTestingPeer;
+
 struct InterpreterImpl : Interpreter {
     std::unique_ptr<Channel> create_channel() override;
 };
@@ -209,10 +212,40 @@ private:
          * (2) is in memory, (3) is not pinned. Evaluation function refers to:
          * @see: TensorInfo::eval_func.
          *
+         * Without sampling, the candidates are visited in increasing order of
+         * their keys (see estimate_key) and the search stops as soon as the
+         * lower bound of the remaining scores is no less than the best score
+         * found, so the result is the same as evaluating every candidate.
+         *
+         * \param max_free_block an upper bound of the free blocks of
+         *      comp_node, which bounds the free memory around a candidate
          * \return the pointer of the best tensor; nullptr is returned if no
          * available tensor is found
          */
-        TensorInfo* find_best_tensor(bool);
+        TensorInfo* find_best_tensor(bool, size_t max_free_block);
+
+        /*!
+         * \brief evaluate the score of evicting tensor ptr now; the tensor with
+         * the lowest score is the best one to evict
+         *
+         * \return infinity if ptr is not available for eviction
+         */
+        double estimate_score(TensorInfo* ptr);
+
+        /*!
+         * \brief the time invariant key of candidate ptr
+         *
+         * It is the score of ptr at one unit of time after its last use and
+         * without the free memory around it, taking the sum of the compute
+         * time of its evicted neighbors as the neighbor cost, which is no
+         * more than the real one. find_best_tensor scales the keys by a bound
+         * of the time and free memory factors common to all the candidates,
+         * which makes them lower bounds of the scores. Keys only need
+         * updating when a neighbor of ptr leaves the evicted state.
+         *
+         * \return infinity if ptr has no producer and can not be evicted
+         */
+        double estimate_key(TensorInfo* ptr);
 
         /*!
          * \brief estimate the cost of recomputing tensor ptr
@@ -284,6 +317,28 @@ private:
          */
         void erase_candidate(TensorInfo* ptr);
 
+        /*!
+         * \brief recompute the key of candidate ptr
+         */
+        void update_candidate(TensorInfo* ptr);
+
+        /*!
+         * \brief update the keys of the candidates whose neighbor cost
+         * involves ptr
+         */
+        void update_neighbor_keys(TensorInfo* ptr);
+
+        //! the candidates whose neighbor cost involves ptr
+        SmallVector<TensorInfo*> neighbor_candidates(TensorInfo* ptr);
+
+        //! add ptr to the indices ordered by key, last used time and memory
+        void index_candidate(TensorInfo* ptr);
+
+        void unindex_candidate(TensorInfo* ptr);
+
+        //! remove all the candidates
+        void clear_candidates();
+
         //! estimate the current time, in order to reduce the overhead of timer
         double estimate_timestamp = 0;
 
@@ -293,19 +348,32 @@ private:
         //! store all tensors that may be evicted
         SmallVector<TensorInfo*> candidates;
 
+        //! candidates ordered by TensorInfo::cand_key
+        std::set<std::pair<double, TensorInfo*>> cand_by_key;
+
+        //! last used time and memory of the candidates with finite keys,
+        //! which bound the factors of the scores that are not in the keys
+        std::multiset<double> cand_used_times;
+        std::multiset<size_t> cand_memories;
+
+        //! number of scores evaluated since the counter was last reset, which
+        //! is reported to the profiler as the overhead of an eviction
+        size_t nr_evaluated = 0;
+
         bool is_bad_op(std::string op_name) {
             return std::find(op_blacklist.begin(), op_blacklist.end(), op_name) !=
                    op_blacklist.end();
         }
 
         // operators that cannot be re-computed, including :
-        // distributed operators, inplace operator, random generator operators
+        // distributed operators, inplace operator. Random generator operators
+        // are recomputed only if rng::OffsetRecorder can replay them
         std::vector<std::string> op_blacklist = {
-                "CollectiveComm", "InplaceAdd", "ParamPackSplit", "ParamPackConcat",
-                "GaussianRNG",    "UniformRNG", "GammaRNG",       "PermutationRNG",
-                "PoissonRNG",     "BetaRNG",    "ExponentialRNG", "MultinomialRNG"};
+                "CollectiveComm", "InplaceAdd", "ParamPackSplit", "ParamPackConcat"};
     } m_dtr;
 
+    friend DynamicSublinearTestingPeer;
+
     //! automatically evict an optimal tensor
     bool auto_evict(size_t);
 
@@ -82,6 +82,8 @@ struct TensorInfo {
         SmallVector<TensorInfo*> unique_inputs;
         SmallVector<TensorInfo*> outputs;
         SmallVector<LogicalTensorDesc> outputs_descs;
+        // offsets of the random oprs run by op, replayed on recomputation
+        SmallVector<uint64_t> rng_offsets;
 
         size_t ref_cnt() {
             return outputs.size() - std::count(outputs.begin(), outputs.end(), nullptr);
@@ -160,6 +162,10 @@ struct TensorInfo {
     // UINT_MAX as a magic default value
     size_t cand_index = UINT_MAX;
 
+    // lower bound of the eviction score of a candidate, see
+    // ChannelImpl::DynamicSublinear::estimate_key
+    double cand_key = 0;
+
     bool shape_valid() {
         MGB_LOCK_GUARD(lock);
         return desc.layout.ndim;
@@ -342,6 +342,18 @@ struct OpMeth<MultiHeadAttn> {
     }
 };
 
+//! whether the dnn opr of Op draws random numbers with the given param
+template <typename Op>
+bool draws_random(const typename OpMeth<Op>::Param&) {
+    return true;
+}
+
+//! only the dropouts of training mode are random
+template <>
+bool draws_random<MultiHeadAttn>(const OpMeth<MultiHeadAttn>::Param& param) {
+    return param.training && (param.attn_prob > 0 || param.out_prob > 0);
+}
+
 template <bool>
 struct _InferLayout;
 
@@ -521,8 +533,31 @@ void exec(
                 dnn_op->param().seed);
     }
     dnn_op->param() = OpMeth<Op>::make_param(rng);
-    _RNGOprInvoker<OpMeth<Op>::DnnOp::NR_INPUTS, OpMeth<Op>::DnnOp::NR_OUTPUTS>::exec(
-            dnn_op, inputs, outputs);
+    auto run = [&]() {
+        _RNGOprInvoker<
+                OpMeth<Op>::DnnOp::NR_INPUTS,
+                OpMeth<Op>::DnnOp::NR_OUTPUTS>::exec(dnn_op, inputs, outputs);
+    };
+    auto recorder = OffsetRecorder::current();
+    auto counter_based = dynamic_cast<megdnn::CounterBasedRNG*>(dnn_op);
+    if (!recorder) {
+        run();
+    } else if (!counter_based) {
+        if (draws_random<Op>(dnn_op->param())) {
+            recorder->on_stateful_exec();
+        }
+        run();
+    } else {
+        // a replayed op runs at its recorded offset, then the stream of the
+        // dnn opr goes on from where it was for the following ops
+        uint64_t current = counter_based->offset();
+        uint64_t offset = recorder->on_exec(current);
+        counter_based->set_offset(offset);
+        run();
+        if (offset != current) {
+            counter_based->set_offset(current);
+        }
+    }
 }
 
 template <typename Op>
@@ -1021,6 +1056,39 @@ CompNode get_rng_handle_compnode(Handle handle) {
     return RNGDnnOpManager::get_comp_node(handle);
 }
 
+namespace {
+thread_local OffsetRecorder* tls_offset_recorder = nullptr;
+}  // anonymous namespace
+
+OffsetRecorder::OffsetRecorder() : m_replay{false}, m_prev{tls_offset_recorder} {
+    tls_offset_recorder = this;
+}
+
+OffsetRecorder::OffsetRecorder(const SmallVector<uint64_t>& offsets)
+        : m_offsets{offsets}, m_replay{true}, m_prev{tls_offset_recorder} {
+    tls_offset_recorder = this;
+}
+
+OffsetRecorder::~OffsetRecorder() {
+    mgb_assert(tls_offset_recorder == this, "offset recorders are not nested");
+    tls_offset_recorder = m_prev;
+}
+
+OffsetRecorder* OffsetRecorder::current() {
+    return tls_offset_recorder;
+}
+
+uint64_t OffsetRecorder::on_exec(uint64_t current) {
+    if (!m_replay) {
+        m_offsets.push_back(current);
+        return current;
+    }
+    mgb_assert(
+            m_nr_replayed < m_offsets.size(),
+            "replaying more random oprs than recorded: %zu", m_offsets.size());
+    return m_offsets[m_nr_replayed++];
+}
+
 #define REG_RNG_OP(NAME, Output)                                            \
     namespace {                                                             \
     OP_TRAIT_REG(NAME, NAME, OpMeth<NAME>::OpNode)                          \
@@ -401,7 +401,11 @@ struct ChromeTimelineEventVisitor : EventVisitor<ChromeTimelineEventVisitor> {
         } else if constexpr (std::is_same_v<TEvent, AutoEvictEvent>) {
             new_host_event("AutoEvict", 'B');
         } else if constexpr (std::is_same_v<TEvent, AutoEvictFinishEvent>) {
-            new_host_event("AutoEvict", 'E');
+            new_host_event("AutoEvict", 'E')
+                    .arg("nr_candidates", event.nr_candidates)
+                    .arg("nr_evaluated", event.nr_evaluated);
+            new_host_event("dtr_candidates", 'C').arg("value", event.nr_candidates);
+            new_host_event("dtr_evaluated", 'C').arg("value", event.nr_evaluated);
         } else if constexpr (std::is_same_v<TEvent, HostToDeviceEvent>) {
             new_device_event("HostToDevice", 'B', event.device);
         } else if constexpr (std::is_same_v<TEvent, HostToDeviceFinishEvent>) {
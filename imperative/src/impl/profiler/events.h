@@ -158,7 +158,10 @@ DEF_DUR_EVENT(TensorCommand, {
     Kind kind;
 });
 
-DEF_DUR_EVENT(AutoEvict, {});
+DEF_DUR_EVENT(AutoEvict, {
+    size_t nr_candidates;
+    size_t nr_evaluated;
+});
 
 DEF_DUR_EVENT(Custom, {
     std::string title;
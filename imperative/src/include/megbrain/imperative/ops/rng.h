@@ -13,4 +13,42 @@ void set_global_rng_seed(uint64_t seed);
 uint64_t get_global_rng_seed();
 CompNode get_rng_handle_compnode(Handle handle);
 
+/*!
+ * \brief records the offsets taken by the counter based random oprs executed on
+ *      the current thread in its scope, or replays previously recorded ones
+ *
+ * Replaying makes random ops generate the same outputs again, which is what
+ * DTR needs to recompute them. Ops that draw random numbers from a dnn opr
+ * with an opaque state can not be replayed and make replayable() false.
+ */
+class OffsetRecorder : public NonCopyableObj {
+public:
+    //! record the offsets of the random ops applied in this scope
+    OffsetRecorder();
+    //! replay \p offsets, as recorded by a former recorder, in this scope
+    explicit OffsetRecorder(const SmallVector<uint64_t>& offsets);
+    ~OffsetRecorder();
+
+    bool replayable() const { return m_replayable; }
+    const SmallVector<uint64_t>& offsets() const { return m_offsets; }
+
+    //! the innermost recorder of the current thread, or nullptr
+    static OffsetRecorder* current();
+
+    /*!
+     * \brief offset to run a counter based opr at, given its \p current one
+     *
+     * Returns \p current when recording, or the recorded offset when replaying.
+     */
+    uint64_t on_exec(uint64_t current);
+    //! note that an op drew random numbers without a counter based dnn opr
+    void on_stateful_exec() { m_replayable = false; }
+
+private:
+    SmallVector<uint64_t> m_offsets;
+    size_t m_nr_replayed = 0;
+    bool m_replay, m_replayable = true;
+    OffsetRecorder* m_prev;
+};
+
 }  // namespace mgb::imperative::rng
@@ -1,9 +1,11 @@
 #include "megbrain/imperative/interpreter.h"
+#include "../impl/interpreter/interpreter_impl.h"
 #include "../impl/interpreter/tensor_info.h"
 #include "./helper.h"
 #include "megbrain/comp_node_env.h"
 #include "megbrain/imperative/blob_manager.h"
 #include "megbrain/imperative/ops/opr_attr.h"
+#include "megbrain/imperative/ops/rng.h"
 #include "megbrain/imperative/physical_tensor.h"
 #include "megbrain/opr/basic_arith.h"
 #include "megbrain/opr/basic_arith_wrapper.h"
@@ -12,11 +14,20 @@
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
 
+#include <random>
+
 using namespace mgb;
 using namespace cg;
 using namespace imperative;
 using namespace interpreter;
 
+namespace mgb::imperative::interpreter::intl {
+class DynamicSublinearTestingPeer {
+public:
+    using DynamicSublinear = ChannelImpl::DynamicSublinear;
+};
+}  // namespace mgb::imperative::interpreter::intl
+
 TEST(TestImperative, InterpreterPut) {
     HostTensorGenerator<> gen;
     auto h0 = gen({3});
@@ -78,4 +89,150 @@ TEST(TestImperative, InterpreterApplyOp) {
     }
 }
 
+TEST(TestImperative, DTRFindBestTensor) {
+    using intl::EvictType;
+    using intl::TensorInfo;
+    intl::DynamicSublinearTestingPeer::DynamicSublinear dtr;
+    HostTensorGenerator<> gen;
+    std::mt19937 rng(42);
+    auto rand_real = [&rng](double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+    };
+    auto cn = CompNode::load("xpux");
+
+    constexpr size_t nr_tensor = 96, nr_input = 4;
+    std::vector<std::unique_ptr<TensorInfo>> infos;
+    std::vector<TensorPtr> values;
+    std::vector<TensorInfo::ComputePath*> paths;
+    for (size_t i = 0; i < nr_tensor; ++i) {
+        auto info = std::make_unique<TensorInfo>();
+        values.push_back(Tensor::make(*gen({16 + rng() % 1024}, cn)));
+        info->ptr = values.back();
+        info->memory = info->ptr->blob()->size();
+        info->compute_time = rand_real(1, 100);
+        info->dsu_ptr = std::make_shared<intl::DsuNode>(info->compute_time);
+        infos.push_back(std::move(info));
+    }
+    //! every op takes one or two earlier tensors, some have two outputs
+    for (size_t i = nr_input; i < nr_tensor;) {
+        SmallVector<TensorInfo*> inputs{infos[rng() % i].get()};
+        if (rng() % 2) {
+            inputs.push_back(infos[rng() % i].get());
+        }
+        SmallVector<TensorInfo*> outputs{infos[i++].get()};
+        if (i < nr_tensor && rng() % 3 == 0) {
+            outputs.push_back(infos[i++].get());
+        }
+        paths.push_back(TensorInfo::ComputePath::make(i, nullptr, inputs, outputs));
+    }
+    for (auto&& info : infos) {
+        dtr.estimate_timestamp += rand_real(0, 10);
+        dtr.update_used_time(info.get());
+        dtr.insert_candidate(info.get());
+    }
+
+    //! compare with the best one found by evaluating all the candidates
+    auto check = [&](TensorInfo* best) {
+        double min_score = std::numeric_limits<double>::infinity();
+        for (auto i : dtr.candidates) {
+            min_score = std::min(min_score, dtr.estimate_score(i));
+        }
+        if (std::isinf(min_score)) {
+            ASSERT_EQ(nullptr, best);
+        } else {
+            ASSERT_NE(nullptr, best);
+            ASSERT_EQ(min_score, dtr.estimate_score(best));
+        }
+    };
+
+    for (size_t step = 0; step < 500; ++step) {
+        dtr.estimate_timestamp += rand_real(0, 10);
+        for (size_t i = 0; i < 4; ++i) {
+            dtr.update_used_time(infos[rng() % nr_tensor].get());
+        }
+        std::vector<size_t> evicted;
+        for (size_t i = 0; i < nr_tensor; ++i) {
+            if (infos[i]->evict_type == EvictType::DROP) {
+                evicted.push_back(i);
+            }
+        }
+        if (!evicted.empty() && rng() % 3 == 0) {
+            //! recompute an evicted tensor
+            size_t idx = evicted[rng() % evicted.size()];
+            auto info = infos[idx].get();
+            info->ptr = values[idx];
+            info->evict_type = EvictType::NONE;
+            dtr.update_used_time(info);
+            dtr.insert_candidate(info);
+            dtr.update_dsu_after_recompute(info);
+            continue;
+        }
+        auto best = dtr.find_best_tensor(false, cn.get_max_block_size_available());
+        ASSERT_NO_FATAL_FAILURE(check(best));
+        if (best) {
+            best->evict_type = EvictType::DROP;
+            best->ptr.reset();
+            dtr.erase_candidate(best);
+            dtr.update_dsu_after_evict(best);
+        }
+    }
+
+    dtr.clear_candidates();
+    for (auto path : paths) {
+        for (auto output : path->outputs) {
+            output->producer = nullptr;
+        }
+        delete path;
+    }
+}
+
+TEST(TestImperative, DTRRegenerateRandomOps) {
+    auto cn = CompNode::load("cpu0");
+    auto&& channel = Interpreter::inst().create_channel();
+    channel->set_option("enable_drop", 1);
+    channel->set_option("record_computing_path", 1);
+    channel->set_option("enable_dtr_auto_drop", 1);
+    channel->set_option("dtr_evictee_minimum_size", 0);
+    uint64_t seed = 42;
+    auto rng_handle = rng::new_handle(cn, seed);
+
+    HostTensorGenerator<> gen;
+    HostTensorND shape{cn, {1}, dtype::Int32()};
+    shape.ptr<int>()[0] = 1000;
+    auto shape_handle = channel->put(shape, false);
+    auto x_handle = channel->put(*gen({1000}, cn), false);
+
+    //! the output regenerated after eviction is the one of the first run,
+    //! though the random stream has moved on
+    auto run = [&](std::shared_ptr<OpDef> op, Interpreter::Handle input) {
+        auto outputs = channel->apply_op(op, {input});
+        HostTensorND expect;
+        expect.copy_from(channel->get_value(outputs[0])).sync();
+        auto next_outputs = channel->apply_op(op, {input});
+        auto next = channel->get_value(next_outputs[0]);
+        size_t size = expect.layout().span().dist_byte();
+        ASSERT_NE(0, memcmp(expect.raw_ptr(), next.raw_ptr(), size));
+
+        channel->drop(outputs[0]);
+        channel->sync();
+        auto info = reinterpret_cast<intl::TensorInfo*>(outputs[0]);
+        ASSERT_EQ(intl::TensorInfo::Dropped, info->status);
+        auto regenerated = channel->get_value(outputs[0]);
+        ASSERT_EQ(0, memcmp(expect.raw_ptr(), regenerated.raw_ptr(), size));
+        for (auto&& i : outputs) {
+            channel->del(i);
+        }
+        for (auto&& i : next_outputs) {
+            channel->del(i);
+        }
+    };
+    run(UniformRNG::make(seed, dtype::Float32(), rng_handle), shape_handle);
+    run(Dropout::make(0.3f, seed, rng_handle), x_handle);
+
+    channel->del(shape_handle);
+    channel->del(x_handle);
+    channel->close();
+    rng::delete_handle(rng_handle);
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
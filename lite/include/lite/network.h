@@ -121,6 +121,10 @@ struct LITE_API Options {
  *
  * @param discrete_input_name configure which input is composed of discrete
  * multiple tensors
+ *
+ * @param mmap_model map the model file into memory instead of reading it when
+ * loading the network from a path, so that processes loading the same bare model
+ * share its weights in page cache; packed or encrypted models are still copied
  */
 struct LITE_API Config {
     bool has_compression = false;
@@ -131,6 +135,7 @@ struct LITE_API Config {
     Options options = {};
     bool auto_optimize_inference = false;
     std::string discrete_input_name = {};
+    bool mmap_model = false;
 };
 
 /*!
@@ -424,6 +429,16 @@ public:
             std::shared_ptr<Network> network,
             const ThreadAffinityCallback& thread_affinity_callback);
 
+    /** @brief set the rounds the idle threads of the multi thread CPU runtime
+     * spin before they park, smaller value saves CPU time when the network
+     * is not forwarding, while larger value reduces the wake up latency
+     *
+     * @param dst_network the target network to set the spin count
+     * @param spin_count the spin rounds, 0 means park immediately
+     */
+    static void set_runtime_thread_spin_count(
+            std::shared_ptr<Network> dst_network, size_t spin_count);
+
     /** @brief Set cpu default mode when device is CPU, in some low computation
      * device or single core device, this mode will get good performace
      *
@@ -534,6 +549,23 @@ public:
     static void dump_layout_transform_model(
             std::shared_ptr<Network> network, std::string optimized_model_path);
 
+    /** @brief enable the compiled graph cache of the network, it should be
+     * called before model loaded
+     *
+     * When the model is loaded the first time, the graph after layout transform
+     * and the optimization of the graph options is dumped into cache_dir, the
+     * following loads of the same model with the same configuration and input
+     * layouts load the optimized graph and skip these passes. The cache file
+     * name is a hash of the model and the configuration including the
+     * MegEngine version, so a changed model or an upgraded MegEngine never
+     * uses a stale cache.
+     *
+     * @param network the network to load with the cache
+     * @param cache_dir the existing directory to store the cached graphs
+     */
+    static void enable_compiled_graph_cache(
+            std::shared_ptr<Network> network, std::string cache_dir);
+
     /** @brief get the model io information before model loaded by model path.
      *
      * @param model_path the model path to get the model IO information
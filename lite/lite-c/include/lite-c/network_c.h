@@ -106,6 +106,9 @@ extern LITE_API const LiteOptions default_option;
  *
  * \param discrete_input_name configure which input is composed of discrete
  * multiple tensors
+ *
+ * \param mmap_model map the model file into memory instead of reading it when
+ * loading the network from a path
  */
 typedef struct LiteConfig {
     int has_compression;
@@ -116,6 +119,7 @@ typedef struct LiteConfig {
     LiteOptions options;
     int auto_optimize_inference;
     const char* discrete_input_name;
+    int mmap_model;
 } LiteConfig;
 
 //! get default config
@@ -543,6 +547,13 @@ LITE_API int LITE_set_finish_callback_with_userdata(
 LITE_API int LITE_set_runtime_thread_affinity(
         LiteNetwork network, const LiteThreadAffinityCallback thread_affinity_callback);
 
+/**
+ * \brief set the rounds the idle threads spin before they park
+ * \param[in] network The loaded model
+ * \param[in] spin_count The spin rounds, 0 means park immediately
+ */
+LITE_API int LITE_set_runtime_thread_spin_count(LiteNetwork network, size_t spin_count);
+
 /**
  * \brief set the network memroy allocator, the allocator is defined by user
  * \param[in] network The loaded model
@@ -609,6 +620,17 @@ LITE_API int LITE_enable_global_layout_transform(LiteNetwork network);
 LITE_API int LITE_dump_layout_transform_model(
         LiteNetwork network, const char* dump_file_path);
 
+/**
+ * \brief enable the compiled graph cache, the optimized graph is dumped into
+ * the cache dir when the model is loaded the first time, and the following
+ * loads with the same model and configuration load it to skip the optimization
+ * \param[in] cache_dir The existing directory to store the cached graphs
+ * \return int if the return is not zero, error happened, the error message
+ * can get by LITE_get_last_error
+ */
+LITE_API int LITE_enable_compiled_graph_cache(
+        LiteNetwork network, const char* cache_dir);
+
 /**! get the model io information before model loaded by model path.
  * \param[in] model_path The model file path
  * \param[in] config The model config for loading
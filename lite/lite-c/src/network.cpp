@@ -44,7 +44,8 @@ LiteConfig default_config_t = {
         .bare_model_cryption_name = nullptr,
         .options = default_option,
         .auto_optimize_inference = false,
-        .discrete_input_name = nullptr};
+        .discrete_input_name = nullptr,
+        .mmap_model = false};
 LiteConfig* default_config() {
     return &default_config_t;
 }
@@ -139,6 +140,7 @@ lite::Config convert_to_lite_config(const LiteConfig c_config) {
     if (c_config.discrete_input_name) {
         lite_config.discrete_input_name = c_config.discrete_input_name;
     }
+    lite_config.mmap_model = c_config.mmap_model;
 
     return lite_config;
 }
@@ -626,6 +628,15 @@ int LITE_set_runtime_thread_affinity(
     LITE_CAPI_END();
 }
 
+int LITE_set_runtime_thread_spin_count(LiteNetwork network, size_t spin_count) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(network, "The network pass to LITE api is null");
+    std::shared_ptr<lite::Network> network_shared{
+            static_cast<lite::Network*>(network), [](void*) {}};
+    lite::Runtime::set_runtime_thread_spin_count(network_shared, spin_count);
+    LITE_CAPI_END();
+}
+
 int LITE_set_memory_allocator(
         LiteNetwork network, const LiteAllocate allocate_fun, const LiteFree free_fun) {
     LITE_CAPI_BEGIN();
@@ -712,6 +723,15 @@ int LITE_dump_layout_transform_model(LiteNetwork network, const char* dump_file_
     LITE_CAPI_END();
 }
 
+int LITE_enable_compiled_graph_cache(LiteNetwork network, const char* cache_dir) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(network, "The network pass to LITE api is null");
+    std::shared_ptr<lite::Network> network_shared{
+            static_cast<lite::Network*>(network), [](void*) {}};
+    lite::Runtime::enable_compiled_graph_cache(network_shared, cache_dir);
+    LITE_CAPI_END();
+}
+
 namespace {
 static LITE_MUTEX mtx_io;
 static std::unordered_map<const void*, InnerIO>& get_global_io_holder() {
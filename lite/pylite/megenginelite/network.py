@@ -177,6 +177,8 @@ class LiteConfig(Structure):
 
         discrete_input_name: configure which input is composed of discrete multiple tensors
 
+        mmap_model: map the model file into memory instead of reading it when loading the network from a path
+
     Examples:
         .. code-block::
 
@@ -198,6 +200,7 @@ class LiteConfig(Structure):
         ("options", LiteOptions),
         ("auto_optimize_inference", c_int),
         ("discrete_input_name", c_char_p),
+        ("mmap_model", c_int),
     ]
 
     def __init__(self, device_type=LiteDeviceType.LITE_CPU, option=None):
@@ -213,6 +216,7 @@ class LiteConfig(Structure):
         self.backend = LiteBackend.LITE_DEFAULT
         self.auto_optimize_inference = 0
         self.discrete_input_name = c_char_p(b"")
+        self.mmap_model = 0
 
     @property
     def bare_model_cryption_name(self):
@@ -236,6 +240,7 @@ class LiteConfig(Structure):
             "options": self.options,
             "auto_optimize_inference": self.auto_optimize_inference,
             "discrete_input_name": self.discrete_input_name,
+            "mmap_model": bool(self.mmap_model),
         }
         return data.__repr__()
 
@@ -534,6 +539,7 @@ class _NetworkAPI(_LiteCObjBase):
         ("LITE_get_static_memory_alloc_info", [_Cnetwork, c_char_p]),
         ("LITE_enable_global_layout_transform", [_Cnetwork]),
         ("LITE_dump_layout_transform_model", [_Cnetwork, c_char_p]),
+        ("LITE_enable_compiled_graph_cache", [_Cnetwork, c_char_p]),
         (
             "LITE_get_model_io_info_by_path",
             [c_char_p, LiteConfig, POINTER(_LiteNetworkIO)],
@@ -1001,6 +1007,19 @@ class LiteNetwork(object):
         c_file = model_file.encode("utf-8")
         self._api.LITE_dump_layout_transform_model(self._network, c_file)
 
+    def enable_compiled_graph_cache(self, cache_dir):
+        """
+        cache the optimized graph in cache_dir when the model is loaded the
+        first time, the following loads of the same model with the same
+        configuration load the cached graph to skip the optimization, it
+        should be called before model loaded
+
+        Args:
+            cache_dir: the existing directory to store the cached graphs
+        """
+        c_dir = cache_dir.encode("utf-8")
+        self._api.LITE_enable_compiled_graph_cache(self._network, c_dir)
+
 
 def get_model_io_info(model_path, config=None):
     """
@@ -96,6 +96,8 @@ inline void call_func<NetworkImplDft, void>(
         std::string func_name, Network::NetworkImplBase* network_impl, size_t num) {
     if (func_name == "set_cpu_threads_number") {
         CALL_FUNC(set_cpu_threads_number, num);
+    } else if (func_name == "set_runtime_thread_spin_count") {
+        CALL_FUNC(set_runtime_thread_spin_count, num);
     } else if (func_name == "set_network_algo_workspace_limit") {
         CALL_FUNC(set_network_algo_workspace_limit, num);
     } else {
@@ -179,6 +181,8 @@ inline void call_func<NetworkImplDft, void>(
         return CALL_FUNC(enable_io_bin_dump, file_name);
     } else if (func_name == "dump_layout_transform_model") {
         return CALL_FUNC(dump_layout_transform_model, file_name);
+    } else if (func_name == "enable_compiled_graph_cache") {
+        return CALL_FUNC(enable_compiled_graph_cache, file_name);
     }
     THROW_FUNC_ERROR(func_name);
 }
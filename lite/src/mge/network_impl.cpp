@@ -17,6 +17,8 @@
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/tensor.h"
+#include "megbrain/utils/hash.h"
+#include "megbrain/version.h"
 
 #if MGB_OPENCL
 #include "megcore_opencl.h"
@@ -26,6 +28,7 @@
 #include "cpuinfo.h"
 #endif
 
+#include <cstdio>
 #include <fstream>
 #include <memory>
 #include <set>
@@ -35,6 +38,11 @@ using namespace mgb;
 
 LITE_DYN_TYPE_OBJ_FINAL_IMPL(NetworkImplDft);
 
+namespace {
+//! bump when the content of the compiled graph cache changes
+constexpr int COMPILED_GRAPH_CACHE_VERSION = 1;
+}  // namespace
+
 void NetworkImplDft::set_config(const Config& config) {
     *m_user_config = config;
     m_compnode_locator = to_compnode_locator(m_user_config->device_type);
@@ -200,6 +208,22 @@ void NetworkImplDft::set_runtime_thread_affinity(
     }
 }
 
+void NetworkImplDft::set_runtime_thread_spin_count(size_t spin_count) {
+    LITE_ASSERT(
+            m_user_config->device_type == LiteDeviceType::LITE_CPU,
+            "multi threads mode is only avaliable in CPU.");
+    if (m_nr_threads > 1) {
+        mgb::CompNode::Locator loc;
+        m_load_config.comp_node_mapper(loc);
+        auto cn = mgb::CompNode::load(loc);
+        mgb::CompNodeEnv::from_comp_node(cn).cpu_env().set_spin_count(spin_count);
+    } else {
+        LITE_WARN(
+                "set_runtime_thread_spin_count has no effect, the network runs "
+                "on one thread without a thread pool.");
+    }
+}
+
 void NetworkImplDft::set_device_id(int device_id) {
     m_compnode_locator.device = device_id;
     m_user_config->device_id = device_id;
@@ -521,8 +545,9 @@ void NetworkImplDft::layout_transform_optimization() {
             //! if all convolution and matmul data type is float32
             if (is_model_float32) {
                 //! if device is x86
-                //! if x86 support avx, use format nchw88
-                if (cpuinfo_has_x86_avx()) {
+                //! if x86 support avx2 and fma, use format nchw88, the x86
+                //! nchw88 float32 kernels need both of them
+                if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
                     m_load_config.comp_graph->options().graph_opt.enable_nchw88();
                     LITE_LOG("Configure model inference with nchw88 format.");
                 } else if (cpuinfo_has_x86_sse2() && !cpuinfo_has_x86_sse3()) {
@@ -554,6 +579,9 @@ void NetworkImplDft::layout_transform_optimization() {
 void NetworkImplDft::load_model(
         std::shared_ptr<void> model_mem, size_t size,
         std::unordered_map<std::string, LiteAny> separate_config_map) {
+    //! the loader is given when sharing weights with another network, the
+    //! shared graph can not be replaced by the cached one
+    bool use_compiled_graph_cache = !m_compiled_graph_cache_dir.empty() && !m_loader;
     if (!m_loader) {
         m_input_file =
                 mgb::serialization::InputFile::make_mem_proxy(model_mem, size, false);
@@ -587,6 +615,31 @@ void NetworkImplDft::load_model(
         use_tensorrt();
     }
 
+    if (use_compiled_graph_cache) {
+        m_compiled_graph_cache_path =
+                get_compiled_graph_cache_path(model_mem.get(), size);
+        std::ifstream cache_file(m_compiled_graph_cache_path, std::ios::binary);
+        if (cache_file.good()) {
+            cache_file.close();
+            auto input_file = mgb::serialization::InputFile::make_fs(
+                    m_compiled_graph_cache_path.c_str());
+            auto format = mgb::serialization::GraphLoader::identify_graph_dump_format(
+                    *input_file);
+            if (format.valid()) {
+                m_loader = mgb::serialization::GraphLoader::make(
+                        std::move(input_file), format.val());
+                m_compiled_graph_cache_hit = true;
+                LITE_LOG(
+                        "load optimized graph from compiled graph cache %s.",
+                        m_compiled_graph_cache_path.c_str());
+            } else {
+                LITE_WARN(
+                        "ignore invalid compiled graph cache %s.",
+                        m_compiled_graph_cache_path.c_str());
+            }
+        }
+    }
+
     m_load_result = m_loader->load(m_load_config, true);
     configure_after_loaded();
 }
@@ -594,7 +647,23 @@ void NetworkImplDft::load_model(
 void NetworkImplDft::configure_after_loaded() {
     modify_exection_policy();
 
-    layout_transform_optimization();
+    if (m_compiled_graph_cache_hit) {
+        //! the cached graph has been transformed and optimized, only the
+        //! runtime option weight_preprocess is kept, which is enabled by
+        //! auto_optimize_inference the same way as in
+        //! layout_transform_optimization
+        auto&& graph_opt = m_load_config.comp_graph->options().graph_opt;
+        bool weight_preprocess =
+                graph_opt.weight_preprocess ||
+                (!m_set_layout_transform && m_user_config->auto_optimize_inference);
+        graph_opt.clear();
+        graph_opt.weight_preprocess = weight_preprocess;
+    } else {
+        layout_transform_optimization();
+        if (!m_compiled_graph_cache_path.empty()) {
+            dump_compiled_graph_cache();
+        }
+    }
 
     //! find how many compnode the model has, this should call before update_io
     cross_compnode_model_detect();
@@ -1210,6 +1279,95 @@ void NetworkImplDft::dump_layout_transform_model(std::string optimized_model_pat
     }
 }
 
+void NetworkImplDft::enable_compiled_graph_cache(std::string cache_dir) {
+    LITE_ASSERT(!cache_dir.empty(), "the compiled graph cache dir is empty.");
+    m_compiled_graph_cache_dir = std::move(cache_dir);
+}
+
+std::string NetworkImplDft::get_compiled_graph_cache_path(
+        const void* model_mem, size_t size) const {
+    auto version = mgb::get_version();
+    auto&& options = m_load_config.comp_graph->options();
+    auto&& graph_opt = options.graph_opt;
+    std::string desc = ssprintf(
+            "version:%d.%d.%d.%d;cache:%d;device:%d,%d;threads:%zu;"
+            "layout_transform:%d,%d;auto_optimize:%d;graph_opt:%d,%d,%d,%d,%d,%d,"
+            "%d,%d,%d;opt_level:%d;const_shape:%d;",
+            version.major, version.minor, version.patch, version.is_dev,
+            COMPILED_GRAPH_CACHE_VERSION, static_cast<int>(m_user_config->device_type),
+            m_compnode_locator.device, m_nr_threads, m_set_layout_transform,
+            static_cast<int>(m_layout_transform_target),
+            m_user_config->auto_optimize_inference,
+            static_cast<int>(graph_opt.layout_transform), graph_opt.f16_io_comp,
+            graph_opt.f16_io_f32_comp, graph_opt.fuse_conv_bias_nonlinearity,
+            graph_opt.fuse_conv_bias_with_z, graph_opt.weight_preprocess,
+            graph_opt.fuse_preprocess, graph_opt.fuse_grain, graph_opt.jit,
+            options.graph_opt_level, m_load_config.const_var_shape);
+    //! the global layout transform profiles with the input shapes
+    for (auto&& input : m_network_io->inputs) {
+        desc += ssprintf(
+                "input:%s,%d,%d", input.name.c_str(),
+                static_cast<int>(input.config_layout.data_type),
+                static_cast<int>(input.config_layout.ndim));
+        for (size_t i = 0; i < input.config_layout.ndim; ++i) {
+            desc += ssprintf(",%zu", input.config_layout.shapes[i]);
+        }
+        desc += ";";
+    }
+    //! the layout chosen by auto_optimize_inference and the global layout
+    //! transform depend on the cpu features
+#if defined(MGB_ENABLE_CPUINFO_CHECK) && MGB_ENABLE_CPUINFO
+    if (m_user_config->device_type == LITE_CPU) {
+        cpuinfo_initialize();
+        desc += ssprintf(
+                "cpu:%d,%d,%d,%d,%d,%d;", cpuinfo_has_x86_avx2(),
+                cpuinfo_has_x86_fma3(), cpuinfo_has_x86_sse2(), cpuinfo_has_x86_sse3(),
+                cpuinfo_has_arm_neon(), cpuinfo_has_arm_neon_dot());
+    }
+#endif
+    auto hash = mgb::XXHash{}
+                        .update(model_mem, size)
+                        .update(desc.data(), desc.size())
+                        .digest();
+    return ssprintf(
+            "%s/%016llx.mge", m_compiled_graph_cache_dir.c_str(),
+            static_cast<unsigned long long>(hash));
+}
+
+void NetworkImplDft::dump_compiled_graph_cache() {
+    //! apply the passes of the graph optimize options here instead of in
+    //! graph compiling, they are reset so would not be applied again
+    auto dest_vars = mgb::cg::to_var_node_array(m_load_result.output_var_list);
+    mgb::gopt::GraphOptimizer optimizer;
+    optimizer.add_passes_for_optimize_options(
+            m_load_config.comp_graph->options().graph_opt, true);
+    optimizer.apply_inplace(dest_vars);
+    m_load_result.update_output_var_list(mgb::cg::to_symbol_var_array(dest_vars));
+
+    //! dump to a temporary file first, so other networks never read a
+    //! partially written cache
+    auto tmp_path = m_compiled_graph_cache_path + ".tmp";
+    try {
+        {
+            auto out_file = mgb::serialization::OutputFile::make_fs(
+                    tmp_path.c_str(), 'w');
+            using DumpConfig = mgb::serialization::GraphDumper::DumpConfig;
+            DumpConfig config{1, false, false};
+            auto dumper = mgb::serialization::GraphDumper::make(
+                    std::move(out_file), m_format.val());
+            dumper->dump(m_load_result.output_var_list, config);
+        }
+        LITE_ASSERT(
+                !std::rename(tmp_path.c_str(), m_compiled_graph_cache_path.c_str()),
+                "failed to rename %s", tmp_path.c_str());
+    } catch (std::exception& e) {
+        std::remove(tmp_path.c_str());
+        LITE_WARN(
+                "failed to write compiled graph cache %s: %s",
+                m_compiled_graph_cache_path.c_str(), e.what());
+    }
+}
+
 NetworkIO lite::get_model_io_info_dft(
         const std::string& model_path, const Config& config) {
     FILE* fin = fopen(model_path.c_str(), "rb");
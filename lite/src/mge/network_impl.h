@@ -149,6 +149,9 @@ public:
     void set_runtime_thread_affinity(
             const ThreadAffinityCallback& thread_affinity_callback);
 
+    //! set the spin rounds of the idle threads in the thread pool
+    void set_runtime_thread_spin_count(size_t spin_count);
+
     //! set the network memroy allocator, the allocator is defined by user
     void set_memory_allocator(std::shared_ptr<Allocator> user_allocator);
 
@@ -179,6 +182,10 @@ public:
     //! dump network after global layout transform optimization
     void dump_layout_transform_model(std::string optimized_model_path);
 
+    //! cache the optimized graph in the given directory, and load it from
+    //! the cache when the same model is loaded with the same configuration
+    void enable_compiled_graph_cache(std::string cache_dir);
+
     mgb::serialization::GraphLoader::LoadResult get_load_result() {
         return m_load_result;
     }
@@ -242,6 +249,16 @@ private:
     //! configure and optimize network after loaded
     void configure_after_loaded();
 
+    //! get the path of the compiled graph cache file of the model, the name
+    //! is the hash of the model and everything that changes the optimized
+    //! graph
+    std::string get_compiled_graph_cache_path(
+            const void* model_mem, size_t size) const;
+
+    //! apply the graph optimize options to the loaded graph and dump it to
+    //! the compiled graph cache
+    void dump_compiled_graph_cache();
+
 private:
     bool m_async = false;
     bool m_is_cpu_inplace_mode = false;
@@ -249,6 +266,10 @@ private:
     size_t m_nr_threads = 1;
     bool m_compute_configured_output_only = false;
     bool m_set_layout_transform = false;
+    //! whether the graph is loaded from the compiled graph cache
+    bool m_compiled_graph_cache_hit = false;
+    std::string m_compiled_graph_cache_dir;
+    std::string m_compiled_graph_cache_path;
     mgb::CompNode::Locator m_compnode_locator;
 
     AsyncCallback m_async_callback = nullptr;
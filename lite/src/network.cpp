@@ -12,8 +12,41 @@
 #include <fstream>
 #include <memory>
 
+#if !defined(WIN32) && !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LITE_HAVE_MMAP 1
+#else
+#define LITE_HAVE_MMAP 0
+#endif
+
 using namespace lite;
 
+namespace {
+#if LITE_HAVE_MMAP
+//! map the model file with a private mapping, so pages are shared in page
+//! cache until they are written
+std::shared_ptr<void> mmap_model_file(const std::string& model_path, size_t& size) {
+    int fd = open(model_path.c_str(), O_RDONLY);
+    LITE_ASSERT(fd >= 0, "failed to open %s: %s", model_path.c_str(), strerror(errno));
+    struct stat st;
+    int err = fstat(fd, &st);
+    LITE_ASSERT(!err, "failed to stat %s: %s", model_path.c_str(), strerror(errno));
+    size = st.st_size;
+    LITE_ASSERT(size, "the model file %s is empty", model_path.c_str());
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    LITE_ASSERT(
+            ptr != MAP_FAILED, "failed to mmap %s: %s", model_path.c_str(),
+            strerror(errno));
+    size_t map_size = size;
+    return {ptr, [map_size](void* p) { munmap(p, map_size); }};
+}
+#endif
+}  // namespace
+
 /**
  * \brief Construct the new work implement
  * the order must be :
@@ -61,6 +94,14 @@ void Network::load_model(void* model_mem, size_t size) {
 void Network::load_model(std::string model_path) {
     LITE_ERROR_HANDLER_BEGIN
     LITE_CHECK_NON_NULL_POINTER(m_impl);
+#if LITE_HAVE_MMAP
+    if (m_config.mmap_model) {
+        size_t size;
+        auto buf = mmap_model_file(model_path, size);
+        prase_model(buf, size);
+        return;
+    }
+#endif
     FILE* fin = fopen(model_path.c_str(), "rb");
     LITE_ASSERT(fin, "failed to open %s: %s", model_path.c_str(), strerror(errno));
     fseek(fin, 0, SEEK_END);
@@ -384,6 +425,23 @@ void Runtime::set_runtime_thread_affinity(
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::set_runtime_thread_spin_count(
+        std::shared_ptr<Network> network, size_t spin_count) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "set_runtime_thread_spin_count should be used after model "
+                "loaded.");
+        call_func<NetworkImplDft, void>(
+                "set_runtime_thread_spin_count", network_impl, spin_count);
+        return;
+    }
+    LITE_THROW("set_runtime_thread_spin_count is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::set_cpu_inplace_mode(std::shared_ptr<Network> network) {
     LITE_ERROR_HANDLER_BEGIN
     auto network_impl = NetworkHelper::implement(network);
@@ -556,6 +614,22 @@ void Runtime::dump_layout_transform_model(
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::enable_compiled_graph_cache(
+        std::shared_ptr<Network> network, std::string cache_dir) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                !NetworkHelper::loaded(network),
+                "enable_compiled_graph_cache should be used before model loaded.");
+        call_func<NetworkImplDft, void>(
+                "enable_compiled_graph_cache", network_impl, cache_dir);
+        return;
+    }
+    LITE_THROW("enable_compiled_graph_cache is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 NetworkIO Runtime::get_model_io_info(
         const std::string& model_path, const Config& config) {
     LITE_ERROR_HANDLER_BEGIN
@@ -8,6 +8,8 @@
 #ifndef WIN32
 #include <dirent.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <chrono>
@@ -234,6 +236,16 @@ TEST(TestNetWork, LoadFBSModel) {
     ASSERT_EQ(out_layout.shapes[3], 180);
 }
 
+TEST(TestNetWork, MmapModel) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+    config.mmap_model = true;
+    auto result_lite = mgelite_lar(model_path, config, "data", lite_tensor);
+    compare_lite_tensor<float>(result_lite, result_mgb);
+}
+
 TEST(TestNetWork, BasicInplaceAndSingleThreadAffinity) {
     Config config;
     auto lite_tensor = get_input_data("./input_data.npy");
@@ -1125,6 +1137,62 @@ TEST(TestNetWork, GlabalLayoutTransform) {
     remove(dump_model_name.c_str());
 }
 
+#ifndef WIN32
+TEST(TestNetWork, CompiledGraphCache) {
+    auto tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+    std::string input_name = "data";
+    std::string cache_dir = "./compiled_graph_cache";
+    mkdir(cache_dir.c_str(), 0755);
+
+    auto list_cache = [&]() {
+        std::vector<std::string> files;
+        DIR* dirptr = opendir(cache_dir.c_str());
+        struct dirent* dirp;
+        while (dirptr != NULL && (dirp = readdir(dirptr)) != NULL) {
+            std::string file_name(dirp->d_name);
+            if (file_name != "." && file_name != "..") {
+                files.push_back(cache_dir + "/" + file_name);
+            }
+        }
+        closedir(dirptr);
+        return files;
+    };
+
+    Config config;
+    auto result_mgb = mgb_lar(model_path, config, input_name, tensor);
+    config.options.enable_nchw44 = true;
+    auto run = [&]() {
+        std::shared_ptr<Network> network = std::make_shared<Network>(config);
+        Runtime::enable_compiled_graph_cache(network, cache_dir);
+        network->load_model(model_path);
+
+        std::shared_ptr<Tensor> input_tensor = network->get_io_tensor(input_name);
+        input_tensor->reset(tensor->get_memory_ptr(), tensor->get_layout());
+        network->forward();
+        network->wait();
+        compare_lite_tensor<float>(network->get_output_tensor(0), result_mgb);
+    };
+
+    //! the first load dumps the optimized graph, the second one loads it
+    run();
+    auto files = list_cache();
+    ASSERT_EQ(files.size(), 1u);
+    run();
+    ASSERT_EQ(list_cache(), files);
+
+    //! another configuration gets another cache
+    config.options.enable_nchw44 = false;
+    run();
+    ASSERT_EQ(list_cache().size(), 2u);
+
+    for (auto&& file : list_cache()) {
+        remove(file.c_str());
+    }
+    rmdir(cache_dir.c_str());
+}
+#endif
+
 TEST(TestNetWork, GetDeviceType) {
     auto tensor = get_input_data("./input_data.npy");
     std::string model_path = "./shufflenet.mge";
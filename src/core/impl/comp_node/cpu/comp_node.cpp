@@ -1,4 +1,5 @@
 #include "./comp_node.h"
+#include "./mem_arena.h"
 
 #include "megbrain/common.h"
 #include "megbrain/comp_node_env.h"
@@ -255,6 +256,10 @@ public:
 
     void* mgb_aligned_alloc(size_t size) {
         auto alignment = get_mem_addr_alignment();
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        if (arena.enabled()) {
+            return arena.alloc(size, alignment, get_numa_node());
+        }
 #ifdef WIN32
         return _aligned_malloc(size, alignment);
 #elif defined(__ANDROID__) || defined(ANDROID) || defined(__OHOS__)
@@ -268,6 +273,10 @@ public:
     }
 
     static void mgb_aligned_free(void* ptr) {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        if (arena.enabled()) {
+            return arena.free(ptr);
+        }
 #ifdef WIN32
         _aligned_free(ptr);
 #else
@@ -335,10 +344,60 @@ public:
         return get_host_cpu_mem_node();
     }
 
+    //! NUMA node of the worker thread if it is bound to a CPU, or -1
+    int get_numa_node() const {
+        if (enable_affinity && m_locator.type == DeviceType::CPU &&
+            m_locator.device >= 0) {
+            return mem_alloc::CpuMemArena::get_cpu_node(m_locator.device);
+        }
+        return -1;
+    }
+
     std::pair<size_t, size_t> get_mem_status_bytes() override {
-        return sys::get_ram_status_bytes();
+        auto ret = sys::get_ram_status_bytes();
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        if (arena.enabled()) {
+            ret.second += arena.get_free_memory().tot;
+        }
+        return ret;
+    }
+
+#if !MGB_BUILD_SLIM_SERVING
+    //! note that the memory arena is shared by all cpu comp nodes
+    void log_mem_pool_details() override {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        if (arena.enabled()) {
+            arena.print_memory_state();
+        } else {
+            Impl::log_mem_pool_details();
+        }
+    }
+
+    size_t get_used_memory() override {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        return arena.enabled() ? arena.get_used_memory() : 0;
+    }
+
+    size_t get_max_used_memory() override {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        return arena.enabled() ? arena.get_max_used_memory() : 0;
     }
 
+    void reset_max_used_memory() override {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        if (arena.enabled()) {
+            arena.reset_max_used_memory();
+        }
+    }
+
+    size_t get_reserved_memory() override {
+        auto&& arena = mem_alloc::CpuMemArena::inst();
+        return arena.enabled()
+                     ? arena.get_used_memory() + arena.get_free_memory().tot
+                     : 0;
+    }
+#endif
+
     Locator locator() override { return m_locator; }
 
     Locator locator_logical() override { return m_locator_logical; }
@@ -409,6 +468,12 @@ public:
             m_queue->add_task({affinity_run, 1_z});
         }
     }
+
+    void set_spin_count(size_t spin_count) override {
+        if (auto thread_pool = m_queue->get_thread_pool()) {
+            thread_pool->set_spin_count(spin_count);
+        }
+    }
 };
 
 //! implementation of InplaceCPUDispatcher
@@ -475,6 +540,12 @@ public:
             affinity_cb(0);
         }
     }
+
+    void set_spin_count(size_t spin_count) override {
+        if (m_thread_pool) {
+            m_thread_pool->set_spin_count(spin_count);
+        }
+    }
 };
 
 //! ==================== CompNodeDefaultImpl ======================
@@ -957,6 +1028,10 @@ void CpuCompNode::finalize() {
         sm_pool->~Pool();
         sm_pool = nullptr;
     }
+    auto&& arena = mem_alloc::CpuMemArena::inst();
+    if (arena.enabled()) {
+        arena.release_cached();
+    }
 }
 
 size_t CpuCompNode::get_device_count() {
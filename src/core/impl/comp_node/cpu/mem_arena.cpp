@@ -0,0 +1,389 @@
+#include "./mem_arena.h"
+
+#include "megbrain/system.h"
+#include "megbrain/utils/arith_helper.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifndef __APPLE__
+#include <malloc.h>
+#endif
+
+#if defined(__linux__) && !defined(WIN32)
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#define MGB_CPU_MEM_ARENA_LINUX 1
+#else
+#define MGB_CPU_MEM_ARENA_LINUX 0
+#endif
+
+using namespace mgb;
+using namespace mem_alloc;
+
+namespace {
+//! number of size classes between two adjacent powers of two is
+//! (1 << CLASS_STEP_LOG2)
+constexpr size_t MIN_CLASS_LOG2 = 8, CLASS_STEP_LOG2 = 3,
+                 NR_CLASS = ((64 - MIN_CLASS_LOG2) << CLASS_STEP_LOG2) + 1;
+static_assert(
+        (size_t(1) << MIN_CLASS_LOG2) == CpuMemArena::MIN_CLASS_SIZE,
+        "bad min class size");
+
+enum class BlockKind : uint32_t { MALLOC, MMAP };
+
+void* aligned_malloc(size_t alignment, size_t size) {
+#ifdef WIN32
+    return _aligned_malloc(size, alignment);
+#elif defined(__ANDROID__) || defined(ANDROID) || defined(__OHOS__)
+    return memalign(alignment, size);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size)) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+void aligned_free(void* ptr) {
+#ifdef WIN32
+    _aligned_free(ptr);
+#else
+    ::free(ptr);
+#endif
+}
+
+size_t class_size_of(size_t id) {
+    if (!id) {
+        return CpuMemArena::MIN_CLASS_SIZE;
+    }
+    size_t p = (id - 1) >> CLASS_STEP_LOG2, k = id - (p << CLASS_STEP_LOG2);
+    p += MIN_CLASS_LOG2;
+    return (size_t(1) << p) + (k << (p - CLASS_STEP_LOG2));
+}
+
+//! map from CPU id to NUMA node read from sysfs
+std::vector<int> read_cpu_nodes() {
+    std::vector<int> nodes(std::max(sys::get_cpu_count(), 1), -1);
+#if MGB_CPU_MEM_ARENA_LINUX
+    for (size_t cpu = 0; cpu < nodes.size(); ++cpu) {
+        auto path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        auto dir = opendir(path.c_str());
+        if (!dir) {
+            continue;
+        }
+        while (auto ent = readdir(dir)) {
+            int node;
+            if (sscanf(ent->d_name, "node%d", &node) == 1) {
+                nodes[cpu] = node;
+                break;
+            }
+        }
+        closedir(dir);
+    }
+#endif
+    return nodes;
+}
+}  // anonymous namespace
+
+struct CpuMemArena::BlockHeader {
+    void* raw;
+    size_t raw_size;
+    size_t class_id;
+    size_t alignment;
+    uint32_t arena_id;
+    BlockKind kind;
+
+    void* ptr() { return this + 1; }
+};
+
+struct CpuMemArena::NodeArena {
+    MGB_MUTEX mtx;
+    std::vector<BlockHeader*> bins[NR_CLASS];
+    size_t used = 0, cached = 0, nr_cached = 0;
+};
+
+constexpr size_t CpuMemArena::HUGE_PAGE_SIZE, CpuMemArena::MAX_NR_NODE,
+        CpuMemArena::MIN_CLASS_SIZE;
+
+CpuMemArena::CpuMemArena(const Config& config)
+        : m_config{config}, m_arenas{new NodeArena[MAX_NR_NODE]} {}
+
+CpuMemArena::~CpuMemArena() {
+    release_cached();
+}
+
+CpuMemArena& CpuMemArena::inst() {
+    // use static storage so the arena can be safely accessed even after
+    // global finalize
+    static std::aligned_storage_t<sizeof(CpuMemArena), alignof(CpuMemArena)>
+            storage;
+    static CpuMemArena* ptr = new (&storage) CpuMemArena{config_from_env()};
+    return *ptr;
+}
+
+CpuMemArena::Config CpuMemArena::config_from_env() {
+    Config config;
+    if (auto setting = MGB_GETENV("MGB_CPU_MEM_ARENA")) {
+        config.enabled = std::atoi(setting) > 0;
+    }
+    if (auto setting = MGB_GETENV("MGB_CPU_MEM_ARENA_CACHE_MB")) {
+        char* end = nullptr;
+        errno = 0;
+        auto mb = std::strtoull(setting, &end, 10);
+        if (end == setting || *end || errno == ERANGE || std::strchr(setting, '-')) {
+            mgb_log_warn(
+                    "invalid MGB_CPU_MEM_ARENA_CACHE_MB: %s, use the default %zu MB",
+                    setting, config.max_cached_per_node >> 20);
+        } else if (mb > (std::numeric_limits<size_t>::max() >> 20)) {
+            config.max_cached_per_node = std::numeric_limits<size_t>::max();
+        } else {
+            config.max_cached_per_node = static_cast<size_t>(mb) << 20;
+        }
+    }
+    if (auto setting = MGB_GETENV("MGB_CPU_HUGE_PAGE")) {
+        auto mode = std::atoi(setting);
+        mgb_assert(
+                mode >= 0 && mode <= static_cast<int>(HugePage::EXPLICIT),
+                "invalid MGB_CPU_HUGE_PAGE: %s", setting);
+        config.huge_page = static_cast<HugePage>(mode);
+    }
+    return config;
+}
+
+size_t CpuMemArena::get_class_id(size_t size) {
+    if (size <= MIN_CLASS_SIZE) {
+        return 0;
+    }
+    // find p such that 2^p < size <= 2^(p+1)
+    size_t p = MIN_CLASS_LOG2;
+    while (p + 1 < 64 && (size_t(1) << (p + 1)) < size) {
+        ++p;
+    }
+    size_t step_log2 = p - CLASS_STEP_LOG2;
+    size_t k = ((size - (size_t(1) << p)) + (size_t(1) << step_log2) - 1) >>
+               step_log2;
+    return ((p - MIN_CLASS_LOG2) << CLASS_STEP_LOG2) + k;
+}
+
+size_t CpuMemArena::get_class_size(size_t size) {
+    return class_size_of(get_class_id(size));
+}
+
+int CpuMemArena::get_cpu_node(int cpu) {
+    static std::vector<int> nodes = read_cpu_nodes();
+    if (cpu < 0 || cpu >= static_cast<int>(nodes.size())) {
+        return -1;
+    }
+    return nodes[cpu];
+}
+
+int CpuMemArena::get_cur_node() {
+#if MGB_CPU_MEM_ARENA_LINUX
+    auto node = get_cpu_node(sched_getcpu());
+    if (node >= 0) {
+        return node;
+    }
+#endif
+    return 0;
+}
+
+CpuMemArena::BlockHeader* CpuMemArena::alloc_raw(
+        size_t class_id, size_t alignment, size_t arena_id) {
+    size_t class_size = class_size_of(class_id),
+           prefix = get_aligned_power2<size_t>(sizeof(BlockHeader), alignment),
+           raw_size = prefix + class_size;
+    void* raw = nullptr;
+    auto kind = BlockKind::MALLOC;
+#if MGB_CPU_MEM_ARENA_LINUX
+    if (m_config.huge_page != HugePage::NONE && class_size >= HUGE_PAGE_SIZE &&
+        alignment <= HUGE_PAGE_SIZE) {
+        raw_size = get_aligned_power2<size_t>(raw_size, HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+        if (m_config.huge_page == HugePage::EXPLICIT) {
+            raw = mmap(
+                    nullptr, raw_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (raw == MAP_FAILED) {
+                static std::atomic_flag warn_printed = ATOMIC_FLAG_INIT;
+                if (!warn_printed.test_and_set()) {
+                    mgb_log_warn(
+                            "failed to map explicit huge pages, fallback to "
+                            "transparent huge pages");
+                }
+                raw = nullptr;
+            } else {
+                kind = BlockKind::MMAP;
+            }
+        }
+#endif
+        if (!raw) {
+            raw = aligned_malloc(HUGE_PAGE_SIZE, raw_size);
+#ifdef MADV_HUGEPAGE
+            if (raw) {
+                madvise(raw, raw_size, MADV_HUGEPAGE);
+            }
+#endif
+        }
+    }
+#endif
+    if (!raw) {
+        raw = aligned_malloc(alignment, raw_size);
+    }
+    if (!raw) {
+        return nullptr;
+    }
+    auto header = reinterpret_cast<BlockHeader*>(
+            static_cast<uint8_t*>(raw) + prefix - sizeof(BlockHeader));
+    header->raw = raw;
+    header->raw_size = raw_size;
+    header->class_id = class_id;
+    header->alignment = alignment;
+    header->arena_id = arena_id;
+    header->kind = kind;
+    return header;
+}
+
+void CpuMemArena::free_raw(BlockHeader* header) {
+#if MGB_CPU_MEM_ARENA_LINUX
+    if (header->kind == BlockKind::MMAP) {
+        munmap(header->raw, header->raw_size);
+        return;
+    }
+#endif
+    aligned_free(header->raw);
+}
+
+void* CpuMemArena::alloc(size_t size, size_t alignment, int node) {
+    alignment = std::max(alignment, alignof(BlockHeader));
+    mgb_assert(!(alignment & (alignment - 1)), "bad alignment: %zu", alignment);
+    if (node < 0) {
+        node = get_cur_node();
+    }
+    size_t arena_id = node % MAX_NR_NODE, class_id = get_class_id(size),
+           class_size = class_size_of(class_id);
+    auto&& arena = m_arenas[arena_id];
+    BlockHeader* header = nullptr;
+    {
+        MGB_LOCK_GUARD(arena.mtx);
+        auto&& bin = arena.bins[class_id];
+        if (!bin.empty() && bin.back()->alignment % alignment == 0) {
+            header = bin.back();
+            bin.pop_back();
+            arena.cached -= class_size;
+            --arena.nr_cached;
+            arena.used += class_size;
+        }
+    }
+    if (!header) {
+        header = alloc_raw(class_id, alignment, arena_id);
+        if (!header) {
+            // give cached blocks of all nodes back to the system and retry
+            release_cached();
+            header = alloc_raw(class_id, alignment, arena_id);
+        }
+        if (!header) {
+            mgb_throw(
+                    MemAllocError, "failed to alloc %zu bytes with align %zu",
+                    size, alignment);
+        }
+        MGB_LOCK_GUARD(arena.mtx);
+        arena.used += class_size;
+    }
+    auto used = m_used.fetch_add(class_size, std::memory_order_relaxed) +
+                class_size;
+    auto max_used = m_max_used.load(std::memory_order_relaxed);
+    while (max_used < used &&
+           !m_max_used.compare_exchange_weak(
+                   max_used, used, std::memory_order_relaxed)) {
+    }
+    return header->ptr();
+}
+
+void CpuMemArena::free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto header = static_cast<BlockHeader*>(ptr) - 1;
+    auto class_size = class_size_of(header->class_id);
+    auto&& arena = m_arenas[header->arena_id];
+    m_used.fetch_sub(class_size, std::memory_order_relaxed);
+    {
+        MGB_LOCK_GUARD(arena.mtx);
+        arena.used -= class_size;
+        if (arena.cached + class_size <= m_config.max_cached_per_node) {
+            arena.bins[header->class_id].push_back(header);
+            arena.cached += class_size;
+            ++arena.nr_cached;
+            return;
+        }
+    }
+    free_raw(header);
+}
+
+void CpuMemArena::release_cached() {
+    std::vector<BlockHeader*> to_free;
+    for (size_t i = 0; i < MAX_NR_NODE; ++i) {
+        auto&& arena = m_arenas[i];
+        MGB_LOCK_GUARD(arena.mtx);
+        for (auto&& bin : arena.bins) {
+            to_free.insert(to_free.end(), bin.begin(), bin.end());
+            bin.clear();
+        }
+        arena.cached = arena.nr_cached = 0;
+    }
+    for (auto header : to_free) {
+        free_raw(header);
+    }
+}
+
+void CpuMemArena::print_memory_state() {
+    for (size_t i = 0; i < MAX_NR_NODE; ++i) {
+        auto&& arena = m_arenas[i];
+        MGB_LOCK_GUARD(arena.mtx);
+        if (arena.used || arena.nr_cached) {
+            mgb_log("cpu memory arena stats: node %zu: used=%zu cached={tot:%zu, "
+                    "nr:%zu}",
+                    i, arena.used, arena.cached, arena.nr_cached);
+        }
+    }
+}
+
+size_t CpuMemArena::get_used_memory() {
+    return m_used.load(std::memory_order_relaxed);
+}
+
+size_t CpuMemArena::get_max_used_memory() {
+    return m_max_used.load(std::memory_order_relaxed);
+}
+
+void CpuMemArena::reset_max_used_memory() {
+    m_max_used.store(get_used_memory(), std::memory_order_relaxed);
+}
+
+FreeMemStat CpuMemArena::get_free_memory() {
+    FreeMemStat stat{0, std::numeric_limits<size_t>::max(), 0, 0};
+    for (size_t i = 0; i < MAX_NR_NODE; ++i) {
+        auto&& arena = m_arenas[i];
+        MGB_LOCK_GUARD(arena.mtx);
+        for (size_t id = 0; id < NR_CLASS; ++id) {
+            if (auto nr = arena.bins[id].size()) {
+                auto size = class_size_of(id);
+                stat.tot += size * nr;
+                stat.min = std::min(stat.min, size);
+                stat.max = std::max(stat.max, size);
+                stat.nr_blk += nr;
+            }
+        }
+    }
+    return stat;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "megbrain/comp_node/alloc.h"
+
+#include <atomic>
+#include <memory>
+
+namespace mgb {
+namespace mem_alloc {
+
+/*!
+ * \brief caching allocator for memory of cpu comp nodes
+ *
+ * Requested sizes are rounded up to size classes (eight classes per power of
+ * two). Freed blocks are kept in the bins of the NUMA node they were allocated
+ * on and reused by later requests of the same class, so that dynamic shapes do
+ * not go through malloc and page faults on every allocation. Blocks not
+ * smaller than HUGE_PAGE_SIZE can be backed by huge pages.
+ *
+ * The process-wide instance is configured by environment variables:
+ *  - MGB_CPU_MEM_ARENA: set to 1 to route cpu comp node allocations here
+ *  - MGB_CPU_MEM_ARENA_CACHE_MB: max cached bytes per NUMA node in MiB
+ *  - MGB_CPU_HUGE_PAGE: 1 for transparent huge pages (madvise), 2 for
+ *    explicit huge pages (MAP_HUGETLB, falling back to 1 if not reserved)
+ */
+class CpuMemArena final : public MemAllocBase, public NonCopyableObj {
+public:
+    enum class HugePage : int { NONE = 0, TRANSPARENT = 1, EXPLICIT = 2 };
+
+    struct Config {
+        bool enabled = false;
+        HugePage huge_page = HugePage::NONE;
+        size_t max_cached_per_node = size_t(1024) << 20;
+    };
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20, MAX_NR_NODE = 8,
+                            MIN_CLASS_SIZE = 256;
+
+    explicit CpuMemArena(const Config& config);
+    ~CpuMemArena();
+
+    /*!
+     * \brief the instance used by cpu comp nodes
+     *
+     * It is never destructed, so memory can still be freed after global
+     * finalize.
+     */
+    static CpuMemArena& inst();
+
+    static Config config_from_env();
+
+    bool enabled() const { return m_config.enabled; }
+
+    const Config& config() const { return m_config; }
+
+    /*!
+     * \brief allocate memory from the arena of given NUMA node
+     * \param node NUMA node id; the node of calling thread is used if
+     *      negative
+     */
+    void* alloc(size_t size, size_t alignment, int node = -1);
+
+    //! return a block to the bins of the node it was allocated on
+    void free(void* ptr);
+
+    //! give all cached blocks back to the system
+    void release_cached();
+
+    void print_memory_state() override;
+
+    //! total class size of blocks held by users
+    size_t get_used_memory() override;
+
+    size_t get_max_used_memory();
+
+    void reset_max_used_memory();
+
+    //! cached blocks over all nodes
+    FreeMemStat get_free_memory() override;
+
+    FreeMemStat get_free_memory_dev() override { return get_free_memory(); }
+
+    //! size of the class that a request of \p size falls into
+    static size_t get_class_size(size_t size);
+
+    //! NUMA node of given CPU, or -1 if unknown
+    static int get_cpu_node(int cpu);
+
+    //! NUMA node of the calling thread, or 0 if unknown
+    static int get_cur_node();
+
+private:
+    struct BlockHeader;
+    struct NodeArena;
+
+    const Config m_config;
+    std::unique_ptr<NodeArena[]> m_arenas;
+    std::atomic_size_t m_used{0}, m_max_used{0};
+
+    static size_t get_class_id(size_t size);
+
+    BlockHeader* alloc_raw(size_t class_id, size_t alignment, size_t arena_id);
+    void free_raw(BlockHeader* header);
+};
+
+}  // namespace mem_alloc
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -2,6 +2,7 @@
 #include "./cg_impl.h"
 #include "./var_node_mem_mgr.h"
 
+#include <algorithm>
 #include <queue>
 
 using namespace mgb;
@@ -12,6 +13,7 @@ void SeqCompNodeOptimizerImpl::optimize_comp_nodes(const VarNodeArray& endpoints
             m_comp_node_to_restore.empty() && m_comp_node_changed_oprs.empty(),
             "restore_comp_nodes not called");
     change_to_specific_stream(endpoints);
+    assign_cpu_branch_comp_nodes(endpoints);
 
     for (auto&& i : m_comp_node_to_restore) {
         auto opr = i.first->owner_opr();
@@ -162,6 +164,185 @@ void SeqCompNodeOptimizerImpl::change_to_specific_stream(
     }
 }
 
+void SeqCompNodeOptimizerImpl::assign_cpu_branch_comp_nodes(
+        const VarNodeArray& endpoints) {
+    auto&& options = m_owner_graph->options();
+    size_t max_nr_branch = options.seq_opt.cpu_inter_op_parallelism;
+    if (max_nr_branch <= 1) {
+        return;
+    }
+    if (options.comp_node_seq_record_level || options.enable_sublinear_memory_opt ||
+        options.enable_dtr_memory_opt) {
+        mgb_log_debug(
+                "cpu inter-op parallelism disabled by seq record or memory "
+                "optimization");
+        return;
+    }
+
+    // estimated cost of a cross-branch synchronization, in number of elements
+    constexpr double SYNC_COST = 4096;
+    // bound of the branch index encoded in the device of a branch comp node
+    constexpr int MAX_NR_BRANCH = 256;
+
+    // only oprs whose outputs all reside on a single multithread comp node
+    // with a worker thread and at least two threads can be split into
+    // branches; multithread:default runs tasks in the caller thread
+    auto get_base_cn = [](OperatorNodeBase* opr) {
+        CompNode cn = opr->output(0)->comp_node();
+        auto&& loc = cn.locator();
+        if (loc.type != CompNode::DeviceType::MULTITHREAD || loc.device < 0 ||
+            loc.device >= CompNode::Locator::DEVICE_MULTITHREAD_BRANCH ||
+            loc.nr_threads < 2) {
+            return CompNode{};
+        }
+        for (auto i : opr->output()) {
+            if (i->comp_node() != cn) {
+                return CompNode{};
+            }
+        }
+        return cn;
+    };
+
+    auto can_move = [](OperatorNodeBase* opr) {
+        if (opr->node_prop().contain(
+                    OperatorNodeBase::NodeProp::Flag::DISALLOW_COMP_NODE_OPTIMIZE)) {
+            return false;
+        }
+        for (auto i : opr->output()) {
+            if (i->contain_flag(VarNode::Flag::PERSISTENT_DEVICE_VALUE)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto&& infer_mgr = m_owner_graph->static_infer_manager();
+    auto estimate_cost = [&](OperatorNodeBase* opr) {
+        double cost = 1;
+        auto add = [&](VarNode* var) {
+            if (auto shp = infer_mgr.infer_shape_fallible(var)) {
+                cost += shp->total_nr_elems();
+            }
+        };
+        for (auto i : opr->input()) {
+            add(i);
+        }
+        for (auto i : opr->output()) {
+            add(i);
+        }
+        return cost;
+    };
+
+    struct OprSchedule {
+        CompNode base_cn;
+        size_t branch;
+        double finish;
+    };
+    ThinHashMap<OperatorNodeBase*, OprSchedule> opr2sched;
+    // time at which each branch of a base comp node becomes free
+    CompNode::UnorderedMap<std::vector<double>> cn2branch_free;
+    // whether each branch of a base comp node runs a movable opr
+    CompNode::UnorderedMap<std::vector<bool>> cn2branch_used;
+    std::vector<OperatorNodeBase*> moved_oprs;
+    std::vector<double> start;
+
+    auto cb = [&](OperatorNodeBase* opr) {
+        CompNode base_cn = get_base_cn(opr);
+        if (!base_cn.valid()) {
+            return;
+        }
+        auto&& branch_free = cn2branch_free[base_cn];
+        if (branch_free.empty()) {
+            size_t nr_threads = base_cn.locator().nr_threads;
+            branch_free.resize(
+                    std::min<size_t>(
+                            {max_nr_branch, nr_threads, size_t(MAX_NR_BRANCH)}),
+                    0);
+            cn2branch_used[base_cn].resize(branch_free.size(), false);
+        }
+
+        // earliest start time on each branch, considering the inputs computed
+        // on the same base comp node
+        start = branch_free;
+        bool movable = can_move(opr);
+        size_t nr_avail = movable ? branch_free.size() : 1;
+        for (auto&& i : opr->node_prop().dep_map()) {
+            auto iter = opr2sched.find(i.first->owner_opr());
+            if (iter == opr2sched.end() || iter->second.base_cn != base_cn) {
+                continue;
+            }
+            auto&& pred = iter->second;
+            for (size_t s = 0; s < nr_avail; ++s) {
+                double t = pred.finish + (pred.branch == s ? 0 : SYNC_COST);
+                start[s] = std::max(start[s], t);
+            }
+        }
+
+        size_t best = 0;
+        for (size_t s = 1; s < nr_avail; ++s) {
+            if (start[s] < start[best]) {
+                best = s;
+            }
+        }
+        double finish = start[best] + estimate_cost(opr);
+        branch_free[best] = finish;
+        opr2sched[opr] = {base_cn, best, finish};
+        if (movable) {
+            cn2branch_used[base_cn][best] = true;
+            moved_oprs.push_back(opr);
+        }
+    };
+
+    DepOprIter dep_iter{cb};
+    for (auto i : endpoints) {
+        dep_iter.add(i->owner_opr());
+    }
+
+    // split the threads of each base comp node among its used branches; the
+    // k'th branch runs on a multithread comp node of its own device, so that
+    // it has its own worker thread and thread pool, and the branches
+    // together use no more threads than the base comp node
+    CompNode::UnorderedMap<std::vector<CompNode>> cn2branch_cn;
+    for (auto&& i : cn2branch_used) {
+        auto&& used = i.second;
+        size_t nr_used = std::count(used.begin(), used.end(), true);
+        auto&& branch_cn = cn2branch_cn[i.first];
+        if (nr_used <= 1) {
+            continue;
+        }
+        auto loc = i.first.locator(), loc_logical = i.first.locator_logical();
+        int nr_threads = loc.nr_threads, device = loc.device;
+        branch_cn.resize(used.size());
+        for (size_t s = 0, k = 0; s < used.size(); ++s) {
+            if (!used[s]) {
+                continue;
+            }
+            loc.nr_threads = nr_threads / nr_used + (k < nr_threads % nr_used);
+            loc.device = CompNode::Locator::DEVICE_MULTITHREAD_BRANCH +
+                         device * MAX_NR_BRANCH + static_cast<int>(k);
+            loc_logical.device = loc.device;
+            loc_logical.nr_threads = loc.nr_threads;
+            branch_cn[s] = CompNode::load(loc, loc_logical);
+            ++k;
+        }
+        mgb_log_debug(
+                "split %s into %zu branches", i.first.to_string().c_str(), nr_used);
+    }
+
+    for (auto opr : moved_oprs) {
+        auto&& sched = opr2sched.at(opr);
+        auto&& branch_cn = cn2branch_cn.at(sched.base_cn);
+        if (branch_cn.empty()) {
+            continue;
+        }
+        auto new_cn = branch_cn.at(sched.branch);
+        for (auto i : opr->output()) {
+            m_comp_node_to_restore.emplace_back(i, sched.base_cn);
+            i->comp_node(new_cn);
+        }
+    }
+}
+
 void SeqCompNodeOptimizerImpl::register_stream_var(
         VarNode* var, StreamPropType stream_prop_type) {
     int stream = stream_prop_type.stream;
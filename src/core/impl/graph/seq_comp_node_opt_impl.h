@@ -33,6 +33,18 @@ class SeqCompNodeOptimizerImpl final : public SeqCompNodeOptimizer {
     //! m_comp_node_to_restore
     void var_to_specific_stream(VarNode* var, const int stream);
 
+    /*!
+     * \brief split the thread pool of multithread comp nodes among
+     *      independent branches so that they run concurrently
+     *
+     * The branches are chosen by list scheduling in topological order, with
+     * the number of elements accessed by an opr as its estimated cost and a
+     * penalty for synchronization between branches. Each used branch runs on
+     * a multithread comp node with a share of the threads of the original
+     * comp node, so the total number of threads is unchanged.
+     */
+    void assign_cpu_branch_comp_nodes(const VarNodeArray& endpoints);
+
 public:
     SeqCompNodeOptimizerImpl(ComputingGraphImpl* graph) : m_owner_graph(graph) {}
 
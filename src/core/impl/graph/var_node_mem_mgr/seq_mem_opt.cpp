@@ -8,11 +8,26 @@
 #include "megbrain/utils/arith_helper.h"
 #include "megbrain/utils/metahelper.h"
 
+#include <algorithm>
+#include <array>
+
 using namespace mgb;
 using namespace cg;
 
 constexpr double BYTE2MB = 1.0 / 1024.0 / 1024;
 
+namespace {
+//! round size up to a multiple of the largest power of two not exceeding
+//! size / 8, so the padded size is at most 12.5% larger
+size_t get_static_mem_bucket_size(size_t size) {
+    size_t step = 1;
+    while (step * 16 <= size) {
+        step *= 2;
+    }
+    return (size + step - 1) / step * step;
+}
+}  // anonymous namespace
+
 class SeqMemOptimizer::StaticMemAllocLogger {
 public:
     virtual ~StaticMemAllocLogger() = default;
@@ -272,13 +287,13 @@ bool SeqMemOptimizer::run_static_mem_alloc() {
         if (!group_by_cn.count(i)) {
             bool need_realloc = false;
             m_graph->event().signal_inplace<event::StaticMemAlloc>(
-                    &need_realloc, i, static_cast<size_t>(0));
+                    &need_realloc, i, static_cast<size_t>(0), false);
             ret |= need_realloc;
         }
     }
 
     m_graph->event().signal_inplace<event::StaticMemAlloc>(
-            nullptr, CompNode{}, static_cast<size_t>(0));
+            nullptr, CompNode{}, static_cast<size_t>(0), false);
 
     return ret;
 }
@@ -286,55 +301,112 @@ bool SeqMemOptimizer::run_static_mem_alloc() {
 bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
         CompNode comp_node, const std::vector<MemChunkLifeInterval>& chunks,
         StaticMemAllocLogger& static_mem_alloc_logger) {
+    auto&& seq_opt = m_graph->options().seq_opt;
     size_t size_ub = 0;
 
-    auto allocator = StaticMemAlloc::make(StaticMemAlloc::AllocatorAlgo::PUSHDOWN);
-    allocator->alignment(comp_node.get_mem_addr_alignment());
-    allocator->padding(comp_node.get_mem_padding());
-#if MGB_ENABLE_DEBUG_UTIL
-    allocator->dbg_key2varnode = [](StaticMemAlloc::UserKeyType key) {
-        return static_cast<const MemChunkLifeInterval*>(key)->chunk->owner_var;
-    };
-#endif
-    ThinHashMap<MemAllocPlan::Chunk*, size_t> chunk2allocatorid;
-    for (auto&& chk : chunks) {
-        auto id = allocator->add(chk.begin, chk.end, chk.chunk->size(), &chk);
-        auto ins_rst = chunk2allocatorid.emplace(chk.chunk, id);
+    ThinHashMap<MemAllocPlan::Chunk*, size_t> chunk2idx;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto ins_rst = chunk2idx.emplace(chunks[i].chunk, i);
         mgb_assert(ins_rst.second);
-        size_ub += chk.chunk->size();
     }
 
+    // overwrite specs as (src, dest, offset) of chunk indices; the src chunk
+    // overwrites part of the dest chunk so its size can not be padded
+    std::vector<std::array<size_t, 3>> overwrite_specs;
+    std::vector<bool> is_overwrite_src(chunks.size());
     for (auto&& i : m_writable_fwd_mem_plans) {
-        auto from_iter = chunk2allocatorid.find(&i.first->chunk()),
-             to_iter = chunk2allocatorid.find(&i.second->chunk());
+        auto from_iter = chunk2idx.find(&i.first->chunk()),
+             to_iter = chunk2idx.find(&i.second->chunk());
 
         // ignore mem fwd specs that involve other chunks
-        if (from_iter != chunk2allocatorid.end() &&
-            to_iter != chunk2allocatorid.end()) {
-            allocator->add_overwrite_spec(
-                    to_iter->second, from_iter->second,
-                    i.first->offset_in_chunk_byte());
+        if (from_iter != chunk2idx.end() && to_iter != chunk2idx.end()) {
+            overwrite_specs.push_back(
+                    {to_iter->second, from_iter->second,
+                     i.first->offset_in_chunk_byte()});
+            is_overwrite_src[to_iter->second] = true;
         }
     }
     {
-        decltype(chunk2allocatorid) v;
-        chunk2allocatorid.swap(v);
+        decltype(chunk2idx) v;
+        chunk2idx.swap(v);
+    }
+
+    std::vector<size_t> key{
+            comp_node.get_mem_addr_alignment(), comp_node.get_mem_padding(),
+            chunks.size()};
+    key.reserve(key.size() + chunks.size() * 3 + overwrite_specs.size() * 3);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto&& chk = chunks[i];
+        size_t chk_size = chk.chunk->size();
+        if (seq_opt.static_mem_chunk_bucketing && !is_overwrite_src[i]) {
+            chk_size = get_static_mem_bucket_size(chk_size);
+        }
+        key.insert(key.end(), {chk.begin, chk.end, chk_size});
+        size_ub += chk_size;
+    }
+    for (auto&& i : overwrite_specs) {
+        key.insert(key.end(), i.begin(), i.end());
     }
 
-    allocator->solve();
-    size_t size = allocator->tot_alloc(), size_lb = allocator->tot_alloc_lower_bound();
+    auto&& plan_cache = m_static_mem_plan_cache[comp_node];
+    auto plan_iter = std::find_if(
+            plan_cache.begin(), plan_cache.end(),
+            [&key](const StaticMemPlan& plan) { return plan.key == key; });
+    bool plan_solved = plan_iter == plan_cache.end();
+    if (!plan_solved) {
+        plan_cache.splice(plan_cache.begin(), plan_cache, plan_iter);
+    } else {
+        auto allocator =
+                StaticMemAlloc::make(StaticMemAlloc::AllocatorAlgo::PUSHDOWN);
+        allocator->alignment(key[0]);
+        allocator->padding(key[1]);
+#if MGB_ENABLE_DEBUG_UTIL
+        allocator->dbg_key2varnode = [](StaticMemAlloc::UserKeyType key) {
+            return static_cast<const MemChunkLifeInterval*>(key)->chunk->owner_var;
+        };
+#endif
+        std::vector<size_t> allocator_ids(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            auto&& chk = chunks[i];
+            allocator_ids[i] =
+                    allocator->add(chk.begin, chk.end, key[3 + i * 3 + 2], &chk);
+        }
+        for (auto&& i : overwrite_specs) {
+            allocator->add_overwrite_spec(
+                    allocator_ids[i[0]], allocator_ids[i[1]], i[2]);
+        }
+
+        allocator->solve();
+
+        StaticMemPlan plan;
+        plan.size = allocator->tot_alloc();
+        plan.size_lb = allocator->tot_alloc_lower_bound();
+        plan.offsets.resize(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            plan.offsets[i] = allocator->get_start_addr(&chunks[i]);
+        }
+        plan.key = std::move(key);
+        plan_cache.push_front(std::move(plan));
+    }
+    // keep the newly used plan for the plan_chunk_allocation() call that
+    // may follow in the same update
+    size_t max_nr_plan = std::max<size_t>(seq_opt.static_mem_plan_cache_size, 1);
+    while (plan_cache.size() > max_nr_plan) {
+        plan_cache.pop_back();
+    }
 
+    auto&& plan = plan_cache.front();
+    size_t size = plan.size, size_lb = plan.size_lb;
     static_mem_alloc_logger.push(comp_node, size, size_lb, size_ub);
 
     bool should_realloc = false;
     m_graph->event().signal_inplace<event::StaticMemAlloc>(
-            &should_realloc, comp_node, size);
+            &should_realloc, comp_node, size, plan_solved);
 
     if (!should_realloc) {
         m_static_mem_usage.val()[comp_node] = size;
-        for (auto&& chk : chunks) {
-            chk.chunk->mem_alloc_status.set_static_offset(
-                    allocator->get_start_addr(&chk));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunks[i].chunk->mem_alloc_status.set_static_offset(plan.offsets[i]);
         }
 #ifndef __IN_TEE_ENV__
         auto& recorder = StaticMemRecorder::Instance();
@@ -360,6 +432,7 @@ void SeqMemOptimizer::reset_opr_seq(
     m_cur_static_alloc_var = static_alloc_var;
     m_all_comp_nodes = std::move(all_comp_nodes);
     m_static_mem_usage.invalidate();
+    m_static_mem_plan_cache.clear();
 }
 
 void SeqMemOptimizer::add_writable_fwd_mem_plan_pair(
@@ -2,6 +2,8 @@
 
 #include "../impl_common.h"
 
+#include <list>
+
 namespace mgb {
 namespace cg {
 
@@ -22,6 +24,20 @@ class SeqMemOptimizer {
         CompNode comp_node;
     };
 
+    /*!
+     * \brief a solved static memory allocation plan on one comp node
+     *
+     * The key holds everything given to StaticMemAlloc: alignment, padding,
+     * life interval and size of each chunk in order, and the overwrite specs.
+     * The allocation algorithm is deterministic, so the same key always gets
+     * the same offsets.
+     */
+    struct StaticMemPlan {
+        std::vector<size_t> key;
+        std::vector<size_t> offsets;
+        size_t size = 0, size_lb = 0;
+    };
+
     using CompNode2Chunkset = CompNode::UnorderedMap<ThinHashSet<MemAllocPlan::Chunk*>>;
 
     ComputingGraphImpl* m_graph;
@@ -35,6 +51,9 @@ class SeqMemOptimizer {
     size_t m_status = 0;
     std::vector<std::pair<MemAllocPlan*, MemAllocPlan*>> m_writable_fwd_mem_plans;
 
+    //! recently used static memory plans on each comp node, most recent first
+    CompNode::UnorderedMap<std::list<StaticMemPlan>> m_static_mem_plan_cache;
+
     bool should_static_alloc_var(VarNode* var);
 
     bool in_sys_alloc(OperatorNodeBase* opr) const {
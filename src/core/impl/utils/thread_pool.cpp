@@ -1,5 +1,7 @@
 #include "megbrain/utils/thread_pool.h"
 #include <chrono>
+#include <memory>
+#include <new>
 
 using namespace mgb;
 
@@ -12,6 +14,9 @@ ThreadPool::ThreadPool(size_t threads_num)
     if (threads_num < 1) {
         m_nr_threads = 1;
     }
+    if (auto env = MGB_GETENV("MGB_THREAD_POOL_SPIN_COUNT")) {
+        m_spin_count = std::stoul(env);
+    }
     if (m_nr_threads > 1) {
         if (m_nr_threads > static_cast<uint32_t>(sys::get_cpu_count())) {
             mgb_log_debug(
@@ -19,9 +24,20 @@ ThreadPool::ThreadPool(size_t threads_num)
                     "physical cpu cores, got: %zu core_number: %zu",
                     static_cast<size_t>(sys::get_cpu_count()), nr_threads());
         }
+        size_t storage_size = sizeof(TaskRange) * m_nr_threads + alignof(TaskRange);
+        m_task_range_storage.reset(new uint8_t[storage_size]);
+        void* storage = m_task_range_storage.get();
+        mgb_assert(std::align(
+                alignof(TaskRange), sizeof(TaskRange) * m_nr_threads, storage,
+                storage_size));
+        m_task_ranges = static_cast<TaskRange*>(storage);
+        for (uint32_t i = 0; i < m_nr_threads; i++) {
+            new (m_task_ranges + i) TaskRange;
+        }
         for (uint32_t i = 0; i < m_nr_threads - 1; i++) {
             m_workers.push_back(new Worker([this, i]() {
                 while (!m_stop) {
+                    size_t nr_spin = 0;
                     while (m_active) {
                         if (m_workers[i]->affinity_flag &&
                             m_core_binding_function != nullptr) {
@@ -30,23 +46,19 @@ ThreadPool::ThreadPool(size_t threads_num)
                         }
                         //! if the thread should work
                         if (m_workers[i]->work_flag.load(std::memory_order_acquire)) {
-                            int index = -1;
-                            //! Get one task and execute
-                            while ((index = m_task_iter.fetch_sub(
-                                            1, std::memory_order_acq_rel)) &&
-                                   index > 0) {
-                                //! index is decrease, use
-                                //! m_all_task_number - index to get the
-                                //! increase id which will pass to task
-                                m_task(static_cast<size_t>(m_nr_parallelism - index),
-                                       i);
-                            }
+                            run_tasks(i);
                             //! Flag worker is finished
                             m_workers[i]->work_flag.store(
                                     false, std::memory_order_release);
+                            nr_spin = 0;
+                        } else if (nr_spin < spin_count()) {
+                            //! Wait next task coming
+                            ++nr_spin;
+                            std::this_thread::yield();
+                        } else {
+                            park(m_workers[i]);
+                            nr_spin = 0;
                         }
-                        //! Wait next task coming
-                        std::this_thread::yield();
                     }
                     {
                         std::unique_lock<std::mutex> lock(m_mutex);
@@ -59,6 +71,31 @@ ThreadPool::ThreadPool(size_t threads_num)
         }
     }
 }
+
+void ThreadPool::run_tasks(size_t thread_id) {
+    auto try_run = [this, thread_id](TaskRange& range) {
+        size_t index;
+        while (range.begin.load(std::memory_order_relaxed) < range.end &&
+               (index = range.begin.fetch_add(1, std::memory_order_acq_rel)) <
+                       range.end) {
+            m_task(index, thread_id);
+        }
+    };
+    //! drain its own range first, then steal from the following threads
+    for (size_t i = 0; i < m_nr_threads; i++) {
+        try_run(m_task_ranges[(thread_id + i) % m_nr_threads]);
+    }
+}
+
+void ThreadPool::park(Worker* worker) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //! m_nr_parked must be increased before checking the work_flag, so
+    //! add_task either sees the parked worker or the worker sees the flag
+    m_nr_parked.fetch_add(1);
+    m_cv.wait(lock, [this, worker] { return m_stop || worker->work_flag.load(); });
+    m_nr_parked.fetch_sub(1);
+}
+
 void ThreadPool::add_task(const TaskElem& task_elem) {
     //! Make sure the main thread have bind
     if (m_main_affinity_flag && m_core_binding_function != nullptr) {
@@ -75,13 +112,15 @@ void ThreadPool::add_task(const TaskElem& task_elem) {
         return;
     } else {
         std::lock_guard<std::mutex> lock(m_mutex_task);
-        mgb_assert(
-                m_task_iter.load(std::memory_order_acquire) <= 0,
-                "The init value of m_all_sub_task is not zero.");
         active();
-        //! Set the task number, task iter and task
+        //! Set the task number, task ranges and task
         m_nr_parallelism = parallelism;
-        m_task_iter.exchange(parallelism, std::memory_order_relaxed);
+        for (size_t i = 0; i < m_nr_threads; i++) {
+            auto&& range = m_task_ranges[i];
+            range.end = parallelism * (i + 1) / m_nr_threads;
+            range.begin.store(
+                    parallelism * i / m_nr_threads, std::memory_order_relaxed);
+        }
         m_task = [&task_elem](size_t index, size_t thread_id) {
             task_elem.task(index, thread_id);
         };
@@ -89,12 +128,15 @@ void ThreadPool::add_task(const TaskElem& task_elem) {
         for (uint32_t i = 0; i < m_nr_threads - 1; i++) {
             m_workers[i]->work_flag = true;
         }
-        //! Main thread working
-        int index = -1;
-        while ((index = m_task_iter.fetch_sub(1, std::memory_order_acq_rel)) &&
-               (index > 0)) {
-            m_task(static_cast<size_t>(m_nr_parallelism - index), m_nr_threads - 1);
+        //! Wake up the parked workers
+        if (m_nr_parked.load()) {
+            {
+                std::lock_guard<std::mutex> lock_cv(m_mutex);
+            }
+            m_cv.notify_all();
         }
+        //! Main thread working
+        run_tasks(m_nr_threads - 1);
         //! make sure all threads done
         sync();
     }
@@ -110,6 +152,10 @@ void ThreadPool::set_affinity(AffinityCallBack affinity_cb) {
     m_main_affinity_flag = true;
 }
 
+void ThreadPool::set_spin_count(size_t spin_count) {
+    m_spin_count.store(spin_count, std::memory_order_relaxed);
+}
+
 size_t ThreadPool::nr_threads() const {
     return m_nr_threads;
 }
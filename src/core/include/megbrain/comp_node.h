@@ -105,6 +105,12 @@ public:
          * caller thread is the main thread of thread pool
          */
         static constexpr int DEVICE_MULTITHREAD_DEFAULT = -1025;
+        /*!
+         * \brief first device number of the multithread comp nodes that run
+         *      independent branches of a graph, see
+         *      ComputingGraph::Options::seq_opt.cpu_inter_op_parallelism
+         */
+        static constexpr int DEVICE_MULTITHREAD_BRANCH = 1 << 20;
 
         DeviceType type = DeviceType::UNSPEC;
 
@@ -239,6 +239,9 @@ public:
     virtual void set_affinity(AffinityCallBack&& /*affinity_cb*/) {
         mgb_assert(0, "The CompNode set_affinity is not implement");
     }
+    //! set the rounds the idle threads spin before parking, only takes
+    //! effect when the dispatcher runs on a thread pool
+    virtual void set_spin_count(size_t /*spin_count*/) {}
 };
 using AtlasDispatcher = CPUDispatcher;
 
@@ -548,6 +551,10 @@ public:
         void set_affinity(AffinityCallBack&& cb) const {
             dispatcher->set_affinity(std::move(cb));
         }
+
+        void set_spin_count(size_t spin_count) const {
+            dispatcher->set_spin_count(spin_count);
+        }
     };
 
     const CpuEnv& cpu_env() const {
@@ -330,6 +330,28 @@ public:
             //! whether to enable comp node optimization (e.g. using copy
             //! stream for I/O operators)
             bool enable_seq_comp_node_opt = true;
+
+            //! max number of independent branches of a graph that run
+            //! concurrently on a multithread comp node; the threads of the
+            //! comp node are split among the branches by
+            //! SeqCompNodeOptimizer. Values <= 1 disable this feature.
+            //! Ignored with comp node seq record and memory optimizations
+            //! that rewrite the opr sequence (sublinear / DTR).
+            uint32_t cpu_inter_op_parallelism = 1;
+
+            //! max number of solved static memory allocation plans kept on
+            //! each comp node. The plans are keyed by the sizes and life
+            //! intervals of the memory chunks, so switching back to
+            //! previously seen input shapes reuses the plan instead of
+            //! solving the allocation again. The last plan is always kept.
+            uint32_t static_mem_plan_cache_size = 0;
+
+            //! whether to pad the size of statically allocated memory
+            //! chunks up to buckets (at most 12.5% larger) when planning,
+            //! so that input shapes in the same bucket share one
+            //! allocation plan and the static buffer is not reallocated
+            //! when they grow within the bucket
+            bool static_mem_chunk_bucketing = false;
         } seq_opt;
 
         //! graph optimization options
@@ -111,11 +111,17 @@ struct AfterKernel {
  * and after static memory alloc finished, it would be issued with need_realloc
  * == nullptr, comp_node being invalid and alloc_size == 0 to indicate
  * allocation has finished.
+ *
+ * plan_solved tells whether the allocation plan was computed by running the
+ * static memory allocator, or taken from the plans cached by the graph (see
+ * ComputingGraph::Options::seq_opt.static_mem_plan_cache_size); it is false
+ * when no plan is involved.
  */
 struct StaticMemAlloc {
     bool* need_realloc;
     CompNode comp_node;
     size_t alloc_size;
+    bool plan_solved;
 
     MGB_TYPEINFO_OBJ_DECL_WITH_EXPORT;
 };
@@ -6,6 +6,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -41,12 +43,34 @@ public:
     bool affinity_flag{false};
 };
 
+/**
+ * \brief the sub task range owned by one thread of the pool, other threads
+ * steal from it after their own range is drained
+ */
+struct alignas(64) TaskRange {
+    //! the next sub task to be executed, shared by the owner and the thieves
+    std::atomic_size_t begin{0};
+    //! one past the last sub task of this range
+    size_t end{0};
+};
+
 /**
  * \brief ThreadPool execute the task in multi-threads(nr_threads>1) mode , it
  * will fallback to single-thread mode if nr_thread is 1.
+ *
+ * The sub tasks of one add_task call are split into contiguous ranges, one
+ * for each thread, and a thread which finishes its own range steals the
+ * remaining sub tasks of the others. Between two tasks, an active worker
+ * spins for spin_count rounds and then parks on a condition variable until
+ * the next task comes.
  */
 class ThreadPool : public NonCopyableObj {
 public:
+    //! spin count which makes the workers never park while the pool is active
+    static constexpr size_t SPIN_FOREVER = std::numeric_limits<size_t>::max();
+    //! default spin count, can be overwritten by env MGB_THREAD_POOL_SPIN_COUNT
+    static constexpr size_t DEFAULT_SPIN_COUNT = 4096;
+
     //! Create thread-pool nr_threads thread_pool
     ThreadPool(size_t nr_threads);
     //! The main thread set the task, parallelism and worker flag to
@@ -58,6 +82,16 @@ public:
     //! Set the affinity of all the threads
     void set_affinity(AffinityCallBack affinity_cb);
 
+    /*!
+     * \brief set the number of rounds an idle worker spins before it parks
+     *
+     * 0 means park immediately after the sub tasks are drained, and
+     * SPIN_FOREVER restores busy waiting while the pool is active.
+     */
+    void set_spin_count(size_t spin_count);
+
+    size_t spin_count() const { return m_spin_count.load(std::memory_order_relaxed); }
+
     void sync();
     //! wake up all the threads from cv.wait(), when the thread pool is not
     //! active, all the threads will go to sleep.
@@ -67,6 +101,11 @@ public:
     ~ThreadPool();
 
 private:
+    //! run the sub tasks of its own range and then steal from the others
+    void run_tasks(size_t thread_id);
+    //! block the worker until new task coming or the pool stopped
+    void park(Worker* worker);
+
     size_t m_nr_threads = 1;
     //! Indicate whether the main thread have binding
     bool m_main_affinity_flag;
@@ -80,8 +119,15 @@ private:
     MultiThreadingTask m_task;
 
     std::vector<Worker*> m_workers;
-    //! The task iter, when finished one, the m_all_task_iter sub 1
-    std::atomic_int m_task_iter{0};
+    //! The sub task ranges, the last one belongs to the main thread
+    //! operator new may not respect the alignment of TaskRange before C++17,
+    //! so the ranges are placed in an over-allocated buffer
+    std::unique_ptr<uint8_t[]> m_task_range_storage;
+    TaskRange* m_task_ranges = nullptr;
+    //! Number of rounds an idle worker spins before it parks
+    std::atomic_size_t m_spin_count{DEFAULT_SPIN_COUNT};
+    //! Number of workers blocked in park()
+    std::atomic_size_t m_nr_parked{0};
     //! The cv and mutex for threading activity
     std::condition_variable m_cv;
     std::mutex m_mutex;
@@ -96,6 +142,8 @@ public:
     ThreadPool(size_t) {}
     void add_task(const TaskElem& task_elem);
     void set_affinity(AffinityCallBack affinity_cb);
+    void set_spin_count(size_t) {}
+    size_t spin_count() const { return 0; }
     void active() {}
     void deactive() {}
     void sync() {}
@@ -1784,6 +1784,72 @@ TEST(TestGraph, In2OutOpStreamPropagate) {
         }
 }
 
+TEST(TestGraph, CPUInterOpParallelism) {
+    HostTensorGenerator<> gen;
+    constexpr size_t nr_branch = 4;
+    auto cn = CompNode::load("multithread4:0");
+    auto host_x = gen({64, 64}, cn);
+    std::shared_ptr<HostTensorND> host_w[nr_branch];
+    for (auto&& i : host_w) {
+        i = gen({64, 64}, cn);
+    }
+
+    auto run = [&](uint32_t parallelism, HostTensorND& host_z,
+                   CompNode::UnorderedSet& used_cn) {
+        auto graph = ComputingGraph::make();
+        graph->options().seq_opt.cpu_inter_op_parallelism = parallelism;
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x, cn);
+        SymbolVarArray branches;
+        for (auto&& i : host_w) {
+            auto w = opr::Host2DeviceCopy::make(*graph, i, cn);
+            auto y = opr::relu(opr::MatrixMul::make(x, w));
+            branches.push_back(opr::MatrixMul::make(y, w) * 2);
+        }
+        auto z = opr::Elemwise::make(branches, opr::Elemwise::Mode::FUSE_MUL_ADD4);
+        auto func = graph->compile({make_callback_copy(z, host_z)});
+        func->iter_opr_seq([&](cg::OperatorNodeBase* opr) {
+            used_cn.insert(opr->output(0)->comp_node());
+            return true;
+        });
+        func->execute();
+        // events between branches must also work when re-executed
+        HostTensorND host_z_first;
+        host_z_first.copy_from(host_z);
+        func->execute();
+        MGB_ASSERT_TENSOR_EQ(host_z_first, host_z);
+    };
+
+    HostTensorND expect, get;
+    CompNode::UnorderedSet cn_seq, cn_par;
+    run(1, expect, cn_seq);
+    run(nr_branch, get, cn_par);
+    MGB_ASSERT_TENSOR_EQ(expect, get);
+    ASSERT_EQ(1u, cn_seq.size());
+    ASSERT_GT(cn_par.size(), 1u);
+
+    // the branches share the threads of the original comp node
+    int nr_threads = 0;
+    for (auto i : cn_par) {
+        auto&& loc = i.locator();
+        ASSERT_EQ(CompNode::DeviceType::MULTITHREAD, loc.type);
+        if (i != cn) {
+            ASSERT_GE(loc.device, CompNode::Locator::DEVICE_MULTITHREAD_BRANCH);
+            nr_threads += loc.nr_threads;
+        }
+    }
+    ASSERT_LE(nr_threads, cn.locator().nr_threads);
+
+    // a single threaded comp node has no threads to split
+    cn = CompNode::load("cpu0");
+    HostTensorND expect_cpu, get_cpu;
+    CompNode::UnorderedSet cn_seq_cpu, cn_cpu;
+    run(1, expect_cpu, cn_seq_cpu);
+    run(nr_branch, get_cpu, cn_cpu);
+    MGB_ASSERT_TENSOR_EQ(expect_cpu, get_cpu);
+    ASSERT_EQ(1u, cn_cpu.size());
+    ASSERT_EQ(cn, *cn_cpu.begin());
+}
+
 TEST(TestGraph, OperatorNodeConfigInstanceID) {
     OperatorNodeConfig config0, config1;
     void *p0 = &config0, *p1 = &config1;
@@ -6,7 +6,10 @@
 #include "megbrain/opr/utility.h"
 #include "megbrain/test/helper.h"
 
+#include "../impl/comp_node/cpu/mem_arena.h"
+
 #include <atomic>
+#include <limits>
 #include <map>
 #include <random>
 #include <thread>
@@ -500,6 +503,134 @@ TEST(TestSimpleCachingAlloc, Basic) {
     EXPECT_EQ(0u, raw_alloc->nr_free());
 };
 
+TEST(TestCpuMemArena, SizeClass) {
+    size_t prev = 0;
+    for (size_t size = 1; size < (size_t(64) << 20); size = size * 5 / 4 + 1) {
+        auto class_size = CpuMemArena::get_class_size(size);
+        ASSERT_GE(class_size, size);
+        ASSERT_GE(class_size, prev);
+        ASSERT_LE(class_size, std::max(size + size / 8, CpuMemArena::MIN_CLASS_SIZE));
+        prev = class_size;
+    }
+}
+
+TEST(TestCpuMemArena, Basic) {
+    CpuMemArena::Config config;
+    config.enabled = true;
+    config.max_cached_per_node = 1 << 20;
+    CpuMemArena arena{config};
+    constexpr size_t REQ = 1000, ALIGN = 64;
+    auto class_size = CpuMemArena::get_class_size(REQ);
+
+    auto ptr = arena.alloc(REQ, ALIGN, 0);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % ALIGN);
+    memset(ptr, 0, REQ);
+    EXPECT_EQ(class_size, arena.get_used_memory());
+    EXPECT_EQ(0u, arena.get_free_memory().tot);
+
+    arena.free(ptr);
+    EXPECT_EQ(0u, arena.get_used_memory());
+    EXPECT_EQ(class_size, arena.get_free_memory().tot);
+    EXPECT_EQ(1u, arena.get_free_memory().nr_blk);
+
+    // requests of the same class on the same node reuse the cached block
+    auto ptr1 = arena.alloc(REQ - 10, ALIGN, 0);
+    EXPECT_EQ(ptr, ptr1);
+    EXPECT_EQ(0u, arena.get_free_memory().tot);
+
+    // blocks that do not fit into the cache are released directly
+    auto ptr2 = arena.alloc(2 << 20, ALIGN, 0);
+    memset(ptr2, 0, 2 << 20);
+    arena.free(ptr2);
+    EXPECT_EQ(0u, arena.get_free_memory().tot);
+    EXPECT_GE(arena.get_max_used_memory(), class_size + (2 << 20));
+
+    arena.free(ptr1);
+    arena.release_cached();
+    EXPECT_EQ(0u, arena.get_free_memory().nr_blk);
+}
+
+TEST(TestCpuMemArena, HugePage) {
+    for (auto mode : {CpuMemArena::HugePage::TRANSPARENT,
+                      CpuMemArena::HugePage::EXPLICIT}) {
+        CpuMemArena::Config config;
+        config.enabled = true;
+        config.huge_page = mode;
+        CpuMemArena arena{config};
+        constexpr size_t REQ = CpuMemArena::HUGE_PAGE_SIZE * 3 + 123;
+        auto ptr = static_cast<uint8_t*>(arena.alloc(REQ, 64));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 64);
+        memset(ptr, 1, REQ);
+        arena.free(ptr);
+        EXPECT_EQ(ptr, arena.alloc(REQ, 64));
+        arena.free(ptr);
+    }
+}
+
+TEST(TestCpuMemArena, MultiThread) {
+    CpuMemArena::Config config;
+    config.enabled = true;
+    config.max_cached_per_node = 8 << 20;
+    CpuMemArena arena{config};
+    auto worker = [&arena](int seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::pair<uint8_t*, size_t>> blocks;
+        for (int i = 0; i < 10000; ++i) {
+            if (blocks.size() < 32 && rng() % 3) {
+                size_t size = rng() % 100000 + 1;
+                auto ptr = static_cast<uint8_t*>(arena.alloc(size, 64));
+                memset(ptr, seed, size);
+                blocks.emplace_back(ptr, size);
+            } else if (!blocks.empty()) {
+                auto blk = blocks.back();
+                blocks.pop_back();
+                ASSERT_EQ(seed, blk.first[blk.second - 1]);
+                arena.free(blk.first);
+            }
+        }
+        for (auto&& blk : blocks) {
+            arena.free(blk.first);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back(worker, i + 1);
+    }
+    for (auto&& i : threads) {
+        i.join();
+    }
+    EXPECT_EQ(0u, arena.get_used_memory());
+    EXPECT_LE(arena.get_free_memory().tot, CpuMemArena::MAX_NR_NODE * (8 << 20));
+}
+
+#if MGB_ENABLE_GETENV && !defined(_WIN32)
+TEST(TestCpuMemArena, CacheSizeFromEnv) {
+    constexpr const char* KEY = "MGB_CPU_MEM_ARENA_CACHE_MB";
+    auto old_value = getenv(KEY);
+    std::string old_setting = old_value ? old_value : "";
+    auto get = [&](const char* setting) {
+        setenv(KEY, setting, 1);
+        return CpuMemArena::config_from_env().max_cached_per_node;
+    };
+    size_t default_size = CpuMemArena::Config{}.max_cached_per_node;
+
+    EXPECT_EQ(size_t(16) << 20, get("16"));
+    // malformed values keep the default
+    EXPECT_EQ(default_size, get("abc"));
+    EXPECT_EQ(default_size, get("16MB"));
+    EXPECT_EQ(default_size, get("-1"));
+    EXPECT_EQ(default_size, get("99999999999999999999999"));
+    // sizes not representable in bytes are clamped
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), get("18446744073709551615"));
+
+    if (old_value) {
+        setenv(KEY, old_setting.c_str(), 1);
+    } else {
+        unsetenv(KEY);
+    }
+}
+#endif
+
 namespace {
 class DevicePolicy {
 public:
@@ -315,4 +315,63 @@ TEST(TestMemReuse, FwdNoSysMemAlloc) {
     }
 }
 
+TEST(TestMemReuse, StaticMemPlanCache) {
+    for (bool bucketing : {false, true}) {
+        HostTensorGenerator<> gen;
+        auto host_x = gen({1000});
+        auto graph = ComputingGraph::make();
+        graph->options().seq_opt.static_mem_plan_cache_size = 4;
+        graph->options().seq_opt.static_mem_chunk_bucketing = bucketing;
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x), y0 = x + 1.f,
+             y1 = x * 2.f, z = y0 * y1 + y0;
+        size_t alloc_size = 0, nr_solve = 0;
+        auto hdl = graph->event().register_receiver<cg::event::StaticMemAlloc>(
+                [&](const cg::event::StaticMemAlloc& s) {
+                    if (s.comp_node.valid()) {
+                        alloc_size = s.alloc_size;
+                        nr_solve += s.plan_solved;
+                    }
+                });
+        HostTensorND host_z;
+        auto func = graph->compile({make_callback_copy(z, host_z)});
+
+        auto run = [&](size_t size) {
+            *host_x = *gen({size});
+            func->execute();
+            auto px = host_x->ptr<float>(), pz = host_z.ptr<float>();
+            ASSERT_EQ(TensorShape{size}, host_z.shape());
+            for (size_t i = 0; i < size; ++i) {
+                MGB_ASSERT_FLOAT_EQ((px[i] + 1) * (px[i] * 2) + (px[i] + 1), pz[i]);
+            }
+        };
+
+        run(1000);
+        size_t size0 = alloc_size;
+        ASSERT_EQ(1u, nr_solve);
+        run(2000);
+        size_t size1 = alloc_size;
+        ASSERT_LT(size0, size1);
+        ASSERT_EQ(2u, nr_solve);
+        // switching back to a planned shape reuses the plan
+        run(1000);
+        ASSERT_EQ(size0, alloc_size);
+        run(2000);
+        ASSERT_EQ(size1, alloc_size);
+        ASSERT_EQ(2u, nr_solve);
+        // shapes in the same bucket share the plan
+        run(1010);
+        if (bucketing) {
+            ASSERT_EQ(size0, alloc_size);
+            ASSERT_EQ(2u, nr_solve);
+        } else {
+            ASSERT_LT(size0, alloc_size);
+            ASSERT_EQ(3u, nr_solve);
+        }
+        // a shape outside of the buckets is solved again
+        run(3000);
+        ASSERT_LT(size1, alloc_size);
+        ASSERT_EQ(bucketing ? 3u : 4u, nr_solve);
+    }
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
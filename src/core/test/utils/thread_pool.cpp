@@ -1,11 +1,14 @@
 #include "megbrain/utils/thread_pool.h"
+#include <algorithm>
 #include <atomic>
+#include <ctime>
 #include <random>
 #include "megbrain/comp_node.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/utility.h"
 #include "megbrain/system.h"
 #include "megbrain/test/helper.h"
+#include "megbrain/utils/timer.h"
 
 #if MGB_HAVE_THREAD
 using namespace mgb;
@@ -52,6 +55,97 @@ TEST(TestThreadPool, BASIC) {
     }
 }
 
+TEST(TestThreadPool, UnbalancedTaskSteal) {
+    constexpr size_t nr_threads = 4, total_task = 97;
+    auto thread_pool = std::make_shared<ThreadPool>(nr_threads);
+    std::vector<std::atomic_size_t> count(total_task);
+    std::vector<size_t> runner(total_task);
+    for (auto&& i : count) {
+        i = 0;
+    }
+    //! the sub tasks of the main thread range are much heavier than the others
+    constexpr size_t main_begin = total_task * (nr_threads - 1) / nr_threads;
+    auto func = [&](size_t index, size_t thread_id) {
+        ASSERT_LT(thread_id, nr_threads);
+        if (index >= main_begin) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        runner[index] = thread_id;
+        count[index]++;
+    };
+    thread_pool->active();
+    thread_pool->add_task({func, total_task});
+    thread_pool->deactive();
+    size_t nr_stolen = 0;
+    for (size_t i = 0; i < total_task; i++) {
+        ASSERT_EQ(count[i], 1u);
+        //! the main thread runs as thread nr_threads - 1
+        if (i >= main_begin && runner[i] != nr_threads - 1) {
+            ++nr_stolen;
+        }
+    }
+    ASSERT_GT(nr_stolen, 0u);
+}
+
+TEST(TestThreadPool, SpinCount) {
+    auto thread_pool = std::make_shared<ThreadPool>(3u);
+    for (size_t spin_count : {size_t(0), size_t(16), ThreadPool::SPIN_FOREVER}) {
+        thread_pool->set_spin_count(spin_count);
+        ASSERT_EQ(thread_pool->spin_count(), spin_count);
+        std::atomic_size_t count{0};
+        thread_pool->active();
+        for (size_t run = 0; run < 50; run++) {
+            thread_pool->add_task({[&](size_t, size_t) { count++; }, 7});
+            //! give the workers the chance to park between the tasks
+            if (run % 10 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        thread_pool->deactive();
+        ASSERT_EQ(count, 50u * 7);
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST(TestThreadPool, BenchmarkSpinPolicy) {
+    constexpr size_t nr_run = 200, total_task = 64;
+    size_t nr_threads = std::max(2, std::min(8, sys::get_cpu_count()));
+    std::vector<float> src(1 << 16), dst(1 << 16);
+    auto func = [&](size_t index, size_t) {
+        size_t len = src.size() / total_task;
+        for (size_t i = index * len; i < (index + 1) * len; i++) {
+            dst[i] = src[i] * src[i] + 1.f;
+        }
+    };
+    auto run = [&](size_t spin_count, const char* name) {
+        auto thread_pool = std::make_shared<ThreadPool>(nr_threads);
+        thread_pool->set_spin_count(spin_count);
+        thread_pool->active();
+        std::vector<double> latency;
+        double wall_time = 0;
+        auto cpu_start = std::clock();
+        for (size_t i = 0; i < nr_run; i++) {
+            //! the model is waiting for the input
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            RealTimer timer;
+            thread_pool->add_task({func, total_task});
+            latency.push_back(timer.get_secs() * 1e6);
+            wall_time += latency.back();
+        }
+        auto cpu_time = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+        thread_pool->deactive();
+        std::sort(latency.begin(), latency.end());
+        printf("%s: nr_threads=%zu p50=%.2fus p99=%.2fus max=%.2fus "
+               "cpu_time=%.2fms wall_in_task=%.2fms\n",
+               name, nr_threads, latency[nr_run / 2], latency[nr_run * 99 / 100],
+               latency.back(), cpu_time * 1e3, wall_time * 1e-3);
+    };
+    run(ThreadPool::SPIN_FOREVER, "spin_forever");
+    run(ThreadPool::DEFAULT_SPIN_COUNT, "spin_then_park");
+    run(0, "park");
+}
+#endif
+
 TEST(TestGraph, ParallelRunMultithreadMode) {
     // check race conditions when graphs are executed on multple threads
     std::atomic_size_t sync_counter{0};
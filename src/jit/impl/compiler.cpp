@@ -1,5 +1,6 @@
-#include "./mlir/compiler.h"
+#include "./cpu_vm/compiler.h"
 #include "./halide/compiler_cuda.h"
+#include "./mlir/compiler.h"
 #include "./nvrtc/compiler_cuda.h"
 
 #include "megbrain/jit/compiler.h"
@@ -108,10 +109,14 @@ Compiler* Compiler::get(ComputingGraph& graph, CompNode comp_node) {
                     break;
                 }
 #endif
+                if (!strcmp(backend.c_str(), "CPUVM")) {
+                    compiler = std::make_unique<CPUVMCompiler>();
+                    break;
+                }
                 mgb_throw(
                         InternalError,
-                        "No compiler support for cpu, may caused by build not enable "
-                        "MLIR module or error config jit backend env");
+                        "No compiler support for cpu, may caused by error config jit "
+                        "backend env");
                 break;
             default:
                 mgb_throw(
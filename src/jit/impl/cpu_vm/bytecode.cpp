@@ -0,0 +1,372 @@
+#include "./bytecode.h"
+
+#if MGB_JIT
+
+#include "megbrain/common.h"
+#include "megbrain/jit/placeholder_opr.h"
+#include "megbrain/utils/arith_helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace mgb;
+using namespace jit;
+using namespace cpu_vm;
+
+namespace {
+
+using Mode = opr::Elemwise::Mode;
+
+const char* mode_name(Mode mode) {
+    switch (mode) {
+#define cb(_mode, _imp) \
+    case Mode::_mode:   \
+        return #_mode;
+        MGB_CPU_VM_FOREACH_UNARY_MODE(cb)
+        MGB_CPU_VM_FOREACH_BINARY_MODE(cb)
+        MGB_CPU_VM_FOREACH_TERNARY_MODE(cb)
+        MGB_CPU_VM_FOREACH_QUATERNARY_MODE(cb)
+#undef cb
+        default:
+            return nullptr;
+    }
+}
+
+size_t mode_arity(Mode mode) {
+    switch (mode) {
+#define cb(_arity, _mode, _imp) \
+    case Mode::_mode:           \
+        return _arity;
+#define cb1(_mode, _imp) cb(1, _mode, _imp)
+#define cb2(_mode, _imp) cb(2, _mode, _imp)
+#define cb3(_mode, _imp) cb(3, _mode, _imp)
+#define cb4(_mode, _imp) cb(4, _mode, _imp)
+        MGB_CPU_VM_FOREACH_UNARY_MODE(cb1)
+        MGB_CPU_VM_FOREACH_BINARY_MODE(cb2)
+        MGB_CPU_VM_FOREACH_TERNARY_MODE(cb3)
+        MGB_CPU_VM_FOREACH_QUATERNARY_MODE(cb4)
+#undef cb4
+#undef cb3
+#undef cb2
+#undef cb1
+#undef cb
+        default:
+            return 0;
+    }
+}
+
+/* ============== primitives ============== */
+
+// The loops below have no loop-carried dependency and are vectorized by the
+// compiler; dst may alias a source since element i is read before written.
+
+template <typename Func>
+void map1(float* dst, const float* a, size_t n, Func f) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = f(a[i]);
+    }
+}
+
+template <typename Func>
+void map2(float* dst, const float* a, const float* b, size_t n, Func f) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = f(a[i], b[i]);
+    }
+}
+
+template <typename Func>
+void map3(
+        float* dst, const float* a, const float* b, const float* c, size_t n,
+        Func f) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = f(a[i], b[i], c[i]);
+    }
+}
+
+template <typename Func>
+void map4(
+        float* dst, const float* a, const float* b, const float* c, const float* d,
+        size_t n, Func f) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = f(a[i], b[i], c[i], d[i]);
+    }
+}
+
+//! the same special cases as gen_powc in ast_c.cpp
+void run_powc(float* dst, const float* a, size_t n, float exp) {
+    auto exp_abs = std::abs(exp);
+    bool neg = exp < 0;
+    if (almost_equal(exp_abs, 0.f)) {
+        std::fill(dst, dst + n, 1.f);
+    } else if (almost_equal(exp_abs, 1.f)) {
+        if (neg) {
+            map1(dst, a, n, [](float x) { return 1.f / x; });
+        } else if (dst != a) {
+            std::copy(a, a + n, dst);
+        }
+    } else if (almost_equal(exp_abs, 2.f)) {
+        if (neg) {
+            map1(dst, a, n, [](float x) { return 1.f / (x * x); });
+        } else {
+            map1(dst, a, n, [](float x) { return x * x; });
+        }
+    } else if (almost_equal(exp_abs, 3.f)) {
+        if (neg) {
+            map1(dst, a, n, [](float x) { return 1.f / (x * x * x); });
+        } else {
+            map1(dst, a, n, [](float x) { return x * x * x; });
+        }
+    } else if (almost_equal(exp, .5f)) {
+        map1(dst, a, n, [](float x) { return sqrtf(x); });
+    } else if (almost_equal(exp, -.5f)) {
+        map1(dst, a, n, [](float x) { return 1.f / sqrtf(x); });
+    } else if (almost_equal(exp, 1.f / 3.f)) {
+        map1(dst, a, n, [](float x) { return cbrtf(x); });
+    } else if (almost_equal(exp, -1.f / 3.f)) {
+        map1(dst, a, n, [](float x) { return 1.f / cbrtf(x); });
+    } else {
+        int exp_i = std::round(exp);
+        if (almost_equal(static_cast<float>(exp_i), exp)) {
+            if (exp_i & 1) {
+                map1(dst, a, n,
+                     [exp](float x) { return copysignf(powf(fabsf(x), exp), x); });
+            } else {
+                map1(dst, a, n, [exp](float x) { return powf(fabsf(x), exp); });
+            }
+        } else {
+            map1(dst, a, n, [exp](float x) { return powf(x, exp); });
+        }
+    }
+}
+
+void run_elemwise(
+        Mode mode, float* dst, const float* const* src, size_t n) {
+    switch (mode) {
+#define cb(_mode, _imp)                                            \
+    case Mode::_mode:                                              \
+        map1(dst, src[0], n, [](float x) -> float { return _imp; }); \
+        return;
+        MGB_CPU_VM_FOREACH_UNARY_MODE(cb)
+#undef cb
+#define cb(_mode, _imp)                                                     \
+    case Mode::_mode:                                                       \
+        map2(dst, src[0], src[1], n,                                        \
+             [](float x, float y) -> float { return _imp; });               \
+        return;
+        MGB_CPU_VM_FOREACH_BINARY_MODE(cb)
+#undef cb
+#define cb(_mode, _imp)                                                     \
+    case Mode::_mode:                                                       \
+        map3(dst, src[0], src[1], src[2], n,                                \
+             [](float x, float y, float z) -> float { return _imp; });      \
+        return;
+        MGB_CPU_VM_FOREACH_TERNARY_MODE(cb)
+#undef cb
+#define cb(_mode, _imp)                                                       \
+    case Mode::_mode:                                                         \
+        map4(dst, src[0], src[1], src[2], src[3], n,                          \
+             [](float x, float y, float z, float w) -> float { return _imp; }); \
+        return;
+        MGB_CPU_VM_FOREACH_QUATERNARY_MODE(cb)
+#undef cb
+        default:
+            mgb_throw(
+                    InternalError, "unsupported elemwise mode %d in cpu vm",
+                    static_cast<int>(mode));
+    }
+}
+
+/* ============== lowering ============== */
+
+//! an opr in the internal graph that computes a value
+struct Node {
+    Instr::Kind kind;
+    Mode mode;
+    float imm;
+    SmallVector<VarNode*, Instr::MAX_NR_SRC> inputs;
+    VarNode* output;
+};
+
+void check_dtype(VarNode* var) {
+    mgb_throw_if(
+            var->dtype() != dtype::Float32(), GraphError,
+            "cpu vm jit only supports float32, got %s for var %s", var->dtype().name(),
+            var->cname());
+}
+
+}  // anonymous namespace
+
+std::string Program::to_string() const {
+    std::string ret = ssprintf(
+            "inputs=%zu consts=%zu temps=%zu\n", nr_input, consts.size(), nr_temp);
+    auto reg_name = [this](uint32_t reg) {
+        if (reg == output_reg()) {
+            return std::string{"out"};
+        }
+        if (reg < nr_input) {
+            return ssprintf("i%u", reg);
+        }
+        if (reg < nr_input + consts.size()) {
+            return ssprintf("c%u(%g)", reg, consts[reg - nr_input]);
+        }
+        return ssprintf("t%u", reg);
+    };
+    for (auto&& i : instrs) {
+        ret += reg_name(i.dst) + " = ";
+        size_t nr_src = 1;
+        if (i.kind == Instr::Kind::ELEMWISE) {
+            ret += mode_name(i.mode);
+            nr_src = mode_arity(i.mode);
+        } else if (i.kind == Instr::Kind::POWC) {
+            ret += ssprintf("POWC[%g]", i.imm);
+        } else {
+            ret += "COPY";
+        }
+        for (size_t j = 0; j < nr_src; ++j) {
+            ret += " " + reg_name(i.src[j]);
+        }
+        ret += "\n";
+    }
+    return ret;
+}
+
+Program cpu_vm::lower(const InternalGraph& graph) {
+    Program prog;
+    prog.nr_input = graph.placeholders().size();
+
+    // registers of inputs and consts are known in the first pass; nodes
+    // computing values are recorded and get temporary registers afterwards
+    ThinHashMap<VarNode*, uint32_t> var2reg;
+    std::vector<Node> nodes;
+    cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
+        if (auto ph = opr->try_cast_final<JITPlaceholder>()) {
+            mgb_throw_if(
+                    ph->is_host_value_shape_input(), GraphError,
+                    "cpu vm jit does not support shape input %s", ph->cname());
+            check_dtype(ph->output(0));
+            var2reg[ph->output(0)] = ph->input_id();
+            return;
+        }
+        auto imm = SymbolVar{opr->output(0)}.as_immutable_scalar();
+        if (imm.valid()) {
+            var2reg[opr->output(0)] = prog.nr_input + prog.consts.size();
+            prog.consts.push_back(imm->get_cast<float>());
+            return;
+        }
+        Node node;
+        node.imm = 0;
+        node.mode = Mode::ADD;
+        node.output = opr->output(0);
+        if (auto elem = opr->try_cast_final<opr::Elemwise>()) {
+            node.kind = Instr::Kind::ELEMWISE;
+            node.mode = elem->param().mode;
+            mgb_throw_if(
+                    mode_arity(node.mode) != opr->input().size(), GraphError,
+                    "unsupported elemwise opr %s in cpu vm jit", opr->cname());
+        } else if (auto powc = opr->try_cast_final<opr::PowC>()) {
+            node.kind = Instr::Kind::POWC;
+            node.imm = powc->param().exp;
+        } else {
+            mgb_throw(
+                    GraphError, "unsupported opr %s{%s} in cpu vm jit", opr->cname(),
+                    opr->dyn_typeinfo()->name);
+        }
+        check_dtype(node.output);
+        for (auto i : opr->input()) {
+            node.inputs.push_back(i);
+        }
+        nodes.emplace_back(std::move(node));
+    }}.add(graph.output());
+
+    if (nodes.empty() || nodes.back().output != graph.output()) {
+        Node node;
+        node.kind = Instr::Kind::COPY;
+        node.mode = Mode::ADD;
+        node.imm = 0;
+        node.inputs.push_back(graph.output());
+        node.output = nullptr;
+        nodes.emplace_back(std::move(node));
+    }
+
+    ThinHashMap<VarNode*, size_t> last_use;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (auto var : nodes[i].inputs) {
+            last_use[var] = i;
+        }
+    }
+
+    // linear scan over the nodes: a temp register is released after the last
+    // read of its value and then handed to the next computed value
+    ThinHashMap<VarNode*, uint32_t> var2temp;
+    std::vector<uint32_t> free_temps;
+    uint32_t temp_base = prog.nr_input + prog.consts.size();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto&& node = nodes[i];
+        Instr instr;
+        instr.kind = node.kind;
+        instr.mode = node.mode;
+        instr.imm = node.imm;
+        std::fill(instr.src, instr.src + Instr::MAX_NR_SRC, 0);
+        for (size_t j = 0; j < node.inputs.size(); ++j) {
+            auto var = node.inputs[j];
+            auto iter = var2reg.find(var);
+            if (iter != var2reg.end()) {
+                instr.src[j] = iter->second;
+                continue;
+            }
+            auto temp = var2temp.find(var);
+            mgb_assert(temp != var2temp.end(), "var %s not computed", var->cname());
+            instr.src[j] = temp_base + temp->second;
+        }
+        for (auto var : node.inputs) {
+            auto temp = var2temp.find(var);
+            if (temp != var2temp.end() && last_use.at(var) == i) {
+                free_temps.push_back(temp->second);
+                var2temp.erase(temp);
+            }
+        }
+        if (i + 1 == nodes.size()) {
+            // the output register is bound after all temps are counted
+            instr.dst = std::numeric_limits<uint32_t>::max();
+        } else {
+            uint32_t temp;
+            if (free_temps.empty()) {
+                temp = prog.nr_temp++;
+            } else {
+                temp = free_temps.back();
+                free_temps.pop_back();
+            }
+            var2temp[node.output] = temp;
+            instr.dst = temp_base + temp;
+        }
+        prog.instrs.push_back(instr);
+    }
+    prog.instrs.back().dst = prog.output_reg();
+    return prog;
+}
+
+void cpu_vm::run_tile(const Program& prog, float* const* regs, size_t size) {
+    const float* src[Instr::MAX_NR_SRC];
+    for (auto&& instr : prog.instrs) {
+        for (size_t i = 0; i < Instr::MAX_NR_SRC; ++i) {
+            src[i] = regs[instr.src[i]];
+        }
+        float* dst = regs[instr.dst];
+        switch (instr.kind) {
+            case Instr::Kind::ELEMWISE:
+                run_elemwise(instr.mode, dst, src, size);
+                break;
+            case Instr::Kind::POWC:
+                run_powc(dst, src[0], size, instr.imm);
+                break;
+            case Instr::Kind::COPY:
+                std::copy(src[0], src[0] + size, dst);
+                break;
+        }
+    }
+}
+
+#endif  // MGB_JIT
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
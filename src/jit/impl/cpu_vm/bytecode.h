@@ -0,0 +1,134 @@
+#pragma once
+
+#include "megbrain_build_config.h"
+#if MGB_JIT
+
+#include "megbrain/jit/internal_graph.h"
+#include "megbrain/opr/basic_arith.h"
+
+// clang-format off
+//! elemwise modes supported by the bytecode, the same set as the other_map of
+//! ast_c::elem_opr_generator; the expressions follow megdnn kern_defs.cuh
+#define MGB_CPU_VM_FOREACH_UNARY_MODE(cb) \
+    cb(RELU, x <= 0.f ? 0.f : x) \
+    cb(ABS, fabsf(x)) \
+    cb(ACOS, acosf(x)) \
+    cb(ASIN, asinf(x)) \
+    cb(CEIL, ceilf(x)) \
+    cb(COS, cosf(x)) \
+    cb(EXP, expf(x)) \
+    cb(EXPM1, expm1f(x)) \
+    cb(FLOOR, floorf(x)) \
+    cb(LOG, logf(x)) \
+    cb(LOG1P, log1pf(x)) \
+    cb(NEGATE, -x) \
+    cb(SIGMOID, 1.f / (expf(-x) + 1.f)) \
+    cb(SIN, sinf(x)) \
+    cb(TANH, tanhf(x)) \
+    cb(ERF, erff(x)) \
+    cb(ERFC, erfcf(x)) \
+    cb(H_SWISH, x * std::min(std::max(x + 3.f, 0.f), 6.f) * (1.f / 6.f))
+
+#define MGB_CPU_VM_FOREACH_BINARY_MODE(cb) \
+    cb(ABS_GRAD, x > 0.f ? y : -y) \
+    cb(ADD, x + y) \
+    cb(FLOOR_DIV, floorf(x / y)) \
+    cb(MAX, x > y ? x : y) \
+    cb(MIN, x < y ? x : y) \
+    cb(MOD, fmodf(x, y)) \
+    cb(MUL, x * y) \
+    cb(POW, powf(x, y)) \
+    cb(SIGMOID_GRAD, x * (1.f - x) * y) \
+    cb(SUB, x - y) \
+    cb(SWITCH_GT0, x > 0.f ? y : 0.f) \
+    cb(TANH_GRAD, (1.f - x * x) * y) \
+    cb(TRUE_DIV, x / y) \
+    cb(LOG_SUM_EXP, x < y ? y + log1pf(expf(x - y)) : x + log1pf(expf(y - x))) \
+    cb(LT, float(x < y)) \
+    cb(LEQ, float(x <= y)) \
+    cb(EQ, float(x == y)) \
+    cb(ATAN2, atan2f(x, y)) \
+    cb(H_SWISH_GRAD, x < -3.f ? 0.f : (x > 3.f ? y : (2.f * x + 3.f) / 6.f * y)) \
+    cb(FUSE_ADD_RELU, x + y <= 0.f ? 0.f : x + y) \
+    cb(FUSE_ADD_SIGMOID, 1.f / (expf(-(x + y)) + 1.f)) \
+    cb(FUSE_ADD_TANH, tanhf(x + y)) \
+    cb(FUSE_ADD_H_SWISH, \
+       (x + y) * std::min(std::max(x + y + 3.f, 0.f), 6.f) * (1.f / 6.f))
+
+#define MGB_CPU_VM_FOREACH_TERNARY_MODE(cb) \
+    cb(COND_LEQ_MOV, x <= y ? z : 0.f) \
+    cb(COND_LT_MOV, x < y ? z : 0.f) \
+    cb(FUSE_MUL_ADD3, x * y + z)
+
+#define MGB_CPU_VM_FOREACH_QUATERNARY_MODE(cb) \
+    cb(FUSE_MUL_ADD4, x * y + z * w)
+// clang-format on
+
+namespace mgb {
+namespace jit {
+namespace cpu_vm {
+
+/*!
+ * \brief one instruction of the register based bytecode
+ *
+ * Every register holds a tile of float32 values. The instruction computes
+ * dst[i] = f(src[0][i], src[1][i], ...) for all elements of the tile.
+ */
+struct Instr {
+    enum class Kind : uint32_t {
+        ELEMWISE,  //!< elemwise opr given by mode
+        POWC,      //!< power with constant exponent in imm
+        COPY,      //!< dst = src[0]
+    };
+    static constexpr size_t MAX_NR_SRC = 4;
+
+    Kind kind;
+    opr::Elemwise::Mode mode;
+    float imm;
+    uint32_t dst;
+    uint32_t src[MAX_NR_SRC];
+};
+
+/*!
+ * \brief bytecode lowered from an InternalGraph
+ *
+ * Registers are numbered as follows:
+ *  - [0, nr_input): the inputs of the JITExecutor, in placeholder order
+ *  - [nr_input, nr_input + consts.size()): scalar constants
+ *  - the following nr_temp registers: intermediate values
+ *  - output_reg(): the output tile, only written by the last instruction
+ */
+struct Program {
+    size_t nr_input = 0, nr_temp = 0;
+    std::vector<float> consts;
+    std::vector<Instr> instrs;
+
+    size_t nr_reg() const { return nr_input + consts.size() + nr_temp; }
+
+    uint32_t output_reg() const { return nr_reg(); }
+
+    std::string to_string() const;
+};
+
+/*!
+ * \brief lower an InternalGraph of float32 Elemwise and PowC oprs
+ *
+ * Temporary registers are reused after the last read of their values, so the
+ * number of registers only depends on the width of the expression.
+ */
+Program lower(const InternalGraph& graph);
+
+/*!
+ * \brief run all instructions on one tile of \p size elements
+ * \param regs pointers to the tiles of all registers, including the output
+ *      register; input and const registers are never written
+ */
+void run_tile(const Program& prog, float* const* regs, size_t size);
+
+}  // namespace cpu_vm
+}  // namespace jit
+}  // namespace mgb
+
+#endif  // MGB_JIT
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
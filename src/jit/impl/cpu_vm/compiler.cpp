@@ -0,0 +1,172 @@
+#include "megbrain_build_config.h"
+#if MGB_JIT
+
+#include "./compiler.h"
+
+#include "megbrain/common.h"
+#include "megbrain/comp_node_env.h"
+#include "megbrain/utils/arith_helper.h"
+
+#include <cstring>
+
+using namespace mgb;
+using namespace jit;
+
+namespace {
+
+//! layout and address of one input of the fused opr
+struct InputTensor {
+    const float* ptr;
+    TensorLayout layout;
+};
+
+/*!
+ * \brief get elements [begin, begin + size) of an input broadcast to the
+ *      output
+ *
+ * Returns the address in the input directly if the elements are contiguous in
+ * memory; otherwise they are gathered into \p buf.
+ */
+const float* load_tile(
+        const InputTensor& inp, size_t begin, size_t size, float* buf) {
+    auto&& ly = inp.layout;
+    size_t ndim = ly.ndim, idx[TensorLayout::MAX_NDIM];
+    ptrdiff_t offset = 0;
+    for (size_t i = ndim, rem = begin; i--;) {
+        idx[i] = rem % ly.shape[i];
+        rem /= ly.shape[i];
+        offset += static_cast<ptrdiff_t>(idx[i]) * ly.stride[i];
+    }
+
+    size_t last = ndim - 1, inner = ly.shape[last];
+    ptrdiff_t stride = ly.stride[last];
+    if (stride == 1 && size <= inner - idx[last]) {
+        return inp.ptr + offset;
+    }
+
+    float* dst = buf;
+    while (size) {
+        size_t run = std::min(size, inner - idx[last]);
+        const float* src = inp.ptr + offset;
+        if (stride == 1) {
+            memcpy(dst, src, sizeof(float) * run);
+        } else if (stride == 0) {
+            std::fill(dst, dst + run, *src);
+        } else {
+            for (size_t i = 0; i < run; ++i) {
+                dst[i] = src[i * stride];
+            }
+        }
+        dst += run;
+        size -= run;
+
+        // advance the index by run elements and carry to outer dims
+        idx[last] += run;
+        offset += static_cast<ptrdiff_t>(run) * stride;
+        for (size_t i = last; i && idx[i] == ly.shape[i]; --i) {
+            offset -= static_cast<ptrdiff_t>(idx[i]) * ly.stride[i];
+            idx[i] = 0;
+            ++idx[i - 1];
+            offset += ly.stride[i - 1];
+        }
+    }
+    return buf;
+}
+
+//! scratch memory of the calling thread, grown on demand and never shrunk
+float* get_thread_scratch(size_t size) {
+    static thread_local std::vector<float> scratch;
+    if (scratch.size() < size) {
+        scratch.resize(size);
+    }
+    return scratch.data();
+}
+
+}  // anonymous namespace
+
+/* =================== CPUVMExecutable ==================== */
+
+constexpr size_t CPUVMExecutable::TILE_SIZE;
+constexpr size_t CPUVMExecutable::MIN_ELEMS_PER_TASK;
+
+void CPUVMExecutable::execute(JITExecutor* fusion_opr) {
+    auto&& args = fusion_opr->args();
+    mgb_assert(args.outputs.size() == 1);
+    auto&& out = args.outputs[0];
+    size_t nr_elems = out.layout.total_nr_elems();
+    if (!nr_elems) {
+        return;
+    }
+    mgb_assert(
+            out.layout.is_contiguous(), "cpu vm jit needs contiguous output, got %s",
+            out.layout.to_string().c_str());
+    float* out_ptr = out.from->dev_tensor().ptr<float>();
+
+    mgb_assert(args.inputs.size() == m_prog.nr_input);
+    SmallVector<InputTensor> inputs(args.inputs.size());
+    for (auto&& i : args.inputs) {
+        mgb_assert(i.layout.eq_shape(out.layout));
+        inputs[i.idx] = {i.from->dev_tensor().ptr<float>(), i.layout};
+    }
+
+    auto&& env = CompNodeEnv::from_comp_node(fusion_opr->comp_node()).cpu_env();
+    size_t nr_tiles = divup(nr_elems, TILE_SIZE);
+    size_t nr_tasks = std::min(
+            env.dispatcher->nr_threads(), divup(nr_elems, MIN_ELEMS_PER_TASK));
+    nr_tasks = std::max<size_t>(nr_tasks, 1);
+
+    auto&& prog = m_prog;
+    auto task = [&prog, inputs, out_ptr, nr_elems, nr_tiles, nr_tasks](
+                        size_t task_id, size_t) {
+        size_t nr_input = prog.nr_input, nr_const = prog.consts.size(),
+               nr_reg = prog.nr_reg();
+        float* scratch = get_thread_scratch(nr_reg * TILE_SIZE);
+        SmallVector<float*> regs(nr_reg + 1);
+        for (size_t i = 0; i < nr_reg; ++i) {
+            regs[i] = scratch + i * TILE_SIZE;
+        }
+        for (size_t i = 0; i < nr_const; ++i) {
+            auto reg = regs[nr_input + i];
+            std::fill(reg, reg + TILE_SIZE, prog.consts[i]);
+        }
+
+        size_t tile_begin = nr_tiles * task_id / nr_tasks,
+               tile_end = nr_tiles * (task_id + 1) / nr_tasks;
+        for (size_t tile = tile_begin; tile < tile_end; ++tile) {
+            size_t begin = tile * TILE_SIZE,
+                   size = std::min(TILE_SIZE, nr_elems - begin);
+            // registers of inputs may point into the input tensors; they are
+            // only read by the instructions
+            for (size_t i = 0; i < nr_input; ++i) {
+                regs[i] = const_cast<float*>(load_tile(
+                        inputs[i], begin, size, scratch + i * TILE_SIZE));
+            }
+            regs[nr_reg] = out_ptr + begin;
+            cpu_vm::run_tile(prog, regs.data(), size);
+        }
+    };
+    env.dispatch(task, nr_tasks);
+}
+
+/* =================== CPUVMCompiler ==================== */
+
+std::unique_ptr<Executable> CPUVMCompiler::do_compile(
+        const InternalGraph& graph, const JITExecutor::Args& args) {
+    MGB_MARK_USED_VAR(args);
+    auto prog = cpu_vm::lower(graph);
+    mgb_log_debug("cpu vm jit program: %s", prog.to_string().c_str());
+    return std::make_unique<CPUVMExecutable>(std::move(prog));
+}
+
+size_t CPUVMCompiler::get_nr_workspace_outputs(JITExecutor* opr) const {
+    MGB_MARK_USED_VAR(opr);
+    return 0;
+}
+
+void CPUVMCompiler::init_workspace_size_infer(JITExecutor* opr) {
+    MGB_MARK_USED_VAR(opr);
+}
+
+#endif  // MGB_JIT
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "megbrain_build_config.h"
+#if MGB_JIT
+
+#include "./bytecode.h"
+
+#include "megbrain/jit/compiler.h"
+
+namespace mgb {
+namespace jit {
+
+/*!
+ * \brief Executable that interprets cpu vm bytecode
+ *
+ * The collapsed output is split into tiles of TILE_SIZE elements, and all
+ * instructions run on one tile before moving to the next, so intermediate
+ * values stay in cache. Tiles are distributed over the threads of the comp
+ * node. The bytecode does not depend on shapes, so one executable serves
+ * all input layouts of an internal graph.
+ */
+class CPUVMExecutable final : public Executable {
+public:
+    //! number of float32 elements in a tile
+    static constexpr size_t TILE_SIZE = 1024;
+
+    //! minimal number of elements processed by one thread
+    static constexpr size_t MIN_ELEMS_PER_TASK = 8 * TILE_SIZE;
+
+    explicit CPUVMExecutable(cpu_vm::Program prog) : m_prog{std::move(prog)} {}
+
+    void execute(JITExecutor* fusion_opr) override;
+
+    const cpu_vm::Program& program() const { return m_prog; }
+
+private:
+    const cpu_vm::Program m_prog;
+};
+
+/*!
+ * \brief JIT compiler for cpu that needs no codegen toolchain
+ *
+ * The internal graph is lowered to register based bytecode (see
+ * cpu_vm::Program) which is run by CPUVMExecutable. Only float32 elemwise and
+ * PowC oprs are supported.
+ */
+class CPUVMCompiler final : public Compiler {
+    std::unique_ptr<Executable> do_compile(
+            const InternalGraph& graph, const JITExecutor::Args& args) override;
+
+public:
+    Property property() const override {
+        using F = Property::Flag;
+        return Property{F::NEED_INPUT_COLLAPSE, JITFeatureBits::NONE, 64};
+    }
+
+    size_t get_nr_workspace_outputs(JITExecutor* opr) const override;
+
+    void init_workspace_size_infer(JITExecutor* opr) override;
+};
+
+}  // namespace jit
+}  // namespace mgb
+
+#endif  // MGB_JIT
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -116,15 +116,16 @@ void JITFusionPass::Impl::config_jit_backends(CompNode comp_node) const {
                     "MLIR/HALIDE module or error config jit backend env");
             break;
 #endif
-        // CPU jit only support MLIR now
+        // CPU jit default property: MLIR > CPUVM
         case CompNode::DeviceType::CPU:
 #if MGB_JIT_MLIR
             ENV_CB("MLIR");
 #endif
+            ENV_CB("CPUVM");
             mgb_throw(
                     InternalError,
-                    "No compiler support for cpu, may caused by build not enable "
-                    "MLIR module or error config jit backend env");
+                    "No compiler support for cpu, may caused by error config jit "
+                    "backend env");
             break;
         default:
             mgb_throw(
@@ -432,14 +433,30 @@ bool JITFusionPass::Impl::can_be_fused(cg::OperatorNodeBase* opr) const {
         }
 #endif  // MGB_JIT_MLIR
 
+        //! CPUVM only runs float32 bytecode
+        if (!strcmp(backend.c_str(), "CPUVM")) {
+            ret = elem->output(0)->dtype() == dtype::Float32();
+            for (auto i : elem->input()) {
+                ret &= i->dtype() == dtype::Float32();
+            }
+        }
+
         return ret &&
                ast_c::check_elem_mode(
                        elem->param().mode, opr->output(0)->comp_node().device_type()) &&
                elem->output(0)->dtype().category() == DTypeCategory::FLOAT;
     }
 
-    //! TINYOPENCL and MLIR only support elemwise now
-    if (strcmp(backend.c_str(), "MLIR") && strcmp(backend.c_str(), "TINYOPENCL")) {
+    //! CPUVM supports float32 elemwise and PowC
+    if (!strcmp(backend.c_str(), "CPUVM")) {
+        if (opr->same_type<opr::PowC>()) {
+            return opr->input(0)->dtype() == dtype::Float32();
+        }
+    }
+
+    //! TINYOPENCL, MLIR and CPUVM only support elemwise now
+    if (strcmp(backend.c_str(), "MLIR") && strcmp(backend.c_str(), "TINYOPENCL") &&
+        strcmp(backend.c_str(), "CPUVM")) {
         if (opr->same_type<opr::PowC>()) {
             return true;
         }
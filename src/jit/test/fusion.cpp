@@ -17,6 +17,7 @@
 #include "megbrain/test/helper.h"
 
 #include "../../core/impl/graph/cg_impl_seq.h"
+#include "../impl/cpu_vm/bytecode.h"
 
 #if MGB_JIT
 
@@ -1677,6 +1678,95 @@ TEST(TestJITExecutor, TestJITMlirFusionGpu) {
 
 #endif  // MGB_JIT_MLIR
 
+void run_cpu_vm(CompNode cn) {
+    set_backend(Backend::CPUVM);
+
+    // more elements than a tile, and not a multiple of the tile size
+    HostTensorGenerator<> gen;
+    auto host_x0 = gen({123, 45}, cn), host_x1 = gen({123, 1}, cn),
+         host_x2 = gen({1, 45}, cn), host_x3 = gen({123, 45}, cn);
+
+    auto make_dst = [&](ComputingGraph& graph) {
+        auto a = opr::Host2DeviceCopy::make(graph, host_x0),
+             b = opr::Host2DeviceCopy::make(graph, host_x1),
+             c = opr::Host2DeviceCopy::make(graph, host_x2),
+             d = opr::Host2DeviceCopy::make(graph, host_x3);
+        auto y = opr::powf(a, 2.f) * b + opr::tanh(c) - d / (opr::abs(b) + 1.f);
+        return opr::max(y, c) * 0.5f + opr::powf(opr::abs(d) + .1f, .5f);
+    };
+    HostTensorND host_y1, host_y2;
+    auto funcs = make_func_pair(host_y1, host_y2, make_dst, 2);
+
+    funcs.first->execute();
+    funcs.second->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y1, host_y2, 1e-5);
+
+    JITExecutor* jit;
+    unpack_vector(find_oprs<JITExecutor>(*funcs.second), jit);
+    ASSERT_EQ(0u, find_oprs<opr::Elemwise>(*funcs.second).size());
+    ASSERT_EQ(4u, jit->input().size());
+
+    // the executable does not depend on shapes
+    auto exe = jit->executable();
+    *host_x0 = *gen({7, 3}, cn);
+    *host_x1 = *gen({7, 1}, cn);
+    *host_x2 = *gen({1, 3}, cn);
+    *host_x3 = *gen({7, 3}, cn);
+    funcs.first->execute();
+    funcs.second->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y1, host_y2, 1e-5);
+    ASSERT_EQ(exe, jit->executable());
+}
+
+TEST(TestJITExecutor, TestJITCPUVMFusion) {
+    run_cpu_vm(CompNode::load("cpu0"));
+}
+
+TEST(TestJITExecutor, TestJITCPUVMFusionMultiThread) {
+    run_cpu_vm(CompNode::load("multithread4:0"));
+}
+
+TEST(TestJITExecutor, TestJITCPUVMAllModes) {
+    set_backend(Backend::CPUVM);
+    auto cn = CompNode::load("multithread2:0");
+
+    using Mode = opr::Elemwise::Mode;
+    std::vector<std::pair<Mode, size_t>> modes;
+#define cb(_arity, _mode) modes.emplace_back(Mode::_mode, _arity);
+#define cb1(_mode, _imp) cb(1, _mode)
+#define cb2(_mode, _imp) cb(2, _mode)
+#define cb3(_mode, _imp) cb(3, _mode)
+#define cb4(_mode, _imp) cb(4, _mode)
+    MGB_CPU_VM_FOREACH_UNARY_MODE(cb1)
+    MGB_CPU_VM_FOREACH_BINARY_MODE(cb2)
+    MGB_CPU_VM_FOREACH_TERNARY_MODE(cb3)
+    MGB_CPU_VM_FOREACH_QUATERNARY_MODE(cb4)
+#undef cb4
+#undef cb3
+#undef cb2
+#undef cb1
+#undef cb
+    ASSERT_EQ(ast_c::elem_opr_generator(cn.device_type()).size(), modes.size());
+
+    TensorShapeArray shapes{{37, 41, 5}, {37, 1, 5}, {1, 41, 5}, {37, 41, 1}};
+    for (auto&& i : modes) {
+        auto mode = i.first;
+        FusionChecker checker{
+                i.second,
+                [mode](SymbolVarArray inp) -> SymbolVar {
+                    // keep inputs in (0.1, 0.9) to be valid for all modes
+                    for (auto&& x : inp) {
+                        x = opr::max(opr::min(opr::abs(x), x.make_scalar_dt(.9f)),
+                                     x.make_scalar_dt(.1f));
+                    }
+                    return opr::Elemwise::make(inp, mode) + 1.f;
+                },
+                cn};
+        checker.enable_direct_build().disable_inp_grad();
+        checker.run(TensorShapeArray(shapes.begin(), shapes.begin() + i.second));
+    }
+}
+
 #endif  // MGB_JIT
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
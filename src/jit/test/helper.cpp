@@ -30,6 +30,9 @@ void jit::set_backend(Backend backend) {
         case Backend::TINYOPENCL:
             setenv("MGB_JIT_BACKEND", "TINYOPENCL", 1);
             return;
+        case Backend::CPUVM:
+            setenv("MGB_JIT_BACKEND", "CPUVM", 1);
+            return;
         default:
             mgb_assert(0);
     }
@@ -4,7 +4,7 @@
 
 namespace mgb {
 namespace jit {
-enum class Backend { NONE, HALIDE, NVRTC, MLIR, TINYOPENCL };
+enum class Backend { NONE, HALIDE, NVRTC, MLIR, TINYOPENCL, CPUVM };
 
 void set_backend(Backend backend);
 
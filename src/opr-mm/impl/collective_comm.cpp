@@ -7,6 +7,7 @@
 #include "megbrain/opr/group_manager.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/megray_helper.h"
+#include "megbrain/opr/shm_comm.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/serialization/sereg.h"
 #include "megbrain/version_symbol.h"
@@ -36,6 +37,30 @@ const char* get_param_name(CollectiveComm::Param param) {
     }
 }
 
+ShmCommunicator::ReduceOp get_shm_reduce_op(MegRay::ReduceOp op) {
+    switch (op) {
+        case MegRay::ReduceOp::MEGRAY_SUM:
+            return ShmCommunicator::ReduceOp::SUM;
+        case MegRay::ReduceOp::MEGRAY_MAX:
+            return ShmCommunicator::ReduceOp::MAX;
+        case MegRay::ReduceOp::MEGRAY_MIN:
+            return ShmCommunicator::ReduceOp::MIN;
+        default:
+            mgb_throw(MegBrainError, "bad CollectiveComm reduce op");
+    }
+}
+
+/*!
+ * the shm communicator reads and writes the tensors on the host, so it runs on
+ * the cpu worker of the comp node, after the kernels computing its input and
+ * before the kernels reading its output
+ */
+void dispatch_shm(CollectiveComm* opr, CompNodeEnv::CpuEnv::Task&& task) {
+    CompNodeEnv::from_comp_node(opr->output(0)->comp_node())
+            .cpu_env()
+            .dispatch(std::move(task));
+}
+
 }  // anonymous namespace
 
 /* ================= ModeTrait ================= */
@@ -144,6 +169,15 @@ class CollectiveComm::ModeTrait::ALL_GATHER : public ModeTrait {
         auto ivar = opr->input(0), ovar = opr->output(0);
         auto &&iv = ivar->dev_tensor(), &&ov = ovar->dev_tensor();
         mgb_assert(ivar->comp_node().mem_node() == ovar->comp_node().mem_node());
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr(), recvbuf = ov.raw_ptr();
+            auto len = iv.shape().total_nr_elems();
+            auto dtype = iv.dtype();
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype]() {
+                shm->all_gather(sendbuf, recvbuf, len, dtype);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->all_gather(
                 (void*)iv.raw_ptr(), (void*)ov.raw_ptr(), iv.shape().total_nr_elems(),
                 get_megray_dtype(iv.dtype()), opr->megray_ctx());
@@ -187,6 +221,16 @@ class CollectiveComm::ModeTrait::REDUCE_SCATTER_SUM : public ModeTrait {
         mgb_assert(ivar->comp_node().mem_node() == ovar->comp_node().mem_node());
 
         size_t buff_len = ov.shape().total_nr_elems();  // * opr->m_nr_devices;
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr(), recvbuf = ov.raw_ptr();
+            auto dtype = ov.dtype();
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, buff_len, dtype]() {
+                shm->reduce_scatter(
+                        sendbuf, recvbuf, buff_len, dtype,
+                        ShmCommunicator::ReduceOp::SUM);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->reduce_scatter(
                 (void*)iv.raw_ptr(), (void*)ov.raw_ptr(), buff_len,
                 get_megray_dtype(ov.dtype()), MegRay::ReduceOp::MEGRAY_SUM,
@@ -233,6 +277,16 @@ class CollectiveComm::ModeTrait::AllReduceBase : public ReducedBasedTrait,
         auto ivar = opr->input(0), ovar = opr->output(0);
         auto &&iv = ivar->dev_tensor(), &&ov = ovar->dev_tensor();
         mgb_assert(ivar->comp_node().mem_node() == ovar->comp_node().mem_node());
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr(), recvbuf = ov.raw_ptr();
+            auto len = iv.shape().total_nr_elems();
+            auto dtype = iv.dtype();
+            auto shm_op = get_shm_reduce_op(op());
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype, shm_op]() {
+                shm->all_reduce(sendbuf, recvbuf, len, dtype, shm_op);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->all_reduce(
                 (void*)iv.raw_ptr(), (void*)ov.raw_ptr(), iv.shape().total_nr_elems(),
                 get_megray_dtype(iv.dtype()), op(), opr->megray_ctx());
@@ -310,6 +364,17 @@ class CollectiveComm::ModeTrait::ReduceBase : public ReducedBasedTrait,
         if (opr->is_root()) {
             recvbuf = ovar->dev_tensor().raw_ptr();
         }
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr();
+            auto len = iv.shape().total_nr_elems();
+            auto dtype = iv.dtype();
+            auto shm_op = get_shm_reduce_op(op());
+            auto root = opr->m_root;
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype, shm_op, root]() {
+                shm->reduce(sendbuf, recvbuf, len, dtype, shm_op, root);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->reduce(
                 (void*)iv.raw_ptr(), recvbuf, iv.shape().total_nr_elems(),
                 get_megray_dtype(iv.dtype()), op(), opr->m_root, opr->megray_ctx());
@@ -356,6 +421,14 @@ class CollectiveComm::ModeTrait::BROADCAST : public ModeTrait {
             datatype = ov.dtype();
             length = ov.shape().total_nr_elems();
         }
+        if (auto shm = opr->m_shm_comm) {
+            auto recvbuf = ov.raw_ptr();
+            auto root = opr->m_root;
+            dispatch_shm(opr, [shm, buff, recvbuf, length, datatype, root]() {
+                shm->broadcast(buff, recvbuf, length, datatype, root);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->broadcast(
                 buff, (void*)ov.raw_ptr(), length, get_megray_dtype(datatype),
                 opr->m_root, opr->megray_ctx());
@@ -385,6 +458,16 @@ class CollectiveComm::ModeTrait::GATHER : public ModeTrait {
         if (opr->is_root()) {
             recvbuf = opr->output(0)->dev_tensor().raw_ptr();
         }
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr();
+            auto len = iv.shape().total_nr_elems();
+            auto dtype = iv.dtype();
+            auto root = opr->m_root;
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype, root]() {
+                shm->gather(sendbuf, recvbuf, len, dtype, root);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->gather(
                 (void*)iv.raw_ptr(), recvbuf, iv.shape().total_nr_elems(),
                 get_megray_dtype(iv.dtype()), opr->m_root, opr->megray_ctx());
@@ -413,6 +496,15 @@ class CollectiveComm::ModeTrait::SCATTER : public ModeTrait {
         if (opr->is_root()) {
             sendbuf = opr->input(0)->dev_tensor().raw_ptr();
         }
+        if (auto shm = opr->m_shm_comm) {
+            auto len = ov.shape().total_nr_elems();
+            auto dtype = ov.dtype();
+            auto root = opr->m_root;
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype, root]() {
+                shm->scatter(sendbuf, recvbuf, len, dtype, root);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->scatter(
                 sendbuf, recvbuf, ov.shape().total_nr_elems(),
                 get_megray_dtype(ov.dtype()), opr->m_root, opr->megray_ctx());
@@ -433,6 +525,15 @@ class CollectiveComm::ModeTrait::ALL_TO_ALL : public ModeTrait {
     void exec(CollectiveComm* opr) override {
         auto&& iv = opr->input(0)->dev_tensor();
         auto&& ov = opr->output(0)->dev_tensor();
+        if (auto shm = opr->m_shm_comm) {
+            auto sendbuf = iv.raw_ptr(), recvbuf = ov.raw_ptr();
+            auto len = iv.shape().total_nr_elems() / opr->nr_devices();
+            auto dtype = iv.dtype();
+            dispatch_shm(opr, [shm, sendbuf, recvbuf, len, dtype]() {
+                shm->all_to_all(sendbuf, recvbuf, len, dtype);
+            });
+            return;
+        }
         auto status = opr->m_megray_comm->all_to_all(
                 (void*)iv.raw_ptr(), (void*)ov.raw_ptr(),
                 iv.shape().total_nr_elems() / opr->nr_devices(),
@@ -580,11 +681,20 @@ void CollectiveComm::opr_register() {
     m_rank = reg_info.rank;
     m_root = reg_info.root_rank;
 
-    m_megray_comm = MegRayCommBuilder::get_megray_comm(
-            reg_info.hash, m_key, m_nr_devices, m_rank, get_megray_backend(m_backend),
-            m_group_client);
-
-    m_megray_ctx = get_megray_context(output(0)->comp_node());
+    if (m_backend == "shm") {
+        mgb_assert(
+                comp_node.device_type() == CompNode::DeviceType::CPU ||
+                        comp_node.device_type() == CompNode::DeviceType::MULTITHREAD,
+                "shm CollectiveComm backend needs cpu comp node, got %s",
+                comp_node.to_string().c_str());
+        m_shm_comm = ShmCommunicator::get(
+                reg_info.hash, m_key, m_nr_devices, m_rank, m_group_client);
+    } else {
+        m_megray_comm = MegRayCommBuilder::get_megray_comm(
+                reg_info.hash, m_key, m_nr_devices, m_rank,
+                get_megray_backend(m_backend), m_group_client);
+        m_megray_ctx = get_megray_context(output(0)->comp_node());
+    }
 
     m_init = true;
 }
@@ -0,0 +1,406 @@
+#include "megbrain/opr/shm_comm.h"
+#include "megbrain/utils/arith_helper.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace mgb;
+using namespace opr;
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "shm comm needs lock free atomics");
+
+namespace {
+
+//! number of polls before yielding the cpu when waiting in a barrier
+constexpr size_t SPIN_COUNT = 1024;
+
+constexpr size_t CACHE_LINE = 64;
+
+/*!
+ * poll \p pred, yielding the cpu after SPIN_COUNT polls; a rank that died
+ * never arrives, so give up after \p timeout_sec instead of blocking the
+ * others forever
+ */
+template <typename Pred>
+void wait_until(Pred&& pred, double timeout_sec, const char* what) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point deadline;
+    for (size_t i = 0; !pred(); ++i) {
+        if (i < SPIN_COUNT) {
+            continue;
+        }
+        if (i == SPIN_COUNT) {
+            auto timeout = std::chrono::duration<double>(timeout_sec);
+            deadline = Clock::now() +
+                       std::chrono::duration_cast<Clock::duration>(timeout);
+        } else if (!(i % SPIN_COUNT) && Clock::now() > deadline) {
+            mgb_throw(
+                    MegBrainError,
+                    "shm comm timed out after %g seconds waiting for %s, some "
+                    "rank may have died",
+                    timeout_sec, what);
+        }
+        std::this_thread::yield();
+    }
+}
+
+template <typename T>
+struct OpSum {
+    static T apply(T a, T b) { return static_cast<T>(a + b); }
+};
+
+template <typename T>
+struct OpMax {
+    static T apply(T a, T b) { return a > b ? a : b; }
+};
+
+template <typename T>
+struct OpMin {
+    static T apply(T a, T b) { return a < b ? a : b; }
+};
+
+//! branch free loop over contiguous arrays, so it is vectorized by compiler
+template <typename T, template <typename> class Op>
+void reduce_into(T* __restrict dst, const T* __restrict src, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        dst[i] = Op<T>::apply(dst[i], src[i]);
+    }
+}
+
+template <typename T>
+void reduce_into(
+        void* dst, const void* src, size_t len, ShmCommunicator::ReduceOp op) {
+    using Op = ShmCommunicator::ReduceOp;
+    auto d = static_cast<T*>(dst);
+    auto s = static_cast<const T*>(src);
+    switch (op) {
+        case Op::SUM:
+            return reduce_into<T, OpSum>(d, s, len);
+        case Op::MAX:
+            return reduce_into<T, OpMax>(d, s, len);
+        case Op::MIN:
+            return reduce_into<T, OpMin>(d, s, len);
+    }
+    mgb_throw(MegBrainError, "bad shm comm reduce op");
+}
+
+}  // anonymous namespace
+
+/* ================= ShmCommunicator ================= */
+
+struct ShmCommunicator::Header {
+    //! number of ranks that have mapped the segment
+    alignas(CACHE_LINE) std::atomic<uint32_t> nr_attached{0};
+    //! number of ranks arrived at current barrier
+    alignas(CACHE_LINE) std::atomic<uint32_t> barrier_count{0};
+    //! increased each time all ranks arrive at a barrier
+    alignas(CACHE_LINE) std::atomic<uint32_t> barrier_gen{0};
+};
+
+constexpr size_t ShmCommunicator::DEFAULT_SLOT_SIZE;
+constexpr double ShmCommunicator::DEFAULT_TIMEOUT_SEC;
+std::mutex ShmCommunicator::sm_cache_mtx;
+std::unordered_map<uint64_t, std::shared_ptr<ShmCommunicator>>
+        ShmCommunicator::sm_cache;
+
+ShmCommunicator::ShmCommunicator(
+        const std::string& key, uint32_t size, uint32_t rank,
+        GroupClient* group_client, size_t slot_size, double timeout_sec)
+        : m_size{size},
+          m_rank{rank},
+          m_slot_size{get_aligned_power2(slot_size, CACHE_LINE)},
+          m_timeout_sec{timeout_sec} {
+    mgb_assert(rank < size, "bad shm comm rank: %u of %u", rank, size);
+    constexpr uint32_t root = 0;
+    auto header_size = get_aligned_power2(sizeof(Header), CACHE_LINE);
+
+    std::string name;
+    int fd = -1;
+    auto do_map = [&]() {
+        m_mapped_size = header_size + m_slot_size * size;
+        if (rank == root) {
+            mgb_throw_if(
+                    ftruncate(fd, m_mapped_size), SystemError,
+                    "failed to resize shared memory %s: %s", name.c_str(),
+                    strerror(errno));
+        }
+        m_mapped = mmap(
+                nullptr, m_mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        mgb_throw_if(
+                m_mapped == MAP_FAILED, SystemError,
+                "failed to map shared memory %s: %s", name.c_str(), strerror(errno));
+        m_header = static_cast<Header*>(m_mapped);
+    };
+
+    // the slot size of root is used by all ranks, and passed as the port
+    int port = static_cast<int>(m_slot_size);
+    if (rank == root) {
+        static std::atomic<uint32_t> nr_created{0};
+        name = ssprintf(
+                "/mgb_shm_comm_%d_%u", static_cast<int>(getpid()), nr_created++);
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        mgb_throw_if(
+                fd < 0, SystemError, "failed to create shared memory %s: %s",
+                name.c_str(), strerror(errno));
+        do_map();
+        new (m_header) Header;
+    }
+    group_client->bcast_addr(name, port, key, size, rank, root);
+    if (rank != root) {
+        m_slot_size = port;
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+        mgb_throw_if(
+                fd < 0, SystemError, "failed to open shared memory %s: %s",
+                name.c_str(), strerror(errno));
+        do_map();
+    }
+    mgb_assert(
+            m_slot_size >= sizeof(dt_float32) * size,
+            "shm comm slot size too small: %zu", m_slot_size);
+    m_scratch.resize(m_slot_size);
+
+    m_header->nr_attached.fetch_add(1, std::memory_order_acq_rel);
+    if (rank == root) {
+        // the segment is released when the last rank unmaps it
+        auto all_attached = [&]() {
+            return m_header->nr_attached.load(std::memory_order_acquire) >= size;
+        };
+        wait_until(all_attached, m_timeout_sec, "all ranks to attach");
+        shm_unlink(name.c_str());
+    }
+}
+
+ShmCommunicator::~ShmCommunicator() {
+    if (m_mapped) {
+        munmap(m_mapped, m_mapped_size);
+    }
+}
+
+uint8_t* ShmCommunicator::slot(uint32_t rank) const {
+    return static_cast<uint8_t*>(m_mapped) +
+           get_aligned_power2(sizeof(Header), CACHE_LINE) + m_slot_size * rank;
+}
+
+void ShmCommunicator::barrier() {
+    auto&& hdr = *m_header;
+    uint32_t gen = hdr.barrier_gen.load(std::memory_order_acquire);
+    if (hdr.barrier_count.fetch_add(1, std::memory_order_acq_rel) + 1 == m_size) {
+        hdr.barrier_count.store(0, std::memory_order_relaxed);
+        hdr.barrier_gen.fetch_add(1, std::memory_order_acq_rel);
+        return;
+    }
+    auto passed = [&]() {
+        return hdr.barrier_gen.load(std::memory_order_acquire) != gen;
+    };
+    wait_until(passed, m_timeout_sec, "a barrier");
+}
+
+void ShmCommunicator::reduce_slots(
+        void* dst, size_t slot_offset, size_t len, DType dtype, ReduceOp op) {
+    if (!len) {
+        return;
+    }
+    size_t esize = dtype.size(), offset = slot_offset * esize;
+    memcpy(dst, slot(0) + offset, len * esize);
+    for (uint32_t i = 1; i < m_size; ++i) {
+        auto src = slot(i) + offset;
+        switch (dtype.enumv()) {
+#define cb(_dt)                                                        \
+    case DTypeTrait<dtype::_dt>::enumv:                                \
+        reduce_into<DTypeTrait<dtype::_dt>::ctype>(dst, src, len, op); \
+        break;
+            cb(Int8) cb(Uint8) cb(Int32) cb(Float32)
+#if !MEGDNN_DISABLE_FLOAT16
+            cb(Float16)
+#endif
+#undef cb
+            default:
+                mgb_throw(MegBrainError, "bad shm comm dtype: %s", dtype.name());
+        }
+    }
+}
+
+void ShmCommunicator::do_reduce(
+        const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op,
+        int root) {
+    size_t esize = dtype.size(), chunk = m_slot_size / esize;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    bool need_output = root < 0 || static_cast<uint32_t>(root) == m_rank;
+    for (size_t off = 0; off < len; off += chunk) {
+        size_t n = std::min(chunk, len - off);
+        memcpy(slot(m_rank), src + off * esize, n * esize);
+        barrier();
+
+        // each rank reduces one part of the chunk, and publishes it in the
+        // same part of its own slot, which is read by no other rank now
+        size_t begin = n * m_rank / m_size, end = n * (m_rank + 1) / m_size;
+        auto acc = need_output ? dst + (off + begin) * esize : m_scratch.data();
+        reduce_slots(acc, begin, end - begin, dtype, op);
+        memcpy(slot(m_rank) + begin * esize, acc, (end - begin) * esize);
+        barrier();
+
+        if (need_output) {
+            for (uint32_t i = 0; i < m_size; ++i) {
+                if (i != m_rank) {
+                    size_t b = n * i / m_size, e = n * (i + 1) / m_size;
+                    memcpy(dst + (off + b) * esize, slot(i) + b * esize,
+                           (e - b) * esize);
+                }
+            }
+        }
+        barrier();
+    }
+}
+
+void ShmCommunicator::do_gather(
+        const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype, int root) {
+    size_t esize = dtype.size(), chunk = m_slot_size / esize;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    bool need_output = root < 0 || static_cast<uint32_t>(root) == m_rank;
+    for (size_t off = 0; off < sendlen; off += chunk) {
+        size_t n = std::min(chunk, sendlen - off);
+        memcpy(slot(m_rank), src + off * esize, n * esize);
+        barrier();
+        if (need_output) {
+            for (uint32_t i = 0; i < m_size; ++i) {
+                auto part = i == m_rank ? src + off * esize : slot(i);
+                memcpy(dst + (i * sendlen + off) * esize, part, n * esize);
+            }
+        }
+        barrier();
+    }
+}
+
+void ShmCommunicator::all_reduce(
+        const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op) {
+    do_reduce(sendbuf, recvbuf, len, dtype, op, -1);
+}
+
+void ShmCommunicator::reduce(
+        const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op,
+        uint32_t root) {
+    mgb_assert(root < m_size);
+    do_reduce(sendbuf, recvbuf, len, dtype, op, root);
+}
+
+void ShmCommunicator::reduce_scatter(
+        const void* sendbuf, void* recvbuf, size_t recvlen, DType dtype,
+        ReduceOp op) {
+    size_t esize = dtype.size(), chunk = m_slot_size / esize / m_size;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    for (size_t off = 0; off < recvlen; off += chunk) {
+        size_t n = std::min(chunk, recvlen - off);
+        for (uint32_t i = 0; i < m_size; ++i) {
+            memcpy(slot(m_rank) + i * n * esize, src + (i * recvlen + off) * esize,
+                   n * esize);
+        }
+        barrier();
+        reduce_slots(dst + off * esize, m_rank * n, n, dtype, op);
+        barrier();
+    }
+}
+
+void ShmCommunicator::all_gather(
+        const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype) {
+    do_gather(sendbuf, recvbuf, sendlen, dtype, -1);
+}
+
+void ShmCommunicator::gather(
+        const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype,
+        uint32_t root) {
+    mgb_assert(root < m_size);
+    do_gather(sendbuf, recvbuf, sendlen, dtype, root);
+}
+
+void ShmCommunicator::broadcast(
+        const void* sendbuf, void* recvbuf, size_t len, DType dtype, uint32_t root) {
+    mgb_assert(root < m_size);
+    size_t esize = dtype.size(), chunk = m_slot_size / esize;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    if (m_rank == root && src != dst) {
+        memcpy(dst, src, len * esize);
+    }
+    for (size_t off = 0; off < len; off += chunk) {
+        size_t n = std::min(chunk, len - off);
+        if (m_rank == root) {
+            memcpy(slot(root), src + off * esize, n * esize);
+        }
+        barrier();
+        if (m_rank != root) {
+            memcpy(dst + off * esize, slot(root), n * esize);
+        }
+        barrier();
+    }
+}
+
+void ShmCommunicator::scatter(
+        const void* sendbuf, void* recvbuf, size_t recvlen, DType dtype,
+        uint32_t root) {
+    mgb_assert(root < m_size);
+    size_t esize = dtype.size(), chunk = m_slot_size / esize / m_size;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    for (size_t off = 0; off < recvlen; off += chunk) {
+        size_t n = std::min(chunk, recvlen - off);
+        if (m_rank == root) {
+            for (uint32_t i = 0; i < m_size; ++i) {
+                memcpy(slot(root) + i * n * esize,
+                       src + (i * recvlen + off) * esize, n * esize);
+            }
+        }
+        barrier();
+        memcpy(dst + off * esize, slot(root) + m_rank * n * esize, n * esize);
+        barrier();
+    }
+}
+
+void ShmCommunicator::all_to_all(
+        const void* sendbuf, void* recvbuf, size_t len, DType dtype) {
+    size_t esize = dtype.size(), chunk = m_slot_size / esize / m_size;
+    auto src = static_cast<const uint8_t*>(sendbuf);
+    auto dst = static_cast<uint8_t*>(recvbuf);
+    for (size_t off = 0; off < len; off += chunk) {
+        size_t n = std::min(chunk, len - off);
+        for (uint32_t i = 0; i < m_size; ++i) {
+            memcpy(slot(m_rank) + i * n * esize, src + (i * len + off) * esize,
+                   n * esize);
+        }
+        barrier();
+        for (uint32_t i = 0; i < m_size; ++i) {
+            memcpy(dst + (i * len + off) * esize, slot(i) + m_rank * n * esize,
+                   n * esize);
+        }
+        barrier();
+    }
+}
+
+std::shared_ptr<ShmCommunicator> ShmCommunicator::get(
+        uint64_t hash, const std::string& key, uint32_t size, uint32_t rank,
+        std::shared_ptr<GroupClient> group_client) {
+    {
+        MGB_LOCK_GUARD(sm_cache_mtx);
+        auto iter = sm_cache.find(hash);
+        if (iter != sm_cache.end()) {
+            return iter->second;
+        }
+    }
+    // construct without holding the lock, since it waits for other ranks
+    // which may live in this process
+    auto comm = std::make_shared<ShmCommunicator>(
+            key, size, rank, group_client.get());
+    MGB_LOCK_GUARD(sm_cache_mtx);
+    return sm_cache.emplace(hash, comm).first->second;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -3,6 +3,7 @@
 #include "megbrain/graph.h"
 #include "megbrain/opr/group_manager.h"
 #include "megbrain/opr/param_defs.h"
+#include "megbrain/opr/shm_comm.h"
 #include "megray.h"
 
 namespace mgb {
@@ -120,6 +121,8 @@ private:
 
     std::shared_ptr<MegRay::Context> m_megray_ctx;
     std::shared_ptr<MegRay::Communicator> m_megray_comm;
+    //! used instead of m_megray_comm for the "shm" backend
+    std::shared_ptr<ShmCommunicator> m_shm_comm;
     bool m_init = false;
     bool m_debug_mode = false;
 
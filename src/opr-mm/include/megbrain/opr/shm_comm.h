@@ -0,0 +1,133 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "megbrain/dtype.h"
+#include "megbrain/opr/group_manager.h"
+
+namespace mgb {
+namespace opr {
+
+/*!
+ * \brief collective communication between ranks on the same host through a
+ *      POSIX shared memory segment
+ *
+ * The root rank creates the segment and its name is broadcast through
+ * GroupClient::bcast_addr(). The segment holds a barrier and one exchange
+ * slot per rank; data larger than a slot is transferred in chunks. Within a
+ * chunk every rank copies its data into its own slot, and after a barrier
+ * reads the slots of the others:
+ *  - reduction is split evenly over the ranks (the reduce-scatter and
+ *    all-gather phases of a ring all-reduce), and reduces in rank order so
+ *    all ranks get bitwise identical results;
+ *  - other collectives copy directly between the slots, which takes a
+ *    single step on shared memory instead of the rounds of a ring or tree.
+ *
+ * The ranks may be processes or threads in one process.
+ */
+class ShmCommunicator {
+public:
+    enum class ReduceOp { SUM, MAX, MIN };
+
+    //! default size in bytes of the exchange slot of each rank
+    static constexpr size_t DEFAULT_SLOT_SIZE = 1 << 20;
+
+    //! default seconds to wait for the other ranks in a barrier, after which
+    //! the peers are considered dead and MegBrainError is thrown
+    static constexpr double DEFAULT_TIMEOUT_SEC = 600;
+
+    /*!
+     * \brief create or attach to the shared memory segment; blocks until
+     *      all ranks have arrived
+     * \param key key of the group to broadcast the segment name
+     */
+    ShmCommunicator(
+            const std::string& key, uint32_t size, uint32_t rank,
+            GroupClient* group_client, size_t slot_size = DEFAULT_SLOT_SIZE,
+            double timeout_sec = DEFAULT_TIMEOUT_SEC);
+
+    ~ShmCommunicator();
+
+    uint32_t size() const { return m_size; }
+    uint32_t rank() const { return m_rank; }
+
+    //! \p sendbuf and \p recvbuf may be the same
+    void all_reduce(
+            const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op);
+
+    //! \p recvbuf is only used on root
+    void reduce(
+            const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op,
+            uint32_t root);
+
+    //! \p sendbuf contains size() * \p recvlen elements
+    void reduce_scatter(
+            const void* sendbuf, void* recvbuf, size_t recvlen, DType dtype,
+            ReduceOp op);
+
+    //! \p recvbuf contains size() * \p sendlen elements
+    void all_gather(const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype);
+
+    //! \p recvbuf is only used on root
+    void gather(
+            const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype,
+            uint32_t root);
+
+    //! \p sendbuf is only used on root
+    void broadcast(
+            const void* sendbuf, void* recvbuf, size_t len, DType dtype,
+            uint32_t root);
+
+    //! \p sendbuf is only used on root
+    void scatter(
+            const void* sendbuf, void* recvbuf, size_t recvlen, DType dtype,
+            uint32_t root);
+
+    //! both buffers contain size() blocks of \p len elements
+    void all_to_all(const void* sendbuf, void* recvbuf, size_t len, DType dtype);
+
+    //! get a communicator cached by the deduplicated hash of the group
+    static std::shared_ptr<ShmCommunicator> get(
+            uint64_t hash, const std::string& key, uint32_t size, uint32_t rank,
+            std::shared_ptr<GroupClient> group_client);
+
+private:
+    struct Header;
+
+    const uint32_t m_size, m_rank;
+    size_t m_slot_size;
+    const double m_timeout_sec;
+    size_t m_mapped_size = 0;
+    void* m_mapped = nullptr;
+    Header* m_header = nullptr;
+    //! accumulator of reduce on non-root ranks
+    std::vector<uint8_t> m_scratch;
+
+    void barrier();
+
+    uint8_t* slot(uint32_t rank) const;
+
+    //! reduce \p len elements starting at \p slot_offset of all slots in
+    //! rank order into \p dst
+    void reduce_slots(
+            void* dst, size_t slot_offset, size_t len, DType dtype, ReduceOp op);
+
+    void do_reduce(
+            const void* sendbuf, void* recvbuf, size_t len, DType dtype, ReduceOp op,
+            int root);
+
+    void do_gather(
+            const void* sendbuf, void* recvbuf, size_t sendlen, DType dtype,
+            int root);
+
+    static std::mutex sm_cache_mtx;
+    static std::unordered_map<uint64_t, std::shared_ptr<ShmCommunicator>> sm_cache;
+};
+
+}  // namespace opr
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
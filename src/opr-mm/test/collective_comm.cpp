@@ -8,6 +8,8 @@
 #include "megbrain/test/helper.h"
 #include "mock_client.h"
 
+#include <thread>
+
 using namespace mgb;
 
 using Mode = opr::CollectiveComm::Param::Mode;
@@ -1794,3 +1796,77 @@ TEST(TestOprCollectiveComm, AllToAllWithGradThisNodeOnly) {
 }
 
 #endif
+
+TEST(TestOprCollectiveComm, ShmBackend) {
+    constexpr size_t nr_devices = 3, nr_row = 6, nr_col = 5,
+                     nr_elem = nr_row * nr_col, blk = nr_elem / nr_devices;
+    HostTensorGenerator<> gen;
+    std::shared_ptr<HostTensorND> host_x[nr_devices];
+    for (auto&& i : host_x) {
+        i = gen({nr_row, nr_col});
+    }
+    auto px = [&](size_t rank, size_t idx) { return host_x[rank]->ptr<float>()[idx]; };
+
+    //! if computed is true, the input and output of the opr are computed by
+    //! cpu kernels, which run asynchronously on the comp node worker
+    auto run_one = [&](const Mode mode, const TensorShape& oshp,
+                       thin_function<float(size_t, size_t)> expect, bool computed) {
+        HostTensorND host_y[nr_devices];
+        auto client = std::make_shared<test::MockGroupClient>();
+        auto run = [&](size_t rank) {
+            auto graph = ComputingGraph::make();
+            auto cn = CompNode::load(ssprintf("cpu%zu", rank));
+            auto x = opr::Host2DeviceCopy::make(*graph, host_x[rank], cn);
+            if (computed) {
+                x = x * 2;
+            }
+            auto y = opr::CollectiveComm::make(
+                    {x}, graph.get(), "shm", nr_devices, rank == 0, rank, false,
+                    client, {mode}, dtype::Float32(), "shm")[0];
+            if (computed) {
+                y = y * 3;
+            }
+            auto func = graph->compile({make_callback_copy(y, host_y[rank])});
+            func->execute();
+        };
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < nr_devices; ++i) {
+            workers.emplace_back(run, i);
+        }
+        for (auto&& i : workers) {
+            i.join();
+        }
+        for (size_t rank = 0; rank < nr_devices; ++rank) {
+            ASSERT_EQ(oshp, host_y[rank].shape());
+            auto py = host_y[rank].ptr<float>();
+            float scale = computed ? 6 : 1;
+            for (size_t i = 0; i < oshp.total_nr_elems(); ++i) {
+                MGB_ASSERT_FLOAT_EQ(expect(rank, i) * scale, py[i]);
+            }
+        }
+    };
+    auto run_mode = [&](const Mode mode, const TensorShape& oshp,
+                        thin_function<float(size_t, size_t)> expect) {
+        run_one(mode, oshp, expect, false);
+        run_one(mode, oshp, expect, true);
+    };
+
+    run_mode(Mode::ALL_REDUCE_SUM, {nr_row, nr_col}, [&](size_t, size_t i) {
+        return px(0, i) + px(1, i) + px(2, i);
+    });
+    run_mode(Mode::ALL_REDUCE_MAX, {nr_row, nr_col}, [&](size_t, size_t i) {
+        return std::max(std::max(px(0, i), px(1, i)), px(2, i));
+    });
+    run_mode(Mode::ALL_GATHER, {nr_row * nr_devices, nr_col}, [&](size_t, size_t i) {
+        return px(i / nr_elem, i % nr_elem);
+    });
+    run_mode(
+            Mode::REDUCE_SCATTER_SUM, {nr_row / nr_devices, nr_col},
+            [&](size_t rank, size_t i) {
+                i += rank * blk;
+                return px(0, i) + px(1, i) + px(2, i);
+            });
+    run_mode(Mode::ALL_TO_ALL, {nr_row, nr_col}, [&](size_t rank, size_t i) {
+        return px(i / blk, rank * blk + i % blk);
+    });
+}
@@ -0,0 +1,142 @@
+#include "megbrain/opr/shm_comm.h"
+#include "megbrain/opr/mm_handler.h"
+#include "megbrain/test/helper.h"
+#include "mock_client.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <thread>
+
+using namespace mgb;
+using ReduceOp = opr::ShmCommunicator::ReduceOp;
+
+namespace {
+
+float get_value(uint32_t rank, size_t idx) {
+    return static_cast<float>((rank * 131 + idx * 7) % 97) - 40.f;
+}
+
+//! run collectives on one rank and return number of mismatched elements
+size_t check_rank(opr::GroupClient* client, uint32_t size, uint32_t rank) {
+    // use small slots so data is transferred in multiple chunks
+    opr::ShmCommunicator comm{"shm_comm", size, rank, client, 256};
+    size_t nr_err = 0;
+    for (size_t len : {1, 63, 1000}) {
+        std::vector<float> src(len * size), dst(len * size);
+        for (size_t i = 0; i < src.size(); ++i) {
+            src[i] = get_value(rank, i);
+        }
+
+        comm.all_reduce(src.data(), dst.data(), len, dtype::Float32(), ReduceOp::SUM);
+        for (size_t i = 0; i < len; ++i) {
+            float expect = get_value(0, i);
+            for (uint32_t r = 1; r < size; ++r) {
+                expect += get_value(r, i);
+            }
+            nr_err += expect != dst[i];
+        }
+
+        comm.reduce_scatter(
+                src.data(), dst.data(), len, dtype::Float32(), ReduceOp::MAX);
+        for (size_t i = 0; i < len; ++i) {
+            float expect = get_value(0, rank * len + i);
+            for (uint32_t r = 1; r < size; ++r) {
+                expect = std::max(expect, get_value(r, rank * len + i));
+            }
+            nr_err += expect != dst[i];
+        }
+
+        comm.all_gather(src.data(), dst.data(), len, dtype::Float32());
+        for (size_t i = 0; i < len * size; ++i) {
+            nr_err += get_value(i / len, i % len) != dst[i];
+        }
+
+        comm.broadcast(src.data(), dst.data(), len, dtype::Float32(), size - 1);
+        for (size_t i = 0; i < len; ++i) {
+            nr_err += get_value(size - 1, i) != dst[i];
+        }
+
+        comm.all_to_all(src.data(), dst.data(), len, dtype::Float32());
+        for (size_t i = 0; i < len * size; ++i) {
+            nr_err += get_value(i / len, rank * len + i % len) != dst[i];
+        }
+    }
+    return nr_err;
+}
+
+}  // anonymous namespace
+
+TEST(TestOprShmComm, MultiThread) {
+    constexpr uint32_t size = 3;
+    auto client = std::make_shared<test::MockGroupClient>();
+    size_t nr_err[size];
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < size; ++i) {
+        workers.emplace_back(
+                [&, i]() { nr_err[i] = check_rank(client.get(), size, i); });
+    }
+    for (auto&& i : workers) {
+        i.join();
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        ASSERT_EQ(0u, nr_err[i]) << "rank " << i;
+    }
+}
+
+TEST(TestOprShmComm, PeerDied) {
+    auto client = std::make_shared<test::MockGroupClient>();
+    constexpr double timeout_sec = 0.5;
+    // rank 1 attaches and leaves without taking part in any collective
+    std::thread peer([&]() {
+        opr::ShmCommunicator comm{"shm_comm_died", 2, 1, client.get(), 256,
+                                  timeout_sec};
+    });
+    opr::ShmCommunicator comm{"shm_comm_died", 2, 0, client.get(), 256, timeout_sec};
+    peer.join();
+    float src[4] = {1, 2, 3, 4}, dst[4];
+    ASSERT_THROW(
+            comm.all_reduce(src, dst, 4, dtype::Float32(), ReduceOp::SUM),
+            MegBrainError);
+}
+
+TEST(TestOprShmComm, MultiProcess) {
+    constexpr uint32_t size = 4;
+
+    // fork before creating any zmq object, and send the server port to the
+    // children through pipes
+    int pipes[size][2];
+    pid_t pids[size];
+    for (uint32_t i = 1; i < size; ++i) {
+        ASSERT_EQ(0, pipe(pipes[i]));
+        pids[i] = fork();
+        ASSERT_GE(pids[i], 0);
+        if (!pids[i]) {
+            int port = 0;
+            close(pipes[i][1]);
+            if (read(pipes[i][0], &port, sizeof(port)) != sizeof(port)) {
+                _exit(2);
+            }
+            opr::GroupClientProxy client{ssprintf("localhost:%d", port)};
+            _exit(check_rank(&client, size, i) ? 1 : 0);
+        }
+        close(pipes[i][0]);
+    }
+
+    int port = opr::create_zmqrpc_server("localhost", 0);
+    for (uint32_t i = 1; i < size; ++i) {
+        ASSERT_EQ(
+                static_cast<ssize_t>(sizeof(port)),
+                write(pipes[i][1], &port, sizeof(port)));
+        close(pipes[i][1]);
+    }
+    opr::GroupClientProxy client{ssprintf("localhost:%d", port)};
+    ASSERT_EQ(0u, check_rank(&client, size, 0));
+    for (uint32_t i = 1; i < size; ++i) {
+        int status;
+        ASSERT_EQ(pids[i], waitpid(pids[i], &status, 0));
+        ASSERT_TRUE(WIFEXITED(status));
+        ASSERT_EQ(0, WEXITSTATUS(status)) << "rank " << i;
+    }
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
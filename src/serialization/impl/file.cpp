@@ -1,5 +1,12 @@
 #include "megbrain/serialization/file.h"
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mgb {
 namespace serialization {
 
@@ -233,6 +240,36 @@ std::unique_ptr<InputFile> InputFile::make_mem_proxy(
     return std::make_unique<SharedMemProxyImpl>(std::move(ptr), size, writable);
 }
 
+std::unique_ptr<InputFile> InputFile::make_mmap(const char* path) {
+#ifdef WIN32
+    FILE* fptr = fopen(path, "rb");
+    mgb_assert(fptr, "failed to open %s: %s", path, strerror(errno));
+    fseek(fptr, 0, SEEK_END);
+    size_t size = ftell(fptr);
+    std::rewind(fptr);
+    std::shared_ptr<void> buf{
+            new uint8_t[size], [](void* p) { delete[] static_cast<uint8_t*>(p); }};
+    auto nr = fread(buf.get(), 1, size, fptr);
+    fclose(fptr);
+    mgb_assert(nr == size, "failed to read %s", path);
+#else
+    int fd = open(path, O_RDONLY);
+    mgb_assert(fd >= 0, "failed to open %s: %s", path, strerror(errno));
+    struct stat st;
+    auto err = fstat(fd, &st);
+    mgb_assert(!err, "failed to stat %s: %s", path, strerror(errno));
+    size_t size = st.st_size;
+    mgb_assert(size, "empty file: %s", path);
+    // private mapping keeps the file untouched when tensor values are
+    // modified or moved for alignment
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    mgb_assert(ptr != MAP_FAILED, "failed to mmap %s: %s", path, strerror(errno));
+    std::shared_ptr<void> buf{ptr, [size](void* p) { munmap(p, size); }};
+#endif
+    return std::make_unique<SharedMemProxyImpl>(std::move(buf), size, true);
+}
+
 class OutputFile::VectorProxyImpl final : public OutputFile {
     std::vector<uint8_t>* const m_buf;
     size_t m_offset;
@@ -448,10 +448,18 @@ void GraphDumperOSSV2::dump_tensor(
                     reinterpret_cast<uint8_t*>(out_vec.data()), out_vec.size());
             m_cur_rst.tensor_value_bytes += out_vec.size();
         } else {
+            auto size = layout.span().high_byte;
+            if (auto align = m_config.tensor_value_align) {
+                mgb_assert(
+                        !(align & (align - 1)),
+                        "tensor_value_align must be power of 2, got %zu", align);
+                // the builder grows downwards, so this pads after the value
+                // and makes the value start at an aligned offset
+                m_builder.PreAlign(size, align);
+            }
             data = m_builder.CreateVector(
-                    reinterpret_cast<uint8_t*>(tensor.raw_ptr()),
-                    layout.span().high_byte);
-            m_cur_rst.tensor_value_bytes += layout.span().high_byte;
+                    reinterpret_cast<uint8_t*>(tensor.raw_ptr()), size);
+            m_cur_rst.tensor_value_bytes += size;
         }
     }
 
@@ -72,6 +72,21 @@ public:
     //! create an InputFile correspoding to a file on local file system
     MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_fs(const char* path);
 
+    /*!
+     * \brief create an InputFile that maps a file on local file system into
+     *      memory
+     *
+     * The mapping is private (copy-on-write), and tensor values are loaded
+     * by sharing the mapped pages like make_mem_proxy() with writable set
+     * to true, so processes loading the same model share its weights in
+     * page cache. Tensor values should be aligned at dump time (see
+     * GraphDumpConfig::tensor_value_align), otherwise they would be moved
+     * to aligned addresses and the touched pages become private. Falls
+     * back to reading the whole file if mmap is not available.
+     */
+    MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_mmap(
+            const char* path);
+
     //! create an InputFile correspoding to a memory region; the memory
     //! region must be alive throughout lifespan of this InputFile
     MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_mem_proxy(
@@ -66,6 +66,12 @@ struct GraphDumpConfig {
     //! whether dump to compat older megbrain version
     std::string compat_older_version;
 
+    //! alignment in bytes of tensor values relative to the beginning of the
+    //! dumped graph; only used by FLATBUFFERS_V2. Aligned values can be
+    //! shared in place when the model is loaded from memory or from
+    //! InputFile::make_mmap(). 0 means no extra alignment.
+    size_t tensor_value_align = 0;
+
     GraphDumpConfig(
             int keep_var_name_ = 1, bool keep_param_name_ = false,
             bool keep_opr_priority_ = false, bool keep_op_name_ = true,
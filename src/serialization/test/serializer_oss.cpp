@@ -896,6 +896,64 @@ void test_serializer_memshare(GraphDumpFormat format) {
     }
 }
 
+void test_serializer_mmap(GraphDumpFormat format) {
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    constexpr size_t SIZE = 127, ALIGN = 64;
+    auto xval = gen({SIZE}, "cpu0"), bval = gen({3}, "cpu0");
+
+    std::vector<uint8_t> buf;
+    auto dump = [&](std::unique_ptr<OutputFile> fout) {
+        auto graph = ComputingGraph::make();
+        auto b = opr::SharedDeviceTensor::make(*graph, *bval).rename("b");
+        auto x = opr::SharedDeviceTensor::make(*graph, *xval).rename("x");
+        auto dumper = GraphDumper::make(std::move(fout), format);
+        GraphDumper::DumpConfig config;
+        config.tensor_value_align = ALIGN;
+        dumper->dump({x + opr::reduce_sum(b, b.make_scalar(1)), x}, config);
+    };
+    dump(OutputFile::make_fs(fname.c_str()));
+    dump(OutputFile::make_vector_proxy(&buf));
+
+    HostTensorND expected;
+    expected.copy_from(*xval);
+    float bsum = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        bsum += bval->ptr<float>()[i];
+    }
+    for (size_t i = 0; i < SIZE; ++i) {
+        expected.ptr<float>()[i] += bsum;
+    }
+
+    auto check = [&](std::unique_ptr<InputFile> fin) {
+        auto loader = GraphLoader::make(std::move(fin), format);
+        auto rst = loader->load();
+        auto x = rst.output_var_map.at("x");
+        auto&& opr = x.node()->owner_opr()->cast_final_safe<opr::SharedDeviceTensor>();
+        HostTensorND val;
+        auto func =
+                rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+        func->execute();
+        MGB_ASSERT_TENSOR_NEAR(expected, val, 1e-6);
+        MGB_ASSERT_TENSOR_EQ(*xval, HostTensorND{}.copy_from(*opr.dev_data()).sync());
+        return opr.dev_data()->raw_ptr();
+    };
+
+    check(InputFile::make_mmap(fname.c_str()));
+
+    // tensor values are shared in place without being moved when the
+    // buffer is aligned
+    std::vector<uint8_t> buf_al(buf.size() + ALIGN);
+    auto begin = reinterpret_cast<uint8_t*>(
+            (reinterpret_cast<uintptr_t>(buf_al.data()) + ALIGN - 1) & ~(ALIGN - 1));
+    memcpy(begin, buf.data(), buf.size());
+    auto ptr = reinterpret_cast<uint8_t*>(check(InputFile::make_mem_proxy(
+            std::shared_ptr<void>{std::shared_ptr<void>{}, begin}, buf.size(),
+            false)));
+    ASSERT_TRUE(begin <= ptr && ptr + SIZE * sizeof(float) <= begin + buf.size());
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % ALIGN);
+}
+
 }  // namespace
 
 TEST(TestSerializer2, GraphDumpLoad) {
@@ -1048,6 +1106,10 @@ TEST(TestSerializer2, ShareMemv2) {
     test_serializer_memshare(GraphDumpFormat::FLATBUFFERS_V2);
 }
 
+TEST(TestSerializer2, MmapV2) {
+    test_serializer_mmap(GraphDumpFormat::FLATBUFFERS_V2);
+}
+
 TEST(TestSerializer2, TestSoftMaxLoadDump) {
     auto fname = GET_OUTPUT_FILE(GraphDumpFormat::FLATBUFFERS_V2);
     TensorShape shape{2, 3};